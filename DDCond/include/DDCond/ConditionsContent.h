@@ -19,6 +19,7 @@
 #include "DD4hep/ConditionDerived.h"
 
 // C/C++ include files
+#include <mutex>
 #include <memory>
 #include <unordered_map>
 
@@ -101,12 +102,21 @@ namespace dd4hep {
       typedef std::map<Condition::key_type,ConditionsLoadInfo* >  Conditions;
       //typedef std::unordered_map<Condition::key_type,ConditionDependency* > Dependencies;
       //typedef std::unordered_map<Condition::key_type,ConditionsLoadInfo* >  Conditions;
+      /// Dependency levels of the derived conditions: key -> (dependency, level)
+      typedef std::unordered_map<Condition::key_type,std::pair<const ConditionDependency*,int> > Levels;
 
     protected:
       /// Container of conditions required by this content
       Conditions        m_conditions;
       /// Container of derived conditions required by this content
       Dependencies      m_derived;
+      /// Cached dependency levels of the derived conditions
+      mutable std::shared_ptr<const Levels> m_levels;     //! Not ROOT persistent
+      /// Lock to protect the dependency level cache
+      mutable std::mutex                    m_levelLock;  //! Not ROOT persistent
+
+      /// Invalidate the dependency level cache
+      void resetLevels();
 
     private:
       /// Default assignment operator
@@ -127,6 +137,12 @@ namespace dd4hep {
       Dependencies& derived()               { return m_derived;      }
       /// Access to the derived condition entries to be computed (CONST)
       const Dependencies& derived() const   { return m_derived;      }
+      /// Topological levels of the derived conditions. Computed once and cached
+      /** Derived conditions of level 0 only depend on conditions, which are not derived.
+       *  Derived conditions of level n depend on derived conditions of levels < n.
+       *  Derived conditions within or depending on a dependency cycle have level -1.
+       */
+      std::shared_ptr<const Levels> dependencyLevels()  const;
       /// Clear the conditions content definitions
       void clear();
       /// Merge the content of "to_add" into the this content
@@ -23,6 +23,7 @@
 // C/C++ include files
 #include <list>
 #include <set>
+#include <mutex>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -60,6 +61,8 @@ namespace dd4hep {
       ConditionsManager m_mgr;
       /// Property: input data source definitions
       Sources           m_sources;
+      /// Lock to serialize the access to the persistent medium
+      std::mutex        m_loadLock;
 
     protected:
       /// Queue update to manager.
@@ -84,6 +87,10 @@ namespace dd4hep {
       void addSource(const std::string& source);
       /// Add data source definition to loader for data corresponding to a given IOV
       void addSource(const std::string& source, const IOV& iov);
+      /// Acquire the loader lock: loaders are not re-entrant and shared by all IOV types
+      std::unique_lock<std::mutex> loadLock()  {
+        return std::unique_lock<std::mutex>(m_loadLock);
+      }
 #if 0
       /// Load  a condition set given the conditions key according to their validity
       virtual size_t load_single(key_type         key,
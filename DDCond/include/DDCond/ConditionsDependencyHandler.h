@@ -17,8 +17,14 @@
 #include "DD4hep/DetElement.h"
 #include "DD4hep/ConditionDerived.h"
 #include "DDCond/ConditionsPool.h"
+#include "DDCond/ConditionsContent.h"
 #include "DDCond/ConditionsManager.h"
 
+// C/C++ include files
+#include <mutex>
+#include <functional>
+#include <atomic>
+
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
 
@@ -44,6 +50,13 @@ namespace dd4hep {
      *  ConditionResolver interface in order to allow for upgrades of
      *  this implementation which might not be polymorph.
      *
+     *  If the dependency levels of the slice content are supplied and the
+     *  conditions manager has the property ComputeThreads > 0, the derived
+     *  conditions are computed level by level: callbacks of dependencies
+     *  flagged threadSafe are executed concurrently on a TBB task arena,
+     *  all other callbacks sequentially. Without TBB all callbacks are
+     *  executed sequentially.
+     *
      *  \author  M.Frank
      *  \version 1.0
      */
@@ -65,6 +78,8 @@ namespace dd4hep {
         int                        callstack = 0;
         /// Current conversion state of the item
         State                      state     = INVALID;
+        /// Time spent in the creation callback [nanoseconds]
+        long long                  elapsed   = 0;
       public:
         /// Inhibit default constructor
         Work() = delete;
@@ -103,15 +118,33 @@ namespace dd4hep {
       State                       m_state = CREATED;
       /// Current block work item
       Work*                       m_block = 0;
-      /// Current item of the block
-      Work*                       m_currentWork = 0;
+      /// Dependency levels of the slice content (optional)
+      std::shared_ptr<const ConditionsContent::Levels> m_levels;
+      /// Lock for work item state changes and pool accesses while callbacks run concurrently
+      std::recursive_mutex        m_lock;
+      /// Flag if callbacks are currently executed concurrently
+      bool                        m_parallel = false;
+      /// Flag to measure the time spent in the callbacks
+      bool                        m_timing   = false;
     public:
       /// Number of callbacks to the handler for monitoring
-      mutable size_t              num_callback;
+      mutable std::atomic<size_t> num_callback;
 
     protected:
+      /// Current item of the executing thread
+      static Work*& currentWork();
       /// Internal call to trigger update callback
       void do_callback(Work* dep);
+      /// Execute the work items level by level with the compute threads. Returns false if not possible
+      bool execute_levels(const char* action, const std::function<void(Work*)>& execute);
+      /// Compute the missing conditions level by level. Returns false if not possible
+      bool compute_parallel();
+      /// Resolve the created conditions level by level. Returns false if not possible
+      bool resolve_parallel();
+      /// Lock the handler if callbacks are executed concurrently
+      std::unique_lock<std::recursive_mutex> parallel_lock();
+      /// Print the timing report of the callbacks
+      void print_timing()  const;
 
     public:
       /// Initializing constructor
@@ -119,6 +152,12 @@ namespace dd4hep {
                                   UserPool& pool, 
                                   const Dependencies& dependencies,
                                   ConditionUpdateUserContext* user_param);
+      /// Initializing constructor with the dependency levels of the slice content
+      ConditionsDependencyHandler(ConditionsManager mgr,
+                                  UserPool& pool, 
+                                  const Dependencies& dependencies,
+                                  ConditionUpdateUserContext* user_param,
+                                  std::shared_ptr<const ConditionsContent::Levels> levels);
       /// Default destructor
       ~ConditionsDependencyHandler();
 
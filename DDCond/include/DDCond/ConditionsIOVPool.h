@@ -18,7 +18,10 @@
 
 // C/C++ include files
 #include <map>
+#include <mutex>
+#include <atomic>
 #include <memory>
+#include <shared_mutex>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -31,6 +34,15 @@ namespace dd4hep {
      *  Purely internal class to the conditions manager implementation.
      *  Not at all to be accessed by clients!
      *
+     *  The pool content is read-mostly: selections share the pool lock,
+     *  the registration of new pools and conditions takes it exclusively.
+     *  Every change of the content increments the version number. Clients
+     *  may compare versions to detect changes since a previous selection.
+     *  The computation of missing derived conditions is serialized with the
+     *  build lock: concurrent requests wait and then re-use the conditions
+     *  created by the first request. Loading is serialized for all IOV types
+     *  by the lock of the conditions loader (ConditionsDataLoader::loadLock).
+     *
      *  \author  M.Frank
      *  \version 1.0
      *  \ingroup DD4HEP_CONDITIONS
@@ -42,12 +54,55 @@ namespace dd4hep {
       /// Shortcut name for the actual conditions container
       typedef std::map<IOV::Key, Element >    Elements;      
 
+      /// Lock contention statistics of the pool
+      /**
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_CONDITIONS
+       */
+      class LockStatistics  {
+      public:
+        /// Number of shared (read) accesses
+        std::atomic<long>      reads      { 0 };
+        /// Number of exclusive (write) accesses
+        std::atomic<long>      writes     { 0 };
+        /// Number of builds of missing conditions
+        std::atomic<long>      builds     { 0 };
+        /// Number of builds satisfied by a concurrent build of another thread
+        std::atomic<long>      shared     { 0 };
+        /// Number of derived computations executed
+        std::atomic<long>      computed   { 0 };
+        /// Time spent waiting for the pool lock [nanoseconds]
+        std::atomic<long long> lockWait   { 0 };
+        /// Time spent waiting for the build lock [nanoseconds]
+        std::atomic<long long> buildWait  { 0 };
+      };
+
       /// Container of IOV dependent conditions pools
-      Elements elements;     //! Not ROOT persistent
+      Elements                   elements;         //! Not ROOT persistent
       /// Reference to the IOV container
-      const IOVType* type;   //! Not ROOT persistent
-      
+      const IOVType*             type;             //! Not ROOT persistent
+      /// Content version: incremented whenever pools or conditions are added or removed
+      std::atomic<unsigned long> version   { 0 };  //! Not ROOT persistent
+      /// Lock contention statistics
+      mutable LockStatistics     statistics;       //! Not ROOT persistent
+
+    protected:
+      /// Reader-writer lock of the pool content (shared_timed_mutex: C++14)
+      mutable std::shared_timed_mutex m_lock;      //! Not ROOT persistent
+      /// Lock to serialize the creation of missing conditions
+      std::mutex                 m_buildLock;      //! Not ROOT persistent
+
     public:
+      /// Acquire shared access to the pool content for selections
+      std::shared_lock<std::shared_timed_mutex> readLock()  const;
+      /// Acquire exclusive access to the pool content for insertions and removals
+      std::unique_lock<std::shared_timed_mutex> writeLock();
+      /// Acquire the build lock before computing missing derived conditions
+      std::unique_lock<std::mutex> buildLock();
+      /// Print the lock statistics
+      void printStatistics()  const;
+
       /// Default constructor
       ConditionsIOVPool(const IOVType* type);
       /// Default destructor
@@ -62,10 +62,12 @@ namespace dd4hep {
         size_t loaded   = 0;
         size_t computed = 0;
         size_t missing  = 0;
+        /// Derived conditions taken over from the previous IOV (incremental updates)
+        size_t reused   = 0;
         Result() = default;
         Result(const Result& result) = default;
         Result& operator=(const Result& result) = default;
-        size_t total() const { return selected+computed+loaded; }
+        size_t total() const { return selected+computed+loaded+reused; }
         /// Add results
         Result& operator +=(const Result& result);
         /// Subtract results
@@ -203,6 +205,7 @@ namespace dd4hep {
       loaded   += result.loaded;
       computed += result.computed;
       missing  += result.missing;
+      reused   += result.reused;
       return *this;
     }
     /// Subtract results
@@ -212,6 +215,7 @@ namespace dd4hep {
       loaded   -= result.loaded;
       computed -= result.computed;
       missing  -= result.missing;
+      reused   -= result.reused;
       return *this;
     }
   }       /* End namespace cond        */
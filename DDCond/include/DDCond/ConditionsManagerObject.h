@@ -72,6 +72,16 @@ namespace dd4hep {
       bool                   m_doLoad = true;
       /// Property: Flag to indicate if unloaded items should be saved to the slice (or not)
       bool                   m_doOutputUnloaded = false;
+      /// Property: Number of threads to compute thread safe derived conditions (0: sequential)
+      int                    m_computeThreads = 0;
+      /// Property: Flag to print a timing report of the derived conditions callbacks
+      bool                   m_doCallbackTiming = false;
+      /// Property: Flag to re-use derived conditions of the previous IOV if their inputs did not change
+      /** Inputs are unchanged if the user pool contains the identical object or, for reloaded
+       *  raw conditions, the same data type with the same data, compared by the string
+       *  representation of the grammar.
+       */
+      bool                   m_doIncremental = false;
 
       /// Register callback listener object
       void registerCallee(Listeners& listeners, const Listener& callee, bool add);
@@ -96,6 +106,15 @@ namespace dd4hep {
       /// Access to flag to indicate if unloaded items should be saved to the slice (or not)
       bool doOutputUnloaded()  const        {  return m_doOutputUnloaded;     }
 
+      /// Access to the number of threads to compute derived conditions
+      int computeThreads()  const           {  return m_computeThreads;       }
+
+      /// Access to the flag to print the timing report of the derived conditions callbacks
+      bool doCallbackTiming()  const        {  return m_doCallbackTiming;     }
+
+      /// Access to the flag to re-use derived conditions with unchanged inputs on IOV transitions
+      bool doIncrementalUpdates()  const    {  return m_doIncremental;        }
+
       /// Listener invocation when a condition is registered to the cache
       void onRegister(Condition condition);
 
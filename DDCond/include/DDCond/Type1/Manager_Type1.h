@@ -136,7 +136,7 @@ namespace dd4hep {
       /// Access conditions multi IOV pool by iov type
       virtual ConditionsIOVPool* iovPool(const IOVType& type)  const  final;
 
-      /// Register new condition with the conditions store. Unlocked version, not multi-threaded
+      /// Register new condition with the conditions store. Locks only the IOV pool, not the manager
       virtual bool registerUnlocked(ConditionsPool& pool, Condition cond)  final;
 
       /// Register a whole block of conditions with identical IOV.
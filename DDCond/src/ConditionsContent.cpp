@@ -16,6 +16,10 @@
 #include <DD4hep/InstanceCount.h>
 #include <DD4hep/Printout.h>
 
+// C/C++ include files
+#include <vector>
+#include <algorithm>
+
 using namespace dd4hep::cond;
 
 /// Default constructor
@@ -45,6 +49,60 @@ ConditionsContent::~ConditionsContent()   {
 void ConditionsContent::clear()   {
   detail::releaseObjects(m_derived);
   detail::releaseObjects(m_conditions);
+  resetLevels();
+}
+
+/// Invalidate the dependency level cache
+void ConditionsContent::resetLevels()   {
+  std::lock_guard<std::mutex> lock(m_levelLock);
+  m_levels.reset();
+}
+
+/// Topological levels of the derived conditions. Computed once and cached
+std::shared_ptr<const ConditionsContent::Levels> ConditionsContent::dependencyLevels()  const   {
+  std::lock_guard<std::mutex> lock(m_levelLock);
+  // derived() gives write access: a different size also invalidates the cache
+  if ( m_levels && m_levels->size() == m_derived.size() )   {
+    return m_levels;
+  }
+  constexpr int IN_PROGRESS = -2;
+  auto levels = std::make_shared<Levels>();
+  levels->reserve(m_derived.size());
+  // Depth first traversal without recursion: dependency chains may be long
+  std::vector<std::pair<Condition::key_type,std::size_t> > stack;
+  for( const auto& d : m_derived )   {
+    if ( !levels->emplace(d.first, std::make_pair(d.second, IN_PROGRESS)).second )
+      continue;
+    stack.emplace_back(d.first, 0);
+    while( !stack.empty() )   {
+      auto& top = stack.back();
+      auto& entry = (*levels)[top.first];
+      const auto& deps = entry.first->dependencies;
+      if ( top.second < deps.size() )   {
+        Condition::key_type key = deps[top.second++].hash;
+        auto i = m_derived.find(key);
+        if ( i != m_derived.end() && levels->emplace(key, std::make_pair(i->second, IN_PROGRESS)).second )
+          stack.emplace_back(key, 0);
+        continue;
+      }
+      int level = 0;
+      for( const auto& k : deps )   {
+        auto j = levels->find(k.hash);
+        if ( j == levels->end() )   {
+          continue;  // Not derived
+        }
+        else if ( j->second.second < 0 )   {
+          level = -1;  // Cycle or depending on a cycle
+          break;
+        }
+        level = std::max(level, j->second.second+1);
+      }
+      entry.second = level;
+      stack.pop_back();
+    }
+  }
+  m_levels = levels;
+  return m_levels;
 }
 
 /// Merge the content of "to_add" into the this content
@@ -67,6 +125,7 @@ void ConditionsContent::merge(const ConditionsContent& to_add)    {
     auto ret = m_derived.emplace(d);
     if ( ret.second )  {
       d.second->addRef();
+      resetLevels();
       continue;
     }
     // Need error handling here ?
@@ -88,6 +147,7 @@ bool ConditionsContent::remove(Condition::key_type hash)   {
   if ( j != m_derived.end() )  {
     detail::releasePtr((*j).second);
     m_derived.erase(j);
+    resetLevels();
     return true;
   }
   return false;
@@ -124,6 +184,7 @@ ConditionsContent::addDependency(ConditionDependency* dep)
   if ( ret.second )  {
     //printout(DEBUG,"ConditionsContent","++ Add dependency key: %016X",dep->key());
     dep->addRef();
+    resetLevels();
     return *(ret.first);
   }
   ConditionKey::KeyMaker maker(dep->target.hash);
@@ -18,6 +18,15 @@
 #include <DD4hep/Printout.h>
 #include <TTimeStamp.h>
 
+#ifdef DD4HEP_USE_TBB
+#include <tbb/task_arena.h>
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#endif
+
+// C/C++ include files
+#include <chrono>
+
 using namespace dd4hep::cond;
 
 namespace {
@@ -76,6 +85,18 @@ ConditionsDependencyHandler::ConditionsDependencyHandler(ConditionsManager   mgr
     p += sizeof(Work);
   }
   m_iovType = iov.iovType;
+  m_timing  = m_manager->doCallbackTiming();
+}
+
+/// Initializing constructor with the dependency levels of the slice content
+ConditionsDependencyHandler::ConditionsDependencyHandler(ConditionsManager   mgr,
+                                                         UserPool&           pool,
+                                                         const Dependencies& dependencies,
+                                                         ConditionUpdateUserContext* user_param,
+                                                         std::shared_ptr<const ConditionsContent::Levels> levels)
+  : ConditionsDependencyHandler(mgr, pool, dependencies, user_param)
+{
+  m_levels = std::move(levels);
 }
 
 /// Default destructor
@@ -90,9 +111,145 @@ dd4hep::Detector& ConditionsDependencyHandler::detectorDescription() const  {
   return m_manager->detectorDescription();
 }
 
+/// Current item of the executing thread
+ConditionsDependencyHandler::Work*& ConditionsDependencyHandler::currentWork()   {
+  static thread_local Work* s_current = nullptr;
+  return s_current;
+}
+
+/// Lock the handler if callbacks are executed concurrently
+std::unique_lock<std::recursive_mutex> ConditionsDependencyHandler::parallel_lock()   {
+  std::unique_lock<std::recursive_mutex> lock(m_lock, std::defer_lock);
+  if ( m_parallel ) lock.lock();
+  return lock;
+}
+
+/// Execute the work items level by level with the compute threads. Returns false if not possible
+bool ConditionsDependencyHandler::execute_levels(const char* action, const std::function<void(Work*)>& execute)   {
+#ifdef DD4HEP_USE_TBB
+  int num_threads = m_manager->computeThreads();
+  if ( num_threads <= 0 || m_todo.size() < 2 )   {
+    return false;
+  }
+  std::vector<std::vector<Work*> > concurrent, sequential;
+  std::vector<Work*> unordered;
+  for( const auto& i : m_todo )   {
+    Work* w = i.second;
+    auto  l = m_levels->find(i.first);
+    if ( l == m_levels->end() || l->second.first != w->context.dependency )   {
+      // The levels do not describe these dependencies: execute sequentially
+      return false;
+    }
+    int level = l->second.second;
+    if ( level < 0 )   {
+      unordered.emplace_back(w);
+      continue;
+    }
+    if ( std::size_t(level) >= concurrent.size() )   {
+      concurrent.resize(level+1);
+      sequential.resize(level+1);
+    }
+    if ( w->context.dependency->threadSafe )
+      concurrent[level].emplace_back(w);
+    else
+      sequential[level].emplace_back(w);
+  }
+  tbb::task_arena arena(num_threads);
+  for( std::size_t level = 0; level < concurrent.size(); ++level )   {
+    // Thread safe callbacks of one level only depend on lower levels: run them concurrently.
+    auto& work = concurrent[level];
+    if ( work.size() > 1 )   {
+      m_parallel = true;
+      try  {
+        arena.execute([&work, &execute]()   {
+          tbb::parallel_for(tbb::blocked_range<std::size_t>(0, work.size()),
+                            [&work, &execute](const tbb::blocked_range<std::size_t>& r)  {
+                              for( std::size_t i = r.begin(); i != r.end(); ++i )
+                                execute(work[i]);
+                            });
+        });
+      }
+      catch(...)   {
+        m_parallel = false;
+        throw;
+      }
+      m_parallel = false;
+    }
+    else if ( !work.empty() )   {
+      execute(work[0]);
+    }
+    for( Work* w : sequential[level] )
+      execute(w);
+  }
+  for( Work* w : unordered )
+    execute(w);
+  printout(m_timing ? INFO : DEBUG,"DependencyHandler","%s %ld derived conditions in %ld levels with %d threads.",
+           action, long(m_todo.size()), long(concurrent.size()), num_threads);
+  return true;
+#else
+  printout(DEBUG,"DependencyHandler","ComputeThreads=%d ignored: DD4hep was built without TBB [%s].",
+           m_manager->computeThreads(), action);
+  return false;
+#endif
+}
+
+/// Compute the missing conditions level by level. Returns false if not possible
+bool ConditionsDependencyHandler::compute_parallel()   {
+  return execute_levels("Computed", [this](Work* w)   {
+    currentWork() = nullptr;
+    if ( !w->condition )  {
+      do_callback(w);
+      if ( !w->condition )  {
+        except("DependencyHandler",
+               "Derived condition was not created after calling the creation callback!");
+      }
+    }
+  });
+}
+
+/// Resolve the created conditions level by level. Returns false if not possible
+bool ConditionsDependencyHandler::resolve_parallel()   {
+  // The resolve callbacks of one level only access conditions of lower levels,
+  // which are resolved at this stage: the state of the work items is stable.
+  return execute_levels("Resolved", [](Work* w)   {
+    currentWork() = w;
+    if ( w->state != RESOLVED )   {
+      w->resolve(currentWork());
+    }
+    currentWork() = nullptr;
+  });
+}
+
+/// Print the timing report of the callbacks
+void ConditionsDependencyHandler::print_timing()  const   {
+  struct Entry  {  long count = 0; long long total = 0, max = 0;  };
+  std::map<std::string, Entry> entries;
+  for( const auto& i : m_todo )   {
+    const Work* w = i.second;
+    if ( w->condition )   {
+      const ConditionUpdateCall& call = *w->context.dependency->callback;
+      Entry& e = entries[typeName(typeid(call))];
+      ++e.count;
+      e.total += w->elapsed;
+      e.max    = std::max(e.max, w->elapsed);
+    }
+  }
+  // Note: the time of conditions created on demand by other callbacks is counted twice
+  for( const auto& e : entries )   {
+    printout(INFO,"DependencyHandler",
+             "+++ Callback %-40s Calls:%8ld Total:%10.6f sec  Mean:%10.3f usec  Max:%10.3f usec",
+             e.first.c_str(), e.second.count, 1e-9*e.second.total,
+             1e-3*double(e.second.total)/double(e.second.count), 1e-3*e.second.max);
+  }
+}
+
 /// 1rst pass: Compute/create the missing conditions
 void ConditionsDependencyHandler::compute()   {
   m_state = CREATED;
+  currentWork() = nullptr;
+  if ( m_levels && compute_parallel() )   {
+    return;
+  }
   for( const auto& i : m_todo )   {
     if ( !i.second->condition )  {
       do_callback(i.second);
@@ -113,24 +270,25 @@ void ConditionsDependencyHandler::resolve()    {
   Work* w;
 
   m_state = RESOLVED;
+  if ( !(m_levels && resolve_parallel()) )   {
+    for( const auto& c : m_todo )   {
+      w = c.second;
+      currentWork() = w;
+      if ( w->state != RESOLVED )   {
+        w->resolve(currentWork());
+      }
+    }
+  }
+  // Optimize pool interactions: Cache pool in map assuming there are only few pools created
   for( const auto& c : m_todo )   {
     w = c.second;
-    m_currentWork = w;
-    if ( w->state != RESOLVED )   {
-      w->resolve(m_currentWork);
-    }
     // Fill an empty map of condition vectors for the block inserts
     auto ret = work_pools.emplace(w->iov->keyData,tmp);
     if ( ret.second )   {
       // There is sort of the hope that most conditions go into 1 pool...
       ret.first->second.reserve(m_todo.size());
     }
-  }
-  // Optimize pool interactions: Cache pool in map assuming there are only few pools created
-  for( const auto& c : m_todo )   {
-    w = c.second;
-    auto& section = work_pools[w->iov->keyData];
-    section.emplace_back(w->condition);
+    ret.first->second.emplace_back(w->condition);
 #if 0
     printout(prt_lvl,"DependencyHandler","++ Register %s %s %s  [%s]",
              w->context.dependency->target.toString().c_str(),
@@ -154,16 +312,22 @@ void ConditionsDependencyHandler::resolve()    {
              result, section.second.size(), iov.str().c_str(),
              stop.AsDouble()-start.AsDouble());
   }
+  currentWork() = nullptr;
+  if ( m_timing )   {
+    print_timing();
+  }
 }
 
 /// Interface to handle multi-condition inserts by callbacks: One single insert
 bool ConditionsDependencyHandler::registerOne(const IOV& iov, Condition cond)    {
+  auto lock = parallel_lock();
   return m_pool.registerOne(iov, cond);
 }
 
 /// Handle multi-condition inserts by callbacks: block insertions of conditions with identical IOV
 std::size_t
 ConditionsDependencyHandler::registerMany(const IOV& iov, const std::vector<Condition>& values)   {
+  auto lock = parallel_lock();
   return m_pool.registerMany(iov, values);
 }
 
@@ -188,8 +352,9 @@ ConditionsDependencyHandler::getByItem(Condition::itemkey_type key)   {
       }
     };
     item_selector proc(key);
+    auto lock = parallel_lock();
     m_pool.scan(conditionsProcessor(proc));
-    for (auto c : proc.conditions ) m_currentWork->do_intersection(c->iov);
+    for (auto c : proc.conditions ) currentWork()->do_intersection(c->iov);
     return proc.conditions;
   }
   except("DependencyHandler",
@@ -203,8 +368,9 @@ ConditionsDependencyHandler::get(Condition::detkey_type det_key)   {
   if ( m_state == RESOLVED )   {
     ConditionKey::KeyMaker lower(det_key, Condition::FIRST_ITEM_KEY);
     ConditionKey::KeyMaker upper(det_key, Condition::LAST_ITEM_KEY);
+    auto lock = parallel_lock();
     std::vector<Condition> conditions = m_pool.get(lower.hash, upper.hash);
-    for (auto c : conditions ) m_currentWork->do_intersection(c->iov);
+    for (auto c : conditions ) currentWork()->do_intersection(c->iov);
     return conditions;
   }
   except("DependencyHandler",
@@ -224,10 +390,12 @@ ConditionsDependencyHandler::get(Condition::key_type key,
                                  const ConditionDependency* dependency,
                                  bool throw_if_not)
 {
+  // Work items change state on access: serialize if callbacks run concurrently
+  auto lock = parallel_lock();
   /// If we are not already resolving here, we follow the normal procedure
   Condition c = m_pool.get(key);
   if ( c.isValid() )  {
-    m_currentWork->do_intersection(c->iov);
+    currentWork()->do_intersection(c->iov);
     return c;
   }
   auto i = m_todo.find(key);
@@ -237,14 +405,14 @@ ConditionsDependencyHandler::get(Condition::key_type key,
       return w->condition;
     }
     else if ( w->state == CREATED )   {
-      return w->resolve(m_currentWork);
+      return w->resolve(currentWork());
     }
     else if ( w->state == INVALID )  {
       do_callback(w);
       if ( w->condition && w->state == RESOLVED ) // cross-dependencies...
         return w->condition;
       else if ( w->condition )
-        return w->resolve(m_currentWork);
+        return w->resolve(currentWork());
     }
   }
   if ( throw_if_not )  {
@@ -291,8 +459,8 @@ ConditionsDependencyHandler::get(Condition::key_type key,
 void ConditionsDependencyHandler::do_callback(Work* work)   {
   const ConditionDependency* dep = work->context.dependency;
   try  {
-    Work* previous  = m_currentWork;
-    m_currentWork   = work;
+    Work* previous  = currentWork();
+    currentWork()   = work;
     if ( work->callstack > 0 )   {
       // if we end up here it means a previous construction call never finished
       // because the bugger tried to access another condition, which in turn
@@ -309,9 +477,16 @@ void ConditionsDependencyHandler::do_callback(Work* work)   {
              );
     }
     ++work->callstack;
-    work->condition = (*dep->callback)(dep->target, work->context).ptr();
+    if ( m_timing )   {
+      auto start = std::chrono::steady_clock::now();
+      work->condition = (*dep->callback)(dep->target, work->context).ptr();
+      work->elapsed   = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-start).count();
+    }
+    else   {
+      work->condition = (*dep->callback)(dep->target, work->context).ptr();
+    }
     --work->callstack;
-    m_currentWork   = previous;
+    currentWork()   = previous;
     if ( work->condition )  {
       if ( !work->iov )  {
         work->_iov = IOV(m_iovType,IOV::Key(IOV::MIN_KEY, IOV::MAX_KEY));
@@ -20,8 +20,19 @@
 
 #include <DD4hep/detail/ConditionsInterna.h>
 
+// C/C++ include files
+#include <chrono>
+
 using namespace dd4hep::cond;
 
+namespace {
+  /// Nanoseconds elapsed since start
+  long long elapsed(std::chrono::steady_clock::time_point start)   {
+    auto diff = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(diff).count();
+  }
+}
+
 /// Default constructor
 ConditionsIOVPool::ConditionsIOVPool(const IOVType* typ) : type(typ)  {
   InstanceCount::increment(this);
@@ -38,8 +49,57 @@ ConditionsIOVPool::~ConditionsIOVPool()  {
   InstanceCount::decrement(this);
 }
 
+/// Acquire shared access to the pool content for selections
+std::shared_lock<std::shared_timed_mutex> ConditionsIOVPool::readLock()  const   {
+  std::shared_lock<std::shared_timed_mutex> lock(m_lock, std::try_to_lock);
+  if ( !lock.owns_lock() )   {
+    auto start = std::chrono::steady_clock::now();
+    lock.lock();
+    statistics.lockWait += elapsed(start);
+  }
+  ++statistics.reads;
+  return lock;
+}
+
+/// Acquire exclusive access to the pool content for insertions and removals
+std::unique_lock<std::shared_timed_mutex> ConditionsIOVPool::writeLock()   {
+  std::unique_lock<std::shared_timed_mutex> lock(m_lock, std::try_to_lock);
+  if ( !lock.owns_lock() )   {
+    auto start = std::chrono::steady_clock::now();
+    lock.lock();
+    statistics.lockWait += elapsed(start);
+  }
+  ++statistics.writes;
+  return lock;
+}
+
+/// Acquire the build lock before computing missing derived conditions
+std::unique_lock<std::mutex> ConditionsIOVPool::buildLock()   {
+  std::unique_lock<std::mutex> lock(m_buildLock, std::try_to_lock);
+  if ( !lock.owns_lock() )   {
+    auto start = std::chrono::steady_clock::now();
+    lock.lock();
+    statistics.buildWait += elapsed(start);
+  }
+  ++statistics.builds;
+  return lock;
+}
+
+/// Print the lock statistics
+void ConditionsIOVPool::printStatistics()  const   {
+  printout(INFO,"ConditionsIOVPool",
+           "+++ IOV type %-8s Version:%6ld Reads:%8ld Writes:%6ld Lock wait:%10.6f sec",
+           type ? type->name.c_str() : "????", (long)version.load(),
+           statistics.reads.load(), statistics.writes.load(), 1e-9*statistics.lockWait.load());
+  printout(INFO,"ConditionsIOVPool",
+           "+++ IOV type %-8s Builds:%5ld Shared builds:%5ld Computations:%5ld Build wait:%10.6f sec",
+           type ? type->name.c_str() : "????", statistics.builds.load(), statistics.shared.load(),
+           statistics.computed.load(), 1e-9*statistics.buildWait.load());
+}
+
 size_t ConditionsIOVPool::select(Condition::key_type key, const IOV& req_validity, RangeConditions& result)
 {
+  auto lock = readLock();
   if ( !elements.empty() )  {
     size_t len = result.size();
     const IOV::Key req_key = req_validity.key(); // 16 bytes => better copy!
@@ -55,6 +115,7 @@ size_t ConditionsIOVPool::select(Condition::key_type key, const IOV& req_validit
 
 size_t ConditionsIOVPool::selectRange(Condition::key_type key, const IOV& req_validity, RangeConditions& result)
 {
+  auto lock = readLock();
   size_t len = result.size();
   const IOV::Key range = req_validity.key();
   for( const auto& e : elements )  {
@@ -74,7 +135,8 @@ size_t ConditionsIOVPool::selectRange(Condition::key_type key, const IOV& req_va
 
 /// Invoke cache cleanup with user defined policy
 int ConditionsIOVPool::clean(const ConditionsCleanup& cleaner)   {
- Elements rest;
+  auto lock = writeLock();
+  Elements rest;
   int count = 0;
   for( const auto& e : elements )  {
     const ConditionsPool* p = e.second.get();
@@ -85,12 +147,14 @@ int ConditionsIOVPool::clean(const ConditionsCleanup& cleaner)   {
     }
     rest.insert(e);
   }
+  if ( elements.size() != rest.size() ) ++version;
   elements = std::move(rest);
   return count;  
 }
 
 /// Remove all key based pools with an age beyon the minimum age
 int ConditionsIOVPool::clean(int max_age)   {
+  auto lock = writeLock();
   Elements rest;
   int count = 0;
   for( const auto& e : elements )  {
@@ -102,6 +166,7 @@ int ConditionsIOVPool::clean(int max_age)   {
       rest.insert(e);
     }
   }
+  if ( elements.size() != rest.size() ) ++version;
   elements = std::move(rest);
   return count;
 }
@@ -112,6 +177,7 @@ size_t ConditionsIOVPool::select(const IOV&        req_validity,
                                  IOV&              cond_validity)
 {
   size_t num_selected = 0;
+  auto lock = readLock();
   if ( !elements.empty() )  {
     const IOV::Key req_key = req_validity.key(); // 16 bytes => better copy!
     for( const auto& i : elements )  {
@@ -133,6 +199,7 @@ size_t ConditionsIOVPool::select(const IOV&              req_validity,
                                  IOV&                    cond_validity)
 {
   size_t num_selected = 0, pool_selected = 0;
+  auto lock = readLock();
   if ( !elements.empty() )  {
     const IOV::Key req_key = req_validity.key(); // 16 bytes => better copy!
     for( const auto& i : elements )  {
@@ -165,6 +232,7 @@ size_t ConditionsIOVPool::select(const IOV& req_validity,
 size_t ConditionsIOVPool::select(const IOV& req_validity, Elements&  valid)
 {
   size_t num_selected = 0;
+  auto lock = readLock();
   if ( !elements.empty() )   {
     const IOV::Key req_key = req_validity.key(); // 16 bytes => better copy!
     for( const auto& i : elements )  {
@@ -194,6 +262,7 @@ size_t ConditionsIOVPool::select(const IOV&        req_validity,
 size_t ConditionsIOVPool::select(const IOV& req_validity, std::vector<Element>& valid)
 {
   size_t num_selected = 0;
+  auto lock = readLock();
   if ( !elements.empty() )   {
     const IOV::Key req_key = req_validity.key(); // 16 bytes => better copy!
     for( const auto& i : elements )  {
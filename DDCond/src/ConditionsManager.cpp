@@ -50,6 +50,9 @@ ConditionsManagerObject::ConditionsManagerObject(Detector& ref_description)
   InstanceCount::increment(this);
   declareProperty("LoadConditions",           m_doLoad);
   declareProperty("OutputUnloadedConditions", m_doOutputUnloaded);
+  declareProperty("ComputeThreads",           m_computeThreads);
+  declareProperty("CallbackTiming",           m_doCallbackTiming);
+  declareProperty("IncrementalUpdates",       m_doIncremental);
 }
 
 /// Default destructor
@@ -220,6 +220,7 @@ ConditionsPool* Manager_Type1::registerIOV(const IOVType& typ, IOV::Key key)   {
   if ( !pool )  {
     m_rawPool[typ.type] = pool = new ConditionsIOVPool(&typ);
   }
+  auto pool_lock = pool->writeLock();
   ConditionsIOVPool::Elements::const_iterator i = pool->elements.find(key);
   if ( i != pool->elements.end() )   {
     return (*i).second.get();
@@ -230,6 +231,7 @@ ConditionsPool* Manager_Type1::registerIOV(const IOVType& typ, IOV::Key key)   {
   const void* argv_pool[] = {this, iov, 0};
   std::shared_ptr<ConditionsPool> cond_pool(createPlugin<ConditionsPool>(m_poolType,m_detDesc,2,argv_pool));
   pool->elements.emplace(key,cond_pool);
+  ++pool->version;
   printout(INFO,"ConditionsMgr","Created IOV Pool for:%s",iov->str().c_str());
   return cond_pool.get();
 }
@@ -239,12 +241,17 @@ ConditionsIOVPool* Manager_Type1::iovPool(const IOVType& iov_type)  const    {
   return m_rawPool[iov_type.type];
 }
 
-/// Register new condition with the conditions store. Unlocked version, not multi-threaded
+/// Register new condition with the conditions store.
+/** Only the IOV pool of the condition is locked, not the conditions manager.  */
 bool Manager_Type1::registerUnlocked(ConditionsPool& pool, Condition cond)   {
   if ( cond.isValid() )  {
     cond->iov  = pool.iov;
-    cond->setFlag(Condition::ACTIVE);
-    pool.insert(cond);
+    cond->setFlag(Condition::ACTIVE);  {
+      ConditionsIOVPool* iov_pool = m_rawPool[pool.iov->type];
+      auto pool_lock = iov_pool->writeLock();
+      pool.insert(cond);
+      ++iov_pool->version;
+    }
 #if !defined(DD4HEP_MINIMAL_CONDITIONS) && defined(DD4HEP_CONDITIONS_HAVE_NAME)
     printout(DEBUG,"ConditionsMgr","Register condition %016lX %s [%s] IOV:%s",
              cond.key(), cond.name(), cond->address.c_str(), pool.iov->str().c_str());
@@ -270,19 +277,27 @@ bool Manager_Type1::registerUnlocked(ConditionsPool& pool, Condition cond)   {
 std::size_t Manager_Type1::blockRegister(ConditionsPool& pool, const std::vector<Condition>& cond) const {
   std::size_t result = 0;
   for(auto c : cond)   {
-    if ( c.isValid() )    {
+    if ( !c.isValid() )    {
+      except("ConditionsMgr",
+             "+++ Invalid condition objects may not be registered. [%s]",
+             Errors::invalidArg().c_str());    
+    }
+  }
+  {
+    // Insert the entire block with one exclusive access to the IOV pool
+    ConditionsIOVPool* iov_pool = m_rawPool[pool.iov->type];
+    auto pool_lock = iov_pool->writeLock();
+    for(auto c : cond)   {
       c->iov = pool.iov;
       c->setFlag(Condition::ACTIVE);
       pool.insert(c);
-      if ( !m_onRegister.empty() )   {
-        __callListeners(m_onRegister, &ConditionsListener::onRegisterCondition, c);
-      }
       ++result;
-      continue;
     }
-    except("ConditionsMgr",
-           "+++ Invalid condition objects may not be registered. [%s]",
-           Errors::invalidArg().c_str());    
+    ++iov_pool->version;
+  }
+  if ( !m_onRegister.empty() )   {
+    for(auto c : cond)
+      __callListeners(m_onRegister, &ConditionsListener::onRegisterCondition, c);
   }
   return result;
 }
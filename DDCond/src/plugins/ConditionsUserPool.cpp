@@ -46,18 +46,46 @@ namespace dd4hep {
     template<typename MAPPING> 
     class ConditionsMappedUserPool : public UserPool    {
       typedef MAPPING Mapping;
+      typedef std::vector<std::pair<Condition::key_type,ConditionDependency*> > CalcMissing;
+      /// Entry of the slice content of the previous IOV
+      struct Previous  {
+        /// Condition object. Only used for identity checks: it may be deleted meanwhile
+        Condition::Object*  object  = 0;
+        /// Key of the condition's IOV
+        IOV::Key            iov;
+        /// Data type of the condition
+        const BasicGrammar* grammar = 0;
+        /// Data identity of raw conditions to recognize identical data of reloaded objects
+        std::string         value;
+      };
       Mapping               m_conditions;
       /// IOV Pool as data source
       ConditionsIOVPool*    m_iovPool = 0;
       /// The loader to access non-existing conditions
       ConditionsDataLoader* m_loader = 0;
+      /// Version of the IOV pool at the last selection
+      unsigned long         m_version = 0;
+      /// Slice content of the previous IOV (incremental updates only)
+      std::unordered_map<Condition::key_type,Previous> m_previous;
 
       /// Internal helper to find conditions
       Condition::Object* i_findCondition(Condition::key_type key)  const;
 
+      /// Internal helper to select the conditions valid for the required IOV from the IOV pool
+      void i_select(const IOV& required, IOV& pool_iov, bool clear_pool);
+
       /// Internal insertion helper
       bool i_insert(Condition::Object* o);
 
+      /// Internal helper to save the slice content for the next IOV transition
+      void i_snapshot();
+
+      /// Internal helper to re-use the derived conditions of the previous IOV with unchanged inputs
+      /** Re-used conditions are registered and removed from the missing list.
+       *  Returns the number of re-used conditions.
+       */
+      size_t i_reuse(ConditionsSlice& slice, CalcMissing& missing);
+
     public:
       /// Default constructor
       ConditionsMappedUserPool(ConditionsManager mgr, ConditionsIOVPool* pool);
@@ -164,6 +192,7 @@ namespace dd4hep {
 
 // C/C++ include files
 #include <mutex>
+#include <algorithm>
 
 using namespace dd4hep::cond;
 
@@ -181,6 +210,18 @@ namespace {
       return 1;
     }
   };
+  /// Data identity of a raw condition: the string representation of the data by its grammar
+  /** Conditions without string conversion fall back to the string value they were created from.
+   */
+  std::string data_identity(const dd4hep::Condition::Object* o)  {
+    try  {
+      return o->data.str();
+    }
+    catch(const std::exception&)  {
+    }
+    return o->value;
+  }
+
   template <typename T> struct MapSelector : public dd4hep::ConditionsSelect {
     T& m;
     MapSelector(T& o) : m(o) {}
@@ -280,6 +321,7 @@ void ConditionsMappedUserPool<MAPPING>::clear()   {
   }
   m_iov = IOV(0);
   m_conditions.clear();
+  m_previous.clear();
 }
 
 /// Check a condition for existence
@@ -499,6 +541,134 @@ namespace {
   };
 }
 
+/// Internal helper to select the conditions valid for the required IOV from the IOV pool
+template<typename MAPPING> void
+ConditionsMappedUserPool<MAPPING>::i_select(const IOV& required, IOV& pool_iov, bool clear_pool)   {
+  // The version is taken before the selection: a concurrent change
+  // is seen by the caller as changed version.
+  m_version = m_iovPool->version;
+  if ( clear_pool ) m_conditions.clear();
+  pool_iov.reset().invert();
+  m_iovPool->select(required, Operators::mapConditionsSelect(m_conditions), pool_iov);
+  m_iov = pool_iov;
+}
+
+/// Internal helper to save the slice content for the next IOV transition
+template<typename MAPPING> void ConditionsMappedUserPool<MAPPING>::i_snapshot()   {
+  m_previous.clear();
+  if ( m_manager->doIncrementalUpdates() )  {
+    m_previous.reserve(m_conditions.size());
+    for( const auto& c : m_conditions )  {
+      const Condition::Object* o = c.second;
+      if ( o->iov )  {
+        Previous& prev = m_previous[c.first];
+        prev.object  = c.second;
+        prev.iov     = o->iov->keyData;
+        prev.grammar = o->data.grammar;
+        if ( !o->testFlag(Condition::DERIVED) ) prev.value = data_identity(o);
+      }
+    }
+  }
+}
+
+/// Internal helper to re-use the derived conditions of the previous IOV with unchanged inputs
+template<typename MAPPING> std::size_t
+ConditionsMappedUserPool<MAPPING>::i_reuse(ConditionsSlice& slice, CalcMissing& missing)   {
+  typedef std::pair<int,const ConditionDependency*> Candidate;
+  if ( m_previous.empty() || missing.empty() )  {
+    return 0;
+  }
+  // Candidates are handled by dependency level: inputs before their clients.
+  // Members of dependency cycles (level -1) are always recomputed.
+  std::shared_ptr<const ConditionsContent::Levels> levels = slice.content->dependencyLevels();
+  std::vector<Candidate> candidates;
+  candidates.reserve(missing.size());
+  for( const auto& m : missing )   {
+    auto l = levels->find(m.first);
+    if ( l != levels->end() && l->second.second >= 0 && m_previous.find(m.first) != m_previous.end() )
+      candidates.emplace_back(l->second.second, m.second);
+  }
+  std::stable_sort(candidates.begin(), candidates.end(),
+                   [](const Candidate& a, const Candidate& b) { return a.first < b.first; });
+
+  // An input is unchanged if it was re-used in this pass, if the slice contains
+  // the identical object with the identical IOV as before or if a reloaded raw
+  // condition has the same type and the same data.
+  std::unordered_map<Condition::key_type,IOV> reused;
+  auto unchanged = [this,&reused](Condition::key_type key, IOV& iov)  {
+    auto r = reused.find(key);
+    if ( r != reused.end() )  {
+      iov.iov_intersection(r->second);
+      return true;
+    }
+    const Condition::Object* o = i_findCondition(key);
+    auto p = m_previous.find(key);
+    if ( !o || !o->iov || p == m_previous.end() )  {
+      return false;
+    }
+    const Previous& prev = p->second;
+    if ( (prev.object == o && prev.iov == o->iov->keyData) ||
+         (!prev.value.empty() && prev.grammar == o->data.grammar && prev.value == data_identity(o)) )  {
+      iov.iov_intersection(*o->iov);
+      return true;
+    }
+    return false;
+  };
+
+  std::map<IOV::Key,std::vector<Condition> > blocks;
+  {
+    // The previous objects may only be accessed while they cannot be purged
+    auto lock = m_iovPool->readLock();
+    for( const auto& c : candidates )   {
+      const ConditionDependency* dep = c.second;
+      IOV  iov(IOV::forever(m_iov.iovType));
+      bool inputs_unchanged = true;
+      for( const auto& d : dep->dependencies )   {
+        if ( !(inputs_unchanged = unchanged(d.hash, iov)) ) break;
+      }
+      if ( !inputs_unchanged )  {
+        continue;
+      }
+      const Previous& prev = m_previous[dep->key()];
+      auto e = m_iovPool->elements.find(prev.iov);
+      if ( e == m_iovPool->elements.end() || e->second->exists(dep->key()).ptr() != prev.object )  {
+        continue;
+      }
+      // Only data with a copyable type can be taken over
+      const Condition::Object* p = prev.object;
+      if ( !p->data.grammar || !p->data.grammar->specialization.copy )  {
+        continue;
+      }
+      Condition cond(dep->key());
+      Condition::Object* o = cond.ptr();
+#if defined(DD4HEP_CONDITIONS_HAVE_NAME)
+      o->name     = p->name;
+      o->type     = p->type;
+#endif
+      o->value    = p->value;
+#if defined(DD4HEP_CONDITIONS_DEBUG) || !defined(DD4HEP_MINIMAL_CONDITIONS)
+      o->validity = p->validity;
+      o->address  = p->address;
+      o->comment  = p->comment;
+#endif
+      o->data     = p->data;
+      o->setFlag(Condition::DERIVED);
+      blocks[iov.keyData].emplace_back(cond);
+      reused.emplace(dep->key(), iov);
+    }
+  }
+  std::size_t num_reused = 0;
+  for( const auto& b : blocks )
+    num_reused += registerMany(IOV(m_iov.iovType, b.first), b.second);
+  if ( num_reused > 0 )  {
+    missing.erase(std::remove_if(missing.begin(), missing.end(),
+                                 [&reused](const CalcMissing::value_type& m)
+                                 { return reused.find(m.first) != reused.end(); }),
+                  missing.end());
+  }
+  return num_reused;
+}
+
 template<typename MAPPING> ConditionsManager::Result
 ConditionsMappedUserPool<MAPPING>::prepare(const IOV&                  required, 
                                            ConditionsSlice&            slice,
@@ -514,38 +684,57 @@ ConditionsMappedUserPool<MAPPING>::prepare(const IOV&                  required,
   bool   do_output_miss  = m_manager->doOutputUnloaded();
   IOV    pool_iov(required.iovType);
   ConditionsManager::Result result;
+  CondMissing cond_missing;
+  CalcMissing calc_missing;
+  CondMissing::iterator last_cond;
+  CalcMissing::iterator last_calc;
+  long num_cond_miss = 0, num_calc_miss = 0;
+
+  auto find_missing_cond = [&]()  {
+    cond_missing.resize(slice_cond.size()+m_conditions.size());
+    last_cond = set_difference(begin(slice_cond),   end(slice_cond),
+                               begin(m_conditions), end(m_conditions),
+                               begin(cond_missing), COMP());
+    num_cond_miss = last_cond-begin(cond_missing);
+    cond_missing.resize(num_cond_miss);
+    last_cond = end(cond_missing);
+  };
+  auto find_missing_calc = [&]()  {
+    calc_missing.resize(slice_calc.size()+m_conditions.size());
+    last_calc = set_difference(begin(slice_calc),   end(slice_calc),
+                               begin(m_conditions), end(m_conditions),
+                               begin(calc_missing), COMP());
+    num_calc_miss = last_calc-begin(calc_missing);
+    calc_missing.resize(num_calc_miss);
+    last_calc = end(calc_missing);
+  };
 
-  // This is a critical operation, because we have to ensure the
-  // IOV pools are ONLY manipulated by the current thread.
-  // Otherwise the selection and the population are unsafe!
-  static std::mutex lock;
-  std::lock_guard<std::mutex> guard(lock);
-
-  m_conditions.clear();
   slice_miss_cond.clear();
   slice_miss_calc.clear();
-  pool_iov.reset().invert();
-  m_iovPool->select(required, Operators::mapConditionsSelect(m_conditions), pool_iov);
-  m_iov = pool_iov;
-  CondMissing cond_missing(slice_cond.size()+m_conditions.size());
-  CalcMissing calc_missing(slice_calc.size()+m_conditions.size());
-
-  CondMissing::iterator last_cond = set_difference(begin(slice_cond),   end(slice_cond),
-                                                   begin(m_conditions), end(m_conditions),
-                                                   begin(cond_missing), COMP());
-  long num_cond_miss = last_cond-begin(cond_missing);
-  cond_missing.resize(num_cond_miss);
+  // The IOV pool is only locked (shared) during the selection.
+  i_select(required, pool_iov, true);
+  find_missing_cond();
+  find_missing_calc();
+
+  // Loading is serialized by the loader lock: the loader is shared by all IOV types.
+  // Concurrent requests wait for the first request and re-use the conditions
+  // it registered to the IOV pool: select again if the pool changed meanwhile.
+  std::unique_lock<std::mutex> load_lock;
+  if ( do_load && num_cond_miss > 0 )  {
+    load_lock = m_loader->loadLock();
+    if ( m_version != m_iovPool->version )  {
+      i_select(required, pool_iov, true);
+      find_missing_cond();
+      find_missing_calc();
+      if ( num_cond_miss == 0 )  {
+        ++m_iovPool->statistics.shared;
+        load_lock.unlock();
+      }
+    }
+  }
   printout((flags&PRINT_LOAD) ? INFO : DEBUG,"UserPool",
            "%ld conditions out of %ld conditions are MISSING.",
            num_cond_miss, slice_cond.size());
-  CalcMissing::iterator last_calc = set_difference(begin(slice_calc),   end(slice_calc),
-                                                   begin(m_conditions), end(m_conditions),
-                                                   begin(calc_missing), COMP());
-  long num_calc_miss = last_calc-begin(calc_missing);
-  calc_missing.resize(num_calc_miss);
-  printout((flags&PRINT_COMPUTE) ? INFO : DEBUG,"UserPool",
-           "%ld derived conditions out of %ld conditions are MISSING.",
-           num_calc_miss, slice_calc.size());
 
   result.loaded   = 0;
   result.computed = 0;
@@ -592,13 +781,42 @@ ConditionsMappedUserPool<MAPPING>::prepare(const IOV&                  required,
       }
     }
   }
+  if ( load_lock.owns_lock() ) load_lock.unlock();
+
+  // Derived computations are serialized per IOV type with the same
+  // re-use of the conditions registered meanwhile by concurrent requests.
+  std::unique_lock<std::mutex> build_lock;
+  if ( do_load && num_calc_miss > 0 )  {
+    build_lock = m_iovPool->buildLock();
+    if ( m_version != m_iovPool->version )  {
+      long num_calc_prev = num_calc_miss;
+      i_select(required, pool_iov, false);
+      find_missing_calc();
+      result.missing -= num_calc_prev-num_calc_miss;
+      if ( num_calc_miss == 0 )  {
+        ++m_iovPool->statistics.shared;
+        build_lock.unlock();
+      }
+    }
+  }
+  printout((flags&PRINT_COMPUTE) ? INFO : DEBUG,"UserPool",
+           "%ld derived conditions out of %ld conditions are MISSING.",
+           num_calc_miss, slice_calc.size());
   //
   // Now we update the already existing dependencies, which have expired
   //
   if ( num_calc_miss > 0 )  {
     if ( do_load )  {
+      if ( m_manager->doIncrementalUpdates() )  {
+        result.reused   = i_reuse(slice, calc_missing);
+        result.missing -= result.reused;
+        last_calc = end(calc_missing);
+      }
       std::map<Condition::key_type,const ConditionDependency*> deps(calc_missing.begin(),last_calc);
-      ConditionsDependencyHandler handler(m_manager, *this, deps, user_param);
+      std::shared_ptr<const ConditionsContent::Levels> levels;
+      if ( m_manager->computeThreads() > 0 ) levels = slice.content->dependencyLevels();
+      ConditionsDependencyHandler handler(m_manager, *this, deps, user_param, std::move(levels));
+      ++m_iovPool->statistics.computed;
       /// 1rst pass: Compute/create the missing condiions
       handler.compute();
       /// 2nd pass:  Resolve missing dependencies
@@ -606,6 +824,11 @@ ConditionsMappedUserPool<MAPPING>::prepare(const IOV&                  required,
       
       result.computed = handler.num_callback;
       result.missing -= handler.num_callback;
+      if ( m_manager->doIncrementalUpdates() )  {
+        printout((flags&PRINT_COMPUTE) ? INFO : DEBUG,"UserPool",
+                 "IOV transition: %ld derived conditions re-used, %ld recomputed.",
+                 result.reused, result.computed);
+      }
       if ( do_output_miss && result.computed < deps.size() )  {
         // Is this cheaper than an intersection ?
         for( auto i = calc_missing.begin(); i != last_calc; ++i )   {
@@ -619,6 +842,7 @@ ConditionsMappedUserPool<MAPPING>::prepare(const IOV&                  required,
       copy(begin(calc_missing), last_calc, inserter(slice_miss_calc, slice_miss_calc.begin()));
     }
   }
+  i_snapshot();
   slice.status = result;
   slice.used_pools.clear();
   if ( slice.flags&ConditionsSlice::REF_POOLS )   {
@@ -639,24 +863,38 @@ ConditionsMappedUserPool<MAPPING>::load(const IOV&                  required,
   bool   do_output_miss  = m_manager->doOutputUnloaded();
   IOV    pool_iov(required.iovType);
   ConditionsManager::Result result;
+  CondMissing cond_missing;
+  CondMissing::iterator last_cond;
+  long num_cond_miss = 0;
+
+  auto find_missing = [&]()  {
+    cond_missing.resize(slice_cond.size()+m_conditions.size());
+    last_cond = set_difference(begin(slice_cond),   end(slice_cond),
+                               begin(m_conditions), end(m_conditions),
+                               begin(cond_missing), COMP());
+    num_cond_miss = last_cond-begin(cond_missing);
+    cond_missing.resize(num_cond_miss);
+    last_cond = end(cond_missing);
+  };
 
-  // This is a critical operation, because we have to ensure the
-  // IOV pools are ONLY manipulated by the current thread.
-  // Otherwise the selection and the population are unsafe!
-  static std::mutex lock;
-  std::lock_guard<std::mutex> guard(lock);
-
-  m_conditions.clear();
   slice_miss_cond.clear();
-  pool_iov.reset().invert();
-  m_iovPool->select(required, Operators::mapConditionsSelect(m_conditions), pool_iov);
-  m_iov = pool_iov;
-  CondMissing cond_missing(slice_cond.size()+m_conditions.size());
-  CondMissing::iterator last_cond = set_difference(begin(slice_cond),   end(slice_cond),
-                                                   begin(m_conditions), end(m_conditions),
-                                                   begin(cond_missing), COMP());
-  long num_cond_miss = last_cond-begin(cond_missing);
-  cond_missing.resize(num_cond_miss);
+  // The IOV pool is only locked (shared) during the selection.
+  i_select(required, pool_iov, true);
+  find_missing();
+
+  // Loading is serialized by the loader lock: see prepare(...)
+  std::unique_lock<std::mutex> load_lock;
+  if ( do_load && num_cond_miss > 0 )  {
+    load_lock = m_loader->loadLock();
+    if ( m_version != m_iovPool->version )  {
+      i_select(required, pool_iov, true);
+      find_missing();
+      if ( num_cond_miss == 0 )  {
+        ++m_iovPool->statistics.shared;
+        load_lock.unlock();
+      }
+    }
+  }
   printout((flags&PRINT_LOAD) ? INFO : DEBUG,"UserPool",
            "Found %ld missing conditions out of %ld conditions.",
            num_cond_miss, slice_cond.size());
@@ -713,20 +951,38 @@ ConditionsMappedUserPool<MAPPING>::compute(const IOV&                  required,
   bool   do_output       = m_manager->doOutputUnloaded();
   IOV    pool_iov(required.iovType);
   ConditionsManager::Result result;
-
-  // This is a critical operation, because we have to ensure the
-  // IOV pools are ONLY manipulated by the current thread.
-  // Otherwise the selection and the population are unsafe!
-  static std::mutex lock;
-  std::lock_guard<std::mutex> guard(lock);
+  CalcMissing calc_missing;
+  CalcMissing::iterator last_calc;
+  long num_calc_miss = 0;
+
+  auto find_missing = [&]()  {
+    calc_missing.resize(slice_calc.size()+m_conditions.size());
+    last_calc = set_difference(begin(slice_calc),   end(slice_calc),
+                               begin(m_conditions), end(m_conditions),
+                               begin(calc_missing), COMP());
+    num_calc_miss = last_calc-begin(calc_missing);
+    calc_missing.resize(num_calc_miss);
+    last_calc = end(calc_missing);
+  };
 
   slice_miss_calc.clear();
-  CalcMissing calc_missing(slice_calc.size()+m_conditions.size());
-  CalcMissing::iterator last_calc = set_difference(begin(slice_calc),   end(slice_calc),
-                                                   begin(m_conditions), end(m_conditions),
-                                                   begin(calc_missing), COMP());
-  long num_calc_miss = last_calc-begin(calc_missing);
-  calc_missing.resize(num_calc_miss);
+  find_missing();
+
+  // Derived computations are serialized per IOV type: see prepare(...)
+  // The conditions of the slice are kept: the selection only adds
+  // the derived conditions registered meanwhile by concurrent requests.
+  std::unique_lock<std::mutex> build_lock;
+  if ( do_load && num_calc_miss > 0 )  {
+    build_lock = m_iovPool->buildLock();
+    if ( m_version != m_iovPool->version )  {
+      i_select(required, pool_iov, false);
+      find_missing();
+      if ( num_calc_miss == 0 )  {
+        ++m_iovPool->statistics.shared;
+        build_lock.unlock();
+      }
+    }
+  }
   printout((flags&PRINT_COMPUTE) ? INFO : DEBUG,"UserPool",
            "Found %ld missing derived conditions out of %ld conditions.",
            num_calc_miss, m_conditions.size());
@@ -740,8 +996,16 @@ ConditionsMappedUserPool<MAPPING>::compute(const IOV&                  required,
   //
   if ( num_calc_miss > 0 )  {
     if ( do_load )  {
+      if ( m_manager->doIncrementalUpdates() )  {
+        result.reused   = i_reuse(slice, calc_missing);
+        result.missing -= result.reused;
+        last_calc = end(calc_missing);
+      }
       std::map<Condition::key_type,const ConditionDependency*> deps(calc_missing.begin(),last_calc);
-      ConditionsDependencyHandler handler(m_manager, *this, deps, user_param);
+      std::shared_ptr<const ConditionsContent::Levels> levels;
+      if ( m_manager->computeThreads() > 0 ) levels = slice.content->dependencyLevels();
+      ConditionsDependencyHandler handler(m_manager, *this, deps, user_param, std::move(levels));
+      ++m_iovPool->statistics.computed;
 
       /// 1rst pass: Compute/create the missing condiions
       handler.compute();
@@ -750,6 +1014,11 @@ ConditionsMappedUserPool<MAPPING>::compute(const IOV&                  required,
 
       result.computed = handler.num_callback;
       result.missing -= handler.num_callback;
+      if ( m_manager->doIncrementalUpdates() )  {
+        printout((flags&PRINT_COMPUTE) ? INFO : DEBUG,"UserPool",
+                 "IOV transition: %ld derived conditions re-used, %ld recomputed.",
+                 result.reused, result.computed);
+      }
       if ( do_output && result.computed < deps.size() )  {
         for(auto i=calc_missing.begin(); i != last_calc; ++i)   {
           typename MAPPING::iterator j = m_conditions.find((*i).first);
@@ -762,6 +1031,7 @@ ConditionsMappedUserPool<MAPPING>::compute(const IOV&                  required,
       copy(begin(calc_missing), last_calc, inserter(slice_miss_calc, slice_miss_calc.begin()));
     }
   }
+  i_snapshot();
   slice.status += result;
   slice.used_pools.clear();
   if ( slice.flags&ConditionsSlice::REF_POOLS )   {
@@ -18,6 +18,10 @@
 #include <DD4hep/AlignmentData.h>
 #include <DD4hep/ConditionsMap.h>
 
+// C/C++ include files
+#include <vector>
+#include <unordered_map>
+
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
 
@@ -47,6 +51,8 @@ namespace dd4hep {
         size_t computed = 0;
         size_t missing  = 0;
 	size_t multiply = 0;
+        /// Alignments with unchanged input taken from the previous computation (incremental mode)
+        size_t reused   = 0;
         Result() = default;
         /// Copy constructor
         Result(const Result& result) = default;
@@ -75,6 +81,93 @@ namespace dd4hep {
       typedef std::map<DetElement,const Delta*,PathOrdering> OrderedDeltas;
       typedef std::map<Condition::key_type,DetElement>       ExtractContext;
 
+      /// Compiled detector element hierarchy for repeated alignment computations
+      /**
+       *  The detector elements below a top element are flattened into level ordered
+       *  index arrays with parent indices. The nominal detector transformations
+       *  are stored as contiguous 3x4 matrices (row major rotation followed by
+       *  the translation). The world transformations of one level only depend
+       *  on the previous level: each level is computed in one sweep, in parallel
+       *  if DD4hep was built with TBB and threads are requested.
+       *
+       *  The matrix products are evaluated in the order of the TGeoHMatrix
+       *  multiplication. The results are identical to the results of the
+       *  path ordered computation of AlignmentsCalculator::compute(deltas, alignments).
+       *
+       *  The hierarchy keeps the results of the last computation. In incremental
+       *  mode only the subtrees below changed deltas are recomputed. Hence an
+       *  instance may not be shared between threads.
+       *
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_CONDITIONS
+       */
+      class Hierarchy  {
+        friend class AlignmentsCalculator;
+      public:
+        /// Number of doubles of one transformation matrix: rotation (3x3) and translation
+        enum { MATRIX_SIZE = 12 };
+        /// Property: Number of threads to compute the levels (0: sequential)
+        int                               threads = 0;
+
+      protected:
+        /// Top detector element of the hierarchy
+        DetElement                        m_top;
+        /// Level ordered detector elements
+        std::vector<DetElement::Object*>  m_detectors;
+        /// Index of the parent element. -1 for the top element
+        std::vector<long>                 m_parents;
+        /// Start index of each level. The last entry is the number of elements
+        std::vector<std::size_t>          m_levels;
+        /// Index of the detector elements
+        std::unordered_map<const DetElement::Object*, std::size_t> m_index;
+        /// Nominal detector transformations (MATRIX_SIZE doubles per element)
+        std::vector<double>               m_nominal;
+        /// Nominal scale factors (3 doubles per element)
+        std::vector<double>               m_nominalScale;
+        /// Type bits (TGeoMatrix) of the nominal transformations
+        std::vector<unsigned int>         m_nominalBits;
+
+        /// Result of the last computation: detector transformations including the delta
+        std::vector<double>               m_detector;
+        /// Result of the last computation: detector scale factors
+        std::vector<double>               m_detectorScale;
+        /// Result of the last computation: type bits of the detector transformations
+        std::vector<unsigned int>         m_detectorBits;
+        /// Result of the last computation: world transformations
+        std::vector<double>               m_world;
+        /// Result of the last computation: world scale factors
+        std::vector<double>               m_worldScale;
+        /// Result of the last computation: type bits of the world transformations
+        std::vector<unsigned int>         m_worldBits;
+        /// Deltas of the last computation
+        std::vector<Delta>                m_deltas;
+        /// Element state of the last computation
+        std::vector<unsigned char>        m_state;
+        /// External parent transformations used by the last computation (subtree tops only)
+        std::unordered_map<std::size_t, TGeoHMatrix> m_external;
+        /// Flag if the result of the last computation is valid
+        bool                              m_valid = false;
+
+      public:
+        /// Initializing constructor: compile the hierarchy below the top element
+        explicit Hierarchy(DetElement top);
+        /// Copy constructor
+        Hierarchy(const Hierarchy& copy) = delete;
+        /// Assignment operator
+        Hierarchy& operator=(const Hierarchy& copy) = delete;
+        /// Default destructor
+        ~Hierarchy();
+        /// Access the top detector element
+        DetElement top()  const                 {  return m_top;                  }
+        /// Number of detector elements in the hierarchy
+        std::size_t size()  const               {  return m_detectors.size();     }
+        /// Number of levels of the hierarchy
+        std::size_t numLevels()  const          {  return m_levels.size()-1;      }
+        /// Forget the result of the last computation
+        void reset()                            {  m_valid = false;               }
+      };
+
       /// Scanner to find all alignment deltas in the detector hierarchy
       /**
        *  The deltas are collected in the appropriate container suited for the
@@ -141,6 +234,15 @@ namespace dd4hep {
                      ConditionsMap& alignments)  const;
       /// Optimized call using already properly ordered Deltas
       Result compute(const OrderedDeltas& deltas, ConditionsMap& alignments)  const;
+      /// Compute the alignment conditions level by level using a compiled hierarchy
+      /** In incremental mode only the alignments below changed deltas are recomputed.
+       *  Unchanged alignments already present in the conditions map are not touched:
+       *  the map must contain the result of the previous computation or no entry.
+       */
+      Result compute(Hierarchy& hierarchy,
+                     const OrderedDeltas& deltas,
+                     ConditionsMap& alignments,
+                     bool incremental = false)  const;
 
       /// Helper: Extract all Delta-conditions from the conditions map
       size_t extract_deltas(cond::ConditionUpdateContext& context,
@@ -180,6 +282,7 @@ namespace dd4hep {
       multiply += result.multiply;
       computed += result.computed;
       missing  += result.missing;
+      reused   += result.reused;
       return *this;
     }
     /// Subtract results
@@ -188,6 +291,7 @@ namespace dd4hep {
       multiply -= result.multiply;
       computed -= result.computed;
       missing  -= result.missing;
+      reused   -= result.reused;
       return *this;
     }
 
@@ -328,6 +328,11 @@ namespace dd4hep {
       std::vector<ConditionKey>            dependencies;
       /// Reference to the update callback. No auto pointer. callback may be shared
       std::shared_ptr<ConditionUpdateCall> callback;
+      /// Flag: the callback may be invoked concurrently with other thread safe callbacks
+      /** Thread safe callbacks must declare all derived conditions they access
+       *  as dependencies and may not modify shared state without protection.
+       */
+      bool                                 threadSafe { false };
 
     protected:
       /// Copy constructor
@@ -146,6 +146,9 @@ namespace dd4hep {
     /// Access an existing extension object from the detector element
     void* extension(unsigned long long int key, bool alert) const;
 
+    /// Access an existing extension object by the dense slot of the extension type
+    void* extension(std::size_t slot, unsigned long long int key, bool alert) const;
+
     /// Extend the sensitive detector element with an arbitrary structure accessible by the type
     template <typename IFACE, typename CONCRETE> IFACE* addExtension(CONCRETE* c)  const {
       return (IFACE*) this->addExtension(detail::typeHash64<IFACE>(),
@@ -154,7 +157,7 @@ namespace dd4hep {
 
     /// Access extension element by the type
     template <typename IFACE> IFACE* extension() const {
-      return (IFACE*) this->extension(detail::typeHash64<IFACE>());
+      return (IFACE*) this->extension(detail::extensionSlot<IFACE>(),detail::typeHash64<IFACE>(),true);
     }
   };
 
@@ -353,6 +356,9 @@ namespace dd4hep {
     /// Access an existing extension object from the detector element
     void* extension(unsigned long long int key, bool alert) const;
 
+    /// Access an existing extension object by the dense slot of the extension type
+    void* extension(std::size_t slot, unsigned long long int key, bool alert) const;
+
     /// Extend the detector element with an arbitrary structure accessible by the type
     template <typename IFACE, typename CONCRETE> IFACE* addExtension(CONCRETE* c) const {
       CallbackSequence::checkTypes(typeid(IFACE), typeid(CONCRETE), dynamic_cast<IFACE*>(c));
@@ -360,11 +366,11 @@ namespace dd4hep {
     }
     /// Access extension element by the type
     template <typename IFACE> IFACE* extension() const {
-      return (IFACE*) this->extension(detail::typeHash64<IFACE>(),true);
+      return (IFACE*) this->extension(detail::extensionSlot<IFACE>(),detail::typeHash64<IFACE>(),true);
     }
     /// Access extension element by the type
     template <typename IFACE> IFACE* extension(bool alert) const {
-      return (IFACE*) this->extension(detail::typeHash64<IFACE>(),alert);
+      return (IFACE*) this->extension(detail::extensionSlot<IFACE>(),detail::typeHash64<IFACE>(),alert);
     }
     /// Extend the detector element with an arbitrary callback
     template <typename Q, typename T>
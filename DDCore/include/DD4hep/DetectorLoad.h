@@ -17,6 +17,8 @@
 #include <DD4hep/Detector.h>
 
 // C/C++ include files
+#include <set>
+#include <string>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -90,5 +92,19 @@ namespace dd4hep {
     virtual void processXMLElement(const xml::Handle_t& root, DetectorBuildType type);
   };
 
+  /// Detector extension: the xml files processed to build the detector description
+  /** 
+   *  Filled while parsing: the top level files and all included documents.
+   *  Used e.g. to check if a geometry snapshot is up to date.
+   *
+   *  \author  M.Frank
+   *  \version 1.0
+   */
+  class DetectorSourceFiles : public std::set<std::string>  {
+  public:
+    /// Record a processed file of the detector description
+    static void add(Detector& description, const std::string& file_name);
+  };
+
 }         /* End namespace dd4hep         */
 #endif // DD4HEP_DETECTORLOAD_H
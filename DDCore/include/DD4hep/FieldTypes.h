@@ -18,6 +18,9 @@
 #include <DD4hep/Shapes.h>
 
 // C/C++ include files
+#include <atomic>
+#include <memory>
+#include <string>
 #include <vector>
 
 /// Namespace for the AIDA detector description toolkit
@@ -40,6 +43,8 @@ namespace dd4hep {
     ConstantField() = default;
     /// Call to access the field components at a given location
     virtual void fieldComponents(const double* /* pos */, double* field);
+    /// The field is independent of the position
+    virtual bool constantField(double* field)  const;
   };
 
   /// Implementation object of a solenoidal magnetic field.
@@ -64,6 +69,8 @@ namespace dd4hep {
     SolenoidField();
     /// Call to access the field components at a given location
     virtual void fieldComponents(const double* pos, double* field);
+    /// Bounding box of the field region
+    virtual bool fieldRegion(double* lower, double* upper)  const;
   };
 
   /// Implementation object of a dipole magnetic field.
@@ -85,6 +92,8 @@ namespace dd4hep {
     DipoleField();
     /// Call to access the field components at a given location
     virtual void fieldComponents(const double* pos, double* field);
+    /// Bounding box of the field region
+    virtual bool fieldRegion(double* lower, double* upper)  const;
   };
 
   /// Implementation object of a Multipole magnetic field.
@@ -176,6 +185,117 @@ namespace dd4hep {
     MultipoleField();
     /// Call to access the field components at a given location
     virtual void fieldComponents(const double* pos, double* field);
+    /// Bounding box of the field region
+    virtual bool fieldRegion(double* lower, double* upper)  const;
+  };
+
+  /// Implementation object of a field given by a field map on a regular grid.
+  /**
+   *  The field values are given on a regular grid either in cartesian
+   *  coordinates (x,y,z) or in cylindrical coordinates (r,z) or (r,phi,z).
+   *  Cylindrical maps hold the components (F_r, F_phi, F_z), which are
+   *  rotated to cartesian components at the space point.
+   *  The field is interpolated trilinearly (bilinearly for (r,z) maps).
+   *  Outside the mapped region the field is zero.
+   *
+   *  The map is read from a compact binary file: a header_t followed by
+   *  3 floats per grid point with the grid index ((i0*num1)+i1)*num2+i2.
+   *  The file is memory mapped read-only. All field maps loaded from the
+   *  same file share one mapping.
+   *
+   *  Symmetries fold the space point into the mapped region:
+   *  \li Mirror symmetry: negative coordinates of axes in 'mirror' are mirrored
+   *      and the field components in flip[axis] change sign.
+   *  \li Rotational symmetry of (r,phi,z) maps: if 'periodic' is set, phi
+   *      is taken modulo the mapped phi range num[1]*step[1].
+   *
+   *  The corner values of the last grid cell are cached per thread:
+   *  consecutive steps of a track mostly stay in the same cell.
+   *
+   *  The field values are not persistent: after reading the geometry
+   *  with ROOT I/O the file is mapped again at the first access.
+   *
+   *  \author  M.Frank
+   *  \version 1.0
+   *  \ingroup DD4HEP_CORE
+   */
+  class FieldMap : public CartesianField::Object {
+  public:
+    /// Coordinate system of the grid
+    enum GridType { CARTESIAN = 1, CYLINDRICAL_RZ = 2, CYLINDRICAL_RPHIZ = 3 };
+    /// Header of the binary field map file
+    struct header_t  {
+      /// File identifier: "DD4FMAP"
+      char         magic[8];
+      /// File format version
+      unsigned int version;
+      /// Grid type (GridType)
+      unsigned int grid;
+      /// Number of grid points per axis (x,y,z) or (r,phi,z). (r,z) maps have num[1]=1
+      int          num[3];
+      /// Reserved
+      unsigned int flags;
+      /// Grid origin per axis. Lengths in units of the file, phi in radians
+      double       min[3];
+      /// Grid spacing per axis
+      double       step[3];
+    };
+    /// Shared memory mapping of a field map file
+    class Mapping;
+
+  public:
+    /// Name of the field map file
+    std::string  file;
+    /// Grid type
+    int          grid        { CARTESIAN };
+    /// Number of grid points per axis
+    int          num[3]      { 1, 1, 1 };
+    /// Grid origin per axis
+    double       min[3]      { 0e0, 0e0, 0e0 };
+    /// Grid spacing per axis
+    double       step[3]     { 1e0, 1e0, 1e0 };
+    /// Field unit: scale factor applied to the values of the file
+    double       scale       { 1e0 };
+    /// Bit mask of mirrored axes
+    unsigned char mirror     { 0 };
+    /// Bit mask of field components changing sign for each mirrored axis
+    unsigned char flip[3]    { 0, 0, 0 };
+    /// Flag for rotational symmetry of (r,phi,z) maps
+    bool         periodic    { false };
+
+  private:
+    /// Reference to the shared file mapping
+    mutable std::shared_ptr<Mapping> m_mapping;   //!
+    /// Field values: 3 floats per grid point. Set once: by load() or by the first attach()
+    mutable std::atomic<const float*> m_values { nullptr }; //!
+    /// Inverse grid spacing
+    double       m_invStep[3]{ 0e0, 0e0, 0e0 };
+    /// Grid strides per axis
+    long         m_stride[3] { 0, 0, 0 };
+    /// Unique identifier for the per-thread cell cache
+    unsigned long m_id       { 0 };       //!
+
+    /// Map the file of a field map read with ROOT I/O. Throws if the file does not match
+    const float* attach()  const;
+
+  public:
+    /// Initializing constructor
+    FieldMap();
+    /// Default destructor
+    virtual ~FieldMap();
+    /// Load the field map from file. Grid lengths are scaled by length_unit
+    void load(const std::string& file_name, double length_unit = 1e0);
+    /// Write field map file. The values array holds 3 floats per grid point
+    static void save(const std::string& file_name, const header_t& header, const float* values);
+    /// Access to the raw field values of the mapped file
+    const float* values()  const  {
+      const float* v = m_values.load(std::memory_order_acquire);
+      return v ? v : attach();
+    }
+    /// Call to access the field components at a given location
+    virtual void fieldComponents(const double* pos, double* field);
+    /// Bounding box of the mapped region including the symmetry folding
+    virtual bool fieldRegion(double* lower, double* upper)  const;
   };
 
 }         /* End namespace dd4hep             */
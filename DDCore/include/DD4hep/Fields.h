@@ -80,6 +80,14 @@ namespace dd4hep {
        *  field vector in order to allow for superposition of the fields.
        */
       virtual void fieldComponents(const double* pos, double* field) = 0;
+      /** Overwrite to supply the axis aligned box outside of which the field vanishes.
+       *  Return false if the field is not bounded (default).
+       */
+      virtual bool fieldRegion(double* lower, double* upper)  const;
+      /** Overwrite for fields independent of the position.
+       *  Return true and fill the field vector if the field is constant (default: false).
+       */
+      virtual bool constantField(double* field)  const;
     };
 
     /// Default constructor
@@ -274,5 +282,59 @@ namespace dd4hep {
     /// Access to properties container
     Properties& properties() const;
   };
+
+  /// Flattened evaluation of the components of an overlayed field
+  /**
+   *  Built once from the components of an OverlayedField, e.g. at the
+   *  initialization of the simulation:
+   *  \li Constant components are fused into one offset vector.
+   *  \li Bounded components are only evaluated if the point lies inside
+   *      their precomputed bounding box.
+   *  \li The remaining components are called directly through their
+   *      implementation objects without handle indirection.
+   *
+   *  Components added to the overlay after construction are not seen:
+   *  the compiled field must then be rebuilt.
+   *
+   *  \author  M.Frank
+   *  \version 1.0
+   *  \ingroup DD4HEP_CORE
+   */
+  class CompiledField  {
+  public:
+    /// Field component with bounding box
+    struct Component  {
+      /// Implementation object of the field component
+      CartesianField::Object* object  { nullptr };
+      /// Lower corner of the bounding box
+      double lower[3]  { 0e0, 0e0, 0e0 };
+      /// Upper corner of the bounding box
+      double upper[3]  { 0e0, 0e0, 0e0 };
+      /// Flag if the bounding box is valid
+      bool   bounded   { false };
+    };
+
+  protected:
+    /// Sum of all constant field components
+    double                 m_offset[3]  { 0e0, 0e0, 0e0 };
+    /// Position dependent field components
+    std::vector<Component> m_components { };
+    /// Number of fused constant components
+    std::size_t            m_constants  { 0 };
+
+  public:
+    /// Default constructor
+    CompiledField() = default;
+    /// Initializing constructor from the electric or magnetic components of an overlay
+    CompiledField(OverlayedField field, int type = OverlayedField::MAGNETIC);
+    /// Access the position dependent field components
+    const std::vector<Component>& components()  const  {  return m_components;  }
+    /// Number of constant components fused into the offset
+    std::size_t numConstants()  const                  {  return m_constants;   }
+    /// Add the field components at a given location to the field vector
+    void fieldComponents(const double* pos, double* field)  const;
+    /// Add the field components of n points (pos[3*n]) to the field vectors (field[3*n])
+    void fieldComponents(std::size_t n, const double* pos, double* field)  const;
+  };
 }         /* End namespace dd4hep             */
 #endif // DD4HEP_FIELDS_H
@@ -18,6 +18,8 @@
 
 // C/C++ include files
 #include <map>
+#include <vector>
+#include <typeinfo>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -26,14 +28,32 @@ namespace dd4hep {
   /**
    *  Usage by inheritance of the client supporting the functionality
    *
+   *  Extension types are assigned a dense slot number at first use.
+   *  Each object keeps a small array indexed by the slot, so that typed
+   *  accessors resolve an extension with an indexed load. Extension types
+   *  beyond the slot capacity use the map lookup by type key.
+   *  Lookup statistics per extension type can be collected to locate
+   *  calls from hot loops.
+   *
    *  \author  M.Frank
    *  \version 1.0
    *  \ingroup DD4HEP_CORE
    */
   class ObjectExtensions   {
   public:
+    /// Slot number of extension types without dense slot
+    static constexpr std::size_t NO_SLOT   = ~0UL;
+    /// Maximal number of extension types with a dense slot
+    static constexpr std::size_t MAX_SLOTS = 64;
+
     /// The extensions object
     std::map<unsigned long long int, ExtensionEntry*>    extensions;   //!
+    /// Extension entries indexed by the dense slot of the extension type
+    std::vector<ExtensionEntry*>                         slots;        //!
+
+  protected:
+    /// Update the slot entry of an extension type
+    void setSlot(unsigned long long int key, ExtensionEntry* entry);
 
   public:
     /// Default constructor
@@ -60,7 +80,26 @@ namespace dd4hep {
     void* extension(unsigned long long int key, bool alert) const;
     /// Access an existing extension object from the detector element
     void* extension(unsigned long long int key) const;
+    /// Access an existing extension object by the dense slot of the extension type
+    void* extension(std::size_t slot, unsigned long long int key, bool alert) const;
+
+    /// Access the dense slot of an extension type. Assigned at first use
+    static std::size_t slot(unsigned long long int key, const std::type_info& type);
+    /// Access the dense slot of an extension type. Assigned at first use
+    static std::size_t slot(unsigned long long int key);
+    /// Enable or disable the lookup statistics per extension type
+    static void enableStatistics(bool value);
+    /// Print the lookup statistics per extension type
+    static void printStatistics();
   };
 
+  namespace detail  {
+    /// Dense slot of an extension type
+    template <typename T> std::size_t extensionSlot()   {
+      static std::size_t code = ObjectExtensions::slot(typeHash64<T>(), typeid(T));
+      return code;
+    }
+  }
+
 } /* End namespace dd4hep        */
 #endif // DD4HEP_OBJECTEXTENSIONS_H
@@ -82,6 +82,11 @@ namespace dd4hep {
     Position position(const CellID& cellID) const;
     /// determine the cell ID based on the local position
     CellID cellID(const Position& localPosition, const Position& globalPosition, const VolumeID& volumeID) const;
+    /// determine the local positions of n cell IDs in one batch
+    void positions(std::size_t n, const CellID* cellIDs, Position* localPositions) const;
+    /// determine the cell IDs of n local positions in one batch
+    void cellIDs(std::size_t n, const Position* localPositions, const Position* globalPositions,
+                 const VolumeID* volumeIDs, CellID* cellIDs) const;
     /// Determine the volume ID from the full cell ID by removing all local fields
     VolumeID volumeID(const CellID& cellID) const;
     /// Calculates the neighbours of the given cell ID and adds them to the list of neighbours
@@ -122,6 +122,11 @@ namespace dd4hep {
    *  subdetectors must have the same length to ensure the uniqueness of the
    *  placement keys.
    *
+   *  Once populated, either mode may be frozen: the map based lookup tree is
+   *  compiled into sorted flat arrays with direct dispatch on the system field.
+   *  Lookups give identical results, but are considerably faster. A frozen
+   *  volume manager does not accept further placements.
+   *
    *  By default the volume manager in TREE mode (-> 1)) is attached to the
    *  Detector instance and also managed by this instance.
    *  If you wish to create instances yourself, you must ensure that the
@@ -197,11 +202,22 @@ namespace dd4hep {
     /// Register physical volume with the manager and pre-computed volume id
     bool adoptPlacement(VolumeID volume_id, VolumeManagerContext* context);
 
+    /// Compile the populated lookup tree into flat tables. Subsections are frozen as well.
+    void freeze();
+    /// Check if the volume manager is frozen
+    bool isFrozen() const;
+
     /** This set of functions is required when reading/analyzing
      *  already created hits which have a VolumeID attached.
      */
     /// Lookup the context, which belongs to a registered physical volume.
     VolumeManagerContext* lookupContext(VolumeID volume_id) const;
+    /// Lookup the contexts of a batch of volume identifiers. Unknown identifiers yield NULL.
+    void lookupContexts(std::size_t num_ids, const VolumeID* volume_ids,
+                        VolumeManagerContext** contexts) const;
+    /// Lookup the contexts of a batch of volume identifiers. Unknown identifiers yield NULL.
+    void lookupContexts(const std::vector<VolumeID>& volume_ids,
+                        std::vector<VolumeManagerContext*>& contexts) const;
     /// Lookup a physical (placed) volume identified by its 64 bit hit ID
     PlacedVolume lookupVolumePlacement(VolumeID volume_id) const;
     /// Lookup a physical (placed) volume of the detector element containing a volume identified by its 64 bit hit ID
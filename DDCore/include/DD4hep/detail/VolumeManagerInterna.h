@@ -30,6 +30,9 @@
 // ROOT include files
 #include <TGeoMatrix.h>
 
+// C/C++ include files
+#include <vector>
+
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
 
@@ -55,6 +58,48 @@ namespace dd4hep {
       ~VolumeManagerContextExtension() = default;
     };
   
+    /// Flat lookup tables of a frozen volume manager
+    /**
+     *  Once the volume manager is populated, the map based tree may be compiled
+     *  into sorted, contiguous arrays of the masked volume identifiers and the
+     *  corresponding contexts. Subdetector sections are addressed directly by
+     *  the value of their system field.
+     *
+     * \author  M.Frank
+     * \version 1.0
+     * \ingroup DD4HEP_CORE
+     */
+    class VolumeManagerFrozenTables {
+    public:
+      /// Sorted lookup table of one volume manager section
+      struct Section {
+        /// Mask applied to the volume identifier before the lookup
+        VolumeID                           detMask = ~0x0ULL;
+        /// Sorted masked volume identifiers
+        std::vector<VolumeID>              keys;
+        /// Contexts corresponding to the keys
+        std::vector<VolumeManagerContext*> contexts;
+        /// Binary search of the context belonging to a volume identifier
+        VolumeManagerContext* search(VolumeID vol_id) const;
+      };
+      /// Direct mapping of the values of one system field to sections
+      struct Dispatch {
+        /// Offset of the system field
+        unsigned         offset = 0;
+        /// Mask of the system field (already shifted to bit 0)
+        VolumeID         mask   = 0;
+        /// Section index by system value. -1 if no section is present
+        std::vector<int> sections;
+      };
+      /// Own volumes (index 0) followed by the subdetector sections in lookup order
+      std::vector<Section>  sections;
+      /// System field dispatch tables. Usually only one entry.
+      std::vector<Dispatch> dispatch;
+    public:
+      /// Search the context of a volume identifier. Same result as the map based search.
+      VolumeManagerContext* search(VolumeID vol_id) const;
+    };
+
     /// This structure describes the internal data of the volume manager object
     /**
      *
@@ -84,6 +129,8 @@ namespace dd4hep {
       VolumeID               detMask = ~0x0ULL;
       /// Population flags
       int                    flags   = VolumeManager::NONE;
+      /// Flat lookup tables once the volume manager is frozen
+      VolumeManagerFrozenTables* frozen = 0;  //! Not ROOT persistent
     public:
       /// Default constructor
       VolumeManagerObject() = default;
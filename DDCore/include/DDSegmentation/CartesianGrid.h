@@ -30,10 +30,30 @@ namespace dd4hep {
       /// Destructor
       virtual ~CartesianGrid();
     protected:
+      /// Description of one regular grid axis for the batch kernels
+      struct GridAxis  {
+        /// Name of the cell ID field of this axis
+        const std::string*  identifier;
+        /// Coordinate of the axis in the local position
+        double Vector3D::*  coordinate;
+        /// The grid size
+        double              cellSize;
+        /// The coordinate offset
+        double              offset;
+      };
+
       /// Default constructor used by derived classes passing the encoding string
       CartesianGrid(const std::string& cellEncoding = "");
       /// Default constructor used by derived classes passing an existing decoder
       CartesianGrid(const BitFieldCoder* decoder);
+
+      /// Batch kernel: local positions of n cell IDs for the given grid axes
+      void gridPositions(const GridAxis* axes, int num_axes,
+                         std::size_t n, const CellID* cellIDs, Vector3D* localPositions) const;
+      /// Batch kernel: cell IDs of n local positions for the given grid axes
+      void gridCellIDs(const GridAxis* axes, int num_axes,
+                       std::size_t n, const Vector3D* localPositions, const VolumeID* volumeIDs,
+                       CellID* cellIDs) const;
     };
 
   } /* namespace DDSegmentation */
@@ -37,6 +37,11 @@ namespace dd4hep {
       virtual Vector3D position(const CellID& cellID) const;
       /// determine the cell ID based on the position
       virtual CellID cellID(const Vector3D& localPosition, const Vector3D& globalPosition, const VolumeID& volumeID) const;
+      /// determine the positions of n cell IDs
+      virtual void positions(std::size_t n, const CellID* cellIDs, Vector3D* localPositions) const;
+      /// determine the cell IDs of n positions
+      virtual void cellIDs(std::size_t n, const Vector3D* localPositions, const Vector3D* globalPositions,
+                           const VolumeID* volumeIDs, CellID* cellIDs) const;
       /// access the grid size in X
       double gridSizeX() const {
         return _gridSizeX;
@@ -0,0 +1,373 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDSEGMENTATION_FIXEDBITFIELDCODER_H
+#define DDSEGMENTATION_FIXEDBITFIELDCODER_H 1
+
+#include <DDSegmentation/BitFieldCoder.h>
+
+#include <array>
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+
+namespace dd4hep {
+
+  namespace DDSegmentation {
+
+    /// Compile-time helpers to parse bit field encoding strings
+    namespace fixed_encoding  {
+
+      /// Offset and signed width of one field of an encoding string
+      struct FieldSpec  {
+        unsigned offset;
+        int      width;
+      };
+
+      /// Compare two string ranges
+      constexpr bool equal(const char* a, std::size_t len_a, const char* b, std::size_t len_b)  {
+        if ( len_a != len_b ) return false;
+        for( std::size_t i = 0; i < len_a; ++i )
+          if ( a[i] != b[i] ) return false;
+        return true;
+      }
+
+      /// Length of a zero terminated string
+      constexpr std::size_t length(const char* s)  {
+        std::size_t len = 0;
+        while( s[len] ) ++len;
+        return len;
+      }
+
+      /// Parse a decimal number with optional leading blanks and sign
+      constexpr int number(const char* s, std::size_t len)  {
+        std::size_t i = 0;
+        bool negative = false;
+        while( i < len && s[i] == ' ' ) ++i;
+        if ( i < len && s[i] == '-' )  { negative = true; ++i; }
+        int value = 0;
+        for( ; i < len && s[i] >= '0' && s[i] <= '9'; ++i )
+          value = 10*value + (s[i]-'0');
+        return negative ? -value : value;
+      }
+
+      /// Locate the n-th non-empty token of the range separated by 'del'. Returns false if absent.
+      constexpr bool token(const char* s, std::size_t len, char del, std::size_t n,
+                           std::size_t& begin, std::size_t& end)  {
+        std::size_t count = 0;
+        for( std::size_t i = 0; i < len; )  {
+          if ( s[i] == del )  { ++i; continue; }
+          std::size_t j = i;
+          while( j < len && s[j] != del ) ++j;
+          if ( count == n )  { begin = i; end = j; return true; }
+          ++count;
+          i = j;
+        }
+        return false;
+      }
+
+      /// Number of non-empty tokens of the range separated by 'del'
+      constexpr std::size_t count(const char* s, std::size_t len, char del)  {
+        std::size_t n = 0, b = 0, e = 0;
+        while( token(s, len, del, n, b, e) ) ++n;
+        return n;
+      }
+
+      /// Number of fields of an encoding string
+      constexpr std::size_t num_fields(const char* s)  {
+        return count(s, length(s), ',');
+      }
+
+      /// Offset and width of field 'idx' following the rules of BitFieldCoder::init
+      constexpr FieldSpec field(const char* s, std::size_t idx)  {
+        const std::size_t len = length(s);
+        unsigned offset = 0;
+        for( std::size_t n = 0; ; ++n )  {
+          std::size_t fb = 0, fe = 0;
+          if ( !token(s, len, ',', n, fb, fe) )
+            throw std::invalid_argument("FixedBitFieldCoder: field index out of range");
+          const char*       f    = s + fb;
+          const std::size_t flen = fe - fb;
+          std::size_t b1 = 0, e1 = 0, b2 = 0, e2 = 0;
+          FieldSpec spec { offset, 0 };
+          switch( count(f, flen, ':') )  {
+          case 2:
+            token(f, flen, ':', 1, b1, e1);
+            spec.width  = number(f+b1, e1-b1);
+            break;
+          case 3:
+            token(f, flen, ':', 1, b1, e1);
+            token(f, flen, ':', 2, b2, e2);
+            spec.offset = unsigned(number(f+b1, e1-b1));
+            spec.width  = number(f+b2, e2-b2);
+            break;
+          default:
+            throw std::invalid_argument("FixedBitFieldCoder: invalid number of subfields");
+          }
+          offset = spec.offset + unsigned(spec.width < 0 ? -spec.width : spec.width);
+          if ( n == idx ) return spec;
+        }
+      }
+
+      /// Index of the field with the given name. Fails to compile if the name is unknown
+      constexpr std::size_t index(const char* s, const char* name)  {
+        const std::size_t len = length(s), name_len = length(name);
+        for( std::size_t n = 0; ; ++n )  {
+          std::size_t fb = 0, fe = 0, nb = 0, ne = 0;
+          if ( !token(s, len, ',', n, fb, fe) )
+            throw std::invalid_argument("FixedBitFieldCoder: unknown field name");
+          token(s+fb, fe-fb, ':', 0, nb, ne);
+          if ( equal(s+fb+nb, ne-nb, name, name_len) ) return n;
+        }
+      }
+    }
+
+    /// Bit field with offset and width fixed at compile time
+    /** Same semantics as BitFieldElement. All masks and shifts are constants,
+     *  sign extension is branch free. A negative WIDTH denotes a signed field.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     */
+    template <unsigned OFFSET, int WIDTH> struct FixedBitField  {
+      /// The field's offset
+      static constexpr unsigned offset   = OFFSET;
+      /// The field's width
+      static constexpr unsigned width    = unsigned(WIDTH < 0 ? -WIDTH : WIDTH);
+      /// True if field is interpreted as signed
+      static constexpr bool     isSigned = WIDTH < 0;
+      /// The field's mask relative to bit 0
+      static constexpr CellID   bits     = width == 64 ? ~CellID(0) : (CellID(1) << width) - 1;
+      /// The field's mask
+      static constexpr CellID   mask     = bits << offset;
+      /// Sign bit of the field value
+      static constexpr CellID   sign     = isSigned ? CellID(1) << (width-1) : CellID(0);
+      /// Minimal value
+      static constexpr FieldID  minValue = isSigned ? -FieldID(sign) : FieldID(0);
+      /// Maximal value
+      static constexpr FieldID  maxValue = isSigned ? FieldID(sign-1) : FieldID(bits);
+
+      static_assert(width > 0,            "FixedBitField: zero width field");
+      static_assert(offset+width <= 64,   "FixedBitField: field exceeds 64 bits");
+
+      /// Calculate this field's value given an external 64 bit bitmap
+      static constexpr FieldID value(CellID bitfield)  {
+        return FieldID((((bitfield >> offset) & bits) ^ sign) - sign);
+      }
+      /// Bits of the given value at the field's position. No range check
+      static constexpr CellID encode(FieldID val)  {
+        return (CellID(val) << offset) & mask;
+      }
+      /// Assign the given value to the bit field with range check like BitFieldElement::set
+      static void set(CellID& bitfield, FieldID val)  {
+        if ( val < minValue || val > maxValue )  {
+          std::stringstream s;
+          s << " FixedBitField [" << offset << ":" << WIDTH << "]: out of range : " << val
+            << " for width " << width;
+          throw std::runtime_error(s.str());
+        }
+        bitfield = (bitfield & ~mask) | encode(val);
+      }
+    };
+
+    template <unsigned OFFSET, int WIDTH> constexpr unsigned FixedBitField<OFFSET,WIDTH>::offset;
+    template <unsigned OFFSET, int WIDTH> constexpr unsigned FixedBitField<OFFSET,WIDTH>::width;
+    template <unsigned OFFSET, int WIDTH> constexpr bool     FixedBitField<OFFSET,WIDTH>::isSigned;
+    template <unsigned OFFSET, int WIDTH> constexpr CellID   FixedBitField<OFFSET,WIDTH>::bits;
+    template <unsigned OFFSET, int WIDTH> constexpr CellID   FixedBitField<OFFSET,WIDTH>::mask;
+    template <unsigned OFFSET, int WIDTH> constexpr CellID   FixedBitField<OFFSET,WIDTH>::sign;
+    template <unsigned OFFSET, int WIDTH> constexpr FieldID  FixedBitField<OFFSET,WIDTH>::minValue;
+    template <unsigned OFFSET, int WIDTH> constexpr FieldID  FixedBitField<OFFSET,WIDTH>::maxValue;
+
+    /// Bit field coder with the layout of all fields fixed at compile time
+    /** Counterpart of the runtime BitFieldCoder for encodings which never change.
+     *  Field access needs neither a name lookup nor runtime offsets and widths:
+     *  every get and set compiles down to a shift and a mask.
+     *
+     *  All fields of a cellID are decoded in one go into a Values structure.
+     *  The batch functions work on arrays of cellIDs with one output array per field
+     *  (structure of arrays). The loops are free of branches and dependencies and
+     *  are vectorized by the compiler.
+     *
+     *  Interoperability with the runtime BitFieldCoder: matches() and check()
+     *  verify at startup that a runtime coder (e.g. the decoder of a segmentation)
+     *  has the identical layout. Only then the fixed coder may be used in its place.
+     *  Encoded cellIDs are bit-identical.
+     *
+     *  Example:<br>
+     *    typedef FixedBitFieldCoder<FixedBitField<0,8>, FixedBitField<8,-16> > Coder;  <br>
+     *    Coder::Values v = Coder::decode(cellID);  <br>
+     *    FieldID y = Coder::get<1>(cellID);        <br>
+     *
+     *  See FixedEncodingCoder to generate the coder from an encoding string.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     */
+    template <typename... FIELDS> class FixedBitFieldCoder  {
+    public:
+      /// Number of fields
+      static constexpr std::size_t SIZE = sizeof...(FIELDS);
+      /// Decoded values of all fields
+      typedef std::array<FieldID, SIZE>        Values;
+      /// Field output arrays for batch decoding
+      typedef std::array<FieldID*, SIZE>       Outputs;
+      /// Field input arrays for batch encoding
+      typedef std::array<const FieldID*, SIZE> Inputs;
+      /// Field type of index I
+      template <std::size_t I> using Field = typename std::tuple_element<I, std::tuple<FIELDS...> >::type;
+
+    private:
+      typedef std::make_index_sequence<SIZE> Sequence;
+
+      template <std::size_t... I>
+      static constexpr Values decode_(CellID bitfield, std::index_sequence<I...>)  {
+        return Values {{ Field<I>::value(bitfield)... }};
+      }
+      template <std::size_t... I>
+      static constexpr CellID encode_(const Values& v, std::index_sequence<I...>)  {
+        CellID result = 0;
+        for( CellID b : { CellID(0), Field<I>::encode(v[I])... } ) result |= b;
+        return result;
+      }
+      template <std::size_t... I>
+      static void decode_(std::size_t n, const CellID* bitfields, const Outputs& out, std::index_sequence<I...>)  {
+        using expand = int[];
+        (void)expand { 0, (decode<I>(n, bitfields, out[I]), 0)... };
+      }
+      template <std::size_t... I>
+      static void encode_(std::size_t n, const Inputs& in, CellID* bitfields, std::index_sequence<I...>)  {
+        for( std::size_t i = 0; i < n; ++i ) bitfields[i] = 0;
+        using expand = int[];
+        (void)expand { 0, (encode<I>(n, in[I], bitfields), 0)... };
+      }
+      template <std::size_t... I>
+      static bool matches_(const BitFieldCoder& coder, std::index_sequence<I...>)  {
+        const unsigned offsets[] = { 0U, Field<I>::offset... };
+        const unsigned widths[]  = { 0U, Field<I>::width... };
+        const bool     signs[]   = { false, Field<I>::isSigned... };
+        bool result = coder.size() == SIZE;
+        for( std::size_t i = 0; result && i < SIZE; ++i )  {
+          const BitFieldElement& f = coder[unsigned(i)];
+          result = f.offset() == offsets[i+1] && f.width() == widths[i+1] && f.isSigned() == signs[i+1];
+        }
+        return result;
+      }
+      template <std::size_t... I>
+      static constexpr CellID mask_(std::index_sequence<I...>)  {
+        CellID result = 0;
+        for( CellID m : { CellID(0), Field<I>::mask... } ) result |= m;
+        return result;
+      }
+
+    public:
+      /// The mask of all the bits used in the description
+      static constexpr CellID mask()   {  return mask_(Sequence());                    }
+
+      /// Get value of sub-field I
+      template <std::size_t I> static constexpr FieldID get(CellID bitfield)  {
+        return Field<I>::value(bitfield);
+      }
+      /// Set value of sub-field I with range check
+      template <std::size_t I> static void set(CellID& bitfield, FieldID value)  {
+        Field<I>::set(bitfield, value);
+      }
+
+      /// Decode all fields of a cellID in one shot
+      static constexpr Values decode(CellID bitfield)  {
+        return decode_(bitfield, Sequence());
+      }
+      /// Encode all field values into a cellID. No range checks: excess bits are masked
+      static constexpr CellID encode(const Values& values)  {
+        return encode_(values, Sequence());
+      }
+
+      /// Batch decode field I of n cellIDs
+      template <std::size_t I> static void decode(std::size_t n, const CellID* bitfields, FieldID* values)  {
+        for( std::size_t i = 0; i < n; ++i )
+          values[i] = Field<I>::value(bitfields[i]);
+      }
+      /// Batch encode field I of n cellIDs. The bits are or-ed to the existing content
+      template <std::size_t I> static void encode(std::size_t n, const FieldID* values, CellID* bitfields)  {
+        for( std::size_t i = 0; i < n; ++i )
+          bitfields[i] |= Field<I>::encode(values[i]);
+      }
+      /// Batch decode all fields of n cellIDs. out[j][i] receives field j of cellID i
+      static void decode(std::size_t n, const CellID* bitfields, const Outputs& out)  {
+        decode_(n, bitfields, out, Sequence());
+      }
+      /// Batch encode n cellIDs from the field arrays. No range checks: excess bits are masked
+      static void encode(std::size_t n, const Inputs& in, CellID* bitfields)  {
+        encode_(n, in, bitfields, Sequence());
+      }
+
+      /// Check if the runtime coder has the identical field layout
+      static bool matches(const BitFieldCoder& coder)  {
+        return matches_(coder, Sequence());
+      }
+      /// Throw an exception if the runtime coder does not have the identical field layout
+      static void check(const BitFieldCoder& coder)  {
+        if ( !matches(coder) )  {
+          throw std::runtime_error(" FixedBitFieldCoder: field layout differs from runtime coder: " +
+                                   coder.fieldDescription());
+        }
+      }
+    };
+
+    namespace fixed_encoding  {
+      template <typename ENCODING, typename SEQUENCE> struct CoderType;
+      template <typename ENCODING, std::size_t... I> struct CoderType<ENCODING, std::index_sequence<I...> >  {
+        typedef FixedBitFieldCoder<FixedBitField<field(ENCODING::encoding(), I).offset,
+                                                 field(ENCODING::encoding(), I).width>...> type;
+      };
+    }
+
+    /// Fixed bit field coder generated at compile time from an encoding string
+    /** The encoding string has the same syntax as for the BitFieldCoder. It is
+     *  supplied by a type with a static constexpr function 'encoding':
+     *
+     *  Example:<br>
+     *    struct CaloEncoding  {  <br>
+     *      static constexpr const char* encoding()  { return "system:8,barrel:3,module:4,layer:8,x:32:-16,y:-16"; }  <br>
+     *    };  <br>
+     *    typedef FixedEncodingCoder<CaloEncoding> Coder;  <br>
+     *    FieldID layer = Coder::get<Coder::index("layer")>(cellID);  <br>
+     *    Coder::check(*segmentation.decoder());  <br>
+     *
+     *  Malformed encoding strings and unknown field names fail to compile.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     */
+    template <typename ENCODING> class FixedEncodingCoder
+      : public fixed_encoding::CoderType<ENCODING,
+                                         std::make_index_sequence<fixed_encoding::num_fields(ENCODING::encoding())> >::type
+    {
+    public:
+      /// The encoding string
+      static constexpr const char* encoding()  {  return ENCODING::encoding();   }
+      /// Index for field named 'name'
+      static constexpr std::size_t index(const char* name)  {
+        return fixed_encoding::index(ENCODING::encoding(), name);
+      }
+      /// Runtime coder with the identical layout
+      static BitFieldCoder runtimeCoder()  {
+        return BitFieldCoder(ENCODING::encoding());
+      }
+    };
+
+  } // end namespace
+} // end namespace
+#endif
@@ -47,6 +47,17 @@ namespace dd4hep {
 
       /// Debug flags
       int m_debug;
+      /// Start key of the disjoint key intervals covering all sub-segmentation ranges
+      std::vector<long> m_intervalKey;     //! Not ROOT persistent
+      /// Entry index of each key interval (-1: no sub-segmentation)
+      std::vector<int>  m_intervalEntry;   //! Not ROOT persistent
+      /// Dense jump table: entry index by key - m_tableKey (-1: no sub-segmentation)
+      std::vector<int>  m_table;           //! Not ROOT persistent
+      /// Key of the first jump table entry
+      long              m_tableKey = 0;    //! Not ROOT persistent
+
+      /// Compile the key ranges of all sub-segmentations into the dispatch tables
+      void buildDispatch();
 
     public:
       /// Default constructor passing the encoding string
@@ -63,12 +74,21 @@ namespace dd4hep {
 
       /// Access subsegmentation by cell identifier
       const Segmentation& subsegmentation(const CellID& cellID) const;
+      /// Index of the subsegmentation entry by cell identifier
+      std::size_t subsegmentationIndex(const CellID& cellID) const;
+      /// Index of the subsegmentation entry by discriminator value. Returns -1 if no entry matches
+      int subsegmentationIndexByKey(long key) const;
 
       /// determine the position based on the cell ID
       virtual Vector3D position(const CellID& cellID) const;
 
       /// determine the cell ID based on the position
       virtual CellID cellID(const Vector3D& localPosition, const Vector3D& globalPosition, const VolumeID& volumeID) const;
+      /// determine the positions of n cell IDs grouped by sub-segmentation
+      virtual void positions(std::size_t n, const CellID* cellIDs, Vector3D* localPositions) const;
+      /// determine the cell IDs of n positions grouped by sub-segmentation
+      virtual void cellIDs(std::size_t n, const Vector3D* localPositions, const Vector3D* globalPositions,
+                           const VolumeID* volumeIDs, CellID* cellIDs) const;
 
       /** \brief Returns a vector<double> of the cellDimensions of the given cell ID
           in natural order of dimensions, e.g., dx/dy/dz, or dr/r*dPhi
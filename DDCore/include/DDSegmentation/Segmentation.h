@@ -23,6 +23,7 @@
 #include <DDSegmentation/BitFieldCoder.h>
 #include <DDSegmentation/SegmentationParameter.h>
 
+#include <cstddef>
 #include <map>
 #include <set>
 #include <string>
@@ -83,6 +84,11 @@ namespace dd4hep {
       /// Determine the cell ID based on the position
       virtual CellID cellID(const Vector3D& localPosition, const Vector3D& globalPosition,
                             const VolumeID& volumeID) const = 0;
+      /// Determine the local positions of n cell IDs. Default implementation calls position() for each cell
+      virtual void positions(std::size_t n, const CellID* cellIDs, Vector3D* localPositions) const;
+      /// Determine the cell IDs of n positions. Default implementation calls cellID() for each position
+      virtual void cellIDs(std::size_t n, const Vector3D* localPositions, const Vector3D* globalPositions,
+                           const VolumeID* volumeIDs, CellID* cellIDs) const;
       /// Determine the volume ID from the full cell ID by removing all local fields
       virtual VolumeID volumeID(const CellID& cellID) const;
       /// Calculates the neighbours of the given cell ID and adds them to the list of neighbours
@@ -136,6 +142,29 @@ namespace dd4hep {
       }
 
     protected:
+      /// Flat copy of one bit field for tight loops of the batch kernels
+      struct BatchField  {
+        CellID   mask;
+        CellID   sign;
+        FieldID  minValue;
+        FieldID  maxValue;
+        unsigned offset;
+        /// Initializing constructor
+        BatchField(const BitFieldElement& element);
+        /// Field value of the cell ID. Same result as BitFieldElement::value without branches
+        FieldID value(CellID cellID) const  {
+          return FieldID((((cellID & mask) >> offset) ^ sign) - sign);
+        }
+        /// Bits of the value at the field position. The range must be checked with inRange
+        CellID bits(FieldID val) const  {
+          return (CellID(val) << offset) & mask;
+        }
+        /// Range check as in BitFieldElement::set
+        bool inRange(FieldID val) const  {
+          return val >= minValue && val <= maxValue;
+        }
+      };
+
       /// Default constructor used by derived classes passing the encoding string
       Segmentation(const std::string& cellEncoding = "");
       /// Default constructor used by derived classes passing an existing decoder
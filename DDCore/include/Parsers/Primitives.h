@@ -116,6 +116,11 @@ namespace dd4hep {
     unsigned long long int update_hash64(unsigned long long int hash, const std::string& key);
     /// 64 bit hash update function
     unsigned long long int update_hash64(unsigned long long int hash, const char* key);
+
+    /// Size and modification time [nanoseconds since the epoch] of a file. False if not accessible
+    bool file_status(const std::string& file_name, long long int& size, long long int& mtime);
+    /// Size and modification time [nanoseconds since the epoch] of an open file. False if not accessible
+    bool file_status(int fd, long long int& size, long long int& mtime);
   
     /// 32 bit hash function
     inline unsigned int hash32(const void* key, std::size_t len) {
@@ -171,6 +171,7 @@ UNICODE (first);
 UNICODE (firstposition);
 UNICODE (firstrotation);
 UNICODE (flags);
+UNICODE (flip);
 UNICODE (formula);
 UNICODE (fraction);
 UNICODE (fractions);
@@ -498,6 +499,7 @@ UNICODE (surface);
 UNICODE (surfaces);
 UNICODE (system);
 UNICODE (symbol);
+UNICODE (symmetry);
 
 UNICODE (t);
 UNICODE (T);
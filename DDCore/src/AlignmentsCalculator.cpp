@@ -23,6 +23,17 @@
 #include <DD4hep/AlignmentsCalculator.h>
 #include <DD4hep/detail/AlignmentsInterna.h>
 
+#ifdef DD4HEP_USE_TBB
+#include <tbb/task_arena.h>
+#include <tbb/parallel_for.h>
+#include <tbb/blocked_range.h>
+#endif
+
+// C/C++ include files
+#include <memory>
+#include <algorithm>
+#include <functional>
+
 using namespace dd4hep;
 using namespace dd4hep::align;
 using Result = AlignmentsCalculator::Result;
@@ -97,6 +108,148 @@ namespace dd4hep {
           except("AlignContext","Failed to add entry: invalid detector handle!");
         }
       };
+
+      /// TGeoMatrix type bits relevant for the matrix products
+      constexpr unsigned int GEO_BITS = TGeoMatrix::kGeoTranslation | TGeoMatrix::kGeoRotation |
+        TGeoMatrix::kGeoScale | TGeoMatrix::kGeoReflection;
+      constexpr std::size_t MSIZE = AlignmentsCalculator::Hierarchy::MATRIX_SIZE;
+      const double unit_rotation[9] = { 1e0, 0e0, 0e0,   0e0, 1e0, 0e0,   0e0, 0e0, 1e0 };
+      const double unit_scale[3]    = { 1e0, 1e0, 1e0 };
+      const double zero_vector[3]   = { 0e0, 0e0, 0e0 };
+
+      /// Element state of the compiled computation
+      enum ElementState  {
+        ACTIVE   = 1<<0,   // Alignment is computed: delta or delta in the parent hierarchy
+        DELTA    = 1<<1,   // Element has a delta
+        DIRTY    = 1<<2,   // Input changed: alignment must be recomputed
+        EXTERNAL = 1<<3    // Parent transformation not computed in this pass
+      };
+
+      /// Copy a TGeoHMatrix to the contiguous representation. Returns the type bits
+      /** As with the TGeoHMatrix assignment only the components flagged by the type
+       *  bits are copied. The others are set to unity.
+       */
+      unsigned int load_matrix(const TGeoHMatrix& h, double* m, double* s)   {
+        const double* rot = h.IsRotation()    ? h.GetRotationMatrix() : unit_rotation;
+        const double* tr  = h.IsTranslation() ? h.GetTranslation()    : zero_vector;
+        const double* sc  = h.IsScale()       ? h.GetScale()          : unit_scale;
+        std::copy(rot, rot+9, m);
+        std::copy(tr,  tr+3,  m+9);
+        std::copy(sc,  sc+3,  s);
+        return h.TestBits(GEO_BITS);
+      }
+
+      /// Copy the contiguous representation to a TGeoHMatrix
+      void store_matrix(const double* m, const double* s, unsigned int bits, TGeoHMatrix& h)   {
+        h.SetRotation(m);
+        h.SetTranslation(m+9);
+        h.SetScale(s);
+        h.ResetBit(GEO_BITS);
+        h.SetBit(bits);
+      }
+
+      /// Matrix product m = l * r in the order of TGeoHMatrix::Multiply
+      /** As TGeoHMatrix::Multiply only the components flagged by the type bits
+       *  are computed, the others are copied. Multiplying by unity instead would
+       *  flip the sign of zeros. The file is compiled with -ffp-contract=off:
+       *  fused multiply-adds would change the rounding.
+       */
+      inline unsigned int multiply(const double* l, const double* ls, unsigned int lb,
+                                   const double* r, const double* rs, unsigned int rb,
+                                   double* m, double* s)   {
+        constexpr unsigned int gen_bits = TGeoMatrix::kGeoTranslation|TGeoMatrix::kGeoRotation|TGeoMatrix::kGeoScale;
+        if ( !(rb & gen_bits) )  {
+          std::copy(l,  l+MSIZE, m);
+          std::copy(ls, ls+3,    s);
+          return lb;
+        }
+        unsigned int bits = (lb | rb) & gen_bits;
+        bool reflect = (rb & TGeoMatrix::kGeoRotation) && (rb & TGeoMatrix::kGeoReflection);
+        if ( bool(lb & TGeoMatrix::kGeoReflection) != reflect ) bits |= TGeoMatrix::kGeoReflection;
+        if ( !(lb & gen_bits) )  {
+          // Unflagged components of both matrices are unity: take those of the right one
+          std::copy(r,  r+MSIZE, m);
+          std::copy(rs, rs+3,    s);
+          return bits;
+        }
+        if ( bits & TGeoMatrix::kGeoTranslation )  {
+          m[9]  = l[9]  + (l[0]*r[9] + l[1]*r[10] + l[2]*r[11]);
+          m[10] = l[10] + (l[3]*r[9] + l[4]*r[10] + l[5]*r[11]);
+          m[11] = l[11] + (l[6]*r[9] + l[7]*r[10] + l[8]*r[11]);
+        }
+        else  {
+          std::copy(l+9, l+12, m+9);
+        }
+        if ( bits & TGeoMatrix::kGeoRotation )  {
+          for( int i = 0; i < 9; i += 3 )  {
+            m[i]   = l[i]*r[0] + l[i+1]*r[3] + l[i+2]*r[6];
+            m[i+1] = l[i]*r[1] + l[i+1]*r[4] + l[i+2]*r[7];
+            m[i+2] = l[i]*r[2] + l[i+1]*r[5] + l[i+2]*r[8];
+          }
+        }
+        else  {
+          std::copy(l, l+9, m);
+        }
+        if ( bits & TGeoMatrix::kGeoScale )  {
+          s[0] = ls[0]*rs[0];
+          s[1] = ls[1]*rs[1];
+          s[2] = ls[2]*rs[2];
+        }
+        else  {
+          std::copy(ls, ls+3, s);
+        }
+        return bits;
+      }
+
+      /// Check if two deltas are identical
+      bool same_delta(const Delta& a, const Delta& b)   {
+        return a.flags == b.flags && a.translation == b.translation &&
+          a.pivot == b.pivot && a.rotation == b.rotation;
+      }
+
+      /// Check if two transformation matrices are identical
+      bool same_matrix(const TGeoHMatrix& a, const TGeoHMatrix& b)   {
+        double ma[MSIZE], sa[3], mb[MSIZE], sb[3];
+        return load_matrix(a, ma, sa) == load_matrix(b, mb, sb) &&
+          std::equal(ma, ma+MSIZE, mb) && std::equal(sa, sa+3, sb);
+      }
+
+      /// Helper to execute the computation of index ranges sequentially or in parallel
+      class Sweeper  {
+      public:
+        typedef std::function<void(std::size_t, std::size_t)> func_t;
+        /// Minimal number of elements per task
+        static constexpr std::size_t GRAIN = 256;
+#ifdef DD4HEP_USE_TBB
+        std::unique_ptr<tbb::task_arena> arena;
+#endif
+        /// Initializing constructor
+        Sweeper(int threads)   {
+#ifdef DD4HEP_USE_TBB
+          if ( threads > 0 ) arena = std::make_unique<tbb::task_arena>(threads);
+#else
+          if ( threads > 0 )  {
+            printout(DEBUG,"AlignmentsCalculator",
+                     "Hierarchy: threads=%d ignored: DD4hep was built without TBB.", threads);
+          }
+#endif
+        }
+        /// Execute the function for the index range [begin, end)
+        void operator()(std::size_t begin, std::size_t end, const func_t& func)  const   {
+#ifdef DD4HEP_USE_TBB
+          if ( arena && end-begin > GRAIN )   {
+            arena->execute([begin, end, &func]()   {
+              tbb::parallel_for(tbb::blocked_range<std::size_t>(begin, end, GRAIN),
+                                [&func](const tbb::blocked_range<std::size_t>& r)  {
+                                  func(r.begin(), r.end());
+                                });
+            });
+            return;
+          }
+#endif
+          func(begin, end);
+        }
+      };
     }
   }       /* End namespace align */
 }         /* End namespace dd4hep     */
@@ -214,6 +367,206 @@ Result AlignmentsCalculator::compute(const OrderedDeltas& deltas,
   return result;
 }
 
+/// Initializing constructor: compile the hierarchy below the top element
+AlignmentsCalculator::Hierarchy::Hierarchy(DetElement top) : m_top(top)   {
+  if ( !top.isValid() )   {
+    except("AlignmentsCalculator","Hierarchy: Invalid top detector element!");
+  }
+  // Breadth first: the elements of one level are contiguous
+  m_detectors.emplace_back(top.ptr());
+  m_parents.emplace_back(-1);
+  m_levels.emplace_back(0);
+  for( std::size_t begin = 0, end = 1; begin < end; begin = end, end = m_detectors.size() )   {
+    for( std::size_t i = begin; i < end; ++i )   {
+      for( const auto& c : DetElement(m_detectors[i]).children() )   {
+        m_detectors.emplace_back(c.second.ptr());
+        m_parents.emplace_back(long(i));
+      }
+    }
+    m_levels.emplace_back(end);
+  }
+  std::size_t num = m_detectors.size();
+  m_index.reserve(num);
+  m_nominal.resize(num*MSIZE);
+  m_nominalScale.resize(num*3);
+  m_nominalBits.resize(num);
+  for( std::size_t i = 0; i < num; ++i )   {
+    DetElement det(m_detectors[i]);
+    m_index.emplace(m_detectors[i], i);
+    m_nominalBits[i] = load_matrix(det.nominal().detectorTransformation(),
+                                   &m_nominal[i*MSIZE], &m_nominalScale[i*3]);
+  }
+  m_detector.resize(num*MSIZE);
+  m_detectorScale.resize(num*3);
+  m_detectorBits.resize(num);
+  m_world.resize(num*MSIZE);
+  m_worldScale.resize(num*3);
+  m_worldBits.resize(num);
+  m_deltas.resize(num);
+  m_state.resize(num, 0);
+  printout(DEBUG,"AlignmentsCalculator","Hierarchy: %s: %ld detector elements in %ld levels.",
+           top.path().c_str(), num, numLevels());
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+AlignmentsCalculator::Hierarchy::~Hierarchy()   {
+  InstanceCount::decrement(this);
+}
+
+/// Compute the alignment conditions level by level using a compiled hierarchy
+Result AlignmentsCalculator::compute(Hierarchy& h,
+                                     const OrderedDeltas& deltas,
+                                     ConditionsMap& alignments,
+                                     bool incremental)  const
+{
+  Result result;
+  const std::size_t num = h.size();
+  std::vector<const Delta*>  element_deltas(num, nullptr);
+  std::vector<unsigned char> state(num, 0);
+  Sweeper sweep(h.threads);
+
+  for( const auto& d : deltas )   {
+    auto i = h.m_index.find(d.first.ptr());
+    if ( i == h.m_index.end() )   {
+      printout(ERROR,"AlignmentsCalculator","Delta of %s is outside the hierarchy of %s.",
+               d.first.path().c_str(), h.m_top.path().c_str());
+      ++result.missing;
+      continue;
+    }
+    element_deltas[i->second] = d.second;
+  }
+  incremental = incremental && h.m_valid;
+
+  // 1rst pass: Find the elements to be (re-)computed and compute the detector transformations.
+  // Elements with a parent outside the computed set start from the parent alignment
+  // in the conditions map or from the nominal parent transformation.
+  for( std::size_t i = 0; i < num; ++i )   {
+    long          p  = h.m_parents[i];
+    unsigned char st = element_deltas[i] ? (ACTIVE|DELTA) : 0;
+    if ( p >= 0 && (state[p]&ACTIVE) ) st |= ACTIVE;
+    if ( !(st&ACTIVE) )   {
+      continue;
+    }
+    bool dirty = !incremental || (p >= 0 && (state[p]&DIRTY)) ||
+      (h.m_state[i]&(ACTIVE|DELTA)) != (st&(ACTIVE|DELTA)) ||
+      ((st&DELTA) && !same_delta(h.m_deltas[i], *element_deltas[i]));
+    if ( p < 0 || !(state[p]&ACTIVE) )   {
+      DetElement det(h.m_detectors[i]), parent_det = det.parent();
+      AlignmentCondition parent_cond = parent_det.isValid()
+        ? alignments.get(parent_det, Keys::alignmentKey) : Condition();
+      TGeoHMatrix parent_transform;
+      if ( parent_cond.isValid() )
+        parent_transform = parent_cond.data().worldTrafo;
+      else if ( parent_det.isValid() )
+        parent_transform = parent_det.nominal().worldTransformation();
+      auto ext = h.m_external.find(i);
+      if ( ext == h.m_external.end() )   {
+        h.m_external.emplace(i, parent_transform);
+        dirty = true;
+      }
+      else if ( dirty || !same_matrix(ext->second, parent_transform) )   {
+        ext->second = parent_transform;
+        dirty = true;
+      }
+      st |= EXTERNAL;
+    }
+    if ( dirty )   {
+      double*       m  = &h.m_detector[i*MSIZE];
+      double*       s  = &h.m_detectorScale[i*3];
+      if ( st&DELTA )   {
+        TGeoHMatrix transform_for_delta;
+        element_deltas[i]->computeMatrix(transform_for_delta);
+        h.m_detectorBits[i] = load_matrix(DetElement(h.m_detectors[i]).nominal().detectorTransformation() *
+                                          transform_for_delta, m, s);
+        h.m_deltas[i] = *element_deltas[i];
+      }
+      else   {
+        std::copy(&h.m_nominal[i*MSIZE], &h.m_nominal[i*MSIZE]+MSIZE, m);
+        std::copy(&h.m_nominalScale[i*3], &h.m_nominalScale[i*3]+3, s);
+        h.m_detectorBits[i] = h.m_nominalBits[i];
+        h.m_deltas[i] = identity_delta;
+      }
+      st |= DIRTY;
+      ++result.computed;
+      result.multiply += 5;
+    }
+    state[i] = st;
+  }
+
+  // 2nd pass: World transformations level by level.
+  // The elements of one level only depend on the previous level.
+  auto world = [&h, &state](std::size_t begin, std::size_t end)   {
+    double pm[MSIZE], ps[3];
+    for( std::size_t i = begin; i < end; ++i )   {
+      unsigned char st = state[i];
+      if ( !(st&DIRTY) ) continue;
+      const double* l  = pm;
+      const double* ls = ps;
+      unsigned int  lb = 0;
+      if ( st&EXTERNAL )   {
+        lb = load_matrix(h.m_external.at(i), pm, ps);
+      }
+      else   {
+        long p = h.m_parents[i];
+        l  = &h.m_world[p*MSIZE];
+        ls = &h.m_worldScale[p*3];
+        lb = h.m_worldBits[p];
+      }
+      h.m_worldBits[i] = multiply(l, ls, lb,
+                                  &h.m_detector[i*MSIZE], &h.m_detectorScale[i*3], h.m_detectorBits[i],
+                                  &h.m_world[i*MSIZE], &h.m_worldScale[i*3]);
+    }
+  };
+  for( std::size_t level = 0; level+1 < h.m_levels.size(); ++level )
+    sweep(h.m_levels[level], h.m_levels[level+1], world);
+
+  // 3rd pass: Update the alignment conditions.
+  // Conditions are looked up and created sequentially, the data are filled in parallel.
+  std::vector<std::pair<std::size_t,AlignmentCondition::Object*> > work;
+  std::vector<std::pair<std::size_t,AlignmentCondition> > created;
+  work.reserve(result.computed);
+  for( std::size_t i = 0; i < num; ++i )   {
+    unsigned char st = state[i];
+    if ( !(st&ACTIVE) ) continue;
+    DetElement det(h.m_detectors[i]);
+    AlignmentCondition c = alignments.get(det, Keys::alignmentKey);
+    if ( !(st&DIRTY) )   {
+      if ( c.isValid() ) continue;
+      ++result.reused;
+    }
+    if ( c.isValid() )   {
+      work.emplace_back(i, c.ptr());
+      continue;
+    }
+    AlignmentCondition cond(det.path()+"#alignment");
+    cond->flags |= Condition::ALIGNMENT_DERIVED;
+    cond->hash = ConditionKey(det,Keys::alignmentKey).hash;
+    work.emplace_back(i, cond.ptr());
+    created.emplace_back(i, cond);
+  }
+  auto fill = [&h, &work](std::size_t begin, std::size_t end)   {
+    for( std::size_t k = begin; k < end; ++k )   {
+      std::size_t    i     = work[k].first;
+      AlignmentData& align = AlignmentCondition(work[k].second).data();
+      align.delta = h.m_deltas[i];
+      store_matrix(&h.m_detector[i*MSIZE], &h.m_detectorScale[i*3], h.m_detectorBits[i], align.detectorTrafo);
+      store_matrix(&h.m_world[i*MSIZE], &h.m_worldScale[i*3], h.m_worldBits[i], align.worldTrafo);
+      align.trToWorld = detail::matrix::_transform(&align.worldTrafo);
+    }
+  };
+  sweep(0, work.size(), fill);
+  for( auto& c : created )
+    alignments.insert(DetElement(h.m_detectors[c.first]), Keys::alignmentKey, c.second);
+
+  for( std::size_t i = 0; i < num; ++i )
+    h.m_state[i] = state[i] & (ACTIVE|DELTA);
+  h.m_valid = true;
+  printout(DEBUG,"AlignmentsCalculator","Hierarchy %s: computed %ld, re-used %ld alignments [%s].",
+           h.m_top.path().c_str(), result.computed, result.reused, incremental ? "incremental" : "full");
+  return result;
+}
+
 /// Compute all alignment conditions of the internal dependency list
 Result AlignmentsCalculator::compute(const std::map<DetElement, Delta>& deltas,
                                      ConditionsMap& alignments)  const
@@ -12,15 +12,34 @@
 //==========================================================================
 
 // Framework include files
+#include <DD4hep/Path.h>
 #include <DD4hep/Printout.h>
+#include <DD4hep/Primitives.h>
+#include <DD4hep/DetectorLoad.h>
 #include <DD4hep/DD4hepRootPersistency.h>
 #include <DD4hep/detail/ObjectsInterna.h>
 #include <DD4hep/detail/SegmentationsInterna.h>
+#include <DD4hep/detail/DetectorInterna.h>
 
 // ROOT include files
 #include <TFile.h>
+#include <TROOT.h>
+#include <TNamed.h>
 #include <TTimeStamp.h>
+
+// C/C++ include files
+#include <set>
+#include <cstdio>
+#include <algorithm>
 #include <memory>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__APPLE__)
+#include <mach-o/dyld.h>
+#else
+#include <link.h>
+#endif
 
 ClassImp(DD4hepRootPersistency)
 
@@ -34,6 +53,47 @@ namespace {
     for(const auto& c : de.children())
       load_nominal_alignments(c.second);
   }
+
+  /// Name of the stamp object of a geometry snapshot
+  const char* s_snapshot_stamp   = "SnapshotStamp";
+  /// Name of the object holding the time to build the geometry from compact XML
+  const char* s_snapshot_build   = "SnapshotBuildTime";
+  /// Format version of the geometry snapshot
+  const int   s_snapshot_version = 2;
+
+  /// Normalized local file name without URI scheme
+  std::string local_file(const std::string& name)   {
+    Path path(name.substr(0,5) == "file:" ? name.substr(5) : name);
+    return path.normalize();
+  }
+
+  /// Loaded DD4hep plugin libraries: shared libraries with a component file next to them
+  std::set<std::string> plugin_libraries()   {
+    std::set<std::string> names, libraries;
+#if defined(__APPLE__)
+    for( uint32_t i = 0, n = ::_dyld_image_count(); i < n; ++i )
+      names.emplace(::_dyld_get_image_name(i));
+#else
+    ::dl_iterate_phdr([](struct dl_phdr_info* info, size_t, void* data)  {
+      if ( info->dlpi_name && info->dlpi_name[0] )
+        ((std::set<std::string>*)data)->emplace(info->dlpi_name);
+      return 0;
+    }, &names);
+#endif
+    for( const auto& name : names )   {
+      struct stat info;
+      std::size_t idx = name.find('.', name.rfind('/') == std::string::npos ? 0 : name.rfind('/'));
+      if ( idx != std::string::npos && ::stat((name.substr(0,idx)+".components").c_str(), &info) == 0 )
+        libraries.insert(name);
+    }
+    return libraries;
+  }
+
+  /// Read a named object of a snapshot file. Empty string if not present
+  std::string snapshot_object(TFile* file, const char* name)   {
+    std::unique_ptr<TNamed> obj((TNamed*)file->Get(name));
+    return obj ? obj->GetTitle() : "";
+  }
 }
 
 /// Default constructor
@@ -44,8 +104,10 @@ DD4hepRootPersistency::DD4hepRootPersistency() : TNamed() {
 DD4hepRootPersistency::~DD4hepRootPersistency() {
 }
 
-int DD4hepRootPersistency::save(Detector& description, const char* fname, const char* instance)   {
-  TFile* f = TFile::Open(fname,"RECREATE");
+int DD4hepRootPersistency::save(Detector& description, const char* fname, const char* instance, int compression)   {
+  TFile* f = compression < 0
+    ? TFile::Open(fname,"RECREATE")
+    : TFile::Open(fname,"RECREATE",instance,compression);
   if ( f && !f->IsZombie()) {
     try  {
       TTimeStamp start;
@@ -80,6 +142,14 @@ int DD4hepRootPersistency::save(Detector& description, const char* fname, const
       /// Now we write the object
       int nBytes = persist->Write(instance);
       f->Close();
+      /// The extensions were moved to the persistent copy: give them back
+      /// so that the detector description stays usable after saving.
+      DetectorData* src_data = dynamic_cast<DetectorData*>(&description);
+      if ( src_data )  {
+        src_data->m_extensions.move(persist->m_data->m_extensions);
+        World w = src_data->m_world;
+        w->description = &description;
+      }
       TTimeStamp stop;
       printout(ALWAYS,"DD4hepRootPersistency",
                "+++ Wrote %d Bytes of geometry data '%s' to '%s'  [%8.3f seconds].",
@@ -206,7 +276,119 @@ int DD4hepRootPersistency::load(Detector& description, const char* fname, const
   return 0;
 }
 
-#include <DD4hep/detail/DetectorInterna.h>
+/// Build the stamp of a geometry snapshot from the source files it depends on
+std::string DD4hepRootPersistency::snapshotStamp(const std::vector<std::string>& sources)   {
+  char text[256];
+  std::set<std::string> files;
+  std::snprintf(text, sizeof(text), "DD4hep-snapshot:%d DD4hep:%s ROOT:%d",
+                s_snapshot_version, versionString().c_str(), gROOT->GetVersionCode());
+  std::string stamp = text;
+  for( const auto& source : sources )   {
+    long long size = 0, mtime = 0;
+    std::string fn = local_file(source);
+    if ( !files.insert(fn).second )
+      continue;
+    if ( detail::file_status(fn, size, mtime) )
+      std::snprintf(text, sizeof(text), " [size:%lld mtime:%lld.%09lld]",
+                    size, mtime/1000000000LL, mtime%1000000000LL);
+    else
+      std::snprintf(text, sizeof(text), " [missing]");
+    stamp += "\n" + fn + text;
+  }
+  return stamp;
+}
+
+/// Save a geometry snapshot: uncompressed and stamped with the source files
+int DD4hepRootPersistency::saveSnapshot(Detector& description, const char* fname,
+                                        const std::vector<std::string>& sources,
+                                        double build_seconds)
+{
+  std::vector<std::string> stamped(sources);
+  // All xml files processed by the parsers including the <include> documents
+  if ( const auto* files = description.extension<DetectorSourceFiles>(false) )
+    stamped.insert(stamped.end(), files->begin(), files->end());
+  // A rebuilt detector constructor invalidates the snapshot
+  for( const auto& lib : plugin_libraries() )
+    stamped.emplace_back(lib);
+
+  std::string stamp = snapshotStamp(stamped);
+  std::string tmp   = std::string(fname) + "." + std::to_string(::getpid());
+  // Uncompressed: the snapshot is read by every job, decompression dominates the load time
+  int nBytes = save(description, tmp.c_str(), "Geometry", 0);
+  if ( nBytes > 0 )   {
+    std::unique_ptr<TFile> f(TFile::Open(tmp.c_str(),"UPDATE"));
+    if ( f && !f->IsZombie() )   {
+      TNamed obj(s_snapshot_stamp, stamp.c_str());
+      TNamed build(s_snapshot_build, std::to_string(build_seconds).c_str());
+      nBytes += obj.Write(s_snapshot_stamp);
+      nBytes += build.Write(s_snapshot_build);
+      f->Close();
+      if ( std::rename(tmp.c_str(), fname) == 0 )   {
+        printout(ALWAYS,"DD4hepRootPersistency","+++ Saved geometry snapshot %s [%ld source files]",
+                 fname, long(std::count(stamp.begin(), stamp.end(), '\n')));
+        return nBytes;
+      }
+    }
+  }
+  std::remove(tmp.c_str());
+  printout(ERROR,"DD4hepRootPersistency","+++ Failed to save geometry snapshot %s",fname);
+  return 0;
+}
+
+/// Load a geometry snapshot if it is up to date with respect to the source files
+int DD4hepRootPersistency::loadSnapshot(Detector& description, const char* fname, const std::vector<std::string>& sources)   {
+  struct stat info;
+  if ( ::stat(fname, &info) != 0 )   {
+    printout(INFO,"DD4hepRootPersistency","+++ No geometry snapshot %s present.",fname);
+    return 0;
+  }
+  std::string stamp;
+  {
+    std::unique_ptr<TFile> f(TFile::Open(fname));
+    if ( f && !f->IsZombie() )   {
+      stamp = snapshot_object(f.get(), s_snapshot_stamp);
+      f->Close();
+    }
+  }
+  // The stamp lists every file the snapshot was built from: one per line after the header
+  std::string line;
+  std::set<std::string> stamped;
+  std::vector<std::string> files;
+  std::istringstream lines(stamp);
+  std::getline(lines, line);
+  while( std::getline(lines, line) )   {
+    files.emplace_back(line.substr(0, line.rfind(" [")));
+    stamped.insert(files.back());
+  }
+  const char* reason = nullptr;
+  for( const auto& source : sources )   {
+    if ( !stamped.count(local_file(source)) )   {
+      printout(INFO,"DD4hepRootPersistency","+++ Geometry snapshot %s does not depend on %s.",
+               fname, source.c_str());
+      reason = "incomplete";
+    }
+  }
+  if ( !reason && (stamp.empty() || stamp != snapshotStamp(files)) )
+    reason = "outdated";
+  if ( reason )   {
+    printout(INFO,"DD4hepRootPersistency","+++ Geometry snapshot %s is %s.",fname,reason);
+    printout(DEBUG,"DD4hepRootPersistency","+++ Snapshot stamp: %s",stamp.c_str());
+    return 0;
+  }
+  return load(description, fname, "Geometry");
+}
+
+/// Access the time needed to build the geometry of a snapshot from compact XML
+double DD4hepRootPersistency::snapshotBuildTime(const char* fname)   {
+  std::unique_ptr<TFile> f(TFile::Open(fname));
+  if ( f && !f->IsZombie() )   {
+    std::string value = snapshot_object(f.get(), s_snapshot_build);
+    f->Close();
+    return value.empty() ? 0e0 : std::stod(value);
+  }
+  return 0e0;
+}
+
 #include <DD4hep/detail/ConditionsInterna.h>
 #include <DD4hep/detail/AlignmentsInterna.h>
 
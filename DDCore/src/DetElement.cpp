@@ -71,6 +71,11 @@ void* DetElement::extension(unsigned long long int k, bool alert) const {
   return access()->extension(k, alert);
 }
 
+/// Access an existing extension object by the dense slot of the extension type
+void* DetElement::extension(std::size_t slot, unsigned long long int k, bool alert) const {
+  return access()->extension(slot, k, alert);
+}
+
 /// Internal call to extend the detector element with an arbitrary structure accessible by the type
 void DetElement::i_addUpdateCall(unsigned int callback_type, const Callback& callback)  const  {
   access()->updateCalls.emplace_back(callback,callback_type);
@@ -509,3 +514,8 @@ void* SensitiveDetector::extension(unsigned long long int k) const {
 void* SensitiveDetector::extension(unsigned long long int k, bool alert) const {
   return access()->extension(k, alert);
 }
+
+/// Access an existing extension object by the dense slot of the extension type
+void* SensitiveDetector::extension(std::size_t slot, unsigned long long int k, bool alert) const {
+  return access()->extension(slot, k, alert);
+}
@@ -16,6 +16,7 @@
 #include <DD4hep/Detector.h>
 #include <DD4hep/Printout.h>
 #include <DD4hep/Plugins.h>
+#include <DD4hep/Path.h>
 #include <XML/XMLElements.h>
 #include <XML/DocumentHandler.h>
 
@@ -45,11 +46,23 @@ DetectorLoad::DetectorLoad(Detector& description) : m_detDesc(&description)  {
 DetectorLoad::~DetectorLoad() {
 }
 
+/// Record a processed file of the detector description
+void DetectorSourceFiles::add(Detector& description, const std::string& file_name)   {
+  DetectorSourceFiles* files = description.extension<DetectorSourceFiles>(false);
+  if ( !files )  {
+    files = new DetectorSourceFiles();
+    description.addExtension<DetectorSourceFiles>(files);
+  }
+  Path path(file_name.substr(0,5) == "file:" ? file_name.substr(5) : file_name);
+  files->insert(path.normalize());
+}
+
 /// Process XML unit and adopt all data from source structure.
 void DetectorLoad::processXML(const std::string& xmlfile, xml::UriReader* entity_resolver) {
   try {
     xml::DocumentHolder doc(xml::DocumentHandler().load(xmlfile,entity_resolver));
     if ( doc )   {
+      DetectorSourceFiles::add(*m_detDesc, doc.uri());
       xml::Handle_t handle = doc.root();
       if ( handle )   {
         processXMLElement(xmlfile,handle);
@@ -75,6 +88,7 @@ void DetectorLoad::processXML(const xml::Handle_t& base, const std::string& xmlf
     xml::Strng_t xml(xmlfile);
     xml::DocumentHolder doc(xml::DocumentHandler().load(base,xml,entity_resolver));
     if ( doc )   {
+      DetectorSourceFiles::add(*m_detDesc, doc.uri());
       xml::Handle_t handle = doc.root();
       if ( handle )   {
         processXMLElement(xmlfile,handle);
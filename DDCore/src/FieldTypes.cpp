@@ -12,8 +12,27 @@
 //==========================================================================
 
 #include <DD4hep/FieldTypes.h>
+#include <DD4hep/Printout.h>
 #include <DD4hep/detail/Handle.inl>
+
+// ROOT include files
+#include <TGeoBBox.h>
+
+// C/C++ include files
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
 #include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <mutex>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 using namespace dd4hep;
 
@@ -36,6 +55,7 @@ DD4HEP_INSTANTIATE_HANDLE(ConstantField);
 DD4HEP_INSTANTIATE_HANDLE(SolenoidField);
 DD4HEP_INSTANTIATE_HANDLE(DipoleField);
 DD4HEP_INSTANTIATE_HANDLE(MultipoleField);
+DD4HEP_INSTANTIATE_HANDLE(FieldMap);
 
 /// Compute  the field components at a given location and add to given field
 void ConstantField::fieldComponents(const double* /* pos */, double* field) {
@@ -44,6 +64,14 @@ void ConstantField::fieldComponents(const double* /* pos */, double* field) {
   field[2] += direction.Z();
 }
 
+/// The field is independent of the position
+bool ConstantField::constantField(double* field)  const   {
+  field[0] = direction.X();
+  field[1] = direction.Y();
+  field[2] = direction.Z();
+  return true;
+}
+
 /// Initializing constructor
 SolenoidField::SolenoidField()
   : innerField(0), outerField(0), minZ(-INFINITY), maxZ(INFINITY), innerRadius(0), outerRadius(INFINITY)
@@ -64,6 +92,15 @@ void SolenoidField::fieldComponents(const double* pos, double* field) {
   }
 }
 
+/// Bounding box of the field region
+bool SolenoidField::fieldRegion(double* lower, double* upper)  const   {
+  lower[0] = lower[1] = -outerRadius;
+  upper[0] = upper[1] =  outerRadius;
+  lower[2] = minZ;
+  upper[2] = maxZ;
+  return true;
+}
+
 /// Initializing constructor
 DipoleField::DipoleField() : zmax(INFINITY), zmin(-INFINITY), rmax(INFINITY) {
   field_type = CartesianField::MAGNETIC;
@@ -90,6 +127,15 @@ void DipoleField::fieldComponents(const double* pos, double* field) {
   }
 }
 
+/// Bounding box of the field region
+bool DipoleField::fieldRegion(double* lower, double* upper)  const   {
+  lower[0] = lower[1] = -rmax;
+  upper[0] = upper[1] =  rmax;
+  lower[2] = zmin;
+  upper[2] = zmax;
+  return true;
+}
+
 namespace   {
   constexpr static unsigned char FIELD_INITIALIZED   = 1<<0;
   constexpr static unsigned char FIELD_IDENTITY      = 1<<1;
@@ -166,3 +212,336 @@ void MultipoleField::fieldComponents(const double* pos, double* field) {
     field[2] += f.Z();
   }
 }
+
+/// Bounding box of the field region
+bool MultipoleField::fieldRegion(double* lower, double* upper)  const   {
+  const TGeoBBox* box = dynamic_cast<const TGeoBBox*>(volume.ptr());
+  if ( !box )  {
+    return false;
+  }
+  const double* o = box->GetOrigin();
+  double d[3] = { box->GetDX(), box->GetDY(), box->GetDZ() };
+  for( int i = 0; i < 3; ++i )  {
+    lower[i] =  std::numeric_limits<double>::max();
+    upper[i] = -std::numeric_limits<double>::max();
+  }
+  // The corners of the boundary volume in the global frame
+  for( int c = 0; c < 8; ++c )  {
+    Transform3D::Point p = transform * Transform3D::Point(o[0] + ((c&4) ? d[0] : -d[0]),
+                                                          o[1] + ((c&2) ? d[1] : -d[1]),
+                                                          o[2] + ((c&1) ? d[2] : -d[2]));
+    double q[3] = { p.X(), p.Y(), p.Z() };
+    for( int i = 0; i < 3; ++i )  {
+      lower[i] = std::min(lower[i], q[i]);
+      upper[i] = std::max(upper[i], q[i]);
+    }
+  }
+  return true;
+}
+
+/// Shared memory mapping of a field map file
+/**
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \ingroup DD4HEP_CORE
+ */
+class FieldMap::Mapping  {
+public:
+  /// File name
+  std::string path;
+  /// Start address of the mapping
+  void*       address { nullptr };
+  /// Length of the mapping in bytes
+  std::size_t length  { 0 };
+public:
+  /// Initializing constructor: map the file read-only
+  Mapping(const std::string& file_name) : path(file_name)  {
+    struct stat st;
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if ( fd < 0 )  {
+      except("FieldMap","+++ Failed to open field map file %s [%s]",
+             path.c_str(), std::strerror(errno));
+    }
+    if ( ::fstat(fd, &st) != 0 || std::size_t(st.st_size) < sizeof(header_t) )  {
+      ::close(fd);
+      except("FieldMap","+++ Invalid field map file %s [No header present]", path.c_str());
+    }
+    length  = std::size_t(st.st_size);
+    address = ::mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if ( address == MAP_FAILED )  {
+      address = nullptr;
+      except("FieldMap","+++ Failed to map field map file %s [%s]",
+             path.c_str(), std::strerror(errno));
+    }
+  }
+  /// Default destructor: unmap the file
+  ~Mapping()  {
+    if ( address ) ::munmap(address, length);
+  }
+  /// Access the file header
+  const header_t* header()  const  {
+    return static_cast<const header_t*>(address);
+  }
+  /// Access the field values following the header
+  const float* values()  const  {
+    return reinterpret_cast<const float*>(static_cast<const char*>(address) + sizeof(header_t));
+  }
+};
+
+namespace   {
+  /// Identifier of the field map file format
+  constexpr static char         FIELDMAP_MAGIC[8] = "DD4FMAP";
+  constexpr static unsigned int FIELDMAP_VERSION  = 1;
+
+  /// Registry of the mapped field map files
+  std::mutex s_mapping_lock;
+  std::map<std::string, std::weak_ptr<FieldMap::Mapping> > s_mappings;
+  /// Source of unique field map identifiers
+  std::atomic<unsigned long> s_fieldmap_id { 0 };
+
+  /// Per-thread cache of the corner values of the last accessed grid cell
+  struct cell_cache_t  {
+    unsigned long id    { 0 };
+    long          cell  { -1 };
+    double        value[8][3];
+  };
+  thread_local cell_cache_t s_cell_cache;
+
+  /// Access the shared mapping of a field map file
+  std::shared_ptr<FieldMap::Mapping> map_file(const std::string& file_name)   {
+    std::lock_guard<std::mutex> lock(s_mapping_lock);
+    auto& entry = s_mappings[file_name];
+    std::shared_ptr<FieldMap::Mapping> mapping = entry.lock();
+    if ( !mapping )  {
+      mapping = std::make_shared<FieldMap::Mapping>(file_name);
+      entry = mapping;
+    }
+    return mapping;
+  }
+
+  /// Check the header of a mapped field map file
+  const FieldMap::header_t* check_mapping(const std::string& file_name, const FieldMap::Mapping& mapping)   {
+    const FieldMap::header_t* hdr = mapping.header();
+    if ( 0 != std::memcmp(hdr->magic, FIELDMAP_MAGIC, sizeof(hdr->magic)) )  {
+      except("FieldMap","+++ %s is no field map file [Invalid magic word]", file_name.c_str());
+    }
+    if ( hdr->version != FIELDMAP_VERSION )  {
+      except("FieldMap","+++ %s: Unsupported field map version %u", file_name.c_str(), hdr->version);
+    }
+    if ( hdr->grid < FieldMap::CARTESIAN || hdr->grid > FieldMap::CYLINDRICAL_RPHIZ )  {
+      except("FieldMap","+++ %s: Unknown grid type %u", file_name.c_str(), hdr->grid);
+    }
+    if ( hdr->grid == FieldMap::CYLINDRICAL_RZ && hdr->num[1] != 1 )  {
+      except("FieldMap","+++ %s: (r,z) field maps must have exactly one phi bin", file_name.c_str());
+    }
+    std::size_t points = 1;
+    for( int i = 0; i < 3; ++i )  {
+      if ( hdr->num[i] < 1 || (hdr->num[i] > 1 && !(hdr->step[i] > 0e0)) )  {
+        except("FieldMap","+++ %s: Invalid grid definition of axis %d: %d points, step %g",
+               file_name.c_str(), i, hdr->num[i], hdr->step[i]);
+      }
+      points *= std::size_t(hdr->num[i]);
+    }
+    if ( mapping.length < sizeof(FieldMap::header_t) + 3*points*sizeof(float) )  {
+      except("FieldMap","+++ %s: File too short for %ld grid points", file_name.c_str(), long(points));
+    }
+    return hdr;
+  }
+}
+
+/// Initializing constructor
+FieldMap::FieldMap() : m_id(++s_fieldmap_id)  {
+  field_type = CartesianField::MAGNETIC;
+}
+
+/// Default destructor
+FieldMap::~FieldMap()  {
+}
+
+/// Load the field map from file. Grid lengths are scaled by length_unit
+void FieldMap::load(const std::string& file_name, double length_unit)   {
+  std::shared_ptr<Mapping> mapping = map_file(file_name);
+  const header_t* hdr = check_mapping(file_name, *mapping);
+  file = file_name;
+  grid = int(hdr->grid);
+  for( int i = 0; i < 3; ++i )  {
+    // Only the phi axis of cylindrical maps is no length
+    double unit = (i == 1 && grid != CARTESIAN) ? 1e0 : length_unit;
+    num[i]  = hdr->num[i];
+    min[i]  = hdr->min[i] * unit;
+    step[i] = hdr->step[i] * unit;
+    m_invStep[i] = num[i] > 1 ? 1e0/step[i] : 0e0;
+  }
+  m_stride[2] = 1;
+  m_stride[1] = num[2];
+  m_stride[0] = long(num[1]) * num[2];
+  m_mapping = std::move(mapping);
+  m_values.store(m_mapping->values(), std::memory_order_release);
+  printout(DEBUG,"FieldMap","+++ Loaded field map %s: grid type %d with %d x %d x %d points.",
+           file.c_str(), grid, num[0], num[1], num[2]);
+}
+
+/// Map the file of a field map read with ROOT I/O. Throws if the file does not match
+const float* FieldMap::attach()  const   {
+  static std::mutex s_attach_lock;
+  std::lock_guard<std::mutex> lock(s_attach_lock);
+  const float* values = m_values.load(std::memory_order_relaxed);
+  if ( !values )  {
+    if ( file.empty() )  {
+      except("FieldMap","+++ Field map without values: no field map file was loaded.");
+    }
+    std::shared_ptr<Mapping> mapping = map_file(file);
+    const header_t* hdr = check_mapping(file, *mapping);
+    if ( int(hdr->grid) != grid || hdr->num[0] != num[0] || hdr->num[1] != num[1] || hdr->num[2] != num[2] )  {
+      except("FieldMap","+++ %s: The grid of the file differs from the grid of the stored field map.",
+             file.c_str());
+    }
+    m_mapping = std::move(mapping);
+    values    = m_mapping->values();
+    // Release: the mapping is visible to all threads which see the pointer
+    m_values.store(values, std::memory_order_release);
+    printout(DEBUG,"FieldMap","+++ Mapped field map %s of the stored geometry.", file.c_str());
+  }
+  return values;
+}
+
+/// Write field map file. The values array holds 3 floats per grid point
+void FieldMap::save(const std::string& file_name, const header_t& header, const float* values)   {
+  header_t hdr = header;
+  std::memcpy(hdr.magic, FIELDMAP_MAGIC, sizeof(hdr.magic));
+  hdr.version = FIELDMAP_VERSION;
+  std::size_t points = std::size_t(hdr.num[0]) * hdr.num[1] * hdr.num[2];
+  std::ofstream out(file_name, std::ios::binary|std::ios::trunc);
+  out.write(reinterpret_cast<const char*>(&hdr), sizeof(hdr));
+  out.write(reinterpret_cast<const char*>(values), 3*points*sizeof(float));
+  if ( !out.good() )  {
+    except("FieldMap","+++ Failed to write field map file %s", file_name.c_str());
+  }
+}
+
+/// Compute  the field components at a given location and add to given field
+void FieldMap::fieldComponents(const double* pos, double* field) {
+  double u[3], cos_phi = 1e0, sin_phi = 0e0;
+  if ( grid == CARTESIAN )  {
+    u[0] = pos[0];
+    u[1] = pos[1];
+    u[2] = pos[2];
+  }
+  else  {
+    double r = std::sqrt(pos[0]*pos[0] + pos[1]*pos[1]);
+    if ( r > 0e0 )  {
+      cos_phi = pos[0]/r;
+      sin_phi = pos[1]/r;
+    }
+    u[0] = r;
+    u[1] = grid == CYLINDRICAL_RPHIZ ? std::atan2(pos[1], pos[0]) : 0e0;
+    u[2] = pos[2];
+  }
+  // Fold the point into the mapped region
+  unsigned char sign = 0;
+  if ( mirror )  {
+    for( int i = 0; i < 3; ++i )  {
+      if ( (mirror & (1<<i)) && u[i] < 0e0 )  {
+        u[i] = -u[i];
+        sign ^= flip[i];
+      }
+    }
+  }
+  if ( periodic )  {
+    double period = num[1]*step[1];
+    double phi = std::fmod(u[1] - min[1], period);
+    u[1] = min[1] + (phi < 0e0 ? phi + period : phi);
+  }
+  // Locate the grid cell
+  long   cell = 0, next[3];
+  double t[3];
+  for( int i = 0; i < 3; ++i )  {
+    if ( num[i] == 1 )  {
+      t[i] = 0e0;
+      next[i] = 0;
+      continue;
+    }
+    double f = (u[i] - min[i]) * m_invStep[i];
+    long   k;
+    if ( i == 1 && periodic )  {
+      k = std::min(long(f), long(num[1]-1));
+      next[i] = k+1 < num[1] ? m_stride[1] : -k*m_stride[1];
+    }
+    else if ( f >= 0e0 && f <= double(num[i]-1) )  {
+      k = std::min(long(f), long(num[i]-2));
+      next[i] = m_stride[i];
+    }
+    else  {
+      return;   // Outside the mapped region
+    }
+    t[i] = f - double(k);
+    cell += k*m_stride[i];
+  }
+  // Load the corner values unless the cell is the same as the previous one
+  cell_cache_t& cache = s_cell_cache;
+  if ( cache.id != m_id || cache.cell != cell )  {
+    const float* data = values();
+    for( int c = 0; c < 8; ++c )  {
+      long idx = cell + ((c&4) ? next[0] : 0) + ((c&2) ? next[1] : 0) + ((c&1) ? next[2] : 0);
+      const float* v = data + 3*idx;
+      cache.value[c][0] = v[0];
+      cache.value[c][1] = v[1];
+      cache.value[c][2] = v[2];
+    }
+    cache.id   = m_id;
+    cache.cell = cell;
+  }
+  // Trilinear interpolation
+  double b[3];
+  const double (*v)[3] = cache.value;
+  for( int i = 0; i < 3; ++i )  {
+    double c00 = v[0][i] + (v[1][i] - v[0][i]) * t[2];
+    double c01 = v[2][i] + (v[3][i] - v[2][i]) * t[2];
+    double c10 = v[4][i] + (v[5][i] - v[4][i]) * t[2];
+    double c11 = v[6][i] + (v[7][i] - v[6][i]) * t[2];
+    double c0  = c00 + (c01 - c00) * t[1];
+    double c1  = c10 + (c11 - c10) * t[1];
+    b[i] = (c0 + (c1 - c0) * t[0]) * scale;
+    if ( sign & (1<<i) ) b[i] = -b[i];
+  }
+  if ( grid == CARTESIAN )  {
+    field[0] += b[0];
+    field[1] += b[1];
+  }
+  else  {
+    field[0] += b[0]*cos_phi - b[1]*sin_phi;
+    field[1] += b[0]*sin_phi + b[1]*cos_phi;
+  }
+  field[2] += b[2];
+}
+
+/// Bounding box of the mapped region including the symmetry folding
+bool FieldMap::fieldRegion(double* lower, double* upper)  const   {
+  double lo[3], hi[3];
+  for( int i = 0; i < 3; ++i )  {
+    lo[i] = min[i];
+    hi[i] = min[i] + (num[i]-1) * step[i];
+    if ( num[i] == 1 )  {          // Field independent of this coordinate
+      lo[i] = -std::numeric_limits<double>::infinity();
+      hi[i] =  std::numeric_limits<double>::infinity();
+    }
+    else if ( mirror & (1<<i) )  {
+      hi[i] = std::max(std::abs(lo[i]), std::abs(hi[i]));
+      lo[i] = -hi[i];
+    }
+  }
+  if ( grid == CARTESIAN )  {
+    for( int i = 0; i < 3; ++i )  {
+      lower[i] = lo[i];
+      upper[i] = hi[i];
+    }
+  }
+  else  {
+    lower[0] = lower[1] = -hi[0];
+    upper[0] = upper[1] =  hi[0];
+    lower[2] = lo[2];
+    upper[2] = hi[2];
+  }
+  return true;
+}
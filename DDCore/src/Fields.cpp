@@ -42,6 +42,16 @@ CartesianField::Object::~Object() {
   InstanceCount::decrement(this);
 }
 
+/// Supply the axis aligned box outside of which the field vanishes (default: unbounded)
+bool CartesianField::Object::fieldRegion(double* /* lower */, double* /* upper */)  const   {
+  return false;
+}
+
+/// Supply the field vector of fields independent of the position (default: none)
+bool CartesianField::Object::constantField(double* /* field */)  const   {
+  return false;
+}
+
 /// Access the field type (string)
 const char* CartesianField::type() const {
   return m_element->GetTitle();
@@ -170,3 +180,62 @@ void OverlayedField::electromagneticField(const Position& pos, double* field) co
   calculate_combined_field(o->electric_components, pos, field);
   calculate_combined_field(o->magnetic_components, pos, field + 3);
 }
+
+/// Initializing constructor from the electric or magnetic components of an overlay
+CompiledField::CompiledField(OverlayedField field, int type)   {
+  if ( !field.isValid() )  {
+    except("CompiledField","Attempt to compile an invalid overlay field.");
+  }
+  const auto* obj = field.data<OverlayedField::Object>();
+  const auto& fields = type == OverlayedField::ELECTRIC ? obj->electric_components : obj->magnetic_components;
+  for ( const auto& f : fields )   {
+    auto*  o = f.data<CartesianField::Object>();
+    double value[3] = { 0e0, 0e0, 0e0 };
+    if ( o->constantField(value) )   {
+      m_offset[0] += value[0];
+      m_offset[1] += value[1];
+      m_offset[2] += value[2];
+      ++m_constants;
+      continue;
+    }
+    Component c;
+    c.object  = o;
+    c.bounded = o->fieldRegion(c.lower, c.upper);
+    m_components.emplace_back(c);
+  }
+}
+
+namespace {
+  inline bool inside(const CompiledField::Component& c, const double* p)   {
+    return p[0] >= c.lower[0] && p[0] <= c.upper[0] &&
+      p[1] >= c.lower[1] && p[1] <= c.upper[1] &&
+      p[2] >= c.lower[2] && p[2] <= c.upper[2];
+  }
+}
+
+/// Add the field components at a given location to the field vector
+void CompiledField::fieldComponents(const double* pos, double* field)  const   {
+  field[0] += m_offset[0];
+  field[1] += m_offset[1];
+  field[2] += m_offset[2];
+  for ( const auto& c : m_components )   {
+    if ( !c.bounded || inside(c, pos) )
+      c.object->fieldComponents(pos, field);
+  }
+}
+
+/// Add the field components of n points (pos[3*n]) to the field vectors (field[3*n])
+void CompiledField::fieldComponents(std::size_t n, const double* pos, double* field)  const   {
+  for ( std::size_t i = 0; i < 3*n; i += 3 )  {
+    field[i]   += m_offset[0];
+    field[i+1] += m_offset[1];
+    field[i+2] += m_offset[2];
+  }
+  // Component major loop: one component is evaluated for all points at once
+  for ( const auto& c : m_components )   {
+    for ( std::size_t i = 0; i < 3*n; i += 3 )  {
+      if ( !c.bounded || inside(c, pos+i) )
+        c.object->fieldComponents(pos+i, field+i);
+    }
+  }
+}
@@ -60,9 +60,13 @@ namespace dd4hep  {
   }
 
   std::pair<int, double> _toFloatingPoint(const std::string& value)   {
-    std::stringstream err;
-    auto result = eval.evaluate(value, err);
-    check_evaluation(value, result, err);
+    auto result = eval.evaluate(value);
+    if ( result.first != tools::Evaluator::OK )   {
+      // Error stream only required to report the failure
+      std::stringstream err;
+      result = eval.evaluate(value, err);
+      check_evaluation(value, result, err);
+    }
     return result;
   }
 
@@ -17,6 +17,11 @@
 #include <DD4hep/Primitives.h>
 #include <DD4hep/Printout.h>
 
+// C/C++ include files
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
 using namespace dd4hep;
 
 #define EXTENSION_DEBUG 0
@@ -26,6 +31,87 @@ namespace {
     ObjectExtensions* o = (ObjectExtensions*)ptr;
     return typeName(typeid(*o));
   }
+
+  /// Registry of the extension types with a dense slot
+  struct slot_registry_t  {
+    std::mutex         lock;
+    /// Number of assigned slots
+    std::atomic<std::size_t>  count    { 0 };
+    /// Type keys of the slots
+    unsigned long long int    keys[ObjectExtensions::MAX_SLOTS];
+    /// Type names of the slots (if known)
+    std::string               names[ObjectExtensions::MAX_SLOTS];
+    /// Lookup counters of the slots
+    std::atomic<long>         lookups[ObjectExtensions::MAX_SLOTS];
+    /// Lookup counter by type key without slot
+    std::atomic<long>         other    { 0 };
+    /// Flag to enable the lookup statistics
+    std::atomic<bool>         statistics { false };
+
+    slot_registry_t()  {
+      for( auto& l : lookups ) l = 0;
+    }
+    /// Find the slot of an extension type. Requires the lock
+    std::size_t find(unsigned long long int key)  const  {
+      for( std::size_t i = 0, n = count; i < n; ++i )
+        if ( keys[i] == key ) return i;
+      return ObjectExtensions::NO_SLOT;
+    }
+  };
+  slot_registry_t& slot_registry()  {
+    static slot_registry_t s_registry;
+    return s_registry;
+  }
+  /// Count an extension lookup if the statistics are enabled
+  inline void count_lookup(std::size_t idx)  {
+    slot_registry_t& reg = slot_registry();
+    if ( reg.statistics.load(std::memory_order_relaxed) )  {
+      (idx < ObjectExtensions::MAX_SLOTS ? reg.lookups[idx] : reg.other).fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}
+
+/// Access the dense slot of an extension type. Assigned at first use
+std::size_t ObjectExtensions::slot(unsigned long long int key, const std::type_info& type)   {
+  slot_registry_t& reg = slot_registry();
+  std::lock_guard<std::mutex> lock(reg.lock);
+  std::size_t idx = reg.find(key);
+  if ( idx == NO_SLOT && reg.count < MAX_SLOTS )  {
+    idx = reg.count;
+    reg.keys[idx] = key;
+    reg.count = idx + 1;
+  }
+  if ( idx != NO_SLOT && reg.names[idx].empty() && type != typeid(void) )  {
+    reg.names[idx] = typeName(type);
+  }
+  return idx;
+}
+
+/// Access the dense slot of an extension type. Assigned at first use
+std::size_t ObjectExtensions::slot(unsigned long long int key)   {
+  return slot(key, typeid(void));
+}
+
+/// Enable or disable the lookup statistics per extension type
+void ObjectExtensions::enableStatistics(bool value)   {
+  slot_registry().statistics = value;
+}
+
+/// Print the lookup statistics per extension type
+void ObjectExtensions::printStatistics()   {
+  slot_registry_t& reg = slot_registry();
+  std::lock_guard<std::mutex> lock(reg.lock);
+  std::vector<std::size_t> order(reg.count);
+  for( std::size_t i = 0; i < order.size(); ++i ) order[i] = i;
+  std::sort(order.begin(), order.end(), [&reg](std::size_t a, std::size_t b)  {
+      return reg.lookups[a] > reg.lookups[b];  });
+  printout(ALWAYS,"ObjectExtensions","+++ Extension lookups [%ld types with slot, statistics %s]",
+           long(reg.count), reg.statistics ? "enabled" : "disabled");
+  for( std::size_t i : order )  {
+    printout(ALWAYS,"ObjectExtensions","+++ Slot %2ld %016llX  %12ld lookups  %s", long(i), reg.keys[i],
+             long(reg.lookups[i]), reg.names[i].empty() ? "(unknown type)" : reg.names[i].c_str());
+  }
+  printout(ALWAYS,"ObjectExtensions","+++ %12ld lookups by type key without slot", long(reg.other));
 }
 
 /// Default constructor
@@ -39,10 +125,21 @@ ObjectExtensions::~ObjectExtensions()   {
   InstanceCount::decrement(this);
 }
 
+/// Update the slot entry of an extension type
+void ObjectExtensions::setSlot(unsigned long long int key, ExtensionEntry* entry)   {
+  std::size_t idx = slot(key);
+  if ( idx != NO_SLOT )   {
+    if ( idx >= slots.size() ) slots.resize(idx+1, nullptr);
+    slots[idx] = entry;
+  }
+}
+
 /// Move extensions to target object
 void ObjectExtensions::move(ObjectExtensions& source)   {
   extensions = source.extensions;
+  slots = source.slots;
   source.extensions.clear();
+  source.slots.clear();
 }
 
 /// Internal object destructor: release extension object(s)
@@ -54,12 +151,15 @@ void ObjectExtensions::clear(bool destroy) {
     }
   }
   extensions.clear();
+  slots.clear();
 }
 
 /// Copy object extensions from another object
 void ObjectExtensions::copyFrom(const std::map<unsigned long long int,ExtensionEntry*>& ext, void* arg)  {
   for( const auto& i : ext )  {
-    extensions[i.first] = i.second->clone(arg);
+    ExtensionEntry* entry = i.second->clone(arg);
+    extensions[i.first] = entry;
+    setSlot(i.first, entry);
   }
 }
 
@@ -76,6 +176,7 @@ void* ObjectExtensions::addExtension(unsigned long long int key, ExtensionEntry*
                  key, p, typeName(typeid(*ptr)).c_str());
 #endif
         extensions[key] = e;
+        setSlot(key, e);
         return e->object();
       }
       except("ObjectExtensions::addExtension","Object already has an extension of type: %s.",obj_type(e->object()).c_str());
@@ -96,6 +197,7 @@ void* ObjectExtensions::removeExtension(unsigned long long int key, bool destroy
     }
     delete (*j).second;
     extensions.erase(j);
+    setSlot(key, nullptr);
     return ptr;
   }
   except("ObjectExtensions::removeExtension","The object of type %016llX is not present.",key);
@@ -108,6 +210,7 @@ void* ObjectExtensions::extension(unsigned long long int key) const {
 #if EXTENSION_DEBUG
   printout(ALWAYS,"extension","+++ Get extension with key: %016llX", key);
 #endif
+  count_lookup(ObjectExtensions::NO_SLOT);
   if (j != extensions.end()) {
     return (*j).second->object();
   }
@@ -121,6 +224,7 @@ void* ObjectExtensions::extension(unsigned long long int key, bool alert) const
 #if EXTENSION_DEBUG
   printout(ALWAYS,"extension","+++ Get extension with key: %016llX", key);
 #endif
+  count_lookup(ObjectExtensions::NO_SLOT);
   if (j != extensions.end()) {
     return (*j).second->object();
   }
@@ -129,3 +233,21 @@ void* ObjectExtensions::extension(unsigned long long int key, bool alert) const
   except("ObjectExtensions::extension","The object has no extension of type %016llX.",key);
   return nullptr;
 }
+
+/// Access an existing extension object by the dense slot of the extension type
+void* ObjectExtensions::extension(std::size_t idx, unsigned long long int key, bool alert) const {
+  count_lookup(idx);
+  if ( idx < slots.size() )   {
+    if ( const ExtensionEntry* e = slots[idx] )
+      return e->object();
+  }
+  // Fallback: extension types without slot or entries not registered by addExtension
+  const auto j = extensions.find(key);
+  if ( j != extensions.end() )   {
+    return (*j).second->object();
+  }
+  else if ( !alert )
+    return nullptr;
+  except("ObjectExtensions::extension","The object has no extension of type %016llX.",key);
+  return nullptr;
+}
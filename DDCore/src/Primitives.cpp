@@ -18,6 +18,7 @@
 
 // C/C++ include files
 #include <cstring>
+#include <sys/stat.h>
 
 #if defined(__linux) || defined(__APPLE__) || defined(__powerpc64__)
 #include <cxxabi.h>
@@ -214,6 +215,33 @@ unsigned long long int dd4hep::detail::update_hash64(unsigned long long int hash
   return hash;
 }
 
+namespace {
+  /// Size and modification time of a stat'ed file. The time stamp member is not portable
+  bool stat_status(int sc, const struct stat& info, long long int& size, long long int& mtime)  {
+    if ( sc != 0 ) return false;
+#if defined(__APPLE__)
+    const struct timespec& t = info.st_mtimespec;
+#else
+    const struct timespec& t = info.st_mtim;
+#endif
+    size  = (long long int)info.st_size;
+    mtime = (long long int)t.tv_sec * 1000000000LL + t.tv_nsec;
+    return true;
+  }
+}
+
+/// Size and modification time [nanoseconds since the epoch] of a file. False if not accessible
+bool dd4hep::detail::file_status(const std::string& file_name, long long int& size, long long int& mtime)  {
+  struct stat info;
+  return stat_status(::stat(file_name.c_str(), &info), info, size, mtime);
+}
+
+/// Size and modification time [nanoseconds since the epoch] of an open file. False if not accessible
+bool dd4hep::detail::file_status(int fd, long long int& size, long long int& mtime)  {
+  struct stat info;
+  return stat_status(::fstat(fd, &info), info, size, mtime);
+}
+
 /// 16 bit hash function
 unsigned short dd4hep::detail::hash16(const void* key, std::size_t len)   {
   unsigned short value = (unsigned short)hash32(key, len);
@@ -677,6 +677,8 @@ template class dd4hep::Handle<TNamed>;
 #pragma link C++ class dd4hep::Handle<dd4hep::SolenoidField>+;
 #pragma link C++ class dd4hep::DipoleField+;
 #pragma link C++ class dd4hep::Handle<dd4hep::DipoleField>+;
+#pragma link C++ class dd4hep::FieldMap+;
+#pragma link C++ class dd4hep::Handle<dd4hep::FieldMap>+;
 
 #pragma link C++ class dd4hep::IDDescriptor+;
 #pragma link C++ class dd4hep::IDDescriptorObject+;
@@ -20,6 +20,7 @@
 #include <DD4hep/detail/SegmentationsInterna.h>
 
 // C/C++ include files
+#include <vector>
 
 using namespace dd4hep;
 
@@ -73,6 +74,29 @@ CellID Segmentation::cellID(const Position& localPosition, const Position& globa
   return access()->segmentation->cellID(localPosition, globalPosition, volID);
 }
 
+/// determine the local positions of n cell IDs in one batch
+void Segmentation::positions(std::size_t n, const CellID* cells, Position* localPositions) const  {
+  std::vector<DDSegmentation::Vector3D> pos(n);
+  if ( n > 0 )  {
+    access()->segmentation->positions(n, cells, &pos[0]);
+    for( std::size_t i = 0; i < n; ++i )
+      localPositions[i].SetCoordinates(pos[i].X, pos[i].Y, pos[i].Z);
+  }
+}
+
+/// determine the cell IDs of n local positions in one batch
+void Segmentation::cellIDs(std::size_t n, const Position* localPositions, const Position* globalPositions,
+                           const VolumeID* volIDs, CellID* cells) const  {
+  std::vector<DDSegmentation::Vector3D> local(n), global(n);
+  if ( n > 0 )  {
+    for( std::size_t i = 0; i < n; ++i )  {
+      local[i]  = DDSegmentation::Vector3D(localPositions[i].X(),  localPositions[i].Y(),  localPositions[i].Z());
+      global[i] = DDSegmentation::Vector3D(globalPositions[i].X(), globalPositions[i].Y(), globalPositions[i].Z());
+    }
+    access()->segmentation->cellIDs(n, &local[0], &global[0], volIDs, cells);
+  }
+}
+
 /// Determine the volume ID from the full cell ID by removing all local fields
 VolumeID Segmentation::volumeID(const CellID& cell) const   {
   return access()->segmentation->volumeID(cell);
@@ -23,6 +23,8 @@
 // C/C++ includes
 #include <set>
 #include <cmath>
+#include <memory>
+#include <algorithm>
 #include <sstream>
 #include <iomanip>
 
@@ -510,6 +512,10 @@ IDDescriptor VolumeManager::idSpec() const {
 bool VolumeManager::adoptPlacement(VolumeID sys_id, VolumeManagerContext* context) {
   std::stringstream err;
   Object&  o      = _data();
+  if ( o.frozen )  {
+    except("VolumeManager","dd4hep: Cannot add placement to frozen volume manager: %s",
+           o.detector.isValid() ? o.detector.name() : "????");
+  }
   VolumeID vid    = context->identifier;
   VolumeID mask   = context->mask;
   PlacedVolume pv = context->elementPlacement();
@@ -601,34 +607,147 @@ bool VolumeManager::adoptPlacement(VolumeManagerContext* context) {
   return false;
 }
 
+namespace  {
+  /// Search the context of a volume identifier without throwing an exception
+  VolumeManagerContext* find_context(const VolumeManagerObject& o, VolumeID id)   {
+    if ( o.frozen )  {
+      return o.frozen->search(id);
+    }
+    /// First look in our own volume cache if the entry is found.
+    VolumeManagerContext* c = o.search(id);
+    if ( c )
+      return c;
+    /// Second: look in the subdetector volume cache if the entry is found.
+    if ( (o.flags & VolumeManager::ONE) != VolumeManager::ONE )  {
+      for (const auto& j : o.subdetectors )  {
+        if ((c = j.second->search(id)) != 0)
+          return c;
+      }
+    }
+    return 0;
+  }
+}
+
+/// Compile the populated lookup tree into flat tables. Subsections are frozen as well.
+void VolumeManager::freeze()   {
+  if ( !isValid() )  {
+    except("VolumeManager","freeze: Cannot freeze volume manager [Invalid Manager Handle]");
+  }
+  Object& o = _data();
+  if ( o.frozen )  {
+    return;
+  }
+  std::unique_ptr<VolumeManagerFrozenTables> tables(new VolumeManagerFrozenTables());
+  auto add_section = [&tables](const Object& obj)   {
+    VolumeManagerFrozenTables::Section sec;
+    sec.detMask = obj.detMask;
+    sec.keys.reserve(obj.volumes.size());
+    sec.contexts.reserve(obj.volumes.size());
+    /// The std::map is already sorted: masked keys are sorted and unique as well
+    std::vector<std::pair<VolumeID, VolumeManagerContext*> > entries;
+    entries.reserve(obj.volumes.size());
+    for( const auto& v : obj.volumes )
+      entries.emplace_back(v.first&obj.detMask, v.second);
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](const std::pair<VolumeID, VolumeManagerContext*>& a,
+                        const std::pair<VolumeID, VolumeManagerContext*>& b) { return a.first < b.first; });
+    for( const auto& e : entries )  {
+      /// Keep the first entry for duplicated keys: std::map::find returns the exact key
+      if ( !sec.keys.empty() && sec.keys.back() == e.first ) continue;
+      sec.keys.emplace_back(e.first);
+      sec.contexts.emplace_back(e.second);
+    }
+    tables->sections.emplace_back(std::move(sec));
+  };
+  add_section(o);
+  if ( (o.flags & ONE) != ONE )  {
+    for( const auto& j : o.subdetectors )  {
+      const Object& mo = *j.second.data<Object>();
+      int idx = int(tables->sections.size());
+      add_section(mo);
+      if ( !mo.system || mo.system->isSigned() || mo.system->width() > 16 )  {
+        continue;
+      }
+      VolumeManagerFrozenTables::Dispatch* disp = 0;
+      for( auto& d : tables->dispatch )  {
+        if ( d.offset == mo.system->offset() && d.mask == (mo.system->mask() >> d.offset) )  {
+          disp = &d;
+          break;
+        }
+      }
+      if ( !disp )  {
+        VolumeManagerFrozenTables::Dispatch d;
+        d.offset = mo.system->offset();
+        d.mask   = mo.system->mask() >> d.offset;
+        d.sections.resize(std::size_t(d.mask)+1, -1);
+        tables->dispatch.emplace_back(std::move(d));
+        disp = &tables->dispatch.back();
+      }
+      /// Preserve the map ordering: the first section in the lookup order wins
+      if ( mo.sysID <= disp->mask && disp->sections[mo.sysID] < 0 )  {
+        disp->sections[mo.sysID] = idx;
+      }
+    }
+  }
+  std::size_t num_entries = 0;
+  for( const auto& sec : tables->sections ) num_entries += sec.keys.size();
+  printout(DEBUG, "VolumeManager", "+++ Frozen %s: %ld sections %ld entries %ld dispatch tables.",
+           o.detector.isValid() ? o.detector.name() : "VolumeManager",
+           long(tables->sections.size()), long(num_entries), long(tables->dispatch.size()));
+  o.frozen = tables.release();
+  for( auto& j : o.managers )
+    j.second.freeze();
+}
+
+/// Check if the volume manager is frozen
+bool VolumeManager::isFrozen() const   {
+  return isValid() && 0 != _data().frozen;
+}
+
 /// Lookup the context, which belongs to a registered physical volume.
 VolumeManagerContext* VolumeManager::lookupContext(VolumeID volume_id) const {
   if (isValid()) {
-    VolumeManagerContext* c = 0;
     const Object& o = _data();
     bool is_top = o.top == ptr();
     bool one_tree = (o.flags & ONE) == ONE;
     if ( !is_top && one_tree ) {
       return VolumeManager(o.top).lookupContext(volume_id);
     }
-    VolumeID id = volume_id;
-    /// First look in our own volume cache if the entry is found.
-    c = o.search(id);
+    VolumeManagerContext* c = find_context(o, volume_id);
     if (c)
       return c;
-    /// Second: look in the subdetector volume cache if the entry is found.
-    if (!one_tree) {
-      for (const auto& j : o.subdetectors )  {
-        if ((c = j.second._data().search(id)) != 0)
-          return c;
-      }
-    }
     except("VolumeManager","lookupContext: Failed to search Volume context %016llX [Unknown identifier]", (void*)volume_id);
   }
   except("VolumeManager","lookupContext: Failed to search Volume context [Invalid Manager Handle]");
   return 0;
 }
 
+/// Lookup the contexts of a batch of volume identifiers. Unknown identifiers yield NULL.
+void VolumeManager::lookupContexts(std::size_t num_ids, const VolumeID* volume_ids,
+                                   VolumeManagerContext** contexts) const
+{
+  if (isValid()) {
+    const Object& o = _data();
+    if ( o.top != ptr() && (o.flags & ONE) == ONE ) {
+      VolumeManager(o.top).lookupContexts(num_ids, volume_ids, contexts);
+      return;
+    }
+    for( std::size_t i = 0; i < num_ids; ++i )
+      contexts[i] = find_context(o, volume_ids[i]);
+    return;
+  }
+  except("VolumeManager","lookupContexts: Failed to search Volume contexts [Invalid Manager Handle]");
+}
+
+/// Lookup the contexts of a batch of volume identifiers. Unknown identifiers yield NULL.
+void VolumeManager::lookupContexts(const std::vector<VolumeID>& volume_ids,
+                                   std::vector<VolumeManagerContext*>& contexts) const
+{
+  contexts.resize(volume_ids.size());
+  if ( !volume_ids.empty() )
+    lookupContexts(volume_ids.size(), &volume_ids[0], &contexts[0]);
+}
+
 /// Lookup a physical (placed) volume identified by its 64 bit hit ID
 PlacedVolume VolumeManager::lookupDetElementPlacement(VolumeID volume_id) const {
   VolumeManagerContext* c = lookupContext(volume_id); // Throws exception if not found!
@@ -713,8 +832,38 @@ std::ostream& dd4hep::operator<<(std::ostream& os, const VolumeManager& mgr) {
   return os;
 }
 
+/// Search the context of a volume identifier. Same result as the map based search.
+VolumeManagerContext* VolumeManagerFrozenTables::search(VolumeID vol_id) const {
+  /// First look in our own volume cache if the entry is found.
+  VolumeManagerContext* c = sections[0].search(vol_id);
+  if ( c )
+    return c;
+  /// Second: direct access to the subdetector section using the value of the system field
+  for( const auto& d : dispatch )  {
+    VolumeID sys_id = (vol_id >> d.offset) & d.mask;
+    int      idx    = d.sections[sys_id];
+    if ( idx > 0 && (c = sections[idx].search(vol_id)) != 0 )
+      return c;
+  }
+  /// Last resort (normally for unknown identifiers): linear scan of the remaining sections
+  for( std::size_t i = 1; i < sections.size(); ++i )  {
+    if ( (c = sections[i].search(vol_id)) != 0 )
+      return c;
+  }
+  return 0;
+}
+
+/// Binary search of the context belonging to a volume identifier
+VolumeManagerContext* VolumeManagerFrozenTables::Section::search(VolumeID vol_id) const {
+  VolumeID key = vol_id&detMask;
+  auto i = std::lower_bound(keys.begin(), keys.end(), key);
+  return (i == keys.end() || *i != key) ? 0 : contexts[i-keys.begin()];
+}
+
 /// Default destructor
 VolumeManagerObject::~VolumeManagerObject() {
+  /// Cleanup flat lookup tables
+  detail::deletePtr(frozen);
   /// Cleanup volume tree
   destroyObjects(volumes);
   /// Cleanup dependent managers
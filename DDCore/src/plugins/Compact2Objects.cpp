@@ -20,6 +20,7 @@
 // Framework includes
 #include <DD4hep/DetFactoryHelper.h>
 #include <DD4hep/DetectorTools.h>
+#include <DD4hep/DetectorLoad.h>
 #include <DD4hep/MatrixHelpers.h>
 #include <DD4hep/PropertyTable.h>
 #include <DD4hep/OpticalSurfaces.h>
@@ -49,6 +50,7 @@
 #include <filesystem>
 #include <iostream>
 #include <climits>
+#include <memory>
 #include <set>
 
 using namespace dd4hep;
@@ -258,6 +260,63 @@ static Ref_t create_MultipoleField(Detector& description, xml_h e) {
 }
 DECLARE_XMLELEMENT(MultipoleMagnet,create_MultipoleField)
 
+/** Field map on a regular grid.
+ *
+ *     <field type="FieldMap" name="MyMap" field="magnetic"
+ *            file="solenoid_map.bin" lunit="mm" funit="tesla">
+ *       <symmetry axis="z" flip="r"/>    Mirror plane z=0: F_r changes sign
+ *       <symmetry axis="phi"/>           Rotational symmetry of (r,phi,z) maps
+ *     </field>
+ *
+ *  Axes and components are named (x,y,z) for cartesian
+ *  maps and (r,phi,z) for cylindrical maps.
+ */
+static Ref_t create_FieldMap(Detector& /* description */, xml_h e) {
+  xml_comp_t c(e);
+  CartesianField obj;
+  std::unique_ptr<FieldMap> ptr(new FieldMap());
+  double      lunit = c.hasAttr(_U(lunit)) ? c.attr<double>(_U(lunit)) : 1.0;
+  std::string file  = c.attr<std::string>(_U(file));
+  auto axis_bit = [&file](const std::string& n) -> unsigned char {
+    if ( n == "x" || n == "r"   ) return 1<<0;
+    if ( n == "y" || n == "phi" ) return 1<<1;
+    if ( n == "z"               ) return 1<<2;
+    throw_print("Compact2Objects[ERROR]: Invalid axis name '"+n+"' for field map "+file);
+    return 0;
+  };
+
+  ptr->load(file, lunit);
+  ptr->scale = c.hasAttr(_U(funit)) ? c.attr<double>(_U(funit)) : 1.0;
+  if ( c.hasAttr(_U(field)) )  {
+    std::string t = c.attr<std::string>(_U(field));
+    ptr->field_type = ::toupper(t[0]) == 'E' ? CartesianField::ELECTRIC : CartesianField::MAGNETIC;
+  }
+  for ( xml_coll_t coll(c, _U(symmetry)); coll; ++coll )  {
+    xml_comp_t sym = coll;
+    std::string axis = sym.attr<std::string>(_U(axis));
+    if ( axis == "phi" && ptr->grid == FieldMap::CYLINDRICAL_RPHIZ )  {
+      ptr->periodic = true;
+      continue;
+    }
+    unsigned char bit = axis_bit(axis);
+    unsigned char flip = 0;
+    if ( sym.hasAttr(_U(flip)) )  {
+      std::string comps = sym.attr<std::string>(_U(flip));
+      for ( std::size_t beg = 0, end = 0; beg < comps.length(); beg = end + 1 )  {
+        end = comps.find_first_of(", ", beg);
+        if ( end == std::string::npos ) end = comps.length();
+        if ( end > beg ) flip |= axis_bit(comps.substr(beg, end - beg));
+      }
+    }
+    int idx = bit == 1 ? 0 : (bit == 2 ? 1 : 2);
+    ptr->mirror   |= bit;
+    ptr->flip[idx] = flip;
+  }
+  obj.assign(ptr.release(), c.nameStr(), c.typeStr());
+  return obj;
+}
+DECLARE_XMLELEMENT(FieldMap,create_FieldMap)
+
 static long load_Compact(Detector& description, xml_h element) {
   Converter<Compact>converter(description);
   converter(element);
@@ -377,6 +436,7 @@ template <> void Converter<Constant>::operator()(xml_h e) const {
     return;
   }
   xml::DocumentHolder doc(xml::DocumentHandler().load(e, e.attr_value(_U(ref))));
+  DetectorSourceFiles::add(description, doc.uri());
   if ( s_debug.includes )   {
     printout(ALWAYS, "Compact","++ Processing xml document %s.",doc.uri().c_str());
   }
@@ -1453,6 +1513,7 @@ template <> void Converter<DetElement>::operator()(xml_h element) const {
 /// Read material entries from a seperate file in one of the include sections of the geometry
 template <> void Converter<IncludeFile>::operator()(xml_h element) const   {
   xml::DocumentHolder doc(xml::DocumentHandler().load(element, element.attr_value(_U(ref))));
+  DetectorSourceFiles::add(description, doc.uri());
   if ( s_debug.include_guard) {
     // Include guard, we check whether this file was already processed
     if (check_process_file(description, doc.uri()))
@@ -1611,6 +1672,7 @@ template <> void Converter<DetElementInclude>::operator()(xml_h element) const {
   std::string type = element.hasAttr(_U(type)) ? element.attr<std::string>(_U(type)) : std::string("xml");
   if ( type == "xml" )  {
     xml::DocumentHolder doc(xml::DocumentHandler().load(element, element.attr_value(_U(ref))));
+    DetectorSourceFiles::add(description, doc.uri());
     if ( s_debug.include_guard ) {
       // Include guard, we check whether this file was already processed
       if (check_process_file(description, doc.uri()))
@@ -0,0 +1,117 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/Detector.h>
+#include <DD4hep/Printout.h>
+#include <DD4hep/Factories.h>
+#include <DD4hep/Fields.h>
+#include <DD4hep/Shapes.h>
+
+// C/C++ include files
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace dd4hep;
+
+namespace  {
+  /// Time a field evaluation function over all points
+  template <typename FUNC>
+  double time_field(FUNC func, int num_loops)   {
+    auto start = std::chrono::steady_clock::now();
+    for( int loop = 0; loop < num_loops; ++loop )
+      func();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+}
+
+/// Benchmark the magnetic field evaluation: OverlayedField versus CompiledField
+/**
+ *  Factory: DD4hep_FieldBenchmark
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    16/10/2026
+ */
+static long field_benchmark(Detector& description, int argc, char** argv)   {
+  int num_points = 100000, num_loops = 10;
+  for( int i = 0; i < argc && argv[i]; ++i )  {
+    if ( 0 == ::strncmp("-points",argv[i],4) )
+      num_points = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-loops",argv[i],4) )
+      num_loops = ::atol(argv[++i]);
+    else  {
+      std::cout <<
+        "Usage: -plugin DD4hep_FieldBenchmark -arg [-arg]                              \n\n"
+        "     Benchmark the magnetic field evaluation of the overlayed field           \n"
+        "     against the compiled field with single and batch evaluation.             \n\n"
+        "     -points <number>  Number of random points inside the world volume.      \n"
+        "     -loops  <number>  Number of passes over all points.                      \n"
+        "     -help             Print this help output                                 \n"
+        "\tArguments given: " << arguments(argc,argv) << std::endl << std::flush;
+      ::exit(EINVAL);
+    }
+  }
+  OverlayedField overlay = description.field();
+  CompiledField  compiled(overlay, OverlayedField::MAGNETIC);
+  Box            world = description.worldVolume().solid();
+  std::mt19937   engine(12345);
+  std::uniform_real_distribution<double> x(-world.x(), world.x()), y(-world.y(), world.y()), z(-world.z(), world.z());
+  std::vector<double> pos(3*num_points), ref(3*num_points), single(3*num_points), batch(3*num_points);
+  for( int i = 0; i < num_points; ++i )  {
+    pos[3*i] = x(engine); pos[3*i+1] = y(engine); pos[3*i+2] = z(engine);
+  }
+
+  double t_overlay = time_field([&]()  {
+      for( int i = 0; i < num_points; ++i )
+        overlay.magneticField(&pos[3*i], &ref[3*i]);
+    }, num_loops);
+  double t_single = time_field([&]()  {
+      for( int i = 0; i < num_points; ++i )  {
+        double* f = &single[3*i];
+        f[0] = f[1] = f[2] = 0e0;
+        compiled.fieldComponents(&pos[3*i], f);
+      }
+    }, num_loops);
+  double t_batch = time_field([&]()  {
+      std::fill(batch.begin(), batch.end(), 0e0);
+      compiled.fieldComponents(num_points, &pos[0], &batch[0]);
+    }, num_loops);
+
+  std::size_t num_diff = 0, num_bounded = 0;
+  for( std::size_t i = 0; i < pos.size(); ++i )  {
+    double tol = 1e-10 * std::abs(ref[i]) + 1e-12;
+    if ( std::abs(ref[i]-single[i]) > tol || std::abs(ref[i]-batch[i]) > tol )
+      ++num_diff;
+  }
+  for( const auto& c : compiled.components() )
+    num_bounded += c.bounded ? 1 : 0;
+
+  double norm = 1e9/double(num_points)/double(num_loops);
+  printout(ALWAYS,"FieldBenchmark","+++ %d points, %d loops. Compiled field: %ld constant components fused, "
+           "%ld of %ld components bounded.", num_points, num_loops, long(compiled.numConstants()),
+           long(num_bounded), long(compiled.components().size()));
+  printout(ALWAYS,"FieldBenchmark","+++ OverlayedField:          %8.2f nsec/point", t_overlay*norm);
+  printout(ALWAYS,"FieldBenchmark","+++ CompiledField single:    %8.2f nsec/point", t_single*norm);
+  printout(ALWAYS,"FieldBenchmark","+++ CompiledField batch:     %8.2f nsec/point", t_batch*norm);
+  printout(num_diff ? ERROR : ALWAYS,"FieldBenchmark",
+           "+++ %ld field component differences between overlayed and compiled field.", long(num_diff));
+  return num_diff == 0 ? 1 : 0;
+}
+DECLARE_APPLY(DD4hep_FieldBenchmark,field_benchmark)
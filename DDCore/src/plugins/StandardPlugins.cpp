@@ -28,6 +28,7 @@
 #include <XML/DocumentHandler.h>
 #include <XML/XMLElements.h>
 #include <XML/XMLTags.h>
+#include <Evaluator/Evaluator.h>
 
 // ROOT includes
 #include <TInterpreter.h>
@@ -35,18 +36,28 @@
 #include <TGeoManager.h>
 #include <TGeoVolume.h>
 #include <TSystem.h>
+#include <TTimeStamp.h>
 #include <TClass.h>
 #include <TRint.h>
 #include <TGDMLMatrix.h>
 
 // C/C++ include files
 #include <cerrno>
+#include <cstdio>
+#include <cstring>
 #include <cstdlib>
 #include <sstream>
+#include <functional>
+#include <unistd.h>
+#include <sys/wait.h>
 
 using namespace dd4hep;
 using namespace dd4hep::detail;
 
+namespace dd4hep {
+  const tools::Evaluator& evaluator();
+}
+
 namespace  {
 
   struct ProcessorArgs   {
@@ -824,6 +835,94 @@ static long load_volmgr(Detector& description, int, char**) {
 DECLARE_APPLY(DD4hep_VolumeManager,load_volmgr)
 DECLARE_APPLY(DD4hepVolumeManager,load_volmgr)
 
+/// Basic entry point to steer the lookup statistics of object extensions
+/**
+ *  Factory: DD4hep_ExtensionStatistics
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    16/10/2026
+ */
+static long extension_statistics(Detector& /* description */, int argc, char** argv) {
+  bool done = false;
+  for(int i = 0; i < argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-enable",argv[i],4) )  {
+      ObjectExtensions::enableStatistics(true);
+      done = true;
+    }
+    else if ( 0 == ::strncmp("-disable",argv[i],4) )  {
+      ObjectExtensions::enableStatistics(false);
+      done = true;
+    }
+    else if ( 0 == ::strncmp("-print",argv[i],4) )  {
+      ObjectExtensions::printStatistics();
+      done = true;
+    }
+  }
+  if ( !done )   {
+    std::cout <<
+      "Usage: -plugin DD4hep_ExtensionStatistics -arg [-arg]                        \n\n"
+      "     Steer the lookup statistics of object extensions by type.              \n\n"
+      "     -enable                  Enable the lookup counters.                    \n"
+      "     -disable                 Disable the lookup counters.                   \n"
+      "     -print                   Print the lookup counters.                     \n"
+      "\tArguments given: " << arguments(argc,argv) << std::endl << std::flush;
+    ::exit(EINVAL);
+  }
+  return 1;
+}
+DECLARE_APPLY(DD4hep_ExtensionStatistics,extension_statistics)
+
+/// Basic entry point to measure the time to process compact files with and without evaluator caching
+/**
+ *  Factory: DD4hep_EvaluatorBenchmark
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    16/10/2026
+ */
+static long evaluator_benchmark(Detector& description, int argc, char** argv) {
+  std::vector<std::string> inputs;
+  bool caching = true;
+  for(int i = 0; i < argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-input",argv[i],4) )
+      inputs.emplace_back(argv[++i]);
+    else if ( 0 == ::strncmp("-cache",argv[i],4) )
+      caching = true;
+    else if ( 0 == ::strncmp("-nocache",argv[i],4) )
+      caching = false;
+  }
+  if ( inputs.empty() )   {
+    std::cout <<
+      "Usage: -plugin DD4hep_EvaluatorBenchmark -arg [-arg]                         \n\n"
+      "     Process compact files and print the time spent together with the      \n"
+      "     counters of the expression evaluator.                                 \n\n"
+      "     -input    <string>       Compact input file (multiple entries allowed)  \n"
+      "     -cache                   Enable the literal conversion and the cache    \n"
+      "                              of compiled expressions (default).             \n"
+      "     -nocache                 Disable the literal conversion and the cache.  \n"
+      "\tArguments given: " << arguments(argc,argv) << std::endl << std::flush;
+    ::exit(EINVAL);
+  }
+  const tools::Evaluator& eval = evaluator();
+  bool old = eval.setCaching(caching);
+  tools::Evaluator::Statistics before = eval.statistics();
+  TTimeStamp start;
+  for( const auto& input : inputs )
+    description.fromXML(input);
+  TTimeStamp stop;
+  tools::Evaluator::Statistics after = eval.statistics();
+  eval.setCaching(old);
+  printout(ALWAYS,"EvaluatorBenchmark","+++ Processed %ld compact file(s) [caching:%s]  [%8.3f seconds]",
+           inputs.size(), caching ? "ON" : "OFF", stop.AsDouble()-start.AsDouble());
+  printout(ALWAYS,"EvaluatorBenchmark","+++ Expressions: %ld literals  %ld cached  %ld compiled  "
+           "%ld interpreted  %ld invalidated",
+           after.literals-before.literals, after.cached-before.cached, after.compiled-before.compiled,
+           after.interpreted-before.interpreted, after.invalidated-before.invalidated);
+  return 1;
+}
+DECLARE_APPLY(DD4hep_EvaluatorBenchmark,evaluator_benchmark)
+
 /// Basic entry point to dump a dd4hep geometry to a ROOT file
 /**
  *  Factory: DD4hep_Geometry2ROOT
@@ -891,6 +990,248 @@ static long load_geometryFromroot(Detector& description, int argc, char** argv)
 }
 DECLARE_APPLY(DD4hep_RootLoader,load_geometryFromroot)
 
+/// Basic entry point to load a dd4hep geometry from a snapshot or from compact XML
+/**
+ *  Factory: DD4hep_GeometrySnapshot
+ *
+ *  If the snapshot file is up to date with respect to the compact files
+ *  and the declared dependencies, the detector description is loaded from
+ *  the snapshot. Otherwise the compact files are processed and the snapshot
+ *  is (re-)created for later jobs.
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    16/10/2026
+ */
+static long load_geometry_snapshot(Detector& description, int argc, char** argv) {
+  std::string snapshot;
+  std::vector<std::string> inputs, sources;
+  bool volmgr = false;
+  for(int i = 0; i < argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-input",argv[i],4) )  {
+      inputs.emplace_back(argv[++i]);
+      sources.emplace_back(inputs.back());
+    }
+    else if ( 0 == ::strncmp("-depends",argv[i],4) )
+      sources.emplace_back(argv[++i]);
+    else if ( 0 == ::strncmp("-snapshot",argv[i],4) )
+      snapshot = argv[++i];
+    else if ( 0 == ::strncmp("-volmgr",argv[i],4) )
+      volmgr = true;
+  }
+  if ( inputs.empty() || snapshot.empty() )   {
+    std::cout <<
+      "Usage: -plugin DD4hep_GeometrySnapshot -arg [-arg]                          \n\n"
+      "     Load DD4hep detector description from a geometry snapshot. If the       \n"
+      "     snapshot is missing or outdated, process the compact files and save     \n"
+      "     the snapshot.                                                         \n\n"
+      "     -input    <string>       Compact input file (multiple entries allowed)  \n"
+      "     -depends  <string>       Further file the geometry depends on (multiple \n"
+      "                              entries allowed). Included xml files and the   \n"
+      "                              plugin libraries are added automatically.      \n"
+      "     -snapshot <string>       Snapshot file name.                            \n"
+      "     -volmgr                  Populate the volume manager before saving.     \n"
+      "\tArguments given: " << arguments(argc,argv) << std::endl << std::flush;
+    ::exit(EINVAL);
+  }
+  TTimeStamp start;
+  if ( 1 == DD4hepRootPersistency::loadSnapshot(description, snapshot.c_str(), sources) )  {
+    TTimeStamp stop;
+    double load_time  = stop.AsDouble()-start.AsDouble();
+    double build_time = DD4hepRootPersistency::snapshotBuildTime(snapshot.c_str());
+    printout(ALWAYS,"GeometrySnapshot","+++ Loaded geometry snapshot %s  [%8.3f seconds]",
+             snapshot.c_str(), load_time);
+    if ( build_time > 0e0 && load_time > 0e0 )   {
+      printout(ALWAYS,"GeometrySnapshot","+++ Startup: snapshot %8.3f seconds versus compact XML %8.3f seconds [speedup %.1f]",
+               load_time, build_time, build_time/load_time);
+    }
+    return 1;
+  }
+  for( const auto& input : inputs )
+    description.fromXML(input);
+  if ( volmgr )
+    load_volmgr(description, 0, nullptr);
+  TTimeStamp built;
+  printout(ALWAYS,"GeometrySnapshot","+++ Built geometry from %ld compact file(s)  [%8.3f seconds]",
+           inputs.size(), built.AsDouble()-start.AsDouble());
+  if ( DD4hepRootPersistency::saveSnapshot(description, snapshot.c_str(), sources,
+                                           built.AsDouble()-start.AsDouble()) > 0 )  {
+    TTimeStamp stop;
+    printout(ALWAYS,"GeometrySnapshot","+++ Created geometry snapshot %s  [%8.3f seconds]",
+             snapshot.c_str(), stop.AsDouble()-built.AsDouble());
+  }
+  return 1;
+}
+DECLARE_APPLY(DD4hep_GeometrySnapshot,load_geometry_snapshot)
+
+namespace  {
+  /// Number of detector elements below and including the given one
+  long count_detelements(DetElement de)   {
+    long count = 1;
+    for( const auto& c : de.children() )
+      count += count_detelements(c.second);
+    return count;
+  }
+
+  /// Execute one startup path in a child process: every measurement starts from the same state
+  /** The function returns the startup time in seconds (negative on failure).
+   *  The child process also reports the number of detector elements it built.
+   */
+  std::pair<double,long> startup_in_child(Detector& description, const std::function<double()>& func)  {
+    int fd[2];
+    double result[2] = { -1e0, 0e0 };
+    if ( ::pipe(fd) != 0 )   {
+      except("GeometrySnapshotBenchmark","+++ Cannot create pipe: %s",::strerror(errno));
+    }
+    std::cout << std::flush;
+    ::fflush(stdout);
+    pid_t pid = ::fork();
+    if ( pid < 0 )   {
+      except("GeometrySnapshotBenchmark","+++ Cannot fork: %s",::strerror(errno));
+    }
+    else if ( pid == 0 )   {
+      ::close(fd[0]);
+      try  {
+        result[0] = func();
+        if ( result[0] >= 0e0 ) result[1] = double(count_detelements(description.world()));
+      }
+      catch(const std::exception& e)   {
+        printout(ERROR,"GeometrySnapshotBenchmark","+++ Exception: %s",e.what());
+      }
+      if ( ::write(fd[1], result, sizeof(result)) != ssize_t(sizeof(result)) )
+        printout(ERROR,"GeometrySnapshotBenchmark","+++ Cannot report the result: %s",::strerror(errno));
+      ::close(fd[1]);
+      std::cout << std::flush;
+      ::fflush(stdout);
+      ::_exit(0);
+    }
+    ::close(fd[1]);
+    if ( ::read(fd[0], result, sizeof(result)) != ssize_t(sizeof(result)) )
+      result[0] = -1e0;
+    ::close(fd[0]);
+    int status = 0;
+    ::waitpid(pid, &status, 0);
+    return std::make_pair(result[0], long(result[1]));
+  }
+}
+
+/// Startup benchmark: compact XML versus ROOT persistency versus the geometry snapshot
+/**
+ *  Factory: DD4hep_GeometrySnapshotBenchmark
+ *
+ *  Every startup path is executed in a separate child process, which
+ *  starts from the state of this process: an empty detector description.
+ *  The first build from compact XML writes the compressed ROOT file
+ *  (DD4hepRootPersistency::save) and the snapshot. The best time of all
+ *  repetitions is compared. The benchmark fails if the snapshot is not
+ *  faster than compact XML by at least the required factor.
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    16/10/2026
+ */
+static long benchmark_geometry_snapshot(Detector& description, int argc, char** argv) {
+  std::string snapshot, reference;
+  std::vector<std::string> inputs;
+  double min_speedup = 1e0;
+  bool   volmgr = false;
+  int    num_repeat = 3;
+  for(int i = 0; i < argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-input",argv[i],4) )
+      inputs.emplace_back(argv[++i]);
+    else if ( 0 == ::strncmp("-snapshot",argv[i],4) )
+      snapshot = argv[++i];
+    else if ( 0 == ::strncmp("-reference",argv[i],4) )
+      reference = argv[++i];
+    else if ( 0 == ::strncmp("-repeat",argv[i],4) )
+      num_repeat = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-min_speedup",argv[i],4) )
+      min_speedup = ::atof(argv[++i]);
+    else if ( 0 == ::strncmp("-volmgr",argv[i],4) )
+      volmgr = true;
+  }
+  if ( inputs.empty() || snapshot.empty() || reference.empty() || num_repeat < 1 )   {
+    std::cout <<
+      "Usage: -plugin DD4hep_GeometrySnapshotBenchmark -arg [-arg]                 \n\n"
+      "     Compare the startup time from compact XML, from a compressed ROOT file  \n"
+      "     and from the geometry snapshot. Both files are created by the benchmark.\n\n"
+      "     -input     <string>      Compact input file (multiple entries allowed)  \n"
+      "     -snapshot  <string>      Snapshot file name.                            \n"
+      "     -reference <string>      File name of the compressed ROOT persistency.  \n"
+      "     -repeat    <number>      Number of measurements per startup path [3].   \n"
+      "     -min_speedup <number>    Required speedup of the snapshot over XML [1]. \n"
+      "     -volmgr                  Populate the volume manager.                   \n"
+      "\tArguments given: " << arguments(argc,argv) << std::endl << std::flush;
+    ::exit(EINVAL);
+  }
+  std::remove(snapshot.c_str());
+  std::remove(reference.c_str());
+  auto best = [](std::pair<double,long>& result, const std::pair<double,long>& value)  {
+    if ( value.first < 0e0 || result.first < 0e0 )
+      result.first = -1e0;
+    else if ( result.first == 0e0 || value.first < result.first )
+      result.first = value.first;
+    result.second = value.second;
+  };
+  std::pair<double,long> xml(0e0,0), root(0e0,0), snap(0e0,0);
+  for( int i = 0; i < num_repeat; ++i )   {
+    best(xml, startup_in_child(description, [&]()  {
+          TTimeStamp start;
+          for( const auto& input : inputs )
+            description.fromXML(input);
+          if ( volmgr )
+            load_volmgr(description, 0, nullptr);
+          TTimeStamp stop;
+          double seconds = stop.AsDouble()-start.AsDouble();
+          if ( i == 0 )   {
+            if ( DD4hepRootPersistency::save(description, reference.c_str(), "Geometry") <= 0 ||
+                 DD4hepRootPersistency::saveSnapshot(description, snapshot.c_str(), inputs, seconds) <= 0 )
+              return -1e0;
+          }
+          return seconds;
+        }));
+    best(root, startup_in_child(description, [&]()  {
+          TTimeStamp start;
+          if ( 1 != DD4hepRootPersistency::load(description, reference.c_str(), "Geometry") )
+            return -1e0;
+          TTimeStamp stop;
+          return stop.AsDouble()-start.AsDouble();
+        }));
+    best(snap, startup_in_child(description, [&]()  {
+          TTimeStamp start;
+          if ( 1 != DD4hepRootPersistency::loadSnapshot(description, snapshot.c_str(), inputs) )
+            return -1e0;
+          TTimeStamp stop;
+          return stop.AsDouble()-start.AsDouble();
+        }));
+  }
+  if ( xml.first <= 0e0 || root.first <= 0e0 || snap.first <= 0e0 )   {
+    printout(ERROR,"GeometrySnapshotBenchmark","+++ FAILED: a startup path failed. "
+             "XML: %.3f ROOT: %.3f snapshot: %.3f seconds", xml.first, root.first, snap.first);
+    return 0;
+  }
+  printout(ALWAYS,"GeometrySnapshotBenchmark","+++ Best of %d startups with %ld DetElements:", num_repeat, xml.second);
+  printout(ALWAYS,"GeometrySnapshotBenchmark","+++   compact XML          %8.3f seconds", xml.first);
+  printout(ALWAYS,"GeometrySnapshotBenchmark","+++   ROOT persistency     %8.3f seconds [speedup %.2f]",
+           root.first, xml.first/root.first);
+  printout(ALWAYS,"GeometrySnapshotBenchmark","+++   geometry snapshot    %8.3f seconds [speedup %.2f]",
+           snap.first, xml.first/snap.first);
+  if ( root.second != xml.second || snap.second != xml.second )   {
+    printout(ERROR,"GeometrySnapshotBenchmark","+++ FAILED: different number of DetElements: "
+             "XML: %ld ROOT: %ld snapshot: %ld", xml.second, root.second, snap.second);
+    return 0;
+  }
+  if ( xml.first/snap.first < min_speedup )   {
+    printout(ERROR,"GeometrySnapshotBenchmark","+++ FAILED: snapshot speedup %.2f below the required %.2f",
+             xml.first/snap.first, min_speedup);
+    return 0;
+  }
+  printout(ALWAYS,"GeometrySnapshotBenchmark","+++ PASSED: snapshot speedup %.2f over compact XML (required: %.2f)",
+           xml.first/snap.first, min_speedup);
+  return 1;
+}
+DECLARE_APPLY(DD4hep_GeometrySnapshotBenchmark,benchmark_geometry_snapshot)
+
 /// Basic entry point to dump a dd4hep geometry as TGeo to a ROOT file
 /**
  *  Factory: DD4hep_Geometry2TGeo
@@ -0,0 +1,135 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/Detector.h>
+#include <DD4hep/Printout.h>
+#include <DD4hep/Factories.h>
+#include <DD4hep/VolumeManager.h>
+#include <DD4hep/detail/VolumeManagerInterna.h>
+
+// C/C++ include files
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+using namespace dd4hep;
+
+namespace  {
+
+  /// Create a temporary volume manager with the requested population flags
+  VolumeManager create_manager(Detector& description, const char* name, int flags)   {
+    return VolumeManager(description, name, description.world(), Readout(), flags);
+  }
+
+  /// Destroy a temporary volume manager and disconnect it from the detector elements
+  void destroy_manager(VolumeManager& mgr)   {
+    for( const auto& sub : mgr->subdetectors )  {
+      sub.first.removeAtUpdate(DetElement::PLACEMENT_CHANGED|DetElement::PLACEMENT_DETECTOR,
+                               sub.second.ptr());
+    }
+    detail::destroyHandle(mgr);
+  }
+
+  /// Time single lookups of all identifiers
+  double time_lookup(const VolumeManager& mgr, const std::vector<VolumeID>& ids,
+                     std::vector<VolumeManagerContext*>& result, int num_loops)   {
+    auto start = std::chrono::steady_clock::now();
+    for( int loop = 0; loop < num_loops; ++loop )  {
+      for( std::size_t i = 0; i < ids.size(); ++i )
+        result[i] = mgr.lookupContext(ids[i]);
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+
+  /// Time batch lookups of all identifiers
+  double time_batch(const VolumeManager& mgr, const std::vector<VolumeID>& ids,
+                    std::vector<VolumeManagerContext*>& result, int num_loops)   {
+    auto start = std::chrono::steady_clock::now();
+    for( int loop = 0; loop < num_loops; ++loop )
+      mgr.lookupContexts(ids.size(), &ids[0], &result[0]);
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+}
+
+/// Benchmark the volume manager lookups in TREE and ONE mode with and without freezing
+/**
+ *  Factory: DD4hep_VolumeManagerBenchmark
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    16/10/2026
+ */
+static long volume_manager_benchmark(Detector& description, int argc, char** argv)   {
+  int num_loops = 10;
+  for( int i = 0; i < argc && argv[i]; ++i )  {
+    if ( 0 == ::strncmp("-loops",argv[i],4) )
+      num_loops = ::atol(argv[++i]);
+    else  {
+      std::cout <<
+        "Usage: -plugin DD4hep_VolumeManagerBenchmark -arg [-arg]                      \n\n"
+        "     Benchmark VolumeManager::lookupContext in TREE and ONE mode              \n"
+        "     using the std::map based and the frozen flat lookup tables.              \n\n"
+        "     -loops  <number>  Number of passes over all volume identifiers.          \n"
+        "     -help             Print this help output                                 \n"
+        "\tArguments given: " << arguments(argc,argv) << std::endl << std::flush;
+      ::exit(EINVAL);
+    }
+  }
+  VolumeManager tree = create_manager(description, "BenchmarkTREE", VolumeManager::TREE);
+  VolumeManager one  = create_manager(description, "BenchmarkONE",  VolumeManager::ONE);
+  std::vector<VolumeID> ids;
+  for( const auto& v : one->volumes )
+    ids.emplace_back(v.second->identifier);
+  if ( ids.empty() )  {
+    printout(ERROR,"VolumeManagerBenchmark","+++ No volumes registered in the volume manager.");
+    destroy_manager(one);
+    destroy_manager(tree);
+    return 0;
+  }
+  /// Random access pattern: hits do not come sorted by volume
+  std::shuffle(ids.begin(), ids.end(), std::mt19937(12345));
+
+  std::size_t num_ids = ids.size();
+  std::vector<VolumeManagerContext*> ref_tree(num_ids), ref_one(num_ids);
+  std::vector<VolumeManagerContext*> res_tree(num_ids), res_one(num_ids), res_batch(num_ids);
+  double t_tree  = time_lookup(tree, ids, ref_tree, num_loops);
+  double t_one   = time_lookup(one,  ids, ref_one,  num_loops);
+  tree.freeze();
+  one.freeze();
+  double t_ftree = time_lookup(tree, ids, res_tree, num_loops);
+  double t_fone  = time_lookup(one,  ids, res_one,  num_loops);
+  double t_batch = time_batch (tree, ids, res_batch, num_loops);
+
+  std::size_t num_diff = 0;
+  for( std::size_t i = 0; i < num_ids; ++i )  {
+    if ( ref_tree[i] != res_tree[i] || ref_tree[i] != res_batch[i] || ref_one[i] != res_one[i] )
+      ++num_diff;
+  }
+  double norm = 1e9/double(num_ids*num_loops);
+  printout(ALWAYS,"VolumeManagerBenchmark","+++ %ld volume identifiers, %d loops", long(num_ids), num_loops);
+  printout(ALWAYS,"VolumeManagerBenchmark","+++ TREE   std::map:  %8.2f nsec/lookup", t_tree*norm);
+  printout(ALWAYS,"VolumeManagerBenchmark","+++ ONE    std::map:  %8.2f nsec/lookup", t_one*norm);
+  printout(ALWAYS,"VolumeManagerBenchmark","+++ TREE   frozen:    %8.2f nsec/lookup", t_ftree*norm);
+  printout(ALWAYS,"VolumeManagerBenchmark","+++ ONE    frozen:    %8.2f nsec/lookup", t_fone*norm);
+  printout(ALWAYS,"VolumeManagerBenchmark","+++ TREE   batch:     %8.2f nsec/lookup", t_batch*norm);
+  printout(num_diff ? ERROR : ALWAYS,"VolumeManagerBenchmark",
+           "+++ %ld lookup differences between map based and frozen volume managers.", long(num_diff));
+  destroy_manager(one);
+  destroy_manager(tree);
+  return num_diff == 0 ? 1 : 0;
+}
+DECLARE_APPLY(DD4hep_VolumeManagerBenchmark,volume_manager_benchmark)
@@ -15,6 +15,10 @@
 /// Framework include files
 #include <DDSegmentation/CartesianGrid.h>
 
+/// C/C++ include files
+#include <cmath>
+#include <stdexcept>
+
 namespace dd4hep {
   
   namespace DDSegmentation {
@@ -32,5 +36,49 @@ namespace dd4hep {
     CartesianGrid::~CartesianGrid() {
     }
 
+    /// Batch kernel: local positions of n cell IDs for the given grid axes
+    void CartesianGrid::gridPositions(const GridAxis* axes, int num_axes,
+                                      std::size_t n, const CellID* cIDs, Vector3D* pos) const  {
+      for (std::size_t i = 0; i < n; ++i)
+        pos[i] = Vector3D();
+      // One pass per axis: the loops have no branches and vectorize
+      for (int a = 0; a < num_axes; ++a)  {
+        const BatchField   field((*_decoder)[*axes[a].identifier]);
+        double Vector3D::* coord  = axes[a].coordinate;
+        const double       size   = axes[a].cellSize;
+        const double       offset = axes[a].offset;
+        for (std::size_t i = 0; i < n; ++i)
+          pos[i].*coord = double(field.value(cIDs[i])) * size + offset;
+      }
+    }
+
+    /// Batch kernel: cell IDs of n local positions for the given grid axes
+    void CartesianGrid::gridCellIDs(const GridAxis* axes, int num_axes,
+                                    std::size_t n, const Vector3D* pos, const VolumeID* vIDs,
+                                    CellID* cIDs) const  {
+      bool valid = true;
+      for (std::size_t i = 0; i < n; ++i)
+        cIDs[i] = vIDs[i];
+      for (int a = 0; a < num_axes; ++a)  {
+        const BatchField   field((*_decoder)[*axes[a].identifier]);
+        double Vector3D::* coord  = axes[a].coordinate;
+        const double       size   = axes[a].cellSize;
+        const double       offset = axes[a].offset;
+        if (size <= 1e-10) {
+          throw std::runtime_error("Invalid cell size: 0.0");
+        }
+        for (std::size_t i = 0; i < n; ++i)  {
+          FieldID bin = int(std::floor((pos[i].*coord + 0.5 * size - offset) / size));
+          valid &= field.inRange(bin);
+          cIDs[i] = (cIDs[i] & ~field.mask) | field.bits(bin);
+        }
+      }
+      if ( !valid )  {
+        // Redo the conversion cell by cell to raise the proper exception. Cartesian grids ignore the global position
+        for (std::size_t i = 0; i < n; ++i)
+          cIDs[i] = cellID(pos[i], pos[i], vIDs[i]);
+      }
+    }
+
   } /* namespace DDSegmentation */
 } /* namespace dd4hep */
@@ -75,6 +75,25 @@ CellID CartesianGridXY::cellID(const Vector3D& localPosition,
 	return cID;
 }
 
+/// determine the positions of n cell IDs
+void CartesianGridXY::positions(std::size_t n, const CellID* cIDs, Vector3D* localPositions) const {
+	const GridAxis axes[] = {
+		{ &_xId, &Vector3D::X, _gridSizeX, _offsetX },
+		{ &_yId, &Vector3D::Y, _gridSizeY, _offsetY }
+	};
+	gridPositions(axes, 2, n, cIDs, localPositions);
+}
+
+/// determine the cell IDs of n positions
+void CartesianGridXY::cellIDs(std::size_t n, const Vector3D* localPositions, const Vector3D* /* globalPositions */,
+                             const VolumeID* vIDs, CellID* cIDs) const {
+	const GridAxis axes[] = {
+		{ &_xId, &Vector3D::X, _gridSizeX, _offsetX },
+		{ &_yId, &Vector3D::Y, _gridSizeY, _offsetY }
+	};
+	gridCellIDs(axes, 2, n, localPositions, vIDs, cIDs);
+}
+
   std::vector<double> CartesianGridXY::cellDimensions(const CellID& /* cellID */) const {
   return {_gridSizeX, _gridSizeY};
 }
@@ -67,6 +67,27 @@ Vector3D CartesianGridXYZ::position(const CellID& cID) const {
 	return cID ;
 }
 
+/// determine the positions of n cell IDs
+void CartesianGridXYZ::positions(std::size_t n, const CellID* cIDs, Vector3D* localPositions) const {
+	const GridAxis axes[] = {
+		{ &_xId, &Vector3D::X, _gridSizeX, _offsetX },
+		{ &_yId, &Vector3D::Y, _gridSizeY, _offsetY },
+		{ &_zId, &Vector3D::Z, _gridSizeZ, _offsetZ }
+	};
+	gridPositions(axes, 3, n, cIDs, localPositions);
+}
+
+/// determine the cell IDs of n positions
+void CartesianGridXYZ::cellIDs(std::size_t n, const Vector3D* localPositions, const Vector3D* /* globalPositions */,
+                             const VolumeID* vIDs, CellID* cIDs) const {
+	const GridAxis axes[] = {
+		{ &_xId, &Vector3D::X, _gridSizeX, _offsetX },
+		{ &_yId, &Vector3D::Y, _gridSizeY, _offsetY },
+		{ &_zId, &Vector3D::Z, _gridSizeZ, _offsetZ }
+	};
+	gridCellIDs(axes, 3, n, localPositions, vIDs, cIDs);
+}
+
 std::vector<double> CartesianGridXYZ::cellDimensions(const CellID&) const {
   return {_gridSizeX, _gridSizeY, _gridSizeZ};
 }
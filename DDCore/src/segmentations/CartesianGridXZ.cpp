@@ -75,6 +75,25 @@ Vector3D CartesianGridXZ::position(const CellID& cID) const {
 	return cID ;
 }
 
+/// determine the positions of n cell IDs
+void CartesianGridXZ::positions(std::size_t n, const CellID* cIDs, Vector3D* localPositions) const {
+	const GridAxis axes[] = {
+		{ &_xId, &Vector3D::X, _gridSizeX, _offsetX },
+		{ &_zId, &Vector3D::Z, _gridSizeZ, _offsetZ }
+	};
+	gridPositions(axes, 2, n, cIDs, localPositions);
+}
+
+/// determine the cell IDs of n positions
+void CartesianGridXZ::cellIDs(std::size_t n, const Vector3D* localPositions, const Vector3D* /* globalPositions */,
+                             const VolumeID* vIDs, CellID* cIDs) const {
+	const GridAxis axes[] = {
+		{ &_xId, &Vector3D::X, _gridSizeX, _offsetX },
+		{ &_zId, &Vector3D::Z, _gridSizeZ, _offsetZ }
+	};
+	gridCellIDs(axes, 2, n, localPositions, vIDs, cIDs);
+}
+
 std::vector<double> CartesianGridXZ::cellDimensions(const CellID&) const {
   return {_gridSizeX, _gridSizeZ};
 }
@@ -72,6 +72,25 @@ Vector3D CartesianGridYZ::position(const CellID& cID) const {
 	return cID ;
 }
 
+/// determine the positions of n cell IDs
+void CartesianGridYZ::positions(std::size_t n, const CellID* cIDs, Vector3D* localPositions) const {
+	const GridAxis axes[] = {
+		{ &_yId, &Vector3D::Y, _gridSizeY, _offsetY },
+		{ &_zId, &Vector3D::Z, _gridSizeZ, _offsetZ }
+	};
+	gridPositions(axes, 2, n, cIDs, localPositions);
+}
+
+/// determine the cell IDs of n positions
+void CartesianGridYZ::cellIDs(std::size_t n, const Vector3D* localPositions, const Vector3D* /* globalPositions */,
+                             const VolumeID* vIDs, CellID* cIDs) const {
+	const GridAxis axes[] = {
+		{ &_yId, &Vector3D::Y, _gridSizeY, _offsetY },
+		{ &_zId, &Vector3D::Z, _gridSizeZ, _offsetZ }
+	};
+	gridCellIDs(axes, 2, n, localPositions, vIDs, cIDs);
+}
+
 std::vector<double> CartesianGridYZ::cellDimensions(const CellID&) const {
   return {_gridSizeY, _gridSizeZ};
 }
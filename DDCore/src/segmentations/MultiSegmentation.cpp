@@ -17,12 +17,32 @@
 #include <DD4hep/Printout.h>
 
 /// C/C++ include files
+#include <algorithm>
 #include <string>
+#include <vector>
 
 namespace dd4hep {
 
   namespace DDSegmentation {
 
+    namespace {
+      /// Maximal number of keys covered by the dense jump table
+      constexpr long MAX_TABLE_KEYS = 4096;
+
+      /// Counting sort of the item indices by sub-segmentation index
+      /** On return order[start[k]...start[k+1]-1] are the items of sub-segmentation k
+       */
+      void group_by_key(const std::vector<std::size_t>& keys, std::size_t num_keys,
+                        std::vector<std::size_t>& order, std::vector<std::size_t>& start)  {
+        start.assign(num_keys+1, 0);
+        order.resize(keys.size());
+        for( std::size_t k : keys ) ++start[k+1];
+        for( std::size_t k = 0; k < num_keys; ++k ) start[k+1] += start[k];
+        std::vector<std::size_t> fill(start.begin(), start.end()-1);
+        for( std::size_t i = 0; i < keys.size(); ++i ) order[fill[keys[i]]++] = i;
+      }
+    }
+
     /// default constructor using an encoding string
     MultiSegmentation::MultiSegmentation(const std::string& cellEncoding)
       :	Segmentation(cellEncoding), m_discriminator(0), m_debug(0)
@@ -59,6 +79,49 @@ namespace dd4hep {
       e.key_max = key_max;
       e.segmentation = entry;
       m_segmentations.emplace_back(e);
+      buildDispatch();
+    }
+
+    /// Compile the key ranges of all sub-segmentations into the dispatch tables
+    void MultiSegmentation::buildDispatch()  {
+      // Split the key axis at all range boundaries into disjoint intervals.
+      // Each interval is served by the first matching entry like the former linear search.
+      std::vector<long> bounds;
+      for( const auto& e : m_segmentations )  {
+        if ( e.key_min > e.key_max ) continue;
+        bounds.emplace_back(e.key_min);
+        bounds.emplace_back(e.key_max+1);
+      }
+      std::sort(bounds.begin(), bounds.end());
+      bounds.erase(std::unique(bounds.begin(), bounds.end()), bounds.end());
+
+      m_intervalKey.clear();
+      m_intervalEntry.clear();
+      for( long key : bounds )  {
+        int entry = -1;
+        for( std::size_t i = 0; i < m_segmentations.size(); ++i )  {
+          const Entry& e = m_segmentations[i];
+          if ( e.key_min <= key && e.key_max >= key )  {
+            entry = int(i);
+            break;
+          }
+        }
+        if ( m_intervalEntry.empty() || m_intervalEntry.back() != entry )  {
+          m_intervalKey.emplace_back(key);
+          m_intervalEntry.emplace_back(entry);
+        }
+      }
+      // Dense jump table if the key span is small
+      m_table.clear();
+      m_tableKey = 0;
+      if ( !bounds.empty() && bounds.back() - bounds.front() <= MAX_TABLE_KEYS )  {
+        m_tableKey = bounds.front();
+        m_table.resize(bounds.back() - bounds.front(), -1);
+        for( std::size_t j = 0; j+1 < m_intervalKey.size(); ++j )  {
+          std::fill(m_table.begin() + (m_intervalKey[j]   - m_tableKey),
+                    m_table.begin() + (m_intervalKey[j+1] - m_tableKey), m_intervalEntry[j]);
+        }
+      }
     }
 
     /// Set the underlying decoder
@@ -69,29 +132,41 @@ namespace dd4hep {
       m_discriminator = &((*_decoder)[m_discriminatorId]);
     }
 
-    /// 
-    const Segmentation& MultiSegmentation::subsegmentation(const CellID& cID)   const  {
+    /// Index of the subsegmentation entry by discriminator value. Returns -1 if no entry matches
+    int MultiSegmentation::subsegmentationIndexByKey(long key)   const  {
+      if ( !m_table.empty() )  {
+        // Unsigned compare also rejects keys below the table start
+        unsigned long idx = (unsigned long)(key - m_tableKey);
+        return idx < m_table.size() ? m_table[idx] : -1;
+      }
+      auto i = std::upper_bound(m_intervalKey.begin(), m_intervalKey.end(), key);
+      return i == m_intervalKey.begin() ? -1 : m_intervalEntry[(i - m_intervalKey.begin()) - 1];
+    }
+
+    /// Index of the subsegmentation entry by cell identifier
+    std::size_t MultiSegmentation::subsegmentationIndex(const CellID& cID)   const  {
       if ( m_discriminator )  {
-        long seg_id = m_discriminator->value(cID);
-        for(Segmentations::const_iterator i=m_segmentations.begin(); i != m_segmentations.end(); ++i)  {
-          const Entry& e = *i; 
-          if ( e.key_min<= seg_id && e.key_max >= seg_id )  {
-            Segmentation* s = e.segmentation;
-            if ( m_debug > 0 )  {
-              printout(ALWAYS,"MultiSegmentation","Id: %04X %s", seg_id, s->name().c_str());
-              const Parameters& pars = s->parameters();
-              for( const auto* p : pars )  {
-                printout(ALWAYS,"MultiSegmentation"," Param  %s = %s",
-                         p->name().c_str(), p->value().c_str());
-              }
-            }
-            return *s;
-          }
-        }
+        int idx = subsegmentationIndexByKey(m_discriminator->value(cID));
+        if ( idx >= 0 )
+          return std::size_t(idx);
       }
       except("MultiSegmentation", "Invalid sub-segmentation identifier!");
       throw std::string("Invalid sub-segmentation identifier!");
     }
+
+    /// 
+    const Segmentation& MultiSegmentation::subsegmentation(const CellID& cID)   const  {
+      Segmentation* s = m_segmentations[subsegmentationIndex(cID)].segmentation;
+      if ( m_debug > 0 )  {
+        printout(ALWAYS,"MultiSegmentation","Id: %04X %s", m_discriminator->value(cID), s->name().c_str());
+        const Parameters& pars = s->parameters();
+        for( const auto* p : pars )  {
+          printout(ALWAYS,"MultiSegmentation"," Param  %s = %s",
+                   p->name().c_str(), p->value().c_str());
+        }
+      }
+      return *s;
+    }
      
     /// determine the position based on the cell ID
     Vector3D MultiSegmentation::position(const CellID& cID) const {
@@ -103,6 +178,50 @@ namespace dd4hep {
       return subsegmentation(vID).cellID(localPosition, globalPosition, vID);
     }
 
+    /// determine the positions of n cell IDs. The cells are processed in batches per sub-segmentation
+    void MultiSegmentation::positions(std::size_t n, const CellID* cIDs, Vector3D* localPositions) const  {
+      std::vector<std::size_t> keys(n), order, start;
+      for( std::size_t i = 0; i < n; ++i )
+        keys[i] = subsegmentationIndex(cIDs[i]);
+      group_by_key(keys, m_segmentations.size(), order, start);
+
+      std::vector<CellID>   ids(n);
+      std::vector<Vector3D> pos(n);
+      for( std::size_t j = 0; j < n; ++j )
+        ids[j] = cIDs[order[j]];
+      for( std::size_t k = 0; k < m_segmentations.size(); ++k )  {
+        if ( start[k+1] > start[k] )
+          m_segmentations[k].segmentation->positions(start[k+1]-start[k], &ids[start[k]], &pos[start[k]]);
+      }
+      for( std::size_t j = 0; j < n; ++j )
+        localPositions[order[j]] = pos[j];
+    }
+
+    /// determine the cell IDs of n positions. The positions are processed in batches per sub-segmentation
+    void MultiSegmentation::cellIDs(std::size_t n, const Vector3D* localPositions, const Vector3D* globalPositions,
+                                    const VolumeID* vIDs, CellID* cIDs) const  {
+      std::vector<std::size_t> keys(n), order, start;
+      for( std::size_t i = 0; i < n; ++i )
+        keys[i] = subsegmentationIndex(vIDs[i]);
+      group_by_key(keys, m_segmentations.size(), order, start);
+
+      std::vector<Vector3D> local(n), global(n);
+      std::vector<VolumeID> vols(n);
+      std::vector<CellID>   ids(n);
+      for( std::size_t j = 0; j < n; ++j )  {
+        local[j]  = localPositions[order[j]];
+        global[j] = globalPositions[order[j]];
+        vols[j]   = vIDs[order[j]];
+      }
+      for( std::size_t k = 0; k < m_segmentations.size(); ++k )  {
+        std::size_t b = start[k], cnt = start[k+1]-start[k];
+        if ( cnt > 0 )
+          m_segmentations[k].segmentation->cellIDs(cnt, &local[b], &global[b], &vols[b], &ids[b]);
+      }
+      for( std::size_t j = 0; j < n; ++j )
+        cIDs[order[j]] = ids[j];
+    }
+
     std::vector<double> MultiSegmentation::cellDimensions(const CellID& cID) const {
       return subsegmentation(cID).cellDimensions(cID);
     }
@@ -62,6 +62,27 @@ namespace dd4hep {
       throw std::runtime_error("This segmentation type:"+_type+" does not support sub-segmentations.");
     }
 
+    /// Initializing constructor
+    Segmentation::BatchField::BatchField(const BitFieldElement& element)
+      : mask(element.mask()),
+        sign(element.isSigned() ? CellID(1) << (element.width()-1) : CellID(0)),
+        minValue(element.minValue()), maxValue(element.maxValue()), offset(element.offset())
+    {
+    }
+
+    /// Determine the local positions of n cell IDs. Default implementation calls position() for each cell
+    void Segmentation::positions(std::size_t n, const CellID* cIDs, Vector3D* localPositions) const  {
+      for (std::size_t i = 0; i < n; ++i)
+        localPositions[i] = position(cIDs[i]);
+    }
+
+    /// Determine the cell IDs of n positions. Default implementation calls cellID() for each position
+    void Segmentation::cellIDs(std::size_t n, const Vector3D* localPositions, const Vector3D* globalPositions,
+                               const VolumeID* vIDs, CellID* cIDs) const  {
+      for (std::size_t i = 0; i < n; ++i)
+        cIDs[i] = cellID(localPositions[i], globalPositions[i], vIDs[i]);
+    }
+
     /// Determine the volume ID from the full cell ID by removing all local fields
     VolumeID Segmentation::volumeID(const CellID& cID) const {
       map<std::string, StringParameter>::const_iterator it;
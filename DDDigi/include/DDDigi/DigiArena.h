@@ -0,0 +1,129 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDDIGI_DIGIARENA_H
+#define DDDIGI_DIGIARENA_H
+
+/// C/C++ include files
+#include <memory_resource>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Digitization part of the AIDA detector description toolkit
+  namespace digi {
+
+    /// Per-event memory arena for the data segments of a DigiEvent
+    /**
+     *  Monotonic bump allocator: memory is taken from large blocks and never
+     *  returned individually. All blocks are released in one go by reset()
+     *  or when the arena is destroyed at the end of the event.
+     *
+     *  If the arena is disabled, every request is forwarded to the upstream
+     *  resource (new/delete). The counters are filled in both modes so that
+     *  the memory traffic of the two layouts can be compared.
+     *
+     *  Allocations are serialized by an internal lock: the data segments of
+     *  one event may be filled by several threads.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiArena : public std::pmr::memory_resource  {
+    public:
+      /// Allocation counters
+      struct counters_t  {
+        /// Number of allocation requests
+        std::uint64_t allocations   { 0 };
+        /// Number of deallocation requests
+        std::uint64_t deallocations { 0 };
+        /// Total number of bytes requested
+        std::uint64_t bytes         { 0 };
+        /// Number of blocks (arena) or upstream allocations (no arena)
+        std::uint64_t blocks        { 0 };
+        /// Total number of bytes taken from the upstream resource
+        std::uint64_t reserved      { 0 };
+        /// Number of resets
+        std::uint64_t resets        { 0 };
+        /// Accumulate counters
+        counters_t& operator+=(const counters_t& c);
+      };
+
+    protected:
+      /// Memory block of the arena
+      struct block_t  {
+        unsigned char* data;
+        std::size_t    size;
+      };
+      /// Upstream memory resource
+      std::pmr::memory_resource* m_upstream  { nullptr };
+      /// Allocated blocks
+      std::vector<block_t>       m_blocks    { };
+      /// Current allocation pointer in the last block
+      unsigned char*             m_current   { nullptr };
+      /// Remaining bytes in the last block
+      std::size_t                m_available { 0 };
+      /// Size of the next block
+      std::size_t                m_next_size { 0 };
+      /// Allocation counters
+      counters_t                 m_counters  { };
+      /// Allocation lock
+      std::mutex                 m_lock;
+      /// Flag to enable the arena. If false requests are forwarded upstream
+      bool                       m_enabled   { true };
+
+      /// Allocate a new block big enough for the request
+      void add_block(std::size_t bytes, std::size_t alignment);
+
+      /// std::pmr::memory_resource overload: allocate memory
+      virtual void* do_allocate(std::size_t bytes, std::size_t alignment)  override;
+      /// std::pmr::memory_resource overload: deallocate memory (no-op in arena mode)
+      virtual void  do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment)  override;
+      /// std::pmr::memory_resource overload: identity check
+      virtual bool  do_is_equal(const std::pmr::memory_resource& other)  const noexcept  override;
+
+    public:
+      /// Default size of the first block
+      static constexpr std::size_t DEFAULT_BLOCK_SIZE = 64*1024;
+
+      /// Initializing constructor
+      DigiArena(bool enabled = true, std::size_t initial_size = DEFAULT_BLOCK_SIZE,
+                std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+      /// Inhibit move constructor
+      DigiArena(DigiArena&& copy) = delete;
+      /// Inhibit copy constructor
+      DigiArena(const DigiArena& copy) = delete;
+      /// Default destructor. Releases all blocks and accumulates the global counters
+      virtual ~DigiArena();
+      /// Inhibit move assignment
+      DigiArena& operator=(DigiArena&& copy) = delete;
+      /// Inhibit copy assignment
+      DigiArena& operator=(const DigiArena& copy) = delete;
+
+      /// Check if the arena is enabled
+      bool enabled()  const                {  return m_enabled;    }
+      /// Access the allocation counters of this arena
+      const counters_t& counters()  const  {  return m_counters;   }
+      /// Release all blocks at once. All memory obtained from the arena becomes invalid
+      void reset();
+
+      /// Access the accumulated counters of all arenas destroyed so far
+      static counters_t total_counters();
+    };
+  }    // End namespace digi
+}      // End namespace dd4hep
+#endif // DDDIGI_DIGIARENA_H
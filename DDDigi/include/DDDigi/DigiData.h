@@ -15,6 +15,7 @@
 
 /// Framework include files
 #include <DD4hep/Objects.h>
+#include <DDDigi/DigiArena.h>
 
 /// C/C++ include files
 #include <cstdint>
@@ -23,6 +24,7 @@
 #include <mutex>
 #include <map>
 #include <any>
+#include <vector>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -40,6 +42,7 @@ namespace dd4hep {
     class EnergyDeposit;
     class ParticleMapping;
     class DepositMapping;
+    class DepositSortedVector;
     class DigiEvent;
     class DataSegment;
 
@@ -613,10 +616,14 @@ namespace dd4hep {
       std::size_t merge(DepositMapping&& updates);
       /// Merge new deposit map onto existing map (destroys inputs. not thread safe!)
       std::size_t merge(const DepositMapping& updates);
+      /// Merge new deposit map onto existing vector (destroys inputs. not thread safe!)
+      std::size_t merge(DepositSortedVector&& updates);
       /// Merge new deposit map onto existing vector (keep inputs. not thread safe!)
       std::size_t insert(const DepositVector& updates);
       /// Merge new deposit map onto existing map (keep inputs. not thread safe!)
       std::size_t insert(const DepositMapping& updates);
+      /// Merge new deposit map onto existing vector (keep inputs. not thread safe!)
+      std::size_t insert(const DepositSortedVector& updates);
       /// Emplace entry
       void emplace(CellID cell, EnergyDeposit&& deposit);
 
@@ -725,6 +732,110 @@ namespace dd4hep {
     {
     }
 
+    /// Energy deposit container sorted by cell identifier
+    /**
+     *  Drop-in alternative to the DepositMapping: same ordering and merge semantics,
+     *  but the deposits are stored in one contiguous vector sorted by cellID.
+     *  Lookups are binary searches, merges are linear merges of sorted ranges.
+     *  Entries with identical cellID keep their insertion order.
+     *
+     *  The deposits are allocated from the memory resource given at construction,
+     *  typically the arena of the event: the payload is then released in one go
+     *  with the event. Containers moved into a data segment keep their resource.
+     *  The deposits are not persistent.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DepositSortedVector : public SegmentEntry  {
+    public: 
+      using container_t    = std::pmr::vector<std::pair<CellID, EnergyDeposit> >;
+      using value_type     = container_t::value_type;
+      using mapped_type    = container_t::value_type::second_type;
+      using key_type       = container_t::value_type::first_type;
+      using iterator       = container_t::iterator;
+      using const_iterator = container_t::const_iterator;
+    protected:
+      container_t    data      { };  //! not persistent
+
+      /// Merge updates onto the sorted data. Deposits of existing cells are combined
+      void merge_entries(container_t&& updates);
+      /// Add updates to the sorted data keeping all entries
+      void insert_entries(container_t&& updates);
+
+    public: 
+      /// Initializing constructor
+      DepositSortedVector(const std::string& name, Key::mask_type mask, data_type_t typ);
+      /// Initializing constructor with the memory resource of the deposits (e.g. the event arena)
+      DepositSortedVector(const std::string& name, Key::mask_type mask, data_type_t typ,
+                          std::pmr::memory_resource* resource);
+      /// Default constructor
+      DepositSortedVector() = default;
+      /// Disable move constructor
+      DepositSortedVector(DepositSortedVector&& copy) = default;
+      /// Disable copy constructor
+      DepositSortedVector(const DepositSortedVector& copy) = default;      
+      /// Default destructor
+      virtual ~DepositSortedVector() = default;
+      /// Disable move assignment
+      DepositSortedVector& operator=(DepositSortedVector&& copy) = default;
+      /// Disable copy assignment
+      DepositSortedVector& operator=(const DepositSortedVector& copy) = default;      
+      /// Merge new deposits: deposits of existing cells are combined (destroys inputs. not thread safe!)
+      std::size_t merge(DepositSortedVector&& updates);
+      /// Merge new deposits: deposits of existing cells are combined (destroys inputs. not thread safe!)
+      std::size_t merge(DepositMapping&& updates);
+      /// Merge new deposits: deposits of existing cells are combined (destroys inputs. not thread safe!)
+      std::size_t merge(DepositVector&& updates);
+      /// Add all deposits (keep inputs. not thread safe!)
+      std::size_t insert(const DepositSortedVector& updates);
+      /// Add all deposits (keep inputs. not thread safe!)
+      std::size_t insert(const DepositMapping& updates);
+      /// Add all deposits (keep inputs. not thread safe!)
+      std::size_t insert(const DepositVector& updates);
+      /// Emplace entry at the end of the range of equal cellIDs
+      void emplace(CellID cell, EnergyDeposit&& deposit);
+      /// Reserve space for entries
+      void reserve(std::size_t len)       { this->data.reserve(len);         }
+      /// Access container size
+      std::size_t size()  const           { return this->data.size();        }
+      /// Check container if empty
+      bool        empty() const           { return this->data.empty();       }
+      /// Access energy deposit by key
+      const EnergyDeposit& get(CellID cell)   const;
+      /// Find first entry with the given cellID
+      iterator find(CellID cell);
+      /// Find first entry with the given cellID (CONST)
+      const_iterator find(CellID cell)  const;
+      /// Range of entries with the given cellID (CONST)
+      std::pair<const_iterator, const_iterator> equal_range(CellID cell)  const;
+      /** Iteration support */
+      /// Begin iteration
+      iterator begin()                    { return this->data.begin();       }
+      /// End iteration
+      iterator end()                      { return this->data.end();         }
+      /// Begin iteration (CONST)
+      const_iterator begin() const        { return this->data.begin();       }
+      /// End iteration (CONST)
+      const_iterator end()   const        { return this->data.end();         }
+      /// Remove entry
+      void remove(iterator position);
+    };
+
+    /// Initializing constructor
+    inline DepositSortedVector::DepositSortedVector(const std::string& nam, Key::mask_type msk, data_type_t typ)
+      : SegmentEntry(nam, msk, typ)
+    {
+    }
+
+    /// Initializing constructor with the memory resource of the deposits (e.g. the event arena)
+    inline DepositSortedVector::DepositSortedVector(const std::string& nam, Key::mask_type msk, data_type_t typ,
+                                                    std::pmr::memory_resource* resource)
+      : SegmentEntry(nam, msk, typ), data(resource)
+    {
+    }
+
     class ADCValue   {
     public:
       using value_t = uint32_t;
@@ -963,11 +1074,26 @@ namespace dd4hep {
     class DataSegment   {
     public:
       using key_t = Key::key_type;
-      using container_map_t = std::map<Key, std::any>;
+      using container_map_t = std::pmr::map<Key, std::any>;
       using iterator        = container_map_t::iterator;
       using const_iterator  = container_map_t::const_iterator;
 
     private:
+      /// Slot of the open addressing key index
+      struct index_slot_t  {
+        key_t     key  { 0 };
+        std::any* item { nullptr };
+      };
+      /// Open addressing key index (linear probing) pointing into the data map
+      std::pmr::vector<index_slot_t> m_index;
+
+      /// Insert a new entry into the key index
+      void index_insert(key_t key, std::any* item);
+      /// Rebuild the key index from the data map (after removals)
+      void index_rebuild();
+      /// Lookup of an entry in the key index
+      std::any* index_find(key_t key)  const;
+
       /// Call on failed any-casts
       std::string invalid_cast(Key key, const std::type_info& type)  const;
       /// Call on failed data requests during data requests
@@ -983,8 +1109,8 @@ namespace dd4hep {
       std::mutex&       lock;
       Key::segment_type id  { 0 };
     public:
-      /// Initializing constructor
-      DataSegment(std::mutex& lock, Key::segment_type id);
+      /// Initializing constructor. Node memory is taken from the memory resource (default: new/delete)
+      DataSegment(std::mutex& lock, Key::segment_type id, std::pmr::memory_resource* resource = nullptr);
       /// Default constructor
       DataSegment() = delete;
       /// Disable move constructor
@@ -1105,6 +1231,8 @@ namespace dd4hep {
       std::mutex  m_lock;
       /// String identifier of this event (for debug printouts)
       std::string m_id;
+      /// Memory arena of the data segments. Must be destroyed after the segments
+      DigiArena   m_arena;
       /// Reference to the general purpose data segment
       segment_t m_data;
       /// Reference to the counts data segment
@@ -1133,11 +1261,15 @@ namespace dd4hep {
       /// Inhibit copy constructor
       DigiEvent(const DigiEvent& copy) = delete;
       /// Intializing constructor
-      DigiEvent(int num);
+      DigiEvent(int num, bool use_arena = true);
       /// Default destructor
       virtual ~DigiEvent();
       /// String identifier of this event
       const char* id()   const    {   return this->m_id.c_str();   }
+      /// Access to the memory arena of the data segments
+      const DigiArena& arena()  const  {   return this->m_arena;   }
+      /// Access to the memory arena to allocate event data
+      DigiArena& arena()               {   return this->m_arena;   }
       /// Retrieve data segment from the event structure by name
       DataSegment& get_segment(const std::string& name);
       /// Retrieve data segment from the event structure by name (CONST)
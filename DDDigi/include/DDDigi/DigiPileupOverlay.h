@@ -0,0 +1,130 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDDIGI_DIGIPILEUPOVERLAY_H
+#define DDDIGI_DIGIPILEUPOVERLAY_H
+
+/// Framework include files
+#include <DDDigi/DigiEventAction.h>
+#include <DDDigi/DigiData.h>
+
+/// C/C++ include files
+#include <atomic>
+#include <mutex>
+#include <set>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Digitization part of the AIDA detector description toolkit
+  namespace digi {
+
+    /// Pile-up overlay from a pool of background events kept in memory
+    /**
+     *  At the first event the pool is filled once with 'pool_size' background
+     *  events read by an input action of type 'reader_type' from the files 'input'.
+     *  The deposit containers of each pool event are stored sorted by cellID.
+     *
+     *  For every signal event 'overlays' pool events are sampled with the
+     *  random generator of the event (Poisson distributed if 'poisson' is set).
+     *  If 'sequential' is set, the pool events are taken in order instead:
+     *  overlay i of the k-th processed event uses pool event i*events_per_file+k,
+     *  i.e. the k-th event of the i-th input file as with one reader per file.
+     *  Without 'events_per_file' pool event k*overlays+i is used.
+     *  The sampled containers with identical names are combined with a k-way merge
+     *  of the sorted pool containers. Deposits of identical cells are combined.
+     *  The resulting DepositSortedVector containers are added with the output mask
+     *  to the output segment. By default this is the input segment of a subsequent
+     *  DigiContainerCombine action, which merges the pile-up with the signal
+     *  containers like any other input.
+     *
+     *  The deposit history of pool events is dropped: the raw records
+     *  of the background events are not part of the signal event.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_DIGITIZATION
+     */
+    class DigiPileupOverlay : public DigiEventAction   {
+    public:
+      /// Deposit container of one pool event
+      class pool_container_t   {
+      public:
+        Key::itemkey_type    item  { 0 };
+        DepositSortedVector  deposits { };
+      };
+      /// Pool event
+      class pool_event_t   {
+      public:
+        std::vector<pool_container_t> containers { };
+      };
+
+    protected:
+      /// Property: Input action type used to fill the pool
+      std::string                    m_reader_type    { "DigiDDG4ROOT" };
+      /// Property: Input data specification of the background events
+      std::vector<std::string>       m_input          { };
+      /// Property: Container names to be loaded (empty: all deposit containers)
+      std::vector<std::string>       m_containers     { };
+      /// Property: Number of background events kept in memory
+      int                            m_pool_size      { 100 };
+      /// Property: Number of overlays per signal event (mean value if Poisson distributed)
+      double                         m_overlays       { 1e0 };
+      /// Property: Flag to draw the number of overlays from a Poisson distribution
+      bool                           m_poisson        { false };
+      /// Property: Flag to take the pool events in order instead of random sampling
+      bool                           m_sequential     { false };
+      /// Property: Maximal number of events read from each input file (0: all)
+      int                            m_events_per_file { 0 };
+      /// Property: Output data segment name
+      std::string                    m_output_segment { "inputs" };
+      /// Property: Mask of the output deposits
+      int                            m_output_mask    { 0 };
+
+      /// Container keys of all containers to be used
+      std::set<Key::itemkey_type>    m_cont_keys      { };
+      /// Reader filling the pool. Kept until the end of the job: it registered kernel callbacks
+      mutable DigiEventAction*       m_reader         { nullptr };
+      /// Background event pool (read-only once filled)
+      mutable std::vector<pool_event_t> m_pool        { };
+      /// Flag to fill the pool exactly once
+      mutable std::once_flag         m_pool_once;
+      /// Number of processed events (sequential mode)
+      mutable std::atomic<long>      m_num_events     { 0 };
+
+    protected:
+      /// Define standard assignments and constructors
+      DDDIGI_DEFINE_ACTION_CONSTRUCTORS(DigiPileupOverlay);
+
+      /// Default destructor
+      virtual ~DigiPileupOverlay();
+
+      /// Initializing function: compute values which depend on properties
+      void initialize();
+
+      /// Read the background events into the pool
+      void fill_pool()  const;
+
+      /// K-way merge of sorted deposit containers. Deposits of identical cells are combined
+      std::size_t merge_sorted(const std::vector<const DepositSortedVector*>& inputs,
+                               DepositSortedVector& output)  const;
+
+    public:
+      /// Standard constructor
+      DigiPileupOverlay(const kernel_t& kernel, const std::string& name);
+
+      /// Main functional callback
+      virtual void execute(context_t& context)  const;
+    };
+  }    // End namespace digi
+}      // End namespace dd4hep
+#endif // DDDIGI_DIGIPILEUPOVERLAY_H
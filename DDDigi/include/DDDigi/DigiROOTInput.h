@@ -34,6 +34,14 @@ namespace dd4hep {
 
     /// Base class for input actions to the digitization using ROOT
     /**
+     *  Two reading modes are supported:
+     *  - prefetch = 0: the worker executing the event reads the branches
+     *    while holding the global I/O lock (default).
+     *  - prefetch > 0: a dedicated reader thread reads and deserializes up to
+     *    'prefetch' events ahead into a bounded queue. Workers only pop fully
+     *    materialized events and never take the global I/O lock.
+     *    The objects handed to the branch callback are then owned by the event
+     *    and are deleted after the callback.
      *
      *  \author  M.Frank
      *  \version 1.0
@@ -56,12 +64,40 @@ namespace dd4hep {
       public:
 	DataSegment& segment;
 	container_t& container;
+	/// Pointer to the object read from the branch
+	void*        object  { nullptr };
+      };
+      /// Counters of the prefetching reader
+      class prefetch_counters_t   {
+      public:
+	/// Number of events read ahead
+	std::size_t events         { 0 };
+	/// Number of bytes read ahead
+	std::size_t bytes          { 0 };
+	/// Number of times the reader waited for a free queue slot
+	std::size_t reader_stalls  { 0 };
+	/// Number of times a worker waited for an event
+	std::size_t worker_stalls  { 0 };
+	/// Time spent by the reader to read and deserialize events [seconds]
+	double      read_time      { 0e0 };
+	/// Time the reader waited for a free queue slot [seconds]
+	double      reader_wait    { 0e0 };
+	/// Time workers waited for an event [seconds]
+	double      worker_wait    { 0e0 };
       };
 
 
     protected:
       /// Connection parameters to the "current" input source
       mutable std::unique_ptr<internals_t> imp;
+      /// Property: Number of events read ahead by the reader thread (0: no prefetching)
+      int m_prefetch_depth  { 0 };
+
+    protected:
+      /// Initialize callback: start the prefetching reader if requested
+      void initialize();
+      /// Terminate callback: stop the prefetching reader and print the counters
+      void terminate();
 
     protected:
       /// Define standard assignments and constructors
@@ -73,6 +109,8 @@ namespace dd4hep {
       /// Default destructor
       virtual ~DigiROOTInput();
 
+      /// Access the counters of the prefetching reader
+      prefetch_counters_t prefetch_counters()  const;
       /// Callback to read event input
       virtual void execute(DigiContext& context)  const override;
       /// Callback to handle single branch
@@ -70,8 +70,8 @@ namespace dd4hep {
 	  const DepositPredicate<EnergyCut> predicate ({ this->epsilon });
 	  len = data.size();
 	  data_io<ddg4_input>::_to_digi_if(data.get(), hits, predicate);
-	  data_io<ddg4_input>::_to_digi(Key(nam, segment.id, mask), hits, out);
 	  data.clear();
+	  data_io<ddg4_input>::_to_digi(Key(nam, segment.id, mask), hits, out);
 	}
 	info("%s+++ %-24s Converted %6ld DDG4 %-14s hits to %6ld cell deposits",
 	     context.event->id(), nam, len, tag.c_str(), out.size());
@@ -100,18 +100,18 @@ namespace dd4hep {
       /// Callback to handle single branch
       virtual void operator()(DigiContext& context, work_t& work)  const  override  {
 	TBranch& br = work.container.branch;
-	void**  add = (void**)br.GetAddress();
+	void*   obj = work.object;
 	int     msk = work.container.key.mask();
 	TClass* cls = &work.container.clazz;
 	auto&   seg = work.segment;
 	const char* nam = br.GetName();
 
 	if ( cls == m_caloHitClass )
-	  from_dd4g4<sim::Geant4Calorimeter::Hit>(context, seg, "calorimeter", msk, nam, *add);
+	  from_dd4g4<sim::Geant4Calorimeter::Hit>(context, seg, "calorimeter", msk, nam, obj);
 	else if ( cls == m_trackerHitClass )
-	  from_dd4g4<sim::Geant4Tracker::Hit>(context, seg, "tracker", msk, nam, *add);
+	  from_dd4g4<sim::Geant4Tracker::Hit>(context, seg, "tracker", msk, nam, obj);
 	else if ( cls == m_particlesClass )
-	  from_dd4g4(context, seg, msk, nam, *add);
+	  from_dd4g4(context, seg, msk, nam, obj);
 	else
 	  except("Unknown data type encountered in branch: %s", nam);
       }
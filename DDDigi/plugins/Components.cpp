@@ -54,6 +54,9 @@ DECLARE_DIGIACTION_NS(dd4hep::digi,DigiContainerCombine)
 #include <DDDigi/DigiContainerDrop.h>
 DECLARE_DIGIACTION_NS(dd4hep::digi,DigiContainerDrop)
 
+#include <DDDigi/DigiPileupOverlay.h>
+DECLARE_DIGIACTION_NS(dd4hep::digi,DigiPileupOverlay)
+
 #include <DDDigi/DigiSegmentSplitter.h>
 DECLARE_DIGIACTION_NS(dd4hep::digi,DigiSegmentSplitter)
 
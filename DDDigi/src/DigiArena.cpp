@@ -0,0 +1,117 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+/// Framework include files
+#include <DDDigi/DigiArena.h>
+
+/// C/C++ include files
+#include <algorithm>
+
+using namespace dd4hep::digi;
+
+namespace  {
+  /// Accumulated counters of all destroyed arenas
+  std::mutex             s_total_lock;
+  DigiArena::counters_t  s_total;
+}
+
+/// Accumulate counters
+DigiArena::counters_t& DigiArena::counters_t::operator+=(const counters_t& c)   {
+  allocations   += c.allocations;
+  deallocations += c.deallocations;
+  bytes         += c.bytes;
+  blocks        += c.blocks;
+  reserved      += c.reserved;
+  resets        += c.resets;
+  return *this;
+}
+
+/// Initializing constructor
+DigiArena::DigiArena(bool enabled, std::size_t initial_size, std::pmr::memory_resource* upstream)
+  : m_upstream(upstream), m_next_size(initial_size), m_enabled(enabled)
+{
+}
+
+/// Default destructor. Releases all blocks and accumulates the global counters
+DigiArena::~DigiArena()   {
+  this->reset();
+  std::lock_guard<std::mutex> lock(s_total_lock);
+  s_total += m_counters;
+}
+
+/// Access the accumulated counters of all arenas destroyed so far
+DigiArena::counters_t DigiArena::total_counters()   {
+  std::lock_guard<std::mutex> lock(s_total_lock);
+  return s_total;
+}
+
+/// Allocate a new block big enough for the request
+void DigiArena::add_block(std::size_t bytes, std::size_t alignment)   {
+  std::size_t size = std::max(m_next_size, bytes + alignment);
+  unsigned char* data = static_cast<unsigned char*>(m_upstream->allocate(size, alignof(std::max_align_t)));
+  m_blocks.emplace_back(block_t { data, size });
+  m_current   = data;
+  m_available = size;
+  m_next_size = 2*size;
+  ++m_counters.blocks;
+  m_counters.reserved += size;
+}
+
+/// std::pmr::memory_resource overload: allocate memory
+void* DigiArena::do_allocate(std::size_t bytes, std::size_t alignment)   {
+  std::lock_guard<std::mutex> lock(m_lock);
+  ++m_counters.allocations;
+  m_counters.bytes += bytes;
+  if ( !m_enabled )   {
+    ++m_counters.blocks;
+    m_counters.reserved += bytes;
+    return m_upstream->allocate(bytes, alignment);
+  }
+  std::size_t pad = (alignment - (reinterpret_cast<std::uintptr_t>(m_current) & (alignment-1))) & (alignment-1);
+  if ( !m_current || pad + bytes > m_available )   {
+    add_block(bytes, alignment);
+    pad = (alignment - (reinterpret_cast<std::uintptr_t>(m_current) & (alignment-1))) & (alignment-1);
+  }
+  void* ptr = m_current + pad;
+  m_current   += pad + bytes;
+  m_available -= pad + bytes;
+  return ptr;
+}
+
+/// std::pmr::memory_resource overload: deallocate memory (no-op in arena mode)
+void DigiArena::do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment)   {
+  std::lock_guard<std::mutex> lock(m_lock);
+  ++m_counters.deallocations;
+  if ( !m_enabled )   {
+    m_upstream->deallocate(ptr, bytes, alignment);
+  }
+}
+
+/// std::pmr::memory_resource overload: identity check
+bool DigiArena::do_is_equal(const std::pmr::memory_resource& other)  const noexcept   {
+  return this == &other;
+}
+
+/// Release all blocks at once. All memory obtained from the arena becomes invalid
+void DigiArena::reset()   {
+  std::lock_guard<std::mutex> lock(m_lock);
+  for( const auto& b : m_blocks )
+    m_upstream->deallocate(b.data, b.size, alignof(std::max_align_t));
+  if ( !m_blocks.empty() )   {
+    m_next_size = m_blocks.front().size;
+    ++m_counters.resets;
+  }
+  m_blocks.clear();
+  m_current   = nullptr;
+  m_available = 0;
+}
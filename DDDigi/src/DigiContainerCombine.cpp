@@ -111,6 +111,8 @@ public:
           merge_depos(out, *m, thr);
         else if ( DepositVector* v = std::any_cast<DepositVector>(work[j]) )
           merge_depos(out, *v, thr);
+        else if ( DepositSortedVector* s = std::any_cast<DepositSortedVector>(work[j]) )
+          merge_depos(out, *s, thr);
         else
           break;
         used_keys_insert(keys[j]);
@@ -200,6 +202,10 @@ public:
       else if ( DepositVector* depov = std::any_cast<DepositVector>(work[i]) )   {
         if ( combine->m_merge_deposits  ) merge(depov->name+opt, i, thr);
       }
+      /// Merge sorted deposit vector
+      else if ( DepositSortedVector* depos = std::any_cast<DepositSortedVector>(work[i]) )   {
+        if ( combine->m_merge_deposits  ) merge(depos->name+opt, i, thr);
+      }
       /// Merge detector response
       else if ( DetectorResponse* resp = std::any_cast<DetectorResponse>(work[i]) )   {
         if ( combine->m_merge_response  ) merge_response(resp->name+opt, i, thr);
@@ -66,6 +66,8 @@ template       DepositVector*    DigiContainerProcessor::work_t::get_input(bool
 template const DepositVector*    DigiContainerProcessor::work_t::get_input(bool exc)  const;
 template       DepositMapping*   DigiContainerProcessor::work_t::get_input(bool exc);
 template const DepositMapping*   DigiContainerProcessor::work_t::get_input(bool exc)  const;
+template       DepositSortedVector* DigiContainerProcessor::work_t::get_input(bool exc);
+template const DepositSortedVector* DigiContainerProcessor::work_t::get_input(bool exc)  const;
 template       ParticleMapping*  DigiContainerProcessor::work_t::get_input(bool exc);
 template const ParticleMapping*  DigiContainerProcessor::work_t::get_input(bool exc)  const;
 template       DetectorHistory*  DigiContainerProcessor::work_t::get_input(bool exc);
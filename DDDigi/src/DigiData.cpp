@@ -20,6 +20,8 @@
 
 // C/C++ include files
 #include <mutex>
+#include <iterator>
+#include <algorithm>
 
 namespace   {
   struct digi_keys   {
@@ -245,6 +247,166 @@ void DepositVector::remove(iterator /* position */)   {
   //data.erase(position);
 }
 
+/// Merge new deposit map onto existing map (keep inputs)
+std::size_t DepositVector::merge(DepositSortedVector&& updates)    {
+  std::size_t update_size = updates.size();
+  std::size_t newlen = std::max(2*data.size(), data.size()+updates.size());
+  data.reserve(newlen);
+  for( auto& c : updates )    {
+    data.emplace_back(c.first, std::move(c.second));
+  }
+  return update_size;
+}
+
+/// Merge new deposit map onto existing map (keep inputs)
+std::size_t DepositVector::insert(const DepositSortedVector& updates)    {
+  std::size_t update_size = updates.size();
+  std::size_t newlen = std::max(2*data.size(), data.size()+updates.size());
+  data.reserve(newlen);
+  for( const auto& c : updates )    {
+    data.emplace_back(c);
+  }
+  return update_size;
+}
+
+namespace  {
+  /// Ordering of sorted deposits by cell identifier
+  struct cell_less   {
+    bool operator()(const DepositSortedVector::value_type& a, const DepositSortedVector::value_type& b)  const
+    {  return a.first < b.first;   }
+    bool operator()(const DepositSortedVector::value_type& a, CellID b)  const
+    {  return a.first < b;         }
+    bool operator()(CellID a, const DepositSortedVector::value_type& b)  const
+    {  return a < b.first;         }
+  };
+}
+
+/// Merge updates onto the sorted data. Deposits of existing cells are combined
+void DepositSortedVector::merge_entries(container_t&& updates)    {
+  // Same result as the sequential DepositMapping::merge: every update is folded into
+  // the first deposit of its cell. Cells not yet present are added.
+  std::stable_sort(updates.begin(), updates.end(), cell_less());
+  container_t out(data.get_allocator());
+  out.reserve(data.size() + updates.size());
+  auto d = data.begin();
+  for( auto u = updates.begin(); u != updates.end(); )    {
+    CellID cell = u->first;
+    while( d != data.end() && d->first < cell )
+      out.emplace_back(std::move(*d++));
+    std::size_t target = out.size();
+    if ( d != data.end() && d->first == cell )   {
+      while( d != data.end() && d->first == cell )
+        out.emplace_back(std::move(*d++));
+    }
+    else   {
+      out.emplace_back(std::move(*u++));
+    }
+    for( ; u != updates.end() && u->first == cell; ++u )
+      out[target].second.update_deposit_weighted(std::move(u->second));
+  }
+  while( d != data.end() )
+    out.emplace_back(std::move(*d++));
+  data = std::move(out);
+}
+
+/// Add updates to the sorted data keeping all entries
+void DepositSortedVector::insert_entries(container_t&& updates)    {
+  // Equal cells: existing entries first, then the updates in their original order
+  std::stable_sort(updates.begin(), updates.end(), cell_less());
+  std::size_t len = data.size();
+  data.reserve(len + updates.size());
+  std::move(updates.begin(), updates.end(), std::back_inserter(data));
+  std::inplace_merge(data.begin(), data.begin()+len, data.end(), cell_less());
+}
+
+/// Merge new deposits: deposits of existing cells are combined
+std::size_t DepositSortedVector::merge(DepositSortedVector&& updates)    {
+  std::size_t update_size = updates.size();
+  merge_entries(std::move(updates.data));
+  updates.data.clear();
+  return update_size;
+}
+
+/// Merge new deposits: deposits of existing cells are combined
+std::size_t DepositSortedVector::merge(DepositMapping&& updates)    {
+  std::size_t update_size = updates.size();
+  container_t entries;
+  entries.reserve(update_size);
+  for( auto& c : updates )
+    entries.emplace_back(c.first, std::move(c.second));
+  merge_entries(std::move(entries));
+  return update_size;
+}
+
+/// Merge new deposits: deposits of existing cells are combined
+std::size_t DepositSortedVector::merge(DepositVector&& updates)    {
+  std::size_t update_size = updates.size();
+  container_t entries;
+  entries.reserve(update_size);
+  for( auto& c : updates )
+    entries.emplace_back(c.first, std::move(c.second));
+  merge_entries(std::move(entries));
+  return update_size;
+}
+
+/// Add all deposits (keep inputs)
+std::size_t DepositSortedVector::insert(const DepositSortedVector& updates)    {
+  insert_entries(container_t(updates.data));
+  return updates.size();
+}
+
+/// Add all deposits (keep inputs)
+std::size_t DepositSortedVector::insert(const DepositMapping& updates)    {
+  insert_entries(container_t(updates.begin(), updates.end()));
+  return updates.size();
+}
+
+/// Add all deposits (keep inputs)
+std::size_t DepositSortedVector::insert(const DepositVector& updates)    {
+  insert_entries(container_t(updates.begin(), updates.end()));
+  return updates.size();
+}
+
+/// Emplace entry at the end of the range of equal cellIDs
+void DepositSortedVector::emplace(CellID cell, EnergyDeposit&& deposit)    {
+  if ( data.empty() || !(cell < data.back().first) )
+    data.emplace_back(cell, std::move(deposit));
+  else
+    data.emplace(std::upper_bound(data.begin(), data.end(), cell, cell_less()), cell, std::move(deposit));
+}
+
+/// Access energy deposit by key
+const EnergyDeposit& DepositSortedVector::get(CellID cell)   const    {
+  auto iter = this->find(cell);
+  if ( iter != data.end() )
+    return iter->second;
+  except("DepositSortedVector","Failed to access deposit by CellID. UNKNOWN ID: %016X", cell);
+  throw std::runtime_error("Failed to access deposit by CellID");
+}
+
+/// Find first entry with the given cellID
+DepositSortedVector::iterator DepositSortedVector::find(CellID cell)    {
+  auto iter = std::lower_bound(data.begin(), data.end(), cell, cell_less());
+  return (iter != data.end() && iter->first == cell) ? iter : data.end();
+}
+
+/// Find first entry with the given cellID (CONST)
+DepositSortedVector::const_iterator DepositSortedVector::find(CellID cell)  const    {
+  auto iter = std::lower_bound(data.begin(), data.end(), cell, cell_less());
+  return (iter != data.end() && iter->first == cell) ? iter : data.end();
+}
+
+/// Range of entries with the given cellID (CONST)
+std::pair<DepositSortedVector::const_iterator, DepositSortedVector::const_iterator>
+DepositSortedVector::equal_range(CellID cell)  const    {
+  return std::equal_range(data.begin(), data.end(), cell, cell_less());
+}
+
+/// Remove entry
+void DepositSortedVector::remove(iterator position)   {
+  data.erase(position);
+}
+
 /// Merge new deposit map onto existing map
 std::size_t DepositMapping::merge(DepositVector&& updates)    {
   std::size_t update_size = updates.size();
@@ -402,11 +564,60 @@ std::size_t DetectorHistory::insert(const DetectorHistory& updates)   {
 }
 
 /// Initializing constructor
-DataSegment::DataSegment(std::mutex& l, Key::segment_type i)
-  : data(), lock(l), id(i)
+DataSegment::DataSegment(std::mutex& l, Key::segment_type i, std::pmr::memory_resource* resource)
+  : m_index(resource ? resource : std::pmr::get_default_resource()),
+    data(resource ? resource : std::pmr::get_default_resource()), lock(l), id(i)
 {
 }
 
+namespace  {
+  /// Fibonacci hashing of the 64 bit key onto the index table
+  inline std::size_t index_hash(Key::key_type key, std::size_t mask)   {
+    return std::size_t((key * 0x9E3779B97F4A7C15UL) >> 32) & mask;
+  }
+}
+
+/// Insert a new entry into the key index
+void DataSegment::index_insert(key_t key, std::any* item)   {
+  // Keep the load factor below 1/2
+  if ( 2*(data.size()+1) > m_index.size() )   {
+    index_rebuild();
+    return;
+  }
+  std::size_t mask = m_index.size()-1;
+  for( std::size_t i = index_hash(key, mask); ; i = (i+1) & mask )   {
+    if ( !m_index[i].item )   {
+      m_index[i] = { key, item };
+      return;
+    }
+  }
+}
+
+/// Rebuild the key index from the data map (after removals)
+void DataSegment::index_rebuild()   {
+  std::size_t len = 16;
+  while( len < 4*data.size() ) len *= 2;
+  m_index.assign(len, index_slot_t());
+  std::size_t mask = len-1;
+  for( auto& e : data )   {
+    std::size_t i = index_hash(e.first.value(), mask);
+    while( m_index[i].item ) i = (i+1) & mask;
+    m_index[i] = { e.first.value(), &e.second };
+  }
+}
+
+/// Lookup of an entry in the key index
+std::any* DataSegment::index_find(key_t key)  const   {
+  if ( m_index.empty() )
+    return nullptr;
+  std::size_t mask = m_index.size()-1;
+  for( std::size_t i = index_hash(key, mask); m_index[i].item; i = (i+1) & mask )   {
+    if ( m_index[i].key == key )
+      return m_index[i].item;
+  }
+  return nullptr;
+}
+
 /// Remove data item from segment
 bool DataSegment::emplace_any(Key key, std::any&& item)    {
   bool has_value = item.has_value();
@@ -416,12 +627,15 @@ bool DataSegment::emplace_any(Key key, std::any&& item)    {
 	   yes_no(has_value), digiTypeName(item.type()).c_str());
 #endif
   std::lock_guard<std::mutex> l(lock);
-  bool ret = data.emplace(key, std::move(item)).second;
-  if ( !ret )   {
+  auto ret = data.emplace(key, std::move(item));
+  if ( ret.second )   {
+    index_insert(key.value(), &ret.first->second);
+  }
+  else   {
     except("DataSegment","Error in DataSegment map. Duplicate ID: segment:%04X mask:%04X Number:%d Value:%s",
 	   key.mask(), key.item(), yes_no(has_value));
   }
-  return ret;
+  return ret.second;
 }
 
 /// Access  data size
@@ -432,6 +646,7 @@ std::size_t DataParameters::size()  const    {
 template bool DataSegment::put(Key key, DataParameters&& data);
 template bool DataSegment::put(Key key, DepositVector&& data);
 template bool DataSegment::put(Key key, DepositMapping&& data);
+template bool DataSegment::put(Key key, DepositSortedVector&& data);
 template bool DataSegment::put(Key key, ParticleMapping&& data);
 template bool DataSegment::put(Key key, DetectorHistory&& data);
 template bool DataSegment::put(Key key, DetectorResponse&& data);
@@ -442,6 +657,7 @@ bool DataSegment::erase(Key key)    {
   auto iter = data.find(key);
   if ( iter != data.end() )   {
     data.erase(iter);
+    index_rebuild();
     return true;
   }
   return false;
@@ -458,6 +674,8 @@ std::size_t DataSegment::erase(const std::vector<Key>& keys)   {
       ++count;
     }
   }
+  if ( count > 0 )
+    index_rebuild();
   return count;
 }
 
@@ -488,11 +706,9 @@ std::string DataSegment::invalid_request(Key key)  const   {
 
 /// Access data item by key
 std::any* DataSegment::get_item(Key key, bool exc)   {
-  auto it = this->data.find(key);
-  if (it != this->data.end()) return &it->second;
+  if ( std::any* item = this->index_find(key.value()) ) return item;
   key.set_segment(0x0);
-  it = this->data.find(key);
-  if (it != this->data.end()) return &it->second;
+  if ( std::any* item = this->index_find(key.value()) ) return item;
 
   if ( exc ) throw std::runtime_error(invalid_request(std::move(key)));
   return nullptr;
@@ -500,11 +716,9 @@ std::any* DataSegment::get_item(Key key, bool exc)   {
 
 /// Access data item by key  (CONST)
 const std::any* DataSegment::get_item(Key key, bool exc)  const   {
-  auto it = this->data.find(key);
-  if (it != this->data.end()) return &it->second;
+  if ( const std::any* item = this->index_find(key.value()) ) return item;
   key.set_segment(0x0);
-  it = this->data.find(key);
-  if (it != this->data.end()) return &it->second;
+  if ( const std::any* item = this->index_find(key.value()) ) return item;
 
   if ( exc ) throw std::runtime_error(invalid_request(std::move(key)));
   return nullptr;
@@ -517,7 +731,7 @@ DigiEvent::DigiEvent()
 }
 
 /// Intializing constructor
-DigiEvent::DigiEvent(int ev_num) : eventNumber(ev_num)
+DigiEvent::DigiEvent(int ev_num, bool use_arena) : m_arena(use_arena), eventNumber(ev_num)
 {
   char text[32];
   ::snprintf(text, sizeof(text), "Ev:%06d ", ev_num);
@@ -528,6 +742,13 @@ DigiEvent::DigiEvent(int ev_num) : eventNumber(ev_num)
 /// Default destructor
 DigiEvent::~DigiEvent()
 {
+  /// Segments first: their nodes live in the arena, which is released in one go afterwards
+  m_data.reset();
+  m_counts.reset();
+  m_inputs.reset();
+  m_outputs.reset();
+  m_deposits.reset();
+  m_arena.reset();
   InstanceCount::decrement(this);
 }
 
@@ -538,7 +759,7 @@ DataSegment& DigiEvent::access_segment(std::unique_ptr<DataSegment>& segment, Ke
   std::lock_guard<std::mutex> guard(m_lock);
   /// Check again after holding the lock:
   if ( !segment )   {
-    segment = std::make_unique<DataSegment>(this->m_lock, id);
+    segment = std::make_unique<DataSegment>(this->m_lock, id, &this->m_arena);
   }
   return *segment;
 }
@@ -45,7 +45,7 @@ DigiInputAction::~DigiInputAction()   {
 /// Check if the number of events per file is reached
 bool DigiInputAction::fileLimitReached(input_source& source)   const    {
   if ( m_events_per_file > 0 )    {
-    if ( source.event_count > m_events_per_file )  {
+    if ( source.event_count >= m_events_per_file )  {
       return true;
     }
   }
@@ -59,7 +59,7 @@ void DigiInputAction::onOpenFile(input_source& source)    {
 
 /// Callback when a new event is processed
 void DigiInputAction::onProcessEvent(input_source& source, event_frame& /* frame */)   {
-  ++source.event_count = 0;
+  ++source.event_count;
 }
 
 /// Check if a event object should be loaded: Default YES unless inhibited by selection or veto
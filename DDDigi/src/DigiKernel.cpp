@@ -110,6 +110,8 @@ public:
   int                   num_threads;
   /// Property: Allow to stop execution from interactive prompt
   bool                  stop = false;
+  /// Property: Allocate the event data segments from a per-event memory arena
+  bool                  useEventArena = true;
 
 public:
   /// Default constructor
@@ -168,7 +170,7 @@ public:
       if ( todo >= 0 )   {
         int ev_num = kernel.internals->numEvents - todo;
 	std::unique_ptr<DigiContext> context = 
-	  std::make_unique<DigiContext>(this->kernel,std::make_unique<DigiEvent>(ev_num));
+	  std::make_unique<DigiContext>(this->kernel,std::make_unique<DigiEvent>(ev_num, kernel.internals->useEventArena));
 	context->set_random_generator(this->kernel.internals->random);
         kernel.executeEvent(std::move(context));
       }
@@ -186,6 +188,7 @@ DigiKernel::DigiKernel(Detector& description_ref)
   declareProperty("numThreads",       internals->num_threads);
   declareProperty("numEvents",        internals->numEvents = 10);
   declareProperty("stop",             internals->stop = false);
+  declareProperty("useEventArena",    internals->useEventArena = true);
   declareProperty("OutputLevels",     internals->clientLevels);
   auto* h = new DigiMonitorHandler(*this, "MonitorData");
   properties().add("MonitorOutput", h->property("MonitorOutput"));
@@ -487,6 +490,11 @@ int DigiKernel::run()   {
        "Total: %7.1f seconds %7.3f seconds/event",
        internals->numEvents-int(internals->events_todo), internals->numEvents,
        sec, sec/double(std::max(1,internals->numEvents)));
+  DigiArena::counters_t mem = DigiArena::total_counters();
+  info("+++ Event memory [%s]: %lu allocations %lu deallocations %lu bytes requested "
+       "%lu blocks %lu bytes reserved",
+       internals->useEventArena ? "arena" : "heap",
+       mem.allocations, mem.deallocations, mem.bytes, mem.blocks, mem.reserved);
   return 1;
 }
 
@@ -0,0 +1,198 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/InstanceCount.h>
+#include <DDDigi/DigiKernel.h>
+#include <DDDigi/DigiPlugins.h>
+#include <DDDigi/DigiContext.h>
+#include <DDDigi/DigiPileupOverlay.h>
+
+/// C/C++ include files
+#include <algorithm>
+#include <chrono>
+#include <map>
+
+using namespace dd4hep::digi;
+
+namespace  {
+  /// Add deposits to a pool event. Combines deposits of identical cells
+  template <typename DEPOSITS>
+  void add_to_pool(DigiPileupOverlay::pool_event_t& event, Key key, const DEPOSITS& deposits)   {
+    DigiPileupOverlay::pool_container_t cont;
+    cont.item     = key.item();
+    cont.deposits = DepositSortedVector(deposits.name, deposits.key.mask(), deposits.data_type);
+    cont.deposits.merge(DEPOSITS(deposits));
+    for( auto& dep : cont.deposits )
+      dep.second.history.drop();
+    event.containers.emplace_back(std::move(cont));
+  }
+}
+
+/// Standard constructor
+DigiPileupOverlay::DigiPileupOverlay(const DigiKernel& krnl, const std::string& nam)
+  : DigiEventAction(krnl, nam)
+{
+  declareProperty("reader_type",    m_reader_type);
+  declareProperty("input",          m_input);
+  declareProperty("containers",     m_containers);
+  declareProperty("pool_size",      m_pool_size);
+  declareProperty("overlays",       m_overlays);
+  declareProperty("poisson",        m_poisson);
+  declareProperty("sequential",     m_sequential);
+  declareProperty("events_per_file", m_events_per_file);
+  declareProperty("output_segment", m_output_segment);
+  declareProperty("output_mask",    m_output_mask);
+  m_kernel.register_initialize(std::bind(&DigiPileupOverlay::initialize,this));
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+DigiPileupOverlay::~DigiPileupOverlay() {
+  if ( m_reader ) m_reader->release();
+  InstanceCount::decrement(this);
+}
+
+/// Initializing function: compute values which depend on properties
+void DigiPileupOverlay::initialize()    {
+  for ( const auto& cont : m_containers )
+    m_cont_keys.emplace(Key(cont, 0x0).item());
+  if ( m_pool_size <= 0 )
+    except("+++ Invalid pool size: %d. The pool must hold at least one event.", m_pool_size);
+}
+
+/// Read the background events into the pool
+void DigiPileupOverlay::fill_pool()  const   {
+  auto start = std::chrono::steady_clock::now();
+  // The reader is released with the overlay: the kernel may invoke its terminate callback
+  m_reader = createAction<DigiEventAction>(m_reader_type, m_kernel, this->name()+"_Reader");
+  if ( !m_reader )   {
+    except("+++ Failed to create pool reader of type: %s", m_reader_type.c_str());
+  }
+  m_reader->property("input").set(m_input);
+  m_reader->property("segment").set(std::string("inputs"));
+  m_reader->property("events_per_file").set(m_events_per_file);
+
+  std::size_t num_deposits = 0;
+  m_pool.reserve(m_pool_size);
+  for( int i = 0; i < m_pool_size; ++i )   {
+    DigiContext context(m_kernel, std::make_unique<DigiEvent>(i, false));
+    try   {
+      m_reader->execute(context);
+    }
+    catch( const std::exception& e )   {
+      warning("+++ Pool filling stopped after %d events: %s", i, e.what());
+      break;
+    }
+    pool_event_t event;
+    for( const auto& entry : context.event->get_segment("inputs") )   {
+      Key key(entry.first);
+      if ( !m_cont_keys.empty() && m_cont_keys.find(key.item()) == m_cont_keys.end() )
+        continue;
+      if ( const auto* m = std::any_cast<DepositMapping>(&entry.second) )
+        add_to_pool(event, key, *m);
+      else if ( const auto* v = std::any_cast<DepositVector>(&entry.second) )
+        add_to_pool(event, key, *v);
+      else if ( const auto* s = std::any_cast<DepositSortedVector>(&entry.second) )
+        add_to_pool(event, key, *s);
+    }
+    for( const auto& c : event.containers )
+      num_deposits += c.deposits.size();
+    m_pool.emplace_back(std::move(event));
+  }
+  if ( m_pool.empty() )   {
+    except("+++ Failed to read any background event into the pool.");
+  }
+  std::chrono::duration<double> sec = std::chrono::steady_clock::now() - start;
+  info("+++ Filled pile-up pool with %ld events [%ld deposits] in %7.3f seconds",
+       m_pool.size(), num_deposits, sec.count());
+}
+
+/// K-way merge of sorted deposit containers. Deposits of identical cells are combined
+std::size_t DigiPileupOverlay::merge_sorted(const std::vector<const DepositSortedVector*>& inputs,
+                                            DepositSortedVector& output)  const
+{
+  using cursor_t = std::pair<DepositSortedVector::const_iterator, DepositSortedVector::const_iterator>;
+  std::vector<cursor_t>    cursors;
+  std::vector<std::size_t> heap;
+  std::size_t total = 0;
+
+  cursors.reserve(inputs.size());
+  heap.reserve(inputs.size());
+  for( const auto* in : inputs )   {
+    if ( !in->empty() )   {
+      heap.emplace_back(cursors.size());
+      cursors.emplace_back(in->begin(), in->end());
+      total += in->size();
+    }
+  }
+  // Min-heap on the current cellID. Equal cells are taken in input order
+  auto greater = [&cursors](std::size_t a, std::size_t b)   {
+    CellID ca = cursors[a].first->first, cb = cursors[b].first->first;
+    return ca > cb || (ca == cb && a > b);
+  };
+  std::make_heap(heap.begin(), heap.end(), greater);
+  output.reserve(output.size() + total);
+  while( !heap.empty() )   {
+    std::pop_heap(heap.begin(), heap.end(), greater);
+    auto& cursor = cursors[heap.back()];
+    const auto& entry = *cursor.first;
+    auto last = output.end();
+    if ( !output.empty() && (--last)->first == entry.first )
+      last->second.update_deposit_weighted(entry.second);
+    else
+      output.emplace(entry.first, EnergyDeposit(entry.second));
+    if ( ++cursor.first == cursor.second )
+      heap.pop_back();
+    else
+      std::push_heap(heap.begin(), heap.end(), greater);
+  }
+  return total;
+}
+
+/// Main functional callback
+void DigiPileupOverlay::execute(DigiContext& context)  const    {
+  std::call_once(m_pool_once, [this]() { this->fill_pool(); });
+
+  auto& event  = *context.event;
+  auto& random = context.randomGenerator();
+  std::size_t num_overlays = m_poisson
+    ? std::size_t(random.poisson(m_overlays)) : std::size_t(m_overlays);
+
+  // Sample the pool and group the containers by item
+  std::map<Key::itemkey_type, std::vector<const DepositSortedVector*> > groups;
+  std::size_t num_event = m_sequential ? std::size_t(m_num_events++) : 0;
+  for( std::size_t i = 0; i < num_overlays; ++i )   {
+    std::size_t idx = 0;
+    if ( !m_sequential )
+      idx = std::min(m_pool.size()-1, std::size_t(random.uniform(double(m_pool.size()))));
+    else if ( m_events_per_file > 0 )
+      idx = (i * m_events_per_file + num_event) % m_pool.size();
+    else
+      idx = (num_event * num_overlays + i) % m_pool.size();
+    for( const auto& c : m_pool[idx].containers )
+      groups[c.item].emplace_back(&c.deposits);
+  }
+
+  std::size_t num_deposits = 0, num_cells = 0;
+  auto& outputs = event.get_segment(m_output_segment);
+  for( const auto& group : groups )   {
+    const auto* first = group.second.front();
+    DepositSortedVector deposits(first->name, m_output_mask, first->data_type, &event.arena());
+    num_deposits += merge_sorted(group.second, deposits);
+    num_cells    += deposits.size();
+    outputs.put(Key(deposits.name, m_output_mask), std::move(deposits));
+  }
+  info("%s+++ Overlayed %ld pile-up events: %ld deposits in %ld cells to segment '%s'",
+       event.id(), num_overlays, num_deposits, num_cells, m_output_segment.c_str());
+}
@@ -19,6 +19,14 @@
 #include <TROOT.h>
 #include <TFile.h>
 #include <TTree.h>
+#include <TVirtualCollectionProxy.h>
+
+// C/C++ include files
+#include <condition_variable>
+#include <exception>
+#include <chrono>
+#include <thread>
+#include <deque>
 
 using namespace dd4hep::digi;
 
@@ -58,31 +66,206 @@ public:
  */
 class DigiROOTInput::internals_t   {
 public:
-  using source_t = std::unique_ptr<inputsource_t>;
+  using source_t = std::shared_ptr<inputsource_t>;
+  using clock_t  = std::chrono::steady_clock;
+
+  /// Event read ahead by the prefetching reader
+  class frame_t   {
+  public:
+    /// Input source of the event. Keeps the file open while the event is in flight
+    source_t source  { };
+    /// Entry number in the input tree
+    Long64_t entry   { -1 };
+    /// Number of bytes read
+    std::size_t bytes { 0 };
+    /// Branch containers and the objects read
+    std::vector<std::pair<container_t*, void*> > objects { };
+    /// Delete the objects read from the branches and the elements not taken by a consumer
+    void release();
+  };
+
   /// Reference to parent action
-  DigiROOTInput* m_parent       { nullptr };
+  DigiROOTInput*          m_parent       { nullptr };
   /// Handle to input source
-  source_t       m_source       { };
+  source_t                m_source       { };
   /// Pointer to current input source
-  int            m_curr_input   { INPUT_START };
+  int                     m_curr_input   { INPUT_START };
+
+  /// Prefetching: reader thread
+  std::thread             m_reader       { };
+  /// Prefetching: queue of materialized events
+  std::deque<frame_t>     m_queue        { };
+  /// Prefetching: queue lock
+  std::mutex              m_lock         { };
+  /// Prefetching: signal events available
+  std::condition_variable m_not_empty    { };
+  /// Prefetching: signal free queue slots
+  std::condition_variable m_not_full     { };
+  /// Prefetching: reader failure to be passed to the workers
+  std::exception_ptr      m_error        { };
+  /// Prefetching: counters
+  prefetch_counters_t     m_counters     { };
+  /// Prefetching: maximal queue length
+  std::size_t             m_depth        { 0 };
+  /// Prefetching: stop flag for the reader
+  bool                    m_stop         { false };
 
 public:
   /// Default constructor
   internals_t (DigiROOTInput* p);
   /// Default destructor
-  ~internals_t () = default;
+  ~internals_t ();
   /// Access the next valid event entry
   inputsource_t& next();
   /// Open the next input source from the input list
   std::unique_ptr<inputsource_t> open_source();
+
+  /// Prefetching: start the reader thread
+  void start(std::size_t depth);
+  /// Prefetching: stop the reader thread and drop unused events
+  void stop();
+  /// Prefetching: reader thread body
+  void read_ahead();
+  /// Prefetching: read all branches of the next event
+  frame_t read_frame();
+  /// Prefetching: get the next materialized event. Blocks if the queue is empty
+  frame_t pop();
 };
 
+/// Delete the objects read from the branches
+void DigiROOTInput::internals_t::frame_t::release()   {
+  for( auto& o : objects )   {
+    TClass& cls = o.first->clazz;
+    // The consumers take ownership of the elements of pointer collections
+    // and clear the container. Elements of unconsumed events are deleted here.
+    TVirtualCollectionProxy* proxy = cls.GetCollectionProxy();
+    if ( proxy && proxy->HasPointers() )   {
+      TVirtualCollectionProxy::TPushPop env(proxy, o.second);
+      TClass* value_class = proxy->GetValueClass();
+      for( UInt_t i = 0, n = proxy->Size(); i < n; ++i )   {
+        void* elt = *(void**)proxy->At(i);
+        if ( elt && value_class ) value_class->Destructor(elt);
+      }
+      proxy->Clear();
+    }
+    cls.Destructor(o.second);
+  }
+  objects.clear();
+}
+
 /// Default constructor
 DigiROOTInput::internals_t::internals_t (DigiROOTInput* p)
   : m_parent(p)
 {
 }
 
+/// Default destructor
+DigiROOTInput::internals_t::~internals_t ()   {
+  stop();
+}
+
+/// Prefetching: start the reader thread
+void DigiROOTInput::internals_t::start(std::size_t depth)   {
+  ROOT::EnableThreadSafety();
+  m_depth  = depth;
+  m_stop   = false;
+  m_reader = std::thread([this]() { this->read_ahead(); });
+}
+
+/// Prefetching: stop the reader thread and drop unused events
+void DigiROOTInput::internals_t::stop()   {
+  {
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_stop = true;
+  }
+  m_not_full.notify_all();
+  if ( m_reader.joinable() )
+    m_reader.join();
+  for( auto& frame : m_queue )
+    frame.release();
+  m_queue.clear();
+}
+
+/// Prefetching: read all branches of the next event
+DigiROOTInput::internals_t::frame_t DigiROOTInput::internals_t::read_frame()   {
+  frame_t frame;
+  auto& src = this->next();
+  frame.source = m_source;
+  frame.entry  = src.entry;
+  frame.objects.reserve(src.branches.size());
+  for( auto& b : src.branches )    {
+    auto& ent = b.second;
+    // Read into an object we own: ROOT does not delete it and does not reuse it.
+    void* obj  = ent.clazz.New();
+    void* addr = obj;
+    ent.branch.SetAddress(&addr);
+    Long64_t bytes = ent.branch.GetEntry( src.entry );
+    ent.branch.ResetAddress();
+    if ( bytes > 0 )   {
+      frame.objects.emplace_back(&ent, obj);
+      frame.bytes += bytes;
+    }
+    else   {
+      ent.clazz.Destructor(obj);
+    }
+  }
+  return frame;
+}
+
+/// Prefetching: reader thread body
+void DigiROOTInput::internals_t::read_ahead()   {
+  while( true )   {
+    frame_t frame;
+    auto start = clock_t::now();
+    try   {
+      frame = read_frame();
+    }
+    catch( ... )   {
+      std::lock_guard<std::mutex> lock(m_lock);
+      m_error = std::current_exception();
+      m_not_empty.notify_all();
+      return;
+    }
+    std::chrono::duration<double> read = clock_t::now() - start;
+    std::unique_lock<std::mutex> lock(m_lock);
+    m_counters.read_time += read.count();
+    if ( !m_stop && m_queue.size() >= m_depth )   {
+      start = clock_t::now();
+      ++m_counters.reader_stalls;
+      m_not_full.wait(lock, [this]() { return m_stop || m_queue.size() < m_depth; });
+      std::chrono::duration<double> wait = clock_t::now() - start;
+      m_counters.reader_wait += wait.count();
+    }
+    if ( m_stop )   {
+      frame.release();
+      return;
+    }
+    ++m_counters.events;
+    m_counters.bytes += frame.bytes;
+    m_queue.emplace_back(std::move(frame));
+    m_not_empty.notify_one();
+  }
+}
+
+/// Prefetching: get the next materialized event. Blocks if the queue is empty
+DigiROOTInput::internals_t::frame_t DigiROOTInput::internals_t::pop()   {
+  std::unique_lock<std::mutex> lock(m_lock);
+  if ( m_queue.empty() && !m_error )   {
+    auto start = clock_t::now();
+    ++m_counters.worker_stalls;
+    m_not_empty.wait(lock, [this]() { return !m_queue.empty() || m_error; });
+    std::chrono::duration<double> wait = clock_t::now() - start;
+    m_counters.worker_wait += wait.count();
+  }
+  if ( m_queue.empty() )   {
+    std::rethrow_exception(m_error);
+  }
+  frame_t frame = std::move(m_queue.front());
+  m_queue.pop_front();
+  m_not_full.notify_one();
+  return frame;
+}
+
 /// Open the next input source from the input list
 std::unique_ptr<DigiROOTInput::inputsource_t> DigiROOTInput::internals_t::open_source()   {
   const auto& inputs    = m_parent->inputs();
@@ -150,7 +333,10 @@ DigiROOTInput::inputsource_t& DigiROOTInput::internals_t::next()   {
 DigiROOTInput::DigiROOTInput(const DigiKernel& kernel, const std::string& nam)
   : DigiInputAction(kernel, nam)
 {
+  declareProperty("prefetch", m_prefetch_depth);
   imp = std::make_unique<internals_t>(this);
+  m_kernel.register_initialize(std::bind(&DigiROOTInput::initialize,this));
+  m_kernel.register_terminate(std::bind(&DigiROOTInput::terminate,this));
   InstanceCount::increment(this);
 }
 
@@ -160,8 +346,57 @@ DigiROOTInput::~DigiROOTInput()   {
   InstanceCount::decrement(this);
 }
 
+/// Initialize callback: start the prefetching reader if requested
+void DigiROOTInput::initialize()   {
+  if ( m_prefetch_depth > 0 )   {
+    info("+++ Start prefetching reader. Read ahead depth: %d events", m_prefetch_depth);
+    imp->start(m_prefetch_depth);
+  }
+}
+
+/// Terminate callback: stop the prefetching reader and print the counters
+void DigiROOTInput::terminate()   {
+  if ( m_prefetch_depth > 0 )   {
+    imp->stop();
+    auto cnt = prefetch_counters();
+    info("+++ Prefetch: %ld events %ld bytes read in %7.3f seconds",
+	 cnt.events, cnt.bytes, cnt.read_time);
+    info("+++ Prefetch: reader stalls: %ld [%7.3f seconds] worker stalls: %ld [%7.3f seconds]",
+	 cnt.reader_stalls, cnt.reader_wait, cnt.worker_stalls, cnt.worker_wait);
+  }
+}
+
+/// Access the counters of the prefetching reader
+DigiROOTInput::prefetch_counters_t DigiROOTInput::prefetch_counters()  const   {
+  std::lock_guard<std::mutex> lock(imp->m_lock);
+  return imp->m_counters;
+}
+
 /// Pre-track action callback
 void DigiROOTInput::execute(DigiContext& context)  const   {
+  if ( m_prefetch_depth > 0 )   {
+    //
+    //  Events are read by the prefetching thread: no global lock required.
+    //
+    auto& event = context.event;
+    auto  frame = imp->pop();
+    DataSegment& segment = event->get_segment(m_input_segment);
+    try   {
+      for( auto& o : frame.objects )    {
+	work_t work { segment, *o.first, o.second };
+	(*this)(context, work);
+      }
+    }
+    catch( ... )   {
+      frame.release();
+      throw;
+    }
+    frame.release();
+    info("%s+++ Read event %6ld [%ld bytes] from tree %s file: %s",
+	 event->id(), frame.entry, frame.bytes,
+	 frame.source->tree->GetName(), frame.source->file->GetName());
+    return;
+  }
   //
   //  We have to lock all ROOT based actions. Consequences are SEGV otherwise.
   //
@@ -176,7 +411,7 @@ void DigiROOTInput::execute(DigiContext& context)  const   {
     auto& ent = b.second;
     Long64_t bytes = ent.branch.GetEntry( source.entry );
     if ( bytes > 0 )  {
-      work_t work { segment, ent };
+      work_t work { segment, ent, *(void**)ent.branch.GetAddress() };
       (*this)(context, work);
       input_len += bytes;
     }
@@ -235,6 +235,9 @@ DigiStoreDump::dump_deposit_history(DigiContext& context, Key container_key, con
 template std::vector<std::string>
 DigiStoreDump::dump_deposit_history(DigiContext& context, Key container_key, const DepositVector& container)  const;
 
+template std::vector<std::string>
+DigiStoreDump::dump_deposit_history(DigiContext& context, Key container_key, const DepositSortedVector& container)  const;
+
 std::vector<std::string>
 DigiStoreDump::dump_particle_history(DigiContext& context, Key container_key, const ParticleMapping& container)  const {
   std::size_t count = 0;
@@ -274,6 +277,9 @@ void DigiStoreDump::dump_history(DigiContext& context,
       else if ( const auto* vector = std::any_cast<DepositVector>(&data) )   {
         rec = dump_deposit_history(context, std::move(key), *vector);
       }
+      else if ( const auto* sorted = std::any_cast<DepositSortedVector>(&data) )   {
+        rec = dump_deposit_history(context, std::move(key), *sorted);
+      }
       else if ( const auto* parts = std::any_cast<ParticleMapping>(&data) )   {
         rec = dump_particle_history(context, std::move(key), *parts);
       }
@@ -312,6 +318,8 @@ void DigiStoreDump::dump_headers(const std::string& tag,
       str = "| " + data_header(std::move(key), "deposits", *mapping);
     else if ( const auto* vector = std::any_cast<DepositVector>(&data) )
       str = "| " + data_header(std::move(key), "deposits", *vector);
+    else if ( const auto* sorted = std::any_cast<DepositSortedVector>(&data) )
+      str = "| " + data_header(std::move(key), "deposits", *sorted);
     else if ( const auto* parts = std::any_cast<ParticleMapping>(&data) )
       str = "| " + data_header(std::move(key), "particles", *parts);
     else if ( const auto* adcs = std::any_cast<DetectorResponse>(&data) )
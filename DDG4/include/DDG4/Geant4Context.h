@@ -93,7 +93,7 @@ namespace dd4hep {
       }
       /// Access to type safe extension object. Exception is thrown if the object is invalid
       template <typename T> T* extension(bool alert=true) {
-        return (T*)ObjectExtensions::extension(detail::typeHash64<T>(),alert);
+        return (T*)ObjectExtensions::extension(detail::extensionSlot<T>(),detail::typeHash64<T>(),alert);
       }
     };
 
@@ -149,7 +149,7 @@ namespace dd4hep {
       }
       /// Access to type safe extension object. Exception is thrown if the object is invalid
       template <typename T> T* extension(bool alert=true) {
-        return (T*)ObjectExtensions::extension(detail::typeHash64<T>(),alert);
+        return (T*)ObjectExtensions::extension(detail::extensionSlot<T>(),detail::typeHash64<T>(),alert);
       }
     };
 
@@ -59,6 +59,8 @@ namespace dd4hep {
       bool       checkOverlaps = true;
       /// Property: Output level for debug printing
       PrintLevel outputLevel = INFO;
+      /// Property: Number of threads to convert tessellated solids (<= 1: sequential)
+      int        numThreads  = 0;
 
       /// Initializing Constructor
       Geant4Converter(const Detector& description);
@@ -96,6 +98,9 @@ namespace dd4hep {
       /// Convert the geometry type solid into the corresponding Geant4 object(s).
       virtual void* handleSolid(const std::string& name, const TGeoShape* volume) const;
 
+      /// Convert all tessellated solids (also components of boolean solids) concurrently
+      void handleTessellatedSolids(const std::vector<TGeoShape*>& shapes) const;
+
       /// Convert the geometry type logical volume into the corresponding Geant4 object(s).
       virtual void* handleVolume(const std::string& name, const TGeoVolume* volume) const;
       virtual void* collectVolume(const std::string& name, const TGeoVolume* volume) const;
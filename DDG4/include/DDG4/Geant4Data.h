@@ -287,6 +287,10 @@ namespace dd4hep {
 	Hit(const Geant4HitData::Contribution& contrib, const Direction& mom, double deposit);
         /// Default destructor
         virtual ~Hit();
+        /// Hit allocation from a per-thread memory pool. Derived classes use the heap
+        static void* operator new(std::size_t size);
+        /// Return the hit memory to the per-thread memory pool
+        static void operator delete(void* ptr, std::size_t size);
         /// Move assignment operator
         Hit& operator=(Hit&& c) = delete;
         /// Copy assignment operator
@@ -341,6 +345,10 @@ namespace dd4hep {
         Hit(const Position& cell_pos);
         /// Default destructor
         virtual ~Hit();
+        /// Hit allocation from a per-thread memory pool. Derived classes use the heap
+        static void* operator new(std::size_t size);
+        /// Return the hit memory to the per-thread memory pool
+        static void operator delete(void* ptr, std::size_t size);
         /// Move assignment operator
         Hit& operator=(Hit&& c) = delete;
         /// Copy assignment operator
@@ -40,10 +40,12 @@ namespace dd4hep {
     protected:
       /// Reference to the detector description field
       OverlayedField m_field;
+      /// Flattened magnetic field components built at construction
+      CompiledField  m_compiled;
 
     public:
       /// Constructor. The sensitive detector element is identified by the detector name
-      Geant4Field(OverlayedField field) : m_field(field) {   }
+      Geant4Field(OverlayedField field) : m_field(field), m_compiled(field, OverlayedField::MAGNETIC) {   }
       /// Standard destructor
       virtual ~Geant4Field() {    }
       /// Access field values at a given point
@@ -16,6 +16,7 @@
 // Framework include files
 #include <DD4hep/Objects.h>
 #include <DD4hep/Printout.h>
+#include <DD4hep/BitFieldCoder.h>
 #include <DD4hep/GeoHandler.h>
 #include <DD4hep/PropertyTable.h>
 #include <DDG4/Geant4Primitives.h>
@@ -99,9 +100,13 @@ namespace dd4hep {
         PlacementFlags()      { this->value = 0; }
         PlacementFlags(int v) { this->value = v; }
       };
+      /// Field encoder of a parametrised/replicated level: (touchable depth, bitfield)
+      typedef std::pair<int, const BitFieldElement*> LevelEncoder;
       struct Placement  {
         VolumeID volumeID;
         int      flags;
+        /// Precomputed encoders for parametrised/replicated levels (flags != 0 only)
+        std::vector<LevelEncoder> encoders { };
       };
 
       class DebugInfo;
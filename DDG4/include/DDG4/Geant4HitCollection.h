@@ -193,6 +193,10 @@ namespace dd4hep {
      * This obviously only helps, if contributions to the same cell come in
      * sequence ie. from the same G4Track.
      *
+     * Hits added with a key (cell identifier) are found by findByKey
+     * using a flat hash index. The sensitive detector sequence reserves
+     * the hit vector and the index according to the size of the collection
+     * in the previous event.
      *
      *  \author  M.Frank
      *  \version 1.0
@@ -205,8 +209,69 @@ namespace dd4hep {
       typedef std::vector<Geant4HitWrapper>    WrappedHits;
       /// Hit manipulator
       typedef Geant4HitWrapper::HitManipulator Manip;
-      /// Hit key map for fast random lookup
-      typedef std::map<VolumeID, size_t>  Keys;
+
+      /// Flat hash index of the hit keys for fast random lookup
+      /**
+       *  Open addressing with linear probing on a power-of-two table.
+       *  The load factor is kept below 1/2. Entries carry the generation
+       *  of the index: clear() invalidates all entries in constant time
+       *  and keeps the table for the next use.
+       *
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_SIMULATION
+       */
+      class Keys  {
+      public:
+        /// Marker for keys not found in the index
+        static constexpr size_t npos = ~size_t(0);
+      private:
+        /// Table entry
+        struct Entry  {
+          VolumeID     key;
+          unsigned int index;
+          unsigned int generation;
+        };
+        /// Hash table
+        std::vector<Entry> m_table;
+        /// Number of valid entries
+        size_t             m_size       { 0 };
+        /// Expected number of entries used to size the table at first insertion
+        size_t             m_expected   { 0 };
+        /// Shift to extract the table slot from the hash value
+        unsigned int       m_shift      { 64 };
+        /// Current generation. Entries of older generations are empty
+        unsigned int       m_generation { 1 };
+
+        /// Slot of the key in the table (Fibonacci hashing)
+        size_t slot(VolumeID key)  const   {
+          return size_t((key * 0x9E3779B97F4A7C15ULL) >> m_shift);
+        }
+        /// Rebuild the table with the given number of slots (power of two)
+        void rehash(size_t num_slots);
+
+      public:
+        /// Number of valid entries
+        size_t size()  const              {  return m_size;        }
+        /// Check if the index is empty
+        bool   empty() const              {  return m_size == 0;   }
+        /// Expected number of entries. The table is sized accordingly at the next insertion
+        void   reserve(size_t num_keys);
+        /// Insert a new key. Returns false if the key is already present
+        bool   insert(VolumeID key, size_t index);
+        /// Remove all keys. Constant time: the table memory is kept
+        void   clear();
+        /// Find the hit index of a key. Returns npos if the key is not present
+        size_t find(VolumeID key)  const   {
+          if ( m_size == 0 ) return npos;
+          const size_t mask = m_table.size() - 1;
+          for( size_t i = slot(key); ; i = (i+1) & mask )  {
+            const Entry& e = m_table[i];
+            if ( e.generation != m_generation ) return npos;
+            if ( e.key == key ) return e.index;
+          }
+        }
+      };
 
       /// Generic class template to compare/select hits in Geant4HitCollection objects
       /**
@@ -301,6 +366,8 @@ namespace dd4hep {
       const ComponentCast& vector_type() const;
       /// Clear the collection (Deletes all valid references to real hits)
       virtual void clear();
+      /// Reserve space for the expected number of hits
+      void reserve(size_t num_hits);
       /// Set optimization flags
       void setOptimize(int flag)  {
         m_flags.value |= flag;
@@ -338,8 +405,7 @@ namespace dd4hep {
       /// Add a new hit with a check, that the hit is of the same type
       template <typename TYPE> void add(VolumeID key, TYPE* hit_pointer) {
         m_lastHit = m_hits.size();
-        std::pair<Keys::iterator,bool> ret = m_keys.emplace(key,m_lastHit);
-        if ( ret.second )  {
+        if ( m_keys.insert(key, m_lastHit) )  {
           Geant4HitWrapper w(m_manipulator->castHit(hit_pointer));
           m_hits.emplace_back(w);
           return;
@@ -352,10 +418,10 @@ namespace dd4hep {
       }
       /// Find hits in a collection by comparison of key value
       template <typename TYPE> TYPE* findByKey(VolumeID key) {
-        Keys::const_iterator i=m_keys.find(key);
-        if ( i == m_keys.end() ) return 0;
-        m_lastHit = (*i).second;
-        TYPE* obj = m_hits.at(m_lastHit);
+        size_t idx = m_keys.find(key);
+        if ( idx == Keys::npos ) return 0;
+        m_lastHit = idx;
+        TYPE* obj = m_hits[m_lastHit];
         return obj;
       }
       /// Release all hits from the Geant4 container and pass ownership to the caller
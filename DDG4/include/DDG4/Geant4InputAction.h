@@ -176,6 +176,11 @@ namespace dd4hep  {
       int m_currentEventNumber;
       /// Flag to call abortEvent in case of failure (default: true)
       bool m_abort;
+      /// Property: read the event given by the Geant4 event identifier (default: false)
+      /** Requires a reader with direct access. Several worker threads with
+       *  their own input action may then share one input file.
+       */
+      bool m_useEventID;
       /// Property: named parameters to configure file readers or input actions
       std::map< std::string, std::string> m_parameters;
 
@@ -16,6 +16,12 @@
 // Framework include files
 #include <DDG4/Geant4OutputAction.h>
 
+// ROOT include files
+#include <RtypesCore.h>
+
+// C/C++ include files
+#include <memory>
+
 class TFile;
 class TTree;
 class TBranch;
@@ -30,24 +36,59 @@ namespace dd4hep {
 
     /// Class to output Geant4 event data to ROOT files
     /**
+     *  Branches are resolved once and afterwards accessed in the order of
+     *  the collections of the first events. Missing collections of an event are
+     *  back-filled with NULL entries at commit only for the concerned branches.
+     *
+     *  Multi-threading: with the property ThreadBuffered set, each instance
+     *  (one per worker thread if the action is not shared) writes into its own
+     *  in-memory buffer file. All buffers with the same output name are merged
+     *  into one output file by a ROOT::TBufferMerger, which writes the file
+     *  when the last instance closes its output. The branches of all hit
+     *  collections and of the MC particles are declared when the output is
+     *  opened: every buffer has the same branches, missing entries are NULL.
+     *
      *  \author  M.Frank
      *  \version 1.0
      *  \ingroup DD4HEP_SIMULATION
      */
     class Geant4Output2ROOT: public Geant4OutputAction {
     protected:
-      typedef std::map<std::string, TBranch*> Branches;
+      /// Branch entry of the event tree
+      class Branch  {
+      public:
+        TBranch* branch  { nullptr };
+        Long64_t entries { 0 };
+      };
+      typedef std::map<std::string, std::size_t> Branches;
       typedef std::map<std::string, TTree*> Sections;
       /// Known file sections
       Sections m_sections;
-      /// Branches in the event tree
+      /// Branches in the event tree: index into the branch list
       Branches m_branches;
+      /// Branch list in the order of creation
+      std::vector<Branch> m_branchList;
+      /// Branch list index of the next collection expected in this event
+      std::size_t m_branchCursor  { 0 };
+      /// Shared buffer merger of all writers of the same output file (ThreadBuffered)
+      std::shared_ptr<void> m_merger;
+      /// Buffer file of this writer (ThreadBuffered)
+      std::shared_ptr<TFile> m_bufferFile;
       /// Reference to the ROOT file to open
       TFile* m_file;
       /// Reference to the event data tree
       TTree* m_tree;
       /// File sequence number
       int    m_fseqNunmber  { 0 };
+      /// Property: ROOT compression settings (algorithm*100 + level). Negative: ROOT default
+      int    m_compression  { -1 };
+      /// Property: TTree auto-flush setting. 0: ROOT default.
+      /// ThreadBuffered: number of events sent to the merger at once (default 100)
+      Long64_t m_autoFlush  { 0 };
+      /// Property: Basket size of the event branches
+      int    m_basketSize   { 32000 };
+      /// Property: Use per-thread buffer files merged into one output file
+      bool   m_threadBuffered { false };
       /// Property: name of the event tree
       std::string m_section;
       /// Property: vector with disabled collections
@@ -66,6 +107,10 @@ namespace dd4hep {
       virtual ~Geant4Output2ROOT();
       /// Create/access tree by name for non collection user data
       TTree* section(const std::string& nam);
+      /// Access the branch of a collection. Creates the branch if not yet present
+      Branch& branch(const std::string& nam, const ComponentCast& type);
+      /// Declare the branches of all possible collections before the first event
+      void declareBranches();
       /// Fill single EVENT branch entry (Geant4 collection data)
       int fill(const std::string& nam, const ComponentCast& type, void* ptr);
 
@@ -155,6 +155,10 @@ namespace dd4hep {
       virtual ~Geant4Particle();
       /// NO assignment operation
       Geant4Particle& operator=(const Geant4Particle& copy) = delete;
+      /// Particle allocation from the memory pool of the current thread
+      static void* operator new(std::size_t size);
+      /// Particle deallocation to the memory pool of the current thread
+      static void operator delete(void* ptr, std::size_t size);
       /// Increase reference count
       Geant4Particle* addRef()  {
         ++ref;
@@ -124,6 +124,20 @@ namespace dd4hep {
       bool              m_haveSuspended = false;
       /// Map associating the G4Track identifiers with identifiers of existing MCParticles
       TrackEquivalents  m_equivalentTracks;
+      /// Dense index of the stored MC Particles by Geant4 track identifier
+      /** Valid while the map is keyed by the Geant4 track identifiers,
+       *  i.e. until the simulated tracks are rebased at the end of the event.
+       */
+      std::vector<Particle*> m_trackIndex;
+      /// Size of the dense track index of the previous event
+      std::size_t       m_trackIndexSize = 0;
+
+      /// Access a stored MC particle by Geant4 track identifier from the dense index
+      Particle* trackParticle(int g4_id)  const  {
+        return std::size_t(g4_id) < m_trackIndex.size() ? m_trackIndex[g4_id] : nullptr;
+      }
+      /// Register a stored MC particle in the map and the dense index
+      Particle* storeParticle(int g4_id, Particle* part);
 
       /// Recombine particles and associate the to parents with cleanup
       int recombineParents();
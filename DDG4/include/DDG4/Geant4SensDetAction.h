@@ -241,9 +241,17 @@ namespace dd4hep {
       /// Initialize the usage of a single hit collection. Returns the collection ID
       template <typename TYPE> std::size_t defineCollection(const std::string& coll_name);
 
+      /// Access the number of hit collections of this detector
+      std::size_t numHitCollections() const   {
+        return m_collections.size();
+      }
+
       /// Access HitCollection container names
       const std::string& hitCollectionName(std::size_t which) const;
 
+      /// Access the type of the hit vector of a collection (e.g. to declare output branches)
+      const ComponentCast& hitCollectionType(std::size_t which) const;
+
       /// Retrieve the hits collection associated with this detector by its serial number
       Geant4HitCollection* collection(std::size_t which);
 
@@ -338,6 +346,8 @@ namespace dd4hep {
 
       /// Hit collection creators
       HitCollections m_collections;
+      /// Hit collection sizes of the previous event to reserve the new collections
+      std::vector<std::size_t> m_collectionSizes;
       /// Reference to the sensitive detector element
       SensitiveDetector m_sensitive;
       /// Reference to G4 sensitive detector
@@ -0,0 +1,155 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDG4_GEANT4STEPBATCH_H
+#define DDG4_GEANT4STEPBATCH_H
+
+// Framework include files
+#include <DD4hep/Segmentations.h>
+#include <DDG4/Geant4Data.h>
+#include <DDG4/Geant4VolumeManager.h>
+
+// Geant4 include files
+#include <G4AffineTransform.hh>
+
+// C/C++ include files
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Forward declarations
+class G4Step;
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim {
+
+    // Forward declarations
+    class Geant4Sensitive;
+
+    /// Buffer of compact step records of a sensitive detector action
+    /**
+     *  Instead of resolving the cell identifier and the hit of every step
+     *  immediately, a sensitive action may store compact step records:
+     *  the Monte Carlo contribution, the volume identifier of the touchable
+     *  and the local and global step position. The Geant4 step and touchable
+     *  objects are transient: everything depending on them is extracted
+     *  when the record is added. The local-to-global transformation of the
+     *  pre-step touchable is stored once per touchable history and event.
+     *
+     *  The records are processed in batches when the buffer is full and at
+     *  the end of the event: the cell identifiers of all records are computed
+     *  with one call to the batch interface of the segmentation.
+     *  The records keep the step order: hits are created in the same order
+     *  and with the same contributions as with the step-by-step processing.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4StepBatch  {
+    public:
+      typedef Geant4HitData::Contribution Contribution;
+
+      /// Compact step record
+      /**
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_SIMULATION
+       */
+      class Record  {
+      public:
+        /// Monte Carlo contribution of the step
+        Contribution contrib;
+        /// Index of the local-to-global transformation of the pre-step volume
+        unsigned int transform  { 0 };
+      };
+
+    protected:
+      /// Maximal number of records before the buffer must be processed
+      std::size_t                    m_capacity   { 0 };
+      /// Step records of the current batch
+      std::vector<Record>            m_records;
+      /// Local step positions (segmentation units) of the current batch
+      std::vector<Position>          m_local;
+      /// Global step positions (segmentation units) of the current batch
+      std::vector<Position>          m_global;
+      /// Volume identifiers of the current batch
+      std::vector<VolumeID>          m_volumeIDs;
+      /// Cell identifiers of the current batch
+      std::vector<VolumeID>          m_cellIDs;
+      /// Validity flags of the cell identifiers
+      std::vector<unsigned char>     m_valid;
+      /// Local-to-global transformations of the volumes seen in this event
+      std::vector<G4AffineTransform> m_transforms;
+      /// Index of the transformations by touchable history
+      std::unordered_map<std::string, unsigned int> m_transformIndex;
+      /// Touchable history key of the current record
+      std::string                    m_key;
+      /// Touchable history key of the last record
+      std::string                    m_lastKey;
+      /// Transformation index of the last record
+      unsigned int                   m_lastIndex  { ~0U };
+      /// Handle to the Geant4 volume manager
+      Geant4VolumeManager            m_volumeManager;
+
+    public:
+      /// Statistics: number of recorded steps
+      long                           numSteps     { 0 };
+      /// Statistics: number of processed batches
+      long                           numBatches   { 0 };
+
+    public:
+      /// Initializing constructor
+      explicit Geant4StepBatch(std::size_t capacity);
+      /// Inhibit copy constructor
+      Geant4StepBatch(const Geant4StepBatch& copy) = delete;
+      /// Inhibit assignment
+      Geant4StepBatch& operator=(const Geant4StepBatch& copy) = delete;
+      /// Default destructor
+      virtual ~Geant4StepBatch();
+
+      /// Number of buffered records
+      std::size_t size()  const        {  return m_records.size();                  }
+      /// Check if the buffer is empty
+      bool empty()  const              {  return m_records.empty();                 }
+      /// Check if the buffer must be processed
+      bool full()  const               {  return m_records.size() >= m_capacity;   }
+      /// Access a buffered record
+      const Record& record(std::size_t which)  const  {  return m_records[which];  }
+      /// Local-to-global transformation of a record
+      const G4AffineTransform& transform(const Record& rec)  const  {
+        return m_transforms[rec.transform];
+      }
+      /// Volume identifier of a record
+      VolumeID volumeID(std::size_t which)  const {  return m_volumeIDs[which];    }
+      /// Check if the cell identifier of a record could be resolved
+      bool valid(std::size_t which)  const   {  return m_valid[which] != 0;       }
+      /// Cell identifier of a record. Requires a previous call to resolve()
+      VolumeID cellID(std::size_t which)  const {  return m_cellIDs[which];        }
+
+      /// Add a step record. Position and volume are taken as in Geant4Sensitive::cellID(step)
+      void add(const G4Step* step, const Contribution& contrib);
+      /// Compute the cell identifiers of all buffered records in one batch
+      /** Records with segmentation errors are reported and flagged invalid.
+       */
+      void resolve(const Geant4Sensitive& sensitive, const Segmentation& segmentation);
+      /// Remove the records of the processed batch. The transformations are kept
+      void release();
+      /// Remove all records and transformations (new event)
+      void clear();
+    };
+  }    // End namespace sim
+}      // End namespace dd4hep
+#endif // DDG4_GEANT4STEPBATCH_H
@@ -0,0 +1,144 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDG4_GEANT4TEXTEVENTFILE_H
+#define DDG4_GEANT4TEXTEVENTFILE_H
+
+// C/C++ include files
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/// Namespace for the AIDA detector description toolkit
+namespace dd4hep {
+
+  /// Namespace for the Geant4 based simulation part of the AIDA detector description toolkit
+  namespace sim {
+
+    /// Memory mapped ASCII event file with a byte-offset index of the events
+    /**
+     *  Support class for ASCII event readers (HepEvt, HepMC2, GuineaPig).
+     *  The file is mapped read-only into memory. The byte offsets of the events
+     *  are located by a format specific scanner. The index is built on the fly
+     *  up to the requested event. If a sidecar index file is requested, the
+     *  index is written once it covers the complete file. Later jobs use it
+     *  if the size and modification time of the data file did not change.
+     *
+     *  All readers of the same file and format share one instance. The access
+     *  to the event data is thread safe: several readers may decode different
+     *  events of the same file concurrently.
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     *  \ingroup DD4HEP_SIMULATION
+     */
+    class Geant4TextEventFile  {
+    public:
+      /// Scanner: offset of the event following the event starting at offset 'pos'.
+      /** With pos = npos the offset of the first event is requested.
+       *  Offsets beyond the last event must be returned as data.size().
+       */
+      typedef std::function<std::size_t(std::string_view data, std::size_t pos)> scanner_t;
+
+      /// Fast tokenizer on a memory buffer without iostreams
+      /**
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_SIMULATION
+       */
+      class Cursor  {
+      public:
+        /// Current position
+        const char* ptr  { nullptr };
+        /// End of the buffer
+        const char* end  { nullptr };
+      public:
+        /// Initializing constructor
+        explicit Cursor(std::string_view data) : ptr(data.data()), end(data.data()+data.size())  {}
+        /// Skip whitespace. Returns false at the end of the buffer
+        bool skip_space();
+        /// Skip the current token
+        bool skip_token();
+        /// Skip the rest of the current line including the line feed
+        void skip_line();
+        /// Access the rest of the current line and move to the next line
+        std::string_view line();
+        /// Read the next token as integer number
+        bool next(int& value);
+        /// Read the next token as unsigned integer number
+        bool next(unsigned int& value);
+        /// Read the next token as floating point number
+        bool next(double& value);
+      };
+
+    protected:
+      /// Name of the data file
+      std::string              m_name;
+      /// Name of the sidecar index file (empty: no sidecar)
+      std::string              m_indexFile;
+      /// Format tag to validate the sidecar index
+      std::string              m_tag;
+      /// Format specific event scanner
+      scanner_t                m_scanner;
+      /// Start address of the file mapping
+      const char*              m_data     { nullptr };
+      /// Size of the file
+      std::size_t              m_size     { 0 };
+      /// Modification time of the data file [nsec]
+      long long                m_modified { 0 };
+      /// Event offsets. If complete, the last entry is the end of the file
+      std::vector<std::size_t> m_offsets;
+      /// Flag if the index covers the entire file
+      bool                     m_complete { false };
+      /// Lock to protect the index
+      mutable std::mutex       m_lock;
+
+      /// Extend the index up to the requested number of offsets
+      void extend(std::size_t num_offsets);
+      /// Load the index from the sidecar file
+      bool load_index();
+      /// Save the complete index to the sidecar file
+      void save_index()  const;
+
+    public:
+      /// Initializing constructor. Maps the file into memory
+      Geant4TextEventFile(const std::string& file_name, const std::string& tag,
+                          scanner_t scanner, const std::string& index_file);
+      /// Inhibit copy constructor
+      Geant4TextEventFile(const Geant4TextEventFile& copy) = delete;
+      /// Inhibit assignment
+      Geant4TextEventFile& operator=(const Geant4TextEventFile& copy) = delete;
+      /// Default destructor. Unmaps the file
+      virtual ~Geant4TextEventFile();
+
+      /// Access the shared instance for a given file and format
+      static std::shared_ptr<Geant4TextEventFile>
+      open(const std::string& file_name, const std::string& tag,
+           scanner_t scanner, const std::string& index_file);
+      /// Sidecar index file from the reader option: "" (none), "auto" (<file>.evtidx) or the file name
+      static std::string indexFileName(const std::string& option, const std::string& file_name);
+
+      /// File name
+      const std::string& name()  const   {  return m_name;   }
+      /// Access the data of the event with the given sequence number. False if beyond the end of the file
+      bool event(std::size_t event_number, std::string_view& data);
+      /// Data of the file before the first event (file header)
+      std::string_view prologue();
+      /// Total number of events in the file. Requires to scan the entire file
+      std::size_t numEvents();
+    };
+  }    // End namespace sim
+}      // End namespace dd4hep
+#endif // DDG4_GEANT4TEXTEVENTFILE_H
@@ -58,6 +58,8 @@ namespace dd4hep {
       /// Property: Flag to dump all sensitives after the conversion procedure
       bool m_printSensitives        = false;
 
+      /// Property: Number of threads to convert tessellated solids (<= 1: sequential)
+      int  m_conversionThreads      = 0;
       /// Property: Printout level of info object
       int  m_geoInfoPrintLevel;
       /// Property: G4 GDML dump file name (default: empty. If non empty, dump)
@@ -145,6 +147,7 @@ Geant4DetectorGeometryConstruction::Geant4DetectorGeometryConstruction(Geant4Con
 
   declareProperty("PrintPlacements",   m_printPlacements);
   declareProperty("PrintSensitives",   m_printSensitives);
+  declareProperty("ConversionThreads", m_conversionThreads);
   declareProperty("GeoInfoPrintLevel", m_geoInfoPrintLevel = DEBUG);
 
   declareProperty("DumpHierarchy",     m_dumpHierarchy);
@@ -173,6 +176,7 @@ void Geant4DetectorGeometryConstruction::constructGeo(Geant4DetectorConstruction
   conv.debugLimits      = m_debugLimits;
   conv.printPlacements  = m_printPlacements;
   conv.printSensitives  = m_printSensitives;
+  conv.numThreads       = m_conversionThreads;
 
   ctxt->geometry = conv.create(world).detach();
   ctxt->geometry->printLevel = outputLevel();
@@ -24,11 +24,10 @@
 
 // Framework include files
 #include <DDG4/Geant4InputAction.h>
+#include <DDG4/Geant4TextEventFile.h>
 
 // C/C++ include files
-#include <fstream>
-#include <algorithm>
-#include <sstream>
+#include <memory>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -41,7 +40,15 @@ namespace dd4hep {
      *  Reader for ascii files with e+e- pairs created from GuineaPig.
      *  Will read complete the file into one event - unless skip N events is
      *  called, then N particles are compiled into one event.
-     * 
+     *
+     *  The file is memory mapped and indexed (see Geant4TextEventFile):
+     *  if 'ParticlesPerEvent' is set, events are accessed directly by their
+     *  sequence number.
+     *
+     *  Parameters:
+     *  \li ParticlesPerEvent: number of lines (particles) per event. Default: all
+     *  \li EventIndex: sidecar index file: "auto" (<file>.evtidx) or file name. Default: none
+     *
      *  \author  F.Gaede, DESY
      *  \author  A. Perez Perez IPHC
      *  \version 1.0
@@ -50,9 +57,15 @@ namespace dd4hep {
     class Geant4EventReaderGuineaPig : public Geant4EventReader  {
 
     protected:
-      std::ifstream m_input;
+      /// Shared memory mapped input file with event index
+      std::shared_ptr<Geant4TextEventFile> m_file;
+      /// Name of the sidecar index file
+      std::string m_indexFile;
       int m_part_num ;
-      
+
+      /// Access the input file. Opened on first access
+      Geant4TextEventFile& file();
+
     public:
       /// Initializing constructor
       explicit Geant4EventReaderGuineaPig(const std::string& nam);
@@ -78,6 +91,10 @@ namespace dd4hep {
 
 // C/C++ include files
 #include <cerrno>
+#include <climits>
+#include <cmath>
+#include <cstring>
+#include <unistd.h>
 
 using namespace dd4hep::sim;
 typedef dd4hep::detail::ReferenceBitMask<int> PropertyMask;
@@ -87,28 +104,51 @@ DECLARE_GEANT4_EVENT_READER(Geant4EventReaderGuineaPig)
 
 /// Initializing constructor
 Geant4EventReaderGuineaPig::Geant4EventReaderGuineaPig(const std::string& nam)
-: Geant4EventReader(nam), m_input(), m_part_num(-1) 
+: Geant4EventReader(nam), m_file(), m_indexFile(), m_part_num(-1)
 {
-  // Now open the input file:
-  m_input.open(nam.c_str(), std::ifstream::in);
-  if ( !m_input.good() )   {
+  // The file is mapped on first access: check here that it can be opened
+  if ( ::access(nam.c_str(), R_OK) != 0 )   {
     std::string err = "+++ Geant4EventReaderGuineaPig: Failed to open input stream:"+nam+
       " Error:"+std::string(strerror(errno));
     throw std::runtime_error(err);
   }
+  m_directAccess = true;
 }
 
 /// Default destructor
 Geant4EventReaderGuineaPig::~Geant4EventReaderGuineaPig()    {
-  m_input.close();
+}
+
+/// Access the input file. Opened on first access
+Geant4TextEventFile& Geant4EventReaderGuineaPig::file()   {
+  if ( !m_file )   {
+    // if no number of particles per event set, we will read the whole file
+    int num_lines = m_part_num < 1 ? INT_MAX : m_part_num;
+    auto scanner = [num_lines](std::string_view data, std::size_t pos)  {
+      Geant4TextEventFile::Cursor input(data);
+      if ( pos == std::string_view::npos )
+        return std::size_t(0);
+      input.ptr += pos;
+      for( int i = 0; i < num_lines && input.ptr < input.end; ++i )
+        input.skip_line();
+      // Trailing blank lines do not start a new event
+      Geant4TextEventFile::Cursor rest(input);
+      return rest.skip_space() ? std::size_t(input.ptr - data.data()) : data.size();
+    };
+    m_file = Geant4TextEventFile::open(m_name, "GuineaPig:"+std::to_string(num_lines), scanner, m_indexFile);
+  }
+  return *m_file;
 }
 
 
 Geant4EventReader::EventReaderStatus
 Geant4EventReaderGuineaPig::setParameters( std::map< std::string, std::string > & parameters ) {
 
+  std::string index;
   _getParameterValue( parameters, "ParticlesPerEvent", m_part_num, -1);
-  
+  _getParameterValue( parameters, "EventIndex", index, std::string());
+  m_indexFile = Geant4TextEventFile::indexFileName(index, m_name);
+
   if( m_part_num <  0 ) 
     printout(INFO,"EventReader","--- Will read all particles in pairs file into one event " );
   else
@@ -123,58 +163,33 @@ Geant4EventReaderGuineaPig::moveToEvent(int event_number) {
   printout(DEBUG,"EventReader"," move to event_number: %d , m_currEvent %d",
            event_number,m_currEvent ) ;
   
-  if( m_currEvent == 0 && event_number > 0 ){
-
-    if( m_part_num <  1 ) {
-
-      printout(ERROR,"EventReader","--- Cannot skip to event %d in GuineaPig file without parameter 'ParticlesPerEvent' being set ! ", event_number );
-
-      return EVENT_READER_IO_ERROR;
-
-    } else {
-
-
-      unsigned nSkipParticles = m_part_num * event_number ;
-
-      printout(INFO,"EventReader","--- Will skip first %d events, i.e. %d particles ", event_number , nSkipParticles  );
-
-      // First check the input file status
-      if ( !m_input.good() || m_input.eof() )   {
-        return EVENT_READER_IO_ERROR;
-      }
-
-      for (unsigned i = 0; i<nSkipParticles; ++i){
-        if (m_input.ignore(std::numeric_limits<std::streamsize>::max(), m_input.widen('\n'))){
-          //just skipping the line
-        }
-        else
-          return EVENT_READER_IO_ERROR ;
-      }
-    }
+  // Without parameter 'ParticlesPerEvent' the file holds exactly one event
+  if( event_number > 0 && m_part_num < 1 ) {
+    printout(INFO,"EventReader","--- Event %d is beyond the end of the pairs file: "
+             "all particles are read into event 0 without parameter 'ParticlesPerEvent' ", event_number );
+    return EVENT_READER_EOF;
   }
-  // else: nothing to do ...
-
+  std::string_view data;
+  if( event_number < 0 || !file().event(event_number, data) ) {
+    printout(INFO,"EventReader","--- Event %d is beyond the end of the pairs file ", event_number );
+    return EVENT_READER_EOF;
+  }
+  m_currEvent = event_number;
   return EVENT_READER_OK;
 }
 
 /// Read an event and fill a vector of MCParticles.
 Geant4EventReader::EventReaderStatus
-Geant4EventReaderGuineaPig::readParticles(int /* event_number */, 
+Geant4EventReaderGuineaPig::readParticles(int event_number,
                                           Vertices& vertices,
                                           std::vector<Particle*>& particles)   {
 
-
-  // if no number of particles per event set, we will read the whole file
-  if ( m_part_num < 0 )
-    m_part_num = std::numeric_limits<int>::max() ; 
-
-  // First check the input file status
-  if ( m_input.eof() )   {
+  std::string_view data;
+  if ( event_number < 0 || !file().event(event_number, data) )   {
     return EVENT_READER_EOF;
   }
-  else if ( !m_input.good() )   {
-    return EVENT_READER_IO_ERROR;
-  }
+  m_currEvent = event_number;
+  Geant4TextEventFile::Cursor input(data);
 
   double Energy;
   double betaX;
@@ -184,35 +199,26 @@ Geant4EventReaderGuineaPig::readParticles(int /* event_number */,
   double posY;
   double posZ;
 
-  //  Loop over particles
-  for( int counter = 0; counter < m_part_num ; ++counter ){      
+  //  Loop over particles: one per line
+  for( int counter = 0; input.ptr < input.end ; ++counter ){
 
-    // need to check for NAN as not all ifstream implementations can handle this directly
-    std::string lineStr ;
-    std::getline( m_input, lineStr ) ;
+    Geant4TextEventFile::Cursor line( input.line() ) ;
+    if( !line.skip_space() ) continue ;   // blank line
 
-    if( m_input.eof() ) {
-      if( counter==0 ) { 
-        return EVENT_READER_IO_ERROR ;  // reading first particle of event failed 
-      } else{
-        ++m_currEvent;
-        return EVENT_READER_OK ; // simply EOF
-      }
+    bool ok = line.next(Energy)
+      && line.next(betaX) && line.next(betaY) && line.next(betaZ)
+      && line.next(posX)  && line.next(posY)  && line.next(posZ) ;
+    if( !ok ) {
+      printout(WARNING,"EventReader","### Cannot decode line - particle will be ignored  ! " ) ;
+      continue ;
     }
-
-    std::transform(lineStr.begin(), lineStr.end(), lineStr.begin(), ::tolower);
-    if( lineStr.find("nan") != std::string::npos){
-
+    // need to check for NAN entries
+    if( std::isnan(Energy) || std::isnan(betaX) || std::isnan(betaY) || std::isnan(betaZ) ||
+        std::isnan(posX)   || std::isnan(posY)  || std::isnan(posZ) ) {
       printout(WARNING,"EventReader","### Read line with 'nan' entries - particle will be ignored  ! " ) ;
       continue ;
     }
-    std::stringstream m_input_str( lineStr ) ;
 
-    m_input_str  >> Energy
-                 >> betaX   >> betaY >> betaZ
-                 >> posX    >> posY  >> posZ ;
-
-    
     //    printf(" ------- %e  %e  %e  %e  %e  %e  %e \n", Energy,betaX, betaY,betaZ,posX,posY,posZ ) ;
 
     //
@@ -274,8 +280,6 @@ Geant4EventReaderGuineaPig::readParticles(int /* event_number */,
 
   } // End loop over particles
 
-  ++m_currEvent;
-
   return EVENT_READER_OK;
 
 }
@@ -24,9 +24,10 @@
 
 // Framework include files
 #include <DDG4/Geant4InputAction.h>
+#include <DDG4/Geant4TextEventFile.h>
 
 // C/C++ include files
-#include <fstream>
+#include <memory>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -39,6 +40,12 @@ namespace dd4hep {
      * Class to populate Geant4 primary particles and vertices from a
      * file in HEPEvt format (ASCII)
      *
+     * The file is memory mapped and indexed (see Geant4TextEventFile):
+     * events are accessed directly by their sequence number.
+     *
+     * Parameters:
+     * \li EventIndex: sidecar index file: "auto" (<file>.evtidx) or file name. Default: none
+     *
      *  \author  P.Kostka (main author)
      *  \author  M.Frank  (code reshuffeling into new DDG4 scheme)
      *  \version 1.0
@@ -47,9 +54,15 @@ namespace dd4hep {
     class Geant4EventReaderHepEvt : public Geant4EventReader  {
 
     protected:
-      std::ifstream m_input;
+      /// Shared memory mapped input file with event index
+      std::shared_ptr<Geant4TextEventFile> m_file;
+      /// Name of the sidecar index file
+      std::string   m_indexFile;
       int           m_format;
 
+      /// Access the input file. Opened on first access
+      Geant4TextEventFile& file();
+
     public:
       /// Initializing constructor
       explicit Geant4EventReaderHepEvt(const std::string& nam, int format);
@@ -61,6 +74,7 @@ namespace dd4hep {
                                               std::vector<Particle*>& particles);
       virtual EventReaderStatus moveToEvent(int event_number);
       virtual EventReaderStatus skipEvent() { return EVENT_READER_OK; }
+      virtual EventReaderStatus setParameters(std::map< std::string, std::string >& parameters);
     };
   }     /* End namespace sim   */
 }       /* End namespace dd4hep       */
@@ -87,6 +101,8 @@ namespace dd4hep {
 
 // C/C++ include files
 #include <cerrno>
+#include <cstring>
+#include <unistd.h>
 
 using namespace dd4hep::sim;
 using PropertyMask = dd4hep::detail::ReferenceBitMask<int>;
@@ -120,64 +136,85 @@ DECLARE_GEANT4_EVENT_READER(Geant4EventReaderHepEvtLong)
 
 /// Initializing constructor
 Geant4EventReaderHepEvt::Geant4EventReaderHepEvt(const std::string& nam, int format)
-: Geant4EventReader(nam), m_input(), m_format(format)
+: Geant4EventReader(nam), m_file(), m_indexFile(), m_format(format)
 {
-  // Now open the input file:
-  m_input.open(nam.c_str(), std::ifstream::in);
-  if ( !m_input.good() )   {
+  // The file is mapped on first access: check here that it can be opened
+  if ( ::access(nam.c_str(), R_OK) != 0 )   {
     except("Geant4EventReaderHepEvt","+++ Failed to open input stream: %s Error:%s",
            nam.c_str(), ::strerror(errno));
   }
+  m_directAccess = true;
 }
 
 /// Default destructor
 Geant4EventReaderHepEvt::~Geant4EventReaderHepEvt()    {
-  m_input.close();
 }
 
-/// skipEvents if required
+/// pass parameters to the event reader object
+Geant4EventReader::EventReaderStatus
+Geant4EventReaderHepEvt::setParameters(std::map< std::string, std::string >& parameters)   {
+  std::string index;
+  _getParameterValue(parameters, "EventIndex", index, std::string());
+  m_indexFile = Geant4TextEventFile::indexFileName(index, m_name);
+  return EVENT_READER_OK;
+}
+
+/// Access the input file. Opened on first access
+Geant4TextEventFile& Geant4EventReaderHepEvt::file()   {
+  if ( !m_file )   {
+    // Event boundaries: NHEP followed by NHEP particle records with a fixed number of fields
+    std::size_t num_fields = m_format == HEPEvtShort ? 8 : 15;
+    auto scanner = [num_fields](std::string_view data, std::size_t pos)  {
+      Geant4TextEventFile::Cursor input(data);
+      if ( pos != std::string_view::npos )  {
+        unsigned NHEP(0);
+        input.ptr += pos;
+        if ( !input.next(NHEP) || NHEP > 5e7 ) return data.size();
+        for( std::size_t i = 0, n = NHEP*num_fields; i < n; ++i )  {
+          if ( !input.skip_token() ) return data.size();
+        }
+      }
+      input.skip_space();
+      return std::size_t(input.ptr - data.data());
+    };
+    m_file = Geant4TextEventFile::open(m_name, m_format == HEPEvtShort ? "HEPEvtShort" : "HEPEvtLong",
+                                       scanner, m_indexFile);
+  }
+  return *m_file;
+}
+
+/// Move to the indicated event number. Direct access by the event index
 Geant4EventReader::EventReaderStatus
 Geant4EventReaderHepEvt::moveToEvent(int event_number) {
-  if( m_currEvent == 0 && event_number != 0 ) {
-    printout(INFO,"EventReaderHepEvt::moveToEvent","Skipping the first %d events ", event_number );
-    printout(INFO,"EventReaderHepEvt::moveToEvent","Event number before skipping: %d", m_currEvent );
-    while ( m_currEvent < event_number ) {
-      std::vector<Particle*> particles;
-      Vertices vertices ;
-      EventReaderStatus sc = readParticles(m_currEvent,vertices,particles);
-      for_each(vertices.begin(), vertices.end(), detail::deleteObject<Vertex>);
-      for_each(particles.begin(), particles.end(), detail::deleteObject<Particle>);
-      if ( sc != EVENT_READER_OK ) return sc;
-      //Current event is increased in readParticles already!
-      // ++m_currEvent;
-    }
+  std::string_view data;
+  if ( event_number < 0 || !file().event(event_number, data) )   {
+    printout(INFO,"EventReaderHepEvt::moveToEvent","Event %d is beyond the end of file %s",
+             event_number, m_name.c_str());
+    return EVENT_READER_EOF;
   }
-  printout(INFO,"EventReaderHepEvt::moveToEvent","Event number after skipping: %d", m_currEvent );
+  m_currEvent = event_number;
+  printout(DEBUG,"EventReaderHepEvt::moveToEvent","Current event number: %d", m_currEvent );
   return EVENT_READER_OK;
 }
 
 /// Read an event and fill a vector of MCParticles.
 Geant4EventReader::EventReaderStatus
-Geant4EventReaderHepEvt::readParticles(int /* event_number */, 
+Geant4EventReaderHepEvt::readParticles(int event_number,
                                        Vertices& vertices,
                                        std::vector<Particle*>& particles)   {
 
-
-  // First check the input file status
-  if ( m_input.eof() )   {
+  std::string_view data;
+  if ( event_number < 0 || !file().event(event_number, data) )   {
     return EVENT_READER_EOF;
   }
-  else if ( !m_input.good() )   {
-    return EVENT_READER_IO_ERROR;
-  }
+  m_currEvent = event_number;
   //static const double c_light = 299.792;// mm/ns
   //
   //  Read the event, check for errors
   //
+  Geant4TextEventFile::Cursor input(data);
   unsigned NHEP(0);  // number of entries
-  m_input >> NHEP;
-
-  if( m_input.eof() )  { return EVENT_READER_EOF; }
+  if ( !input.next(NHEP) )  { return EVENT_READER_EOF; }
 
 
   //check loop variable read from input file and chack that is reasonable
@@ -210,23 +247,21 @@ Geant4EventReaderHepEvt::readParticles(int /* event_number */,
   std::vector<int> daughter2;
 
   for( unsigned IHEP=0; IHEP<NHEP; IHEP++ )    {
+    bool ok;
     if ( m_format == HEPEvtShort )
-      m_input >> ISTHEP >> IDHEP >> JDAHEP1 >> JDAHEP2
-              >> PHEP1 >> PHEP2 >> PHEP3 >> PHEP5;
+      ok = input.next(ISTHEP) && input.next(IDHEP) && input.next(JDAHEP1) && input.next(JDAHEP2)
+        && input.next(PHEP1)  && input.next(PHEP2) && input.next(PHEP3)   && input.next(PHEP5);
     else
-      m_input >> ISTHEP >> IDHEP
-              >> JMOHEP1 >> JMOHEP2
-              >> JDAHEP1 >> JDAHEP2
-              >> PHEP1 >> PHEP2 >> PHEP3
-              >> PHEP4 >> PHEP5
-              >> VHEP1 >> VHEP2 >> VHEP3
-              >> VHEP4;
+      ok = input.next(ISTHEP)  && input.next(IDHEP)
+        && input.next(JMOHEP1) && input.next(JMOHEP2)
+        && input.next(JDAHEP1) && input.next(JDAHEP2)
+        && input.next(PHEP1)   && input.next(PHEP2) && input.next(PHEP3)
+        && input.next(PHEP4)   && input.next(PHEP5)
+        && input.next(VHEP1)   && input.next(VHEP2) && input.next(VHEP3)
+        && input.next(VHEP4);
 
-    if(m_input.eof())
-      return EVENT_READER_EOF;
-
-    if(! m_input.good())
-      return EVENT_READER_IO_ERROR;
+    if( !ok )
+      return input.skip_space() ? EVENT_READER_IO_ERROR : EVENT_READER_EOF;
 
     //
     //  create a MCParticle and fill it from stdhep info
@@ -371,8 +406,6 @@ Geant4EventReaderHepEvt::readParticles(int /* event_number */,
       vtx->out.insert(p->id) ;
     }
   }
-
-  ++m_currEvent;
   return EVENT_READER_OK;
 }
 
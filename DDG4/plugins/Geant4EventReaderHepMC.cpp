@@ -22,10 +22,13 @@
  */
 
 // Framework include files
-#include <DDG4/IoStreams.h>
 #include <DDG4/Geant4InputAction.h>
+#include <DDG4/Geant4TextEventFile.h>
 
 // C/C++ include files
+#include <istream>
+#include <memory>
+#include <streambuf>
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -37,6 +40,23 @@ namespace dd4hep {
     namespace HepMC {
       /// HepMC EventStream class used internally by the Geant4EventReaderHepMC plugin
       class EventStream;
+
+      /// Stream buffer on the memory mapped data of one event. The data are not copied
+      class EventBuffer : public std::streambuf  {
+      public:
+        /// Attach the buffer to new data
+        void assign(std::string_view data)   {
+          char* ptr = const_cast<char*>(data.data());
+          this->setg(ptr, ptr, ptr + data.size());
+        }
+        /// Access the unread rest of the current line and move the stream to the next line
+        std::string_view line()   {
+          Geant4TextEventFile::Cursor cursor(std::string_view(this->gptr(), this->egptr()-this->gptr()));
+          std::string_view data = cursor.line();
+          this->setg(this->eback(), const_cast<char*>(cursor.ptr), this->egptr());
+          return data;
+        }
+      };
     }
 
     /// Class to populate Geant4 primaries from HepMC(2) files.
@@ -47,18 +67,37 @@ namespace dd4hep {
      *  For details also see:
      *  http://hepmc.web.cern.ch/hepmc/ReaderAsciiHepMC2_8cc_source.html
      *
+     *  The file is memory mapped and indexed (see Geant4TextEventFile):
+     *  events are accessed directly by their sequence number.
+     *  The vertex and particle records, i.e. the bulk of the event data, are
+     *  decoded from the mapped buffer without iostreams. The few header
+     *  records of the event (E, U, C, F, H, N) are read through a stream
+     *  on the mapped event data.
+     *
+     *  Parameters:
+     *  \li EventIndex: sidecar index file: "auto" (<file>.evtidx) or file name. Default: none
+     *
      *  \author  P.Kostka (main author)
      *  \author  M.Frank  (code reshuffeling into new DDG4 scheme)
      *  \version 1.0
      *  \ingroup DD4HEP_SIMULATION
      */
     class Geant4EventReaderHepMC : public Geant4EventReader  {
-      typedef boost::iostreams::stream<dd4hep_file_source<int> > in_stream;
-      //typedef boost::iostreams::stream<dd4hep_file_source<TFile*> > in_stream;
       typedef HepMC::EventStream EventStream;
     protected:
-      in_stream    m_input;
-      EventStream* m_events;
+      /// Shared memory mapped input file with event index
+      std::shared_ptr<Geant4TextEventFile> m_file;
+      /// Name of the sidecar index file
+      std::string         m_indexFile;
+      /// Stream buffer on the data of the current event
+      HepMC::EventBuffer  m_buffer;
+      /// Input stream on the event buffer
+      std::istream        m_input;
+      EventStream*        m_events;
+
+      /// Access the input file. Opened on first access
+      Geant4TextEventFile& file();
+
     public:
       /// Initializing constructor
       explicit Geant4EventReaderHepMC(const std::string& nam);
@@ -70,6 +109,7 @@ namespace dd4hep {
                                               std::vector<Particle*>& particles)  override;
       virtual EventReaderStatus moveToEvent(int event_number)  override;
       virtual EventReaderStatus skipEvent() override { return EVENT_READER_OK; }
+      virtual EventReaderStatus setParameters(std::map< std::string, std::string >& parameters)  override;
 
     };
   }     /* End namespace sim   */
@@ -92,7 +132,9 @@ namespace dd4hep {
 // C/C++ include files
 #include <cerrno>
 #include <climits>
+#include <cstring>
 #include <algorithm>
+#include <unistd.h>
 
 using namespace dd4hep::sim;
 using PropertyMask = dd4hep::detail::ReferenceBitMask<int>;
@@ -150,6 +192,8 @@ namespace dd4hep {
         typedef std::map<int,Geant4Particle*> Particles;
 
         std::istream& instream;
+        /// Stream buffer of the input stream: direct access to the event data
+        EventBuffer&  buffer;
 
         // io information
         std::string key;
@@ -162,8 +206,9 @@ namespace dd4hep {
         Particles m_particles;
 
         /// Default constructor
-        EventStream(std::istream& in) : instream(in), mom_unit(0.0), pos_unit(0.0),
-                                   io_type(0), xsection(0.0), xsection_err(0.0)
+        EventStream(std::istream& in, EventBuffer& buf)
+          : instream(in), buffer(buf), mom_unit(0.0), pos_unit(0.0),
+            io_type(0), xsection(0.0), xsection_err(0.0)
         { use_default_units();                       }
         /// Check if data stream is in proper state and has data
         bool ok()  const;
@@ -181,8 +226,8 @@ namespace dd4hep {
       char get_input(std::istream& is, std::istringstream& iline);
       int read_until_event_end(std::istream & is);
       int read_weight_names(EventStream &, std::istringstream& iline);
-      int read_particle(EventStream &info, std::istringstream& iline, Geant4Particle * p);
-      int read_vertex(EventStream &info, std::istream& is, std::istringstream & iline);
+      int read_particle(EventStream &info, Geant4TextEventFile::Cursor& input, Geant4Particle * p);
+      int read_vertex(EventStream &info);
       int read_event_header(EventStream &info, std::istringstream & input, EventHeader& header);
       int read_cross_section(EventStream &info, std::istringstream & input);
       int read_units(EventStream &info, std::istringstream & input);
@@ -200,44 +245,78 @@ namespace dd4hep {
 
 /// Initializing constructor
 Geant4EventReaderHepMC::Geant4EventReaderHepMC(const std::string& nam)
-  : Geant4EventReader(nam), m_input(), m_events(0)
+  : Geant4EventReader(nam), m_file(), m_indexFile(), m_buffer(), m_input(&m_buffer), m_events(0)
 {
-  // Now open the input file:
-  m_input.open(nam.c_str(), BOOST_IOS::in|BOOST_IOS::binary);
-  if ( not m_input.is_open() )   {
+  // The file is mapped on first access: check here that it can be opened
+  if ( ::access(nam.c_str(), R_OK) != 0 )   {
     except("+++ Failed to open input stream: %s Error:%s.", nam.c_str(), ::strerror(errno));
   }
-  m_events = new HepMC::EventStream(m_input);
+  m_events = new HepMC::EventStream(m_input, m_buffer);
+  m_directAccess = true;
 }
 
 /// Default destructor
 Geant4EventReaderHepMC::~Geant4EventReaderHepMC()    {
   delete m_events;
   m_events = 0;
-  m_input.close();
 }
 
-/// skipEvents if required
+/// pass parameters to the event reader object
+Geant4EventReader::EventReaderStatus
+Geant4EventReaderHepMC::setParameters(std::map< std::string, std::string >& parameters)   {
+  std::string index;
+  _getParameterValue(parameters, "EventIndex", index, std::string());
+  m_indexFile = Geant4TextEventFile::indexFileName(index, m_name);
+  return EVENT_READER_OK;
+}
+
+/// Access the input file. Opened on first access
+Geant4TextEventFile& Geant4EventReaderHepMC::file()   {
+  if ( !m_file )   {
+    // Every event starts with the event line 'E'
+    auto scanner = [](std::string_view data, std::size_t pos)  {
+      if ( pos == std::string_view::npos && !data.empty() && data[0] == 'E' )
+        return std::size_t(0);
+      std::size_t next = data.find("\nE", pos == std::string_view::npos ? 0 : pos);
+      return next == std::string_view::npos ? data.size() : next + 1;
+    };
+    m_file = Geant4TextEventFile::open(m_name, "HepMC2", scanner, m_indexFile);
+    // The file header defines the input type of the event listing
+    m_buffer.assign(m_file->prologue());
+    m_input.clear();
+    m_events->read();
+  }
+  return *m_file;
+}
+
+/// Move to the indicated event number. Direct access by the event index
 Geant4EventReader::EventReaderStatus
 Geant4EventReaderHepMC::moveToEvent(int event_number) {
-  if( m_currEvent < event_number && event_number != 0 ) {
-    printout(INFO,"EventReaderHepMC::moveToEvent","Current event:%d Skipping the next %d events",
-             m_currEvent, event_number);
-    while ( m_currEvent < event_number ) {
-      if ( not m_events->read() ) return EVENT_READER_ERROR;
-      ++m_currEvent;
-    }
+  std::string_view data;
+  if ( event_number < 0 || !file().event(event_number, data) )   {
+    printout(INFO,"EventReaderHepMC::moveToEvent","Event %d is beyond the end of file %s",
+             event_number, m_name.c_str());
+    return EVENT_READER_EOF;
   }
+  m_currEvent = event_number;
   printout(DEBUG,"EventReaderHepMC::moveToEvent","Current event number: %d",m_currEvent);
   return EVENT_READER_OK;
 }
 
 /// Read an event and fill a vector of MCParticles.
 Geant4EventReaderHepMC::EventReaderStatus
-Geant4EventReaderHepMC::readParticles(int /* ev_id */,
+Geant4EventReaderHepMC::readParticles(int event_number,
                                       Vertices&  vertices,
                                       Particles& output) {
 
+  std::string_view data;
+  if ( event_number < 0 || !file().event(event_number, data) )   {
+    return EVENT_READER_EOF;
+  }
+  m_currEvent = event_number;
+  m_buffer.assign(data);
+  m_input.clear();
+
   //fg: for now we create exactly one event vertex here ( as before )
   //    this needs revisiting as HepMC allows to have more than one vertex ...
   Geant4Vertex* primary_vertex = new Geant4Vertex ;
@@ -246,12 +325,7 @@ Geant4EventReaderHepMC::readParticles(int /* ev_id */,
   primary_vertex->y = 0;
   primary_vertex->z = 0;
 
-  if ( !m_events->ok() )  {
-    vertices.clear();
-    output.clear();
-    return EVENT_READER_EOF;
-  }
-  else if ( m_events->read() )  {
+  if ( m_events->read() )  {
     EventStream::Particles& parts = m_events->particles();
 
     Position pos(primary_vertex->x,primary_vertex->y,primary_vertex->z);
@@ -290,12 +364,13 @@ Geant4EventReaderHepMC::readParticles(int /* ev_id */,
           primary_vertex->out.insert(p->id); // Stuff, to be given to Geant4 together with daughters
       }
     }
-    ++m_currEvent;
     return EVENT_READER_OK;
   }
+  // The event is present in the index, but could not be decoded
+  for_each(vertices.begin(), vertices.end(), detail::deleteObject<Vertex>);
   vertices.clear();
   output.clear();
-  return EVENT_READER_EOF;
+  return EVENT_READER_IO_ERROR;
 }
 
 void HepMC::fix_particles(EventStream& info)  {
@@ -431,13 +506,17 @@ int HepMC::read_weight_names(EventStream&, std::istringstream&)   {
   return 1;
 }
 
-int HepMC::read_particle(EventStream &info, std::istringstream& input, Geant4Particle * p)   {
-  float ene = 0., theta = 0., phi = 0;
-  int   size = 0, stat=0;
+int HepMC::read_particle(EventStream &info, Geant4TextEventFile::Cursor& input, Geant4Particle * p)   {
+  double energy = 0., theta = 0., phi = 0.;
+  int    size = 0, stat=0;
   PropertyMask status(p->status);
 
-  // check that the input stream is still OK after reading item
-  input >> p->id >> p->pdgID >> p->psx >> p->psy >> p->psz >> ene;
+  // check that the input is still OK after reading item
+  if ( !(input.next(p->id)  && input.next(p->pdgID) &&
+         input.next(p->psx) && input.next(p->psy) && input.next(p->psz) && input.next(energy)) )
+    return 0;
+  // The energy is kept in single precision as in the HepMC2 record
+  float ene = float(energy);
   p->id = info.particles().size();
 #if defined(DD4HEP_DEBUG_HEP_MC_PARTICLE)
   if ( p->id == DD4HEP_DEBUG_HEP_MC_PARTICLE )   {
@@ -449,18 +528,17 @@ int HepMC::read_particle(EventStream &info, std::istringstream& input, Geant4Par
   p->psy *= info.mom_unit;
   p->psz *= info.mom_unit;
   ene *= info.mom_unit;
-  if ( !input )
-    return 0;
-  else if ( info.io_type != ascii )  {
-    input >> p->mass;
+  if ( info.io_type != ascii )  {
+    if ( !input.next(p->mass) )
+      return 0;
     p->mass *= info.mom_unit;
   }
   else   {
     p->mass = std::sqrt(fabs(ene*ene - (p->psx*p->psx + p->psy*p->psy + p->psz*p->psz)));
   }
   // Reuse here the secondaries to store the end-vertex ID
-  input >> stat >> theta >> phi >> p->secondaries >> size;
-  if( !input )   {
+  if ( !(input.next(stat) && input.next(theta) && input.next(phi) &&
+         input.next(p->secondaries) && input.next(size)) )   {
     return 0;
   }
   //
@@ -484,25 +562,23 @@ int HepMC::read_particle(EventStream &info, std::istringstream& input, Geant4Par
   // read flow patterns if any exist. Protect against tainted readings.
   size = std::min(size,100);
   for (int i = 0; i < size; ++i ) {
-    input >> p->colorFlow[0] >> p->colorFlow[1];
-    if(!input) return 0;
+    if ( !(input.next(p->colorFlow[0]) && input.next(p->colorFlow[1])) )
+      return 0;
   }
   return 1;
 }
 
-int HepMC::read_vertex(EventStream &info, std::istream& is, std::istringstream & input)    {
+int HepMC::read_vertex(EventStream &info)    {
   int id=0, dummy = 0, num_orphans_in=0, num_particles_out=0, weights_size=0;
   std::vector<float> weights;
+  Geant4TextEventFile::Cursor input(info.buffer.line());
   Geant4Vertex* v = new Geant4Vertex();
-  Geant4Particle* p;
 
-  if( !input ) {
-    delete v;
-    return 0;
-  }
-  input >> id >> dummy >> v->x >> v->y >> v->z >> v->time
-        >> num_orphans_in >> num_particles_out >> weights_size;
-  if( !input ) {
+  // Skip the record key 'V'
+  if ( !(input.skip_token() &&
+         input.next(id)  && input.next(dummy) &&
+         input.next(v->x) && input.next(v->y) && input.next(v->z) && input.next(v->time) &&
+         input.next(num_orphans_in) && input.next(num_particles_out) && input.next(weights_size)) )  {
     delete v;
     return 0;
   }
@@ -519,22 +595,19 @@ int HepMC::read_vertex(EventStream &info, std::istream& is, std::istringstream &
   v->y *= info.pos_unit;
   v->z *= info.pos_unit;
   for (int i1 = 0; i1 < weights_size; ++i1) {
-    float value = 0e0;
-    input >> value;
-    weights.emplace_back(value);
-    if( !input ) {
+    double value = 0e0;
+    if( !input.next(value) ) {
       delete v;
       return 0;
     }
+    weights.emplace_back(value);
   }
   info.vertices().emplace(id,v);
-  for(char value = is.peek(); value=='P'; value=is.peek())  {
-    value = get_input(is,input);
-    if( !input || value < 0 )
-      return 0;
-
-    read_particle(info, input,p = new Geant4Particle());
-    if( !input )   {
+  for(char value = info.instream.peek(); value=='P'; value=info.instream.peek())  {
+    Geant4TextEventFile::Cursor line(info.buffer.line());
+    Geant4Particle* p = new Geant4Particle();
+    // Skip the record key 'P'
+    if ( !line.skip_token() || !read_particle(info, line, p) )   {
       printout(ERROR,"HepMC","++ Vertex %d Failed to daughter read particle!",id);
       delete p;
       return 0;
@@ -745,6 +818,11 @@ bool HepMC::EventStream::read()   {
       get_input(instream,input_line);
       continue;
     }
+    else if ( value == 'V' )  {  // Read vertex with particles from the event buffer
+      if ( !read_vertex(info) )
+        goto Skip;
+      continue;
+    }
     value = get_input(instream,input_line);
 
     // On failure switch to end
@@ -815,11 +893,6 @@ bool HepMC::EventStream::read()   {
         goto Skip;
       continue;
 
-    case 'V':           // Read vertex with particles
-      if ( !read_vertex(info, instream, input_line) )
-        goto Skip;
-      continue;
-
     case 'F':           // Read PDF
       if ( !read_pdf(info, input_line) )
         goto Skip;
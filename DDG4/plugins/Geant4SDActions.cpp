@@ -15,8 +15,20 @@
 #include <DDG4/Geant4SensDetAction.inl>
 #include <DDG4/Geant4FastSimHandler.h>
 #include <DDG4/Geant4EventAction.h>
+#include <DDG4/Geant4RunAction.h>
+#include <DDG4/Geant4StepBatch.h>
+#include <DDG4/Geant4TrackingAction.h>
 #include <G4OpticalPhoton.hh>
+#include <G4ParticleDefinition.hh>
 #include <G4VProcess.hh>
+#include <G4Track.hh>
+
+// C/C++ include files
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <unordered_map>
+#include <utility>
 
 
 /// Namespace for the AIDA detector description toolkit
@@ -28,6 +40,152 @@ namespace dd4hep {
     namespace {
       struct Geant4VoidSensitive {};
 
+      /// Contribution policy of the generic DDG4 calorimeter sensitive detector
+      /**
+       *  Showers deposit energy in a cell with thousands of steps. Depending on the
+       *  policy the steps are combined into one contribution per track, per primary
+       *  particle or per time bin. The number of steps and of stored contributions
+       *  is accumulated to quantify the saving.
+       *
+       *  \author  M.Frank
+       *  \version 1.0
+       *  \ingroup DD4HEP_SIMULATION
+       */
+      class ContributionPolicy  {
+      public:
+        typedef Geant4Calorimeter::Hit Hit;
+        /// Policies to record the Monte Carlo contributions of calorimeter hits
+        enum Mode  {
+          /// Keep one contribution for every step (default)
+          KEEP_ALL_STEPS    = 0,
+          /// Merge the contributions of each track
+          MERGE_PER_TRACK   = 1,
+          /// Merge the contributions of all descendants of a primary particle
+          MERGE_PER_PRIMARY = 2,
+          /// Merge the contributions within time bins
+          MERGE_TIME_BINNED = 3
+        };
+        /// Hash of the index of merged contributions: (hit, merge key)
+        struct KeyHash  {
+          std::size_t operator()(const std::pair<const Hit*, long>& k)  const  {
+            return std::hash<const Hit*>()(k.first) ^ (std::size_t(k.second)*0x9E3779B97F4A7C15ULL);
+          }
+        };
+
+        /// Property: policy name (AllSteps, PerTrack, PerPrimary, TimeBinned)
+        std::string name             { "AllSteps" };
+        /// Property: time bin width for the TimeBinned policy [ns]
+        double      timeBin          { 1e0 };
+        /// Owner name for printouts
+        std::string owner            { };
+        /// Policy mode
+        int         mode             { KEEP_ALL_STEPS };
+        /// Primary ancestor (track identifier, PDG code) of each track of the current event
+        std::unordered_map<int, std::pair<int,int> > ancestors { };
+        /// Merged contributions of the current event: (hit, merge key) -> index in the hit truth
+        std::unordered_map<std::pair<const Hit*, long>, std::size_t, KeyHash> merged { };
+        /// Statistics: number of steps with energy deposit
+        long        numSteps         { 0 };
+        /// Statistics: number of stored contributions
+        long        numContributions { 0 };
+        /// Statistics: number of hits
+        long        numHits          { 0 };
+
+      public:
+        /// Prepare the contribution according to the policy and return the merge key
+        long mergeKey(HitContribution& contrib)  const  {
+          switch( mode )  {
+          case MERGE_PER_PRIMARY:  {
+            auto i = ancestors.find(contrib.trackID);
+            if ( i != ancestors.end() )  {
+              contrib.trackID = i->second.first;
+              contrib.pdgID   = i->second.second;
+            }
+            return contrib.trackID;
+          }
+          case MERGE_TIME_BINNED:
+            return long(std::floor(contrib.time/timeBin));
+          case MERGE_PER_TRACK:
+          default:
+            return contrib.trackID;
+          }
+        }
+
+        /// Add a contribution to the hit. Contributions with identical merge key are combined
+        /** The deposits and the step lengths are summed, the position is energy weighted,
+         *  the time is the earliest time. Track, PDG code and momentum of the first
+         *  contribution are kept.
+         */
+        void add(Hit* hit, const HitContribution& contrib)  {
+          ++numSteps;
+          if ( mode == KEEP_ALL_STEPS )  {
+            hit->truth.emplace_back(contrib);
+            ++numContributions;
+            return;
+          }
+          HitContribution next(contrib);
+          long key = mergeKey(next);
+          auto ret = merged.emplace(std::make_pair(hit, key), hit->truth.size());
+          if ( ret.second )  {
+            hit->truth.emplace_back(next);
+            ++numContributions;
+            return;
+          }
+          HitContribution& c = hit->truth[ret.first->second];
+          double dep = c.deposit + next.deposit;
+          if ( dep > 0e0 )  {
+            double w1 = c.deposit/dep, w2 = next.deposit/dep;
+            c.x = float(w1*c.x + w2*next.x);
+            c.y = float(w1*c.y + w2*next.y);
+            c.z = float(w1*c.z + w2*next.z);
+          }
+          c.deposit = dep;
+          c.length += next.length;
+          c.time    = std::min(c.time, next.time);
+        }
+
+        /// Event callback: resolve the policy name and reset the per-event indices
+        void beginEvent(const G4Event* /* event */)  {
+          if      ( name == "AllSteps"   ) mode = KEEP_ALL_STEPS;
+          else if ( name == "PerTrack"   ) mode = MERGE_PER_TRACK;
+          else if ( name == "PerPrimary" ) mode = MERGE_PER_PRIMARY;
+          else if ( name == "TimeBinned" ) mode = MERGE_TIME_BINNED;
+          else  {
+            except(owner.c_str(), "+++ Unknown contribution policy: %s. "
+                   "Known: AllSteps, PerTrack, PerPrimary, TimeBinned", name.c_str());
+          }
+          if ( mode == MERGE_TIME_BINNED && !(timeBin > 0e0) )  {
+            except(owner.c_str(), "+++ Invalid time bin width %g for the TimeBinned contribution policy.", timeBin);
+          }
+          ancestors.clear();
+          merged.clear();
+        }
+
+        /// Tracking callback: record the primary ancestor of a new track
+        void beginTrack(const G4Track* track)  {
+          if ( mode == MERGE_PER_PRIMARY )  {
+            int id = track->GetTrackID(), parent = track->GetParentID();
+            // Parents are tracked before their secondaries: the parent entry exists
+            auto i = parent > 0 ? ancestors.find(parent) : ancestors.end();
+            if ( i != ancestors.end() )
+              ancestors[id] = i->second;
+            else
+              ancestors[id] = std::make_pair(id, int(track->GetDefinition()->GetPDGEncoding()));
+          }
+        }
+
+        /// Run callback: print the contribution statistics
+        void endRun(const G4Run* /* run */)  {
+          double mem_all    = double(numSteps)*sizeof(HitContribution)/1024e0;
+          double mem_stored = double(numContributions)*sizeof(HitContribution)/1024e0;
+          printout(INFO, owner,
+                   "+++ Contribution policy %s: %ld hits, %ld steps -> %ld contributions. "
+                   "Truth memory: %.1f kB instead of %.1f kB (%.1f %%)",
+                   name.c_str(), numHits, numSteps, numContributions, mem_stored, mem_all,
+                   numSteps > 0 ? 100e0*double(numContributions)/double(numSteps) : 100e0);
+        }
+      };
+
       /// Common code to handle the creation of a calorimeter hit.
       template <class HANDLER>
       void handleCalorimeterHit (VolumeID cell,
@@ -35,7 +193,8 @@ namespace dd4hep {
                                  Geant4HitCollection& coll,
                                  const HANDLER& h,
                                  const Geant4Sensitive& sd,
-                                 const Segmentation& segmentation)
+                                 const Segmentation& segmentation,
+                                 ContributionPolicy* policy = nullptr)
       {
         typedef Geant4Calorimeter::Hit Hit;
         Hit* hit = coll.findByKey<Hit>(cell);
@@ -73,9 +232,44 @@ namespace dd4hep {
             hit->cellID = cell;
             sd.except("+++ Invalid CELL ID for hit!");
           }
+          if ( policy ) ++policy->numHits;
         }
-        hit->truth.emplace_back(contrib);
         hit->energyDeposit += contrib.deposit;
+        if ( policy )
+          policy->add(hit, contrib);
+        else
+          hit->truth.emplace_back(contrib);
+      }
+
+      /// Hit handler for buffered steps: the touchable is replaced by the stored transformation
+      struct Geant4BatchHitHandler  {
+        /// Local-to-global transformation of the step volume
+        const G4AffineTransform& transform;
+        /// No touchable available for buffered steps
+        const G4VTouchable* touchable()  const   {  return nullptr;  }
+        /// Coordinate transformation to global coordinates (as Geant4HitHandler)
+        Position localToGlobal(const DDSegmentation::Vector3D& local)  const   {
+          G4ThreeVector p = transform.TransformPoint(G4ThreeVector(local.X / dd4hep::mm,local.Y / dd4hep::mm,local.Z / dd4hep::mm));
+          return Position(p.x(),p.y(),p.z());
+        }
+      };
+
+      /// Create the calorimeter hits of all buffered steps
+      void processCalorimeterBatch(Geant4StepBatch& batch,
+                                   Geant4HitCollection& coll,
+                                   const Geant4Sensitive& sd,
+                                   const Segmentation& segmentation,
+                                   ContributionPolicy* policy)
+      {
+        batch.resolve(sd, segmentation);
+        for( std::size_t i = 0, n = batch.size(); i < n; ++i )  {
+          if ( batch.valid(i) )  {
+            const Geant4StepBatch::Record& rec = batch.record(i);
+            Geant4BatchHitHandler h { batch.transform(rec) };
+            handleCalorimeterHit(batch.cellID(i), rec.contrib, coll, h, sd, segmentation, policy);
+          }
+        }
+        batch.release();
       }
     }
 
@@ -265,19 +459,96 @@ namespace dd4hep {
      * \package Geant4CalorimeterAction
      *
      * \brief Sensitive detector meant for calorimeters
-
+     *
+     * Properties:
+     * ContributionPolicy:  Recording of the Monte Carlo contributions of the hits:
+     *                      AllSteps (default), PerTrack, PerPrimary or TimeBinned.
+     * ContributionTimeBin: Time bin width of the TimeBinned policy [ns]
+     * StepBatchSize:       If > 0, steps are buffered as compact records and the hits
+     *                      are created in batches when the buffer is full and at the
+     *                      end of the event. The cell identifiers are computed with
+     *                      one call to the segmentation per batch. The hits are
+     *                      identical, but only available at the end of the event.
      *
      * @}
      */
+    /// Helper class to define properties and transient state of calorimeters
+    struct Geant4CalorimeterSensitive {
+      /// Recording of the Monte Carlo contributions of the hits
+      ContributionPolicy policy;
+      /// Number of buffered steps of the batched processing (0: process steps immediately)
+      int                stepBatchSize { 0 };
+      /// Step buffer of the batched processing
+      Geant4StepBatch*   stepBatch     { nullptr };
+    };
+
+    /// Initialization overload for specialization
+    template <> void Geant4SensitiveAction<Geant4CalorimeterSensitive>::initialize() {
+      auto& policy = m_userData.policy;
+      policy.owner = name();
+      declareProperty("ContributionPolicy",  policy.name);
+      declareProperty("ContributionTimeBin", policy.timeBin);
+      declareProperty("StepBatchSize",       m_userData.stepBatchSize);
+      eventAction().callAtBegin(&policy, &ContributionPolicy::beginEvent);
+      trackingAction().callAtBegin(&policy, &ContributionPolicy::beginTrack);
+      runAction().callAtEnd(&policy, &ContributionPolicy::endRun);
+    }
+
+    /// Finalization overload for specialization
+    template <> void Geant4SensitiveAction<Geant4CalorimeterSensitive>::finalize() {
+      if ( m_userData.stepBatch )  {
+        printout(INFO, name(), "+++ Batched step processing: %ld steps in %ld batches.",
+                 m_userData.stepBatch->numSteps, m_userData.stepBatch->numBatches);
+      }
+      detail::deletePtr(m_userData.stepBatch);
+    }
+
+    /// G4VSensitiveDetector interface: Method invoked at the begining of each event.
+    template <> void Geant4SensitiveAction<Geant4CalorimeterSensitive>::begin(G4HCofThisEvent* hce) {
+      if ( m_userData.stepBatchSize > 0 && !m_userData.stepBatch )  {
+        m_userData.stepBatch = new Geant4StepBatch(m_userData.stepBatchSize);
+      }
+      if ( m_userData.stepBatch )  {
+        m_userData.stepBatch->clear();
+      }
+      Geant4Sensitive::begin(hce);
+    }
+
+    /// G4VSensitiveDetector interface: Method invoked at the end of each event.
+    template <> void Geant4SensitiveAction<Geant4CalorimeterSensitive>::end(G4HCofThisEvent* hce) {
+      Geant4StepBatch* batch = m_userData.stepBatch;
+      if ( batch && !batch->empty() )  {
+        processCalorimeterBatch(*batch, *collection(m_collectionID), *this, m_segmentation, &m_userData.policy);
+      }
+      Geant4Sensitive::end(hce);
+    }
+
+    /// G4VSensitiveDetector interface: Method invoked if the event was aborted.
+    template <> void Geant4SensitiveAction<Geant4CalorimeterSensitive>::clear(G4HCofThisEvent* hce) {
+      if ( m_userData.stepBatch )  {
+        m_userData.stepBatch->clear();
+      }
+      Geant4Sensitive::clear(hce);
+    }
+
     /// Define collections created by this sensitivie action object
-    template <> void Geant4SensitiveAction<Geant4Calorimeter>::defineCollections() {
+    template <> void Geant4SensitiveAction<Geant4CalorimeterSensitive>::defineCollections() {
       m_collectionID = declareReadoutFilteredCollection<Geant4Calorimeter::Hit>();
     }
 
     /// Method for generating hit(s) using the information of G4Step object.
     template <> bool
-    Geant4SensitiveAction<Geant4Calorimeter>::process(const G4Step* step,G4TouchableHistory*) {
+    Geant4SensitiveAction<Geant4CalorimeterSensitive>::process(const G4Step* step,G4TouchableHistory*) {
       typedef Geant4Calorimeter::Hit Hit;
+      Geant4StepBatch* batch = m_userData.stepBatch;
+      if ( batch )  {
+        batch->add(step, Hit::extractContribution(step));
+        mark(step->GetTrack());
+        if ( batch->full() )  {
+          processCalorimeterBatch(*batch, *collection(m_collectionID), *this, m_segmentation, &m_userData.policy);
+        }
+        return true;
+      }
       Geant4StepHandler    h(step);
       HitContribution      contrib = Hit::extractContribution(step);
       Geant4HitCollection* coll    = collection(m_collectionID);
@@ -301,13 +572,13 @@ namespace dd4hep {
         return true;
       }
 
-      handleCalorimeterHit(cell, contrib, *coll, h, *this, m_segmentation);
+      handleCalorimeterHit(cell, contrib, *coll, h, *this, m_segmentation, &m_userData.policy);
       mark(h.track);
       return true;
     }
     /// GFlash/FastSim interface: Method for generating hit(s) using the information of Geant4FastSimSpot object.
     template <> bool
-    Geant4SensitiveAction<Geant4Calorimeter>::processFastSim(const Geant4FastSimSpot* spot,
+    Geant4SensitiveAction<Geant4CalorimeterSensitive>::processFastSim(const Geant4FastSimSpot* spot,
 							     G4TouchableHistory* /* hist */)
     {
       typedef Geant4Calorimeter::Hit Hit;
@@ -327,12 +598,12 @@ namespace dd4hep {
         std::cout << out.str();
         return true;
       }
-      handleCalorimeterHit(cell, contrib, *coll, h, *this, m_segmentation);
+      handleCalorimeterHit(cell, contrib, *coll, h, *this, m_segmentation, &m_userData.policy);
       mark(h.track);
       return true;
     }
 
-    typedef Geant4SensitiveAction<Geant4Calorimeter> Geant4CalorimeterAction;
+    typedef Geant4SensitiveAction<Geant4CalorimeterSensitive> Geant4CalorimeterAction;
 
     // ++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++
     //               Geant4SensitiveAction<OpticalCalorimeter>
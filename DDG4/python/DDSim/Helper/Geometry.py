@@ -36,6 +36,9 @@ class Geometry(ConfigHelper):
     self._dumpDGDML_EXTRA = {"help": "If not empty, filename to dump the Geometry as GDML"}
     self.dumpGDML = ""
 
+    self._conversionThreads_EXTRA = {"help": "Number of threads to convert tessellated solids (<= 1: sequential)"}
+    self.conversionThreads = 0
+
     self._regexSDDict = {}
 
     self._closeProperties()
@@ -78,6 +81,7 @@ class Geometry(ConfigHelper):
     act.GeoInfoPrintLevel = geoPrintLevel
     act.DumpHierarchy = self.dumpHierarchy
     act.DumpGDML = self.dumpGDML
+    act.ConversionThreads = self.conversionThreads
 
     # Apply sensitive detectors
     sensitives = DetectorConstruction(kernel, str('Geant4DetectorSensitivesConstruction/ConstructSD'))
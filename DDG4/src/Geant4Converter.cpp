@@ -71,6 +71,7 @@
 #include <G4MaterialPropertiesIndex.hh>
 #endif
 #include <G4ScaledSolid.hh>
+#include <G4TessellatedSolid.hh>
 #include <CLHEP/Units/SystemOfUnits.h>
 
 // C/C++ include files
@@ -78,6 +79,11 @@
 #include <iomanip>
 #include <sstream>
 #include <limits>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
 
 namespace units = dd4hep;
 using namespace dd4hep::sim;
@@ -738,6 +744,87 @@ void* Geant4Converter::handleSolid(const std::string& name, const TGeoShape* sha
   return solid;
 }
 
+namespace {
+  /// Collect tessellated shapes. Descend into scaled and boolean shapes
+  void collect_tessellated(const TGeoShape* shape, std::set<const TGeoShape*>& seen,
+                           std::vector<const TGeoShape*>& result)   {
+    if ( !shape || !seen.insert(shape).second )
+      return;
+    TClass* isa = shape->IsA();
+    if ( isa == TGeoTessellated::Class() )  {
+      result.emplace_back(shape);
+    }
+    else if ( isa == TGeoScaledShape::Class() )  {
+      collect_tessellated(((const TGeoScaledShape*)shape)->GetShape(), seen, result);
+    }
+    else if ( isa == TGeoCompositeShape::Class() )  {
+      const TGeoBoolNode* boolean = ((const TGeoCompositeShape*)shape)->GetBoolNode();
+      collect_tessellated(boolean->GetLeftShape(),  seen, result);
+      collect_tessellated(boolean->GetRightShape(), seen, result);
+    }
+  }
+}
+
+/// Convert all tessellated solids (also components of boolean solids) concurrently
+void Geant4Converter::handleTessellatedSolids(const std::vector<TGeoShape*>& shapes) const   {
+  std::set<const TGeoShape*>     seen;
+  std::vector<const TGeoShape*>  work;
+  Geant4GeometryInfo&            info = data();
+  for ( const TGeoShape* shape : shapes )
+    collect_tessellated(shape, seen, work);
+  work.erase(std::remove_if(work.begin(), work.end(),
+                            [&info](const TGeoShape* s) { return info.g4Solids[s] != nullptr; }),
+             work.end());
+  if ( work.empty() )  {
+    return;
+  }
+  // Largest meshes first: balances the load between the threads
+  std::sort(work.begin(), work.end(), [](const TGeoShape* a, const TGeoShape* b)  {
+      return ((const TGeoTessellated*)a)->GetNfacets() > ((const TGeoTessellated*)b)->GetNfacets();
+    });
+
+  TTimeStamp start;
+  std::vector<G4TessellatedSolid*> solids(work.size(), nullptr);
+  std::atomic<std::size_t> next  { 0 };
+  std::exception_ptr       error { };
+  std::mutex               lock;
+  auto worker = [&]()  {
+    for( std::size_t i = next++; i < work.size(); i = next++ )  {
+      try  {
+        G4TessellatedSolid* g4 = nullptr;
+        {
+          // The solid constructor registers to the (not thread safe) G4SolidStore
+          std::lock_guard<std::mutex> guard(lock);
+          g4 = new G4TessellatedSolid(work[i]->GetName());
+        }
+        // Facets and voxelization only touch the solid itself
+        fillTessellatedSolid(work[i], g4);
+        solids[i] = g4;
+      }
+      catch( ... )  {
+        std::lock_guard<std::mutex> guard(lock);
+        if ( !error ) error = std::current_exception();
+        next = work.size();
+      }
+    }
+  };
+  std::size_t num_threads = std::min(work.size(), std::size_t(numThreads));
+  std::vector<std::thread> threads;
+  for( std::size_t i = 1; i < num_threads; ++i )
+    threads.emplace_back(worker);
+  worker();
+  for( auto& t : threads )
+    t.join();
+  if ( error )  {
+    std::rethrow_exception(error);
+  }
+  for( std::size_t i = 0; i < work.size(); ++i )
+    info.g4Solids[work[i]] = solids[i];
+  TTimeStamp stop;
+  printout(outputLevel, "Geant4Converter", "++ Converted %ld tessellated solids with %ld threads. [%7.3f seconds]",
+           work.size(), num_threads, stop.AsDouble()-start.AsDouble());
+}
+
 /// Dump logical volume in GDML format to output stream
 void* Geant4Converter::handleVolume(const std::string& name, const TGeoVolume* volume) const {
   Volume _v(volume);
@@ -1691,6 +1778,9 @@ Geant4Converter& Geant4Converter::create(DetElement top) {
   handleArray(this, geo.manager->GetListOfOpticalSurfaces(), &Geant4Converter::handleOpticalSurface);
   
   handle(this,     geo.volumes, &Geant4Converter::collectVolume);
+  if ( numThreads > 1 )  {
+    handleTessellatedSolids(geo.solids);
+  }
   handle(this,     geo.solids,  &Geant4Converter::handleSolid);
   printout(outputLevel, "Geant4Converter", "++ Handled %ld solids.", geo.solids.size());
   handleRefs(this, geo.vis,     &Geant4Converter::handleVis);
@@ -26,6 +26,33 @@
 
 using namespace dd4hep::sim;
 
+namespace {
+  /// Per-thread memory pools of the standard DDG4 hits
+  G4ThreadLocal G4Allocator<Geant4Tracker::Hit>*     s_trackerHitPool     = nullptr;
+  G4ThreadLocal G4Allocator<Geant4Calorimeter::Hit>* s_calorimeterHitPool = nullptr;
+
+  /// Allocate a hit from the pool. Objects of derived classes have a different size
+  template <typename HIT> void* allocate_hit(G4Allocator<HIT>*& pool, std::size_t size)  {
+    if ( size != sizeof(HIT) )
+      return ::operator new(size);
+    if ( !pool ) pool = new G4Allocator<HIT>;
+    return pool->MallocSingle();
+  }
+
+  /// Return the hit memory to the pool of the current thread
+  template <typename HIT> void release_hit(G4Allocator<HIT>*& pool, void* ptr, std::size_t size)  {
+    if ( !ptr )
+      return;
+    else if ( size != sizeof(HIT) )
+      ::operator delete(ptr);
+    else  {
+      // Hits may be deleted by a thread which did not allocate any
+      if ( !pool ) pool = new G4Allocator<HIT>;
+      pool->FreeSingle(static_cast<HIT*>(ptr));
+    }
+  }
+}
+
 /// Default constructor
 SimpleRun::SimpleRun()  {
   InstanceCount::increment(this);
@@ -140,6 +167,16 @@ void Geant4Tracker::Hit::copyFrom(const Hit& c) {
   }
 }
 
+/// Hit allocation from a per-thread memory pool
+void* Geant4Tracker::Hit::operator new(std::size_t size)   {
+  return allocate_hit(s_trackerHitPool, size);
+}
+
+/// Return the hit memory to the per-thread memory pool
+void Geant4Tracker::Hit::operator delete(void* ptr, std::size_t size)   {
+  release_hit(s_trackerHitPool, ptr, size);
+}
+
 /// Clear hit content
 Geant4Tracker::Hit& Geant4Tracker::Hit::clear() {
   position.SetXYZ(0, 0, 0);
@@ -208,3 +245,13 @@ Geant4Calorimeter::Hit::Hit(const Position& pos) : position(pos)  {
 Geant4Calorimeter::Hit::~Hit() {
   InstanceCount::decrement(this);
 }
+
+/// Hit allocation from a per-thread memory pool
+void* Geant4Calorimeter::Hit::operator new(std::size_t size)   {
+  return allocate_hit(s_calorimeterHitPool, size);
+}
+
+/// Return the hit memory to the per-thread memory pool
+void Geant4Calorimeter::Hit::operator delete(void* ptr, std::size_t size)   {
+  release_hit(s_calorimeterHitPool, ptr, size);
+}
@@ -17,6 +17,9 @@
 #include <DDG4/Geant4Data.h>
 #include <G4Allocator.hh>
 
+// C/C++ include files
+#include <algorithm>
+
 using namespace dd4hep::sim;
 
 G4ThreadLocal G4Allocator<Geant4HitWrapper>* HitWrapperAllocator = 0;
@@ -76,6 +79,55 @@ Geant4HitWrapper::Wrapper Geant4HitWrapper::releaseData() {
 Geant4HitCollection::Compare::~Compare()  {
 }
 
+/// Rebuild the table with the given number of slots (power of two)
+void Geant4HitCollection::Keys::rehash(size_t num_slots)   {
+  std::vector<Entry> table(num_slots, Entry{0, 0, 0});
+  unsigned int shift = 64;
+  for( size_t n = num_slots; n > 1; n >>= 1 ) --shift;
+  table.swap(m_table);
+  m_shift = shift;
+  const size_t mask = num_slots - 1;
+  for( const Entry& e : table )  {
+    if ( e.generation == m_generation )  {
+      size_t i = slot(e.key);
+      while( m_table[i].generation == m_generation ) i = (i+1) & mask;
+      m_table[i] = e;
+    }
+  }
+}
+
+/// Expected number of entries. The table is sized accordingly at the next insertion
+void Geant4HitCollection::Keys::reserve(size_t num_keys)   {
+  m_expected = num_keys;
+}
+
+/// Insert a new key. Returns false if the key is already present
+bool Geant4HitCollection::Keys::insert(VolumeID key, size_t index)   {
+  if ( 2*(m_size+1) > m_table.size() )  {
+    size_t num_slots = 16;
+    while( num_slots < 2*std::max(m_size+1, m_expected) ) num_slots <<= 1;
+    rehash(num_slots);
+  }
+  const size_t mask = m_table.size() - 1;
+  size_t i = slot(key);
+  for( ; m_table[i].generation == m_generation; i = (i+1) & mask )  {
+    if ( m_table[i].key == key ) return false;
+  }
+  m_table[i] = Entry{key, (unsigned int)index, m_generation};
+  ++m_size;
+  return true;
+}
+
+/// Remove all keys. Constant time: the table memory is kept
+void Geant4HitCollection::Keys::clear()   {
+  m_size = 0;
+  if ( ++m_generation == 0 )  {
+    // Generation counter wrapped: entries of old generations may look valid
+    for( Entry& e : m_table ) e.generation = 0;
+    m_generation = 1;
+  }
+}
+
 /// Default destructor
 Geant4HitCollection::~Geant4HitCollection() {
   m_hits.clear();
@@ -105,6 +157,12 @@ void Geant4HitCollection::clear()   {
   m_keys.clear();
 }
 
+/// Reserve space for the expected number of hits
+void Geant4HitCollection::reserve(size_t num_hits)   {
+  m_hits.reserve(num_hits);
+  m_keys.reserve(num_hits);
+}
+
 /// Find hit in a collection by comparison of attributes
 void* Geant4HitCollection::findHit(const Compare& cmp)  {
   void* p = 0;
@@ -123,9 +181,9 @@ void* Geant4HitCollection::findHit(const Compare& cmp)  {
 
 /// Find hit in a collection by comparison of the key
 Geant4HitWrapper* Geant4HitCollection::findHitByKey(VolumeID key)   {
-  Keys::const_iterator i=m_keys.find(key);
-  if ( i == m_keys.end() ) return 0;
-  m_lastHit = (*i).second;
+  size_t idx = m_keys.find(key);
+  if ( idx == Keys::npos ) return 0;
+  m_lastHit = idx;
   return &m_hits.at(m_lastHit);
 }
 
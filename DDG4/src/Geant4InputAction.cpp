@@ -124,6 +124,7 @@ Geant4InputAction::Geant4InputAction(Geant4Context* ctxt, const std::string& nam
   declareProperty("Mask",           m_mask = 0);
   declareProperty("MomentumScale",  m_momScale = 1.0);
   declareProperty("HaveAbort",      m_abort = true);
+  declareProperty("UseEventID",     m_useEventID = false);
   declareProperty("Parameters",     m_parameters = {});
   declareProperty("AlternativeDecayStatuses", m_alternativeDecayStatuses = {});
   m_needsControl = true;
@@ -238,9 +239,18 @@ void Geant4InputAction::operator()(G4Event* event)   {
   Vertices                  vertices ;
   int result;
 
-  result = readParticles(m_currentEventNumber, vertices, primaries);
+  int evt_number = m_currentEventNumber;
+  if ( m_useEventID )   {
+    createReader();
+    if ( !m_reader->hasDirectAccess() )  {
+      except("The reader of %s does not support direct access. Cannot use the event identifier.",
+             m_input.c_str());
+    }
+    evt_number = event->GetEventID();
+  }
+  result = readParticles(evt_number, vertices, primaries);
 
-  event->SetEventID(m_firstEvent + m_currentEventNumber);
+  event->SetEventID(m_firstEvent + evt_number);
   ++m_currentEventNumber;
 
   if ( result != Geant4EventReader::EVENT_READER_OK )   {    // handle I/O error, but how?
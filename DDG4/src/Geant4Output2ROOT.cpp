@@ -19,6 +19,8 @@
 #include <DDG4/Geant4Output2ROOT.h>
 #include <DDG4/Geant4Particle.h>
 #include <DDG4/Geant4Data.h>
+#include <DDG4/Geant4Context.h>
+#include <DDG4/Geant4SensDetAction.h>
 
 // Geant4 include files
 #include <G4HCofThisEvent.hh>
@@ -30,10 +32,43 @@
 #include <TTree.h>
 #include <TBranch.h>
 #include <TSystem.h>
+#include <TROOT.h>
+#include <RVersion.h>
+#if ROOT_VERSION_CODE >= ROOT_VERSION(6,22,0)
+#include <ROOT/TBufferMerger.hxx>
+#define DD4HEP_HAVE_BUFFERMERGER 1
+#endif
 
+// C/C++ include files
+#include <algorithm>
+#include <mutex>
 
 using namespace dd4hep::sim;
 
+#ifdef DD4HEP_HAVE_BUFFERMERGER
+namespace {
+  /// Buffer mergers shared by all writers of the same output file
+  std::mutex s_merger_lock;
+  std::map<std::string, std::weak_ptr<ROOT::TBufferMerger> > s_mergers;
+
+  /// Access the buffer merger of an output file. Created by the first writer
+  std::shared_ptr<ROOT::TBufferMerger> buffer_merger(const std::string& fname, int compression)  {
+    std::lock_guard<std::mutex> lock(s_merger_lock);
+    auto& entry = s_mergers[fname];
+    std::shared_ptr<ROOT::TBufferMerger> merger = entry.lock();
+    if ( !merger )  {
+      ROOT::EnableThreadSafety();
+      if ( compression >= 0 )
+        merger = std::make_shared<ROOT::TBufferMerger>(fname.c_str(), "RECREATE", compression);
+      else
+        merger = std::make_shared<ROOT::TBufferMerger>(fname.c_str(), "RECREATE");
+      entry = merger;
+    }
+    return merger;
+  }
+}
+#endif
+
 /// Standard constructor
 Geant4Output2ROOT::Geant4Output2ROOT(Geant4Context* ctxt, const std::string& nam)
   : Geant4OutputAction(ctxt, nam), m_file(nullptr), m_tree(nullptr) {
@@ -42,6 +77,10 @@ Geant4Output2ROOT::Geant4Output2ROOT(Geant4Context* ctxt, const std::string& nam
   declareProperty("DisabledCollections",  m_disabledCollections);
   declareProperty("DisableParticles",     m_disableParticles);
   declareProperty("FilesByRun",           m_filesByRun = false);
+  declareProperty("Compression",          m_compression);
+  declareProperty("AutoFlush",            m_autoFlush);
+  declareProperty("BasketSize",           m_basketSize);
+  declareProperty("ThreadBuffered",       m_threadBuffered);
   InstanceCount::increment(this);
 }
 
@@ -60,6 +99,18 @@ void Geant4Output2ROOT::closeOutput()   {
     if ( i != m_sections.end() )
       m_sections.erase(i);
     m_branches.clear();
+    m_branchList.clear();
+    m_branchCursor = 0;
+    if ( m_bufferFile )  {
+      // Send the remaining buffer to the merger. The merger writes the output
+      // file once the last writer released it.
+      m_bufferFile->Write();
+      m_tree = nullptr;
+      m_file = nullptr;
+      m_bufferFile.reset();
+      m_merger.reset();
+      return;
+    }
     m_tree->Write();
     m_file->Close();
     m_tree = nullptr;
@@ -73,6 +124,9 @@ TTree* Geant4Output2ROOT::section(const std::string& nam) {
   if (i == m_sections.end()) {
     TDirectory::TContext ctxt(m_file);
     TTree* t = new TTree(nam.c_str(), ("Geant4 " + nam + " information").c_str());
+    // Buffered output is flushed to the merger by commit()
+    if ( m_autoFlush != 0 && !m_threadBuffered )
+      t->SetAutoFlush(m_autoFlush);
     m_sections.emplace(nam, t);
     return t;
   }
@@ -92,6 +146,19 @@ void Geant4Output2ROOT::beginRun(const G4Run* run) {
     if ( idx != std::string::npos )
       fname += m_output.substr(idx);
   }
+  if ( !m_file && !fname.empty() && m_threadBuffered ) {
+#ifdef DD4HEP_HAVE_BUFFERMERGER
+    auto merger = buffer_merger(fname, m_compression);
+    TDirectory::TContext ctxt(TDirectory::CurrentDirectory());
+    m_bufferFile = merger->GetFile();
+    m_merger     = merger;
+    m_file       = m_bufferFile.get();
+    m_tree       = section(m_section);
+    declareBranches();
+#else
+    except("ThreadBuffered output requires ROOT 6.22 or later.");
+#endif
+  }
   if ( !m_file && !fname.empty() ) {
     TDirectory::TContext ctxt(TDirectory::CurrentDirectory());
     if ( !gSystem->AccessPathName(fname.c_str()) )  {
@@ -108,45 +175,75 @@ void Geant4Output2ROOT::beginRun(const G4Run* run) {
       detail::deletePtr (m_file);
       except("Failed to open ROOT output file:'%s'", fname.c_str());
     }
+    if ( m_compression >= 0 )
+      file->SetCompressionSettings(m_compression);
     m_file = file.release();
     m_tree = section(m_section);
   }
   Geant4OutputAction::beginRun(run);
 }
 
+/// Access the branch of a collection. Creates the branch if not yet present
+Geant4Output2ROOT::Branch& Geant4Output2ROOT::branch(const std::string& nam, const ComponentCast& type)  {
+  // Collections arrive in the same order every event: check the expected one first
+  if ( m_branchCursor < m_branchList.size() )  {
+    Branch& b = m_branchList[m_branchCursor];
+    if ( nam == b.branch->GetName() )  {
+      ++m_branchCursor;
+      return b;
+    }
+  }
+  Branches::const_iterator i = m_branches.find(nam);
+  if ( i != m_branches.end() )  {
+    m_branchCursor = i->second + 1;
+    return m_branchList[i->second];
+  }
+  const std::type_info& typ = type.type();
+  TClass* cl = TBuffer::GetClass(typ);
+  if ( !cl )  {
+    throw std::runtime_error("No ROOT TClass object availible for object type:" + typeName(typ));
+  }
+  Branch b;
+  b.branch = m_tree->Branch(nam.c_str(), cl->GetName(), (void*) 0, m_basketSize);
+  b.branch->SetAutoDelete(false);
+  m_branches.emplace(nam, m_branchList.size());
+  m_branchList.emplace_back(b);
+  m_branchCursor = m_branchList.size();
+  return m_branchList.back();
+}
+
+/// Declare the branches of all possible collections before the first event
+void Geant4Output2ROOT::declareBranches()  {
+  if ( !m_disableParticles )  {
+    branch("MCParticles", Geant4HitWrapper::manipulator<Geant4Particle>()->vec_type);
+  }
+  for ( const auto& seq : context()->sensitiveActions().sequences() )  {
+    for ( std::size_t i = 0, n = seq.second->numHitCollections(); i < n; ++i )  {
+      const std::string& nam = seq.second->hitCollectionName(i);
+      if ( std::find(m_disabledCollections.begin(), m_disabledCollections.end(), nam) == m_disabledCollections.end() )
+        branch(nam, seq.second->hitCollectionType(i));
+    }
+  }
+  m_branchCursor = 0;
+  info("+++ Declared %ld branches of the buffered event tree %s", m_branchList.size(), m_section.c_str());
+}
+
 /// Fill single EVENT branch entry (Geant4 collection data)
 int Geant4Output2ROOT::fill(const std::string& nam, const ComponentCast& type, void* ptr) {
   if (m_file) {
-    TBranch* b = 0;
-    Branches::const_iterator i = m_branches.find(nam);
-    if (i == m_branches.end()) {
-      const std::type_info& typ = type.type();
-      TClass* cl = TBuffer::GetClass(typ);
-      if (cl) {
-        b = m_tree->Branch(nam.c_str(), cl->GetName(), (void*) 0);
-        b->SetAutoDelete(false);
-        m_branches.emplace(nam, b);
-      }
-      else {
-        throw std::runtime_error("No ROOT TClass object availible for object type:" + typeName(typ));
-      }
+    Branch& b = branch(nam, type);
+    Long64_t num = m_tree->GetEntries() - b.entries;
+    if ( num > 0 ) {
+      b.branch->SetAddress(0);
+      for ( ; num > 0; --num, ++b.entries )
+        b.branch->Fill();
     }
-    else {
-      b = (*i).second;
-    }
-    Long64_t evt = b->GetEntries(), nevt = b->GetTree()->GetEntries(), num = nevt - evt;
-    if (nevt > evt) {
-      b->SetAddress(0);
-      while (num > 0) {
-        b->Fill();
-        --num;
-      }
-    }
-    b->SetAddress(&ptr);
-    int nbytes = b->Fill();
+    b.branch->SetAddress(&ptr);
+    int nbytes = b.branch->Fill();
     if (nbytes < 0) {
       throw std::runtime_error("Failed to write ROOT collection:" + nam + "!");
     }
+    ++b.entries;
     return nbytes;
   }
   return 0;
@@ -155,23 +252,26 @@ int Geant4Output2ROOT::fill(const std::string& nam, const ComponentCast& type, v
 /// Commit data at end of filling procedure
 void Geant4Output2ROOT::commit(OutputContext<G4Event>& ctxt) {
   if (m_file) {
-    TObjArray* a = m_tree->GetListOfBranches();
     Long64_t evt = m_tree->GetEntries() + 1;
-    Int_t nb = a->GetEntriesFast();
     /// Fill NULL pointers to all branches, which have less entries than the Event branch
-    for (Int_t i = 0; i < nb; ++i) {
-      TBranch* br_ptr = (TBranch*) a->UncheckedAt(i);
-      Long64_t br_evt = br_ptr->GetEntries();
-      if (br_evt < evt) {
-        Long64_t num = evt - br_evt;
-        br_ptr->SetAddress(0);
-        while (num > 0) {
-          br_ptr->Fill();
-          --num;
-        }
+    for ( auto& b : m_branchList )  {
+      if ( b.entries < evt )  {
+        b.branch->SetAddress(0);
+        for ( ; b.entries < evt; ++b.entries )
+          b.branch->Fill();
       }
     }
     m_tree->SetEntries(evt);
+    m_branchCursor = 0;
+    // Buffered output: send the events to the merger every AutoFlush events
+    // (default: 100). Writing resets the tree of the buffer file, the branches
+    // are kept. All branches were declared at begin-of-run: all buffers sent
+    // by all writers have the same branches.
+    if ( m_bufferFile && evt >= (m_autoFlush > 0 ? m_autoFlush : 100) )  {
+      m_bufferFile->Write();
+      for ( auto& b : m_branchList )
+        b.entries = 0;
+    }
   }
   Geant4OutputAction::commit(ctxt);
 }
@@ -23,6 +23,7 @@
 #include <G4ParticleDefinition.hh>
 #include <G4ParticleTable.hh>
 #include <G4VProcess.hh>
+#include <G4Allocator.hh>
 
 #include <TDatabasePDG.h>
 #include <TParticlePDG.h>
@@ -34,6 +35,11 @@
 
 using namespace dd4hep::sim;
 
+namespace {
+  /// Per-thread memory pool of the MC particle records
+  G4ThreadLocal G4Allocator<Geant4Particle>* s_particlePool = nullptr;
+}
+
 /// Default destructor
 ParticleExtension::~ParticleExtension() {
 }
@@ -56,6 +62,28 @@ Geant4Particle::~Geant4Particle()  {
   //::printf("************ Delete Geant4Particle[%p]: ID:%d pdgID %d ref:%d\n",(void*)this,id,pdgID,ref);
 }
 
+/// Particle allocation from the memory pool of the current thread
+void* Geant4Particle::operator new(std::size_t size)   {
+  // Objects of derived classes have a different size
+  if ( size != sizeof(Geant4Particle) )
+    return ::operator new(size);
+  if ( !s_particlePool ) s_particlePool = new G4Allocator<Geant4Particle>;
+  return s_particlePool->MallocSingle();
+}
+
+/// Particle deallocation to the memory pool of the current thread
+void Geant4Particle::operator delete(void* ptr, std::size_t size)   {
+  if ( !ptr )
+    return;
+  else if ( size != sizeof(Geant4Particle) )
+    ::operator delete(ptr);
+  else  {
+    // Particles may be deleted by a thread which did not allocate any (e.g. output)
+    if ( !s_particlePool ) s_particlePool = new G4Allocator<Geant4Particle>;
+    s_particlePool->FreeSingle(static_cast<Geant4Particle*>(ptr));
+  }
+}
+
 void Geant4Particle::release()  {
   //::printf("************ Release Geant4Particle[%p]: ID:%d pdgID %d ref:%d\n",(void*)this,id,pdgID,ref-1);
   if ( --ref <= 0 )  {
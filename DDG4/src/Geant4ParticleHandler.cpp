@@ -112,11 +112,24 @@ bool Geant4ParticleHandler::adopt(Geant4Action* action)    {
 void Geant4ParticleHandler::clear()  {
   detail::releaseObjects(m_particleMap);
   m_particleMap.clear();
+  m_trackIndex.clear();
   // m_suspendedPM should already be empty and cleared...
   assert(m_suspendedPM.empty() && "There was something wrong with the particle record treatment, please open a bug report!");
   m_equivalentTracks.clear();
 }
 
+/// Register a stored MC particle in the map and the dense index
+Geant4ParticleHandler::Particle* Geant4ParticleHandler::storeParticle(int g4_id, Particle* part)  {
+  m_particleMap[g4_id] = part;
+  if ( g4_id >= 0 )  {
+    if ( std::size_t(g4_id) >= m_trackIndex.size() )  {
+      m_trackIndex.resize(std::max(std::size_t(g4_id)+1, 2*m_trackIndex.size()), nullptr);
+    }
+    m_trackIndex[g4_id] = part;
+  }
+  return part;
+}
+
 /// Mark a Geant4 track to be kept for later MC truth analysis
 void Geant4ParticleHandler::mark(const G4Track* track, int reason)   {
   if ( track )   {
@@ -212,13 +225,12 @@ void Geant4ParticleHandler::begin(const G4Track* track)   {
   // if particles are not tracked to the end, we pick up where we stopped previously
   if (m_haveSuspended) {
     //primary particles are already in the particle map, we don't have to store them in another map
-    auto existingParticle = m_particleMap.find(h.id());
-    if(existingParticle != m_particleMap.end()) {
-      m_currTrack.get_data(*(existingParticle->second));
+    if( Particle* existing = trackParticle(h.id()) ) {
+      m_currTrack.get_data(*existing);
       return;
     }
     //other particles might not be in the particleMap yet, so we take them from here
-    existingParticle = m_suspendedPM.find(h.id());
+    auto existingParticle = m_suspendedPM.find(h.id());
     if(existingParticle != m_suspendedPM.end()) {
       m_currTrack.get_data(*(existingParticle->second));
       // make sure we delete a suspended particle in the map, fill it back later...
@@ -234,7 +246,7 @@ void Geant4ParticleHandler::begin(const G4Track* track)   {
       except("+++ Tracking preaction: Primary particle without generator particle!");
     }
     reason |= (G4PARTICLE_PRIMARY|G4PARTICLE_ABOVE_ENERGY_THRESHOLD);
-    m_particleMap[h.id()] = prim_part->addRef();
+    storeParticle(h.id(), prim_part->addRef());
   }
 
   if ( prim_part )   {
@@ -361,14 +373,12 @@ void Geant4ParticleHandler::end(const G4Track* track)   {
     dynamic_cast<Geant4ParticleInformation*>(track->GetUserInformation());
   if ( !mask.isNull() || track_info )   {
     m_equivalentTracks[g4_id] = g4_id;
-    ParticleMap::iterator ip = m_particleMap.find(g4_id);
+    Particle* part = trackParticle(g4_id);
     if ( mask.isSet(G4PARTICLE_PRIMARY) )   {
-      ph.dump2(outputLevel()-1,name(),"Add Primary",h.id(),ip!=m_particleMap.end());
+      ph.dump2(outputLevel()-1,name(),"Add Primary",h.id(),part != nullptr);
     }
     // Create a new MC particle from the current track information saved in the pre-tracking action
-    Particle* part = 0;
-    if ( ip==m_particleMap.end() ) part = m_particleMap[g4_id] = new Particle();
-    else part = (*ip).second;
+    if ( !part ) part = storeParticle(g4_id, new Particle());
     if ( track_info )  {
       mask.set(G4PARTICLE_KEEP_USER);
       part->extension.reset(track_info->release());
@@ -385,13 +395,13 @@ void Geant4ParticleHandler::end(const G4Track* track)   {
     // Need to find the last stored particle and OR this particle's mask
     // with the mask of the last stored particle
     auto iend = m_equivalentTracks.end(), iequiv=m_equivalentTracks.end();
-    ParticleMap::iterator ip;
-    for(ip=m_particleMap.find(pid); ip == m_particleMap.end(); ip=m_particleMap.find(pid))  {
+    Particle* parent_part = nullptr;
+    for(parent_part=trackParticle(pid); !parent_part; parent_part=trackParticle(pid))  {
       if (iequiv=m_equivalentTracks.find(pid); iequiv == iend) break;  // ERROR
       pid = (*iequiv).second;
     }
-    if ( ip != m_particleMap.end() )
-      (*ip).second->reason |= track_reason;
+    if ( parent_part )
+      parent_part->reason |= track_reason;
     else
       ph.dumpWithVertex(outputLevel()+3,name(),"FATAL: No real particle parent present");
   }
@@ -399,7 +409,7 @@ void Geant4ParticleHandler::end(const G4Track* track)   {
   if(track->GetTrackStatus() == fSuspend) {
     m_haveSuspended = true;
     //track is already in particle map, we pick it up from there in begin again
-    if(m_particleMap.find(g4_id) != m_particleMap.end()) return;
+    if( trackParticle(g4_id) ) return;
     //track is not already stored, keep it in special map
     auto iPart = m_suspendedPM.emplace(g4_id, new Particle());
     (iPart.first->second)->get_data(m_currTrack);
@@ -416,6 +426,8 @@ void Geant4ParticleHandler::beginEvent(const G4Event* event)  {
   m_globalParticleID = interaction->nextPID();
   m_particleMap.clear();
   m_equivalentTracks.clear();
+  // Size the dense track index from the previous event to avoid reallocations
+  m_trackIndex.assign(m_trackIndexSize, nullptr);
   /// Call the user particle handler
   if ( m_userHandler )  {
     m_userHandler->begin(event);
@@ -441,6 +453,7 @@ void Geant4ParticleHandler::endEvent(const G4Event* event)  {
   } while( recombineParents() > 0 );
 
   if ( level <= VERBOSE ) dumpMap(  "Recombined");
+  m_trackIndexSize = std::max(m_trackIndexSize, m_trackIndex.size());
   // Rebase the simulated tracks, so that they fit to the generator particles
   rebaseSimulatedTracks(0);
   if ( level <= VERBOSE ) dumpMap(  "Rebased   ");
@@ -495,16 +508,17 @@ void Geant4ParticleHandler::rebaseSimulatedTracks(int )   {
   // (2) Re-evaluate the corresponding geant4 track equivalents using the new mapping
   for(TrackEquivalents::iterator ie=m_equivalentTracks.begin(),ie_end=m_equivalentTracks.end(); ie!=ie_end; ++ie)  {
     int g4_equiv = (*ie).first;
-    while( (ipar=m_particleMap.find(g4_equiv)) == m_particleMap.end() )  {
+    Particle* equiv_part = nullptr;
+    while( !(equiv_part=trackParticle(g4_equiv)) )  {
       TrackEquivalents::const_iterator iequiv = m_equivalentTracks.find(g4_equiv);
       if ( iequiv == ie_end )  {
-        break;  // ERROR !! Will be handled by printout below because ipar==end()
+        break;  // ERROR !! Will be handled by printout below because equiv_part==nullptr
       }
       g4_equiv = (*iequiv).second;
     }
     TrackEquivalents::mapped_type equiv = (*ie).second;
-    if ( ipar != m_particleMap.end() )   {
-      Geant4ParticleHandle p = (*ipar).second;
+    if ( equiv_part )   {
+      Geant4ParticleHandle p = equiv_part;
       equivalents[(*ie).first] = p->id;  // requires (1) to be filled properly!
       const G4ParticleDefinition* def = p.definition();
       int pdg = int(std::abs(def->GetPDGEncoding())+0.1);
@@ -585,6 +599,8 @@ void Geant4ParticleHandler::rebaseSimulatedTracks(int )   {
 #endif
   m_equivalentTracks = std::move(equivalents);
   m_particleMap = std::move(finalParticles);
+  // The map is now keyed by the particle identifiers: the track index is no longer valid
+  m_trackIndex.clear();
 }
 
 /// Default callback to be answered if the particle should be kept if NO user handler is installed
@@ -653,8 +669,7 @@ int Geant4ParticleHandler::recombineParents()  {
       //continue;
     }
     else if ( mask.isSet(G4PARTICLE_KEEP_PROCESS) )  {
-      if(ParticleMap::iterator ip = m_particleMap.find(p->g4Parent); ip != m_particleMap.end() )   {
-        Particle* parent_part = (*ip).second;
+      if( Particle* parent_part = trackParticle(p->g4Parent) )   {
         PropertyMask parent_mask(parent_part->reason);
         if ( parent_mask.isSet(G4PARTICLE_ABOVE_ENERGY_THRESHOLD) )   {
           parent_mask.set(G4PARTICLE_KEEP_PARENT);
@@ -670,8 +685,7 @@ int Geant4ParticleHandler::recombineParents()  {
       int g4_id = (*i).first;
       remove.insert(g4_id);
       m_equivalentTracks[g4_id] = p->g4Parent;
-      if(ParticleMap::iterator ip = m_particleMap.find(p->g4Parent); ip != m_particleMap.end() )   {
-        Particle* parent_part = (*ip).second;
+      if( Particle* parent_part = trackParticle(p->g4Parent) )   {
         PropertyMask(parent_part->reason).set(mask.value());
         parent_part->steps += p->steps;
         parent_part->secondaries += p->secondaries;
@@ -686,6 +700,7 @@ int Geant4ParticleHandler::recombineParents()  {
     if( auto ir = m_particleMap.find(r); ir != m_particleMap.end() )  {
       (*ir).second->release();
       m_particleMap.erase(ir);
+      if ( std::size_t(r) < m_trackIndex.size() ) m_trackIndex[r] = nullptr;
     }
   }
   return int(remove.size());
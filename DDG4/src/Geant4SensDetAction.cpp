@@ -30,6 +30,7 @@
 
 // C/C++ include files
 #include <stdexcept>
+#include <memory>
 
 #include "G4OpticalParameters.hh"
 #include "G4OpticalPhoton.hh"
@@ -405,6 +406,18 @@ const std::string& Geant4SensDetActionSequence::hitCollectionName(std::size_t wh
   return blank;
 }
 
+/// Access the type of the hit vector of a collection (e.g. to declare output branches)
+const dd4hep::ComponentCast& Geant4SensDetActionSequence::hitCollectionType(std::size_t which) const {
+  if (which < m_collections.size()) {
+    const HitCollection& cr = m_collections[which];
+    // The type information is static: the temporary collection is not needed
+    std::unique_ptr<Geant4HitCollection> col((*cr.second.second)(name(), cr.first, cr.second.first));
+    return col->vector_type();
+  }
+  except("The collection name index for subdetector %s is out of range!", c_name());
+  throw std::runtime_error("Geant4SensDetActionSequence: invalid collection index");
+}
+
 /// Retrieve the hits collection associated with this detector by its serial number
 Geant4HitCollection* Geant4SensDetActionSequence::collection(std::size_t which) const {
   if (which < m_collections.size()) {
@@ -472,6 +485,8 @@ void Geant4SensDetActionSequence::begin(G4HCofThisEvent* hce) {
   for (std::size_t count = 0; count < m_collections.size(); ++count) {
     const HitCollection& cr = m_collections[count];
     Geant4HitCollection* col = (*cr.second.second)(name(), cr.first, cr.second.first);
+    if ( count < m_collectionSizes.size() )
+      col->reserve(m_collectionSizes[count]);
     int id = m_detector->GetCollectionID(count);
     m_hce->AddHitsCollection(id, col);
   }
@@ -483,6 +498,11 @@ void Geant4SensDetActionSequence::begin(G4HCofThisEvent* hce) {
 void Geant4SensDetActionSequence::end(G4HCofThisEvent* hce) {
   m_end(hce);
   m_actors(&Geant4Sensitive::end, hce);
+  m_collectionSizes.resize(m_collections.size(), 0);
+  for (std::size_t count = 0; count < m_collections.size(); ++count) {
+    G4VHitsCollection* col = hce ? hce->GetHC(m_detector->GetCollectionID(count)) : nullptr;
+    m_collectionSizes[count] = col ? col->GetSize() : 0;
+  }
   // G4HCofThisEvent must be availible until end-event. m_hce = 0;
 }
 
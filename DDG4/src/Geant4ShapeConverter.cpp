@@ -251,8 +251,14 @@ namespace dd4hep {
     }
 
     template <> G4VSolid* convertShape<TGeoTessellated>(const TGeoShape* shape)  {
-      TGeoTessellated*   sh  = (TGeoTessellated*) shape;
-      G4TessellatedSolid* g4 = new G4TessellatedSolid(sh->GetName());
+      G4TessellatedSolid* g4 = new G4TessellatedSolid(shape->GetName());
+      fillTessellatedSolid(shape, g4);
+      return g4;
+    }
+
+    /// Add the facets of a TGeoTessellated shape to an empty geant4 tessellated solid and close it
+    void fillTessellatedSolid(const TGeoShape* shape, G4TessellatedSolid* g4)  {
+      TGeoTessellated* sh = (TGeoTessellated*) shape;
       int num_facet = sh->GetNfacets();
 
       printout(DEBUG,"TessellatedSolid","+++ %s> Converting %d facets", sh->GetName(), num_facet);
@@ -294,7 +300,6 @@ namespace dd4hep {
         g4->AddFacet(g4f);
       }
       g4->SetSolidClosed(sh->IsClosedBody());
-      return g4;
     }
     
   }    // End namespace sim
@@ -20,6 +20,7 @@
 // Forward declarations
 class TGeoShape;
 class G4VSolid;
+class G4TessellatedSolid;
 
 /// Namespace for the AIDA detector description toolkit
 namespace dd4hep {
@@ -30,6 +31,10 @@ namespace dd4hep {
     /// Convert a specific TGeo shape into the geant4 equivalent
     template <typename T> G4VSolid* convertShape(const TGeoShape* shape);
 
+    /// Add the facets of a TGeoTessellated shape to an empty geant4 tessellated solid and close it
+    /** Only the solid itself is modified: several solids may be filled concurrently. */
+    void fillTessellatedSolid(const TGeoShape* shape, G4TessellatedSolid* solid);
+
   }    // End namespace sim
 }      // End namespace dd4hep
 #endif // DDG4_SRC_GEANT4SHAPECONVERTER_H
@@ -0,0 +1,139 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/InstanceCount.h>
+#include <DDG4/Geant4StepBatch.h>
+#include <DDG4/Geant4Mapping.h>
+#include <DDG4/Geant4StepHandler.h>
+#include <DDG4/Geant4SensDetAction.h>
+
+// Geant4 include files
+#include <G4Step.hh>
+#include <G4OpticalParameters.hh>
+#include <G4OpticalPhoton.hh>
+
+#ifdef DD4HEP_USE_GEANT4_UNITS
+#define MM_2_CM 1.0
+#else
+#define MM_2_CM 0.1
+#endif
+
+using namespace dd4hep::sim;
+
+/// Initializing constructor
+Geant4StepBatch::Geant4StepBatch(std::size_t capacity)
+  : m_capacity(capacity > 0 ? capacity : 1)
+{
+  m_records.reserve(m_capacity);
+  m_local.reserve(m_capacity);
+  m_global.reserve(m_capacity);
+  m_volumeIDs.reserve(m_capacity);
+  InstanceCount::increment(this);
+}
+
+/// Default destructor
+Geant4StepBatch::~Geant4StepBatch()   {
+  InstanceCount::decrement(this);
+}
+
+/// Add a step record. Position and volume are taken as in Geant4Sensitive::cellID(step)
+void Geant4StepBatch::add(const G4Step* step, const Contribution& contrib)   {
+  Geant4StepHandler h(step);
+  bool post_only = G4OpticalParameters::Instance() && G4OpticalParameters::Instance()->GetBoundaryInvokeSD() &&
+    (step->GetTrack()->GetDefinition() == G4OpticalPhoton::Definition());
+  const G4VTouchable* touchable = post_only ? h.postTouchable() : h.preTouchable();
+  G4ThreeVector global = post_only ? h.postPosG4() : 0.5 * (h.prePosG4()+h.postPosG4());
+  G4ThreeVector local  = touchable->GetHistory()->GetTopTransform().TransformPoint(global);
+
+  if ( !m_volumeManager.isValid() )  {
+    m_volumeManager = Geant4Mapping::instance().volumeManager();
+  }
+  VolumeID volID = m_volumeManager.volumeID(touchable);
+
+  // The hit position is computed with the pre-step touchable (Geant4HitHandler::localToGlobal).
+  // Volume identifiers need not be unique per placement: the transformations
+  // are identified by the touchable history (physical volumes and copy numbers).
+  const G4VTouchable* pre = h.preTouchable();
+  m_key.clear();
+  for( int i = 0, depth = pre->GetHistoryDepth(); i <= depth; ++i )  {
+    const G4VPhysicalVolume* pv = pre->GetVolume(i);
+    int copy = pre->GetReplicaNumber(i);
+    m_key.append((const char*)&pv, sizeof(pv));
+    m_key.append((const char*)&copy, sizeof(copy));
+  }
+  if ( m_key != m_lastKey || m_lastIndex == ~0U )  {
+    auto ret = m_transformIndex.emplace(m_key, (unsigned int)m_transforms.size());
+    if ( ret.second ) m_transforms.emplace_back(pre->GetHistory()->GetTopTransform().Inverse());
+    m_lastKey.swap(m_key);
+    m_lastIndex = ret.first->second;
+  }
+  m_records.emplace_back(Record{contrib, m_lastIndex});
+  m_local.emplace_back(local.x()*MM_2_CM, local.y()*MM_2_CM, local.z()*MM_2_CM);
+  m_global.emplace_back(global.x()*MM_2_CM, global.y()*MM_2_CM, global.z()*MM_2_CM);
+  m_volumeIDs.emplace_back(volID);
+  ++numSteps;
+}
+
+/// Compute the cell identifiers of all buffered records in one batch
+void Geant4StepBatch::resolve(const Geant4Sensitive& sensitive, const Segmentation& segmentation)   {
+  std::size_t num_records = m_records.size();
+  m_valid.assign(num_records, 1);
+  if ( !segmentation.isValid() )  {
+    m_cellIDs.assign(m_volumeIDs.begin(), m_volumeIDs.end());
+    ++numBatches;
+    return;
+  }
+  m_cellIDs.resize(num_records);
+  try  {
+    segmentation.cellIDs(num_records, m_local.data(), m_global.data(), m_volumeIDs.data(), m_cellIDs.data());
+  }
+  catch(const std::exception&)   {
+    // At least one position is outside the segmentation: resolve cell by cell
+    // to report the failing steps. They are dropped as in the step-wise processing.
+    for( std::size_t i = 0; i < num_records; ++i )  {
+      const Position& loc  = m_local[i];
+      const Position& glob = m_global[i];
+      try  {
+        m_cellIDs[i] = segmentation.cellID(loc, glob, m_volumeIDs[i]);
+      }
+      catch(const std::exception& e)   {
+        m_valid[i] = 0;
+        sensitive.error("cellID: failed to access segmentation for VolumeID: %016lX [%ld]  [%s]",
+                        m_volumeIDs[i], m_volumeIDs[i], e.what());
+        sensitive.error("....... TGeo-local: (%f, %f, %f) TGeo-global: (%f, %f, %f)",
+                        loc.x(), loc.y(), loc.z(), glob.x(), glob.y(), glob.z());
+      }
+    }
+  }
+  ++numBatches;
+}
+
+/// Remove the records of the processed batch. The transformations are kept
+void Geant4StepBatch::release()   {
+  m_records.clear();
+  m_local.clear();
+  m_global.clear();
+  m_volumeIDs.clear();
+  m_cellIDs.clear();
+  m_valid.clear();
+}
+
+/// Remove all records and transformations (new event)
+void Geant4StepBatch::clear()   {
+  release();
+  m_transforms.clear();
+  m_transformIndex.clear();
+  m_lastKey.clear();
+  m_lastIndex  = ~0U;
+}
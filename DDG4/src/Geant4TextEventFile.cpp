@@ -0,0 +1,307 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+// Framework include files
+#include <DD4hep/Printout.h>
+#include <DD4hep/Primitives.h>
+#include <DDG4/Geant4TextEventFile.h>
+
+// C/C++ include files
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <map>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+using namespace dd4hep::sim;
+
+namespace  {
+
+  /// Header of the sidecar index file
+  struct index_header_t  {
+    /// File identifier: "DD4EIDX"
+    char               magic[8];
+    /// File format version
+    unsigned int       version;
+    /// Reserved
+    unsigned int       flags;
+    /// Format tag of the reader which created the index
+    char               tag[64];
+    /// Size of the data file
+    unsigned long long file_size;
+    /// Modification time of the data file [nsec]
+    long long          modified;
+    /// Number of offsets following the header
+    unsigned long long num_offsets;
+  };
+  const char         s_index_magic[8] = "DD4EIDX";
+  const unsigned int s_index_version  = 1;
+
+  /// Registry of shared event files
+  std::mutex s_registry_lock;
+  std::map<std::string, std::weak_ptr<Geant4TextEventFile> > s_registry;
+
+  inline bool is_space(char c)   {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\f' || c == '\v';
+  }
+}
+
+/// Skip whitespace. Returns false at the end of the buffer
+bool Geant4TextEventFile::Cursor::skip_space()   {
+  while( ptr < end && is_space(*ptr) ) ++ptr;
+  return ptr < end;
+}
+
+/// Skip the current token
+bool Geant4TextEventFile::Cursor::skip_token()   {
+  if ( !skip_space() ) return false;
+  while( ptr < end && !is_space(*ptr) ) ++ptr;
+  return true;
+}
+
+/// Skip the rest of the current line including the line feed
+void Geant4TextEventFile::Cursor::skip_line()   {
+  const void* p = ::memchr(ptr, '\n', end-ptr);
+  ptr = p ? static_cast<const char*>(p) + 1 : end;
+}
+
+/// Access the rest of the current line and move to the next line
+std::string_view Geant4TextEventFile::Cursor::line()   {
+  const char* start = ptr;
+  skip_line();
+  const char* stop = ptr;
+  while( stop > start && (stop[-1] == '\n' || stop[-1] == '\r') ) --stop;
+  return std::string_view(start, stop-start);
+}
+
+/// Read the next token as integer number
+bool Geant4TextEventFile::Cursor::next(int& value)   {
+  if ( !skip_space() ) return false;
+  if ( *ptr == '+' ) ++ptr;
+  auto res = std::from_chars(ptr, end, value);
+  if ( res.ec != std::errc() ) return false;
+  ptr = res.ptr;
+  return ptr == end || is_space(*ptr);
+}
+
+/// Read the next token as unsigned integer number
+bool Geant4TextEventFile::Cursor::next(unsigned int& value)   {
+  if ( !skip_space() ) return false;
+  if ( *ptr == '+' ) ++ptr;
+  auto res = std::from_chars(ptr, end, value);
+  if ( res.ec != std::errc() ) return false;
+  ptr = res.ptr;
+  return ptr == end || is_space(*ptr);
+}
+
+/// Read the next token as floating point number
+bool Geant4TextEventFile::Cursor::next(double& value)   {
+  if ( !skip_space() ) return false;
+  if ( *ptr == '+' ) ++ptr;
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+  auto res = std::from_chars(ptr, end, value);
+  if ( res.ec != std::errc() ) return false;
+  ptr = res.ptr;
+#else
+  // No floating point support of from_chars: strtod on a terminated copy of the token.
+  // The mapped buffer is not terminated and must not be overrun.
+  char buff[64], *stop = nullptr;
+  std::size_t len = 0;
+  while( ptr+len < end && len < sizeof(buff)-1 && !is_space(ptr[len]) )  {
+    buff[len] = ptr[len];
+    ++len;
+  }
+  buff[len] = 0;
+  value = ::strtod(buff, &stop);
+  if ( stop == buff ) return false;
+  ptr += stop - buff;
+#endif
+  return ptr == end || is_space(*ptr);
+}
+
+/// Initializing constructor. Maps the file into memory
+Geant4TextEventFile::Geant4TextEventFile(const std::string& file_name, const std::string& tag,
+                                         scanner_t scanner, const std::string& index_file)
+  : m_name(file_name), m_indexFile(index_file), m_tag(tag), m_scanner(std::move(scanner))
+{
+  long long size = 0;
+  int fd = ::open(m_name.c_str(), O_RDONLY);
+  if ( fd < 0 )   {
+    except("Geant4TextEventFile","+++ Failed to open input file: %s Error:%s",
+           m_name.c_str(), ::strerror(errno));
+  }
+  if ( !dd4hep::detail::file_status(fd, size, m_modified) )   {
+    int err = errno;
+    ::close(fd);
+    except("Geant4TextEventFile","+++ Failed to access input file: %s Error:%s",
+           m_name.c_str(), ::strerror(err));
+  }
+  m_size = std::size_t(size);
+  if ( m_size > 0 )   {
+    void* ptr = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if ( ptr == MAP_FAILED )   {
+      int err = errno;
+      ::close(fd);
+      except("Geant4TextEventFile","+++ Failed to map input file: %s Error:%s",
+             m_name.c_str(), ::strerror(err));
+    }
+    m_data = static_cast<const char*>(ptr);
+  }
+  ::close(fd);
+  if ( !m_indexFile.empty() && load_index() )   {
+    printout(INFO,"Geant4TextEventFile","+++ Using event index %s: %ld events in %s",
+             m_indexFile.c_str(), long(m_offsets.size()-1), m_name.c_str());
+  }
+}
+
+/// Default destructor. Unmaps the file
+Geant4TextEventFile::~Geant4TextEventFile()   {
+  if ( m_data )   {
+    ::munmap(const_cast<char*>(m_data), m_size);
+  }
+}
+
+/// Access the shared instance for a given file and format
+std::shared_ptr<Geant4TextEventFile>
+Geant4TextEventFile::open(const std::string& file_name, const std::string& tag,
+                          scanner_t scanner, const std::string& index_file)
+{
+  std::lock_guard<std::mutex> lock(s_registry_lock);
+  std::string key = file_name + "|" + tag;
+  auto file = s_registry[key].lock();
+  if ( !file )   {
+    file = std::make_shared<Geant4TextEventFile>(file_name, tag, std::move(scanner), index_file);
+    s_registry[key] = file;
+  }
+  return file;
+}
+
+/// Sidecar index file from the reader option
+std::string Geant4TextEventFile::indexFileName(const std::string& option, const std::string& file_name)  {
+  if ( option == "auto" )
+    return file_name + ".evtidx";
+  return option;
+}
+
+/// Load the index from the sidecar file
+bool Geant4TextEventFile::load_index()   {
+  index_header_t hdr;
+  std::ifstream in(m_indexFile, std::ios::in|std::ios::binary);
+  if ( !in.good() || !in.read((char*)&hdr, sizeof(hdr)) )
+    return false;
+  hdr.tag[sizeof(hdr.tag)-1] = 0;
+  if ( ::strncmp(hdr.magic, s_index_magic, sizeof(hdr.magic)) != 0 ||
+       hdr.version   != s_index_version ||
+       hdr.file_size != m_size          ||
+       hdr.modified  != m_modified      ||
+       hdr.num_offsets == 0             ||
+       m_tag != hdr.tag )   {
+    printout(INFO,"Geant4TextEventFile","+++ Event index %s does not match %s. Rebuild it.",
+             m_indexFile.c_str(), m_name.c_str());
+    return false;
+  }
+  std::vector<unsigned long long> offsets(hdr.num_offsets);
+  if ( !in.read((char*)offsets.data(), offsets.size()*sizeof(unsigned long long)) )
+    return false;
+  for( std::size_t i = 1; i < offsets.size(); ++i )  {
+    if ( offsets[i] < offsets[i-1] ) return false;
+  }
+  if ( offsets.back() != m_size )
+    return false;
+  m_offsets.assign(offsets.begin(), offsets.end());
+  m_complete = true;
+  return true;
+}
+
+/// Save the complete index to the sidecar file
+void Geant4TextEventFile::save_index()  const   {
+  if ( m_indexFile.empty() )
+    return;
+  index_header_t hdr;
+  ::memset(&hdr, 0, sizeof(hdr));
+  ::memcpy(hdr.magic, s_index_magic, sizeof(hdr.magic));
+  ::strncpy(hdr.tag, m_tag.c_str(), sizeof(hdr.tag)-1);
+  hdr.version     = s_index_version;
+  hdr.file_size   = m_size;
+  hdr.modified    = m_modified;
+  hdr.num_offsets = m_offsets.size();
+  std::vector<unsigned long long> offsets(m_offsets.begin(), m_offsets.end());
+  // Write to a temporary file first: concurrent jobs must never see a partial index
+  std::string tmp = m_indexFile + "." + std::to_string(::getpid());
+  {
+    std::ofstream out(tmp, std::ios::out|std::ios::binary|std::ios::trunc);
+    out.write((const char*)&hdr, sizeof(hdr));
+    out.write((const char*)offsets.data(), offsets.size()*sizeof(unsigned long long));
+    if ( !out.good() )   {
+      out.close();
+      std::remove(tmp.c_str());
+      printout(DEBUG,"Geant4TextEventFile","+++ Cannot write event index %s", m_indexFile.c_str());
+      return;
+    }
+  }
+  if ( std::rename(tmp.c_str(), m_indexFile.c_str()) != 0 )   {
+    std::remove(tmp.c_str());
+    printout(DEBUG,"Geant4TextEventFile","+++ Cannot write event index %s", m_indexFile.c_str());
+    return;
+  }
+  printout(INFO,"Geant4TextEventFile","+++ Saved event index %s: %ld events in %s",
+           m_indexFile.c_str(), long(m_offsets.size()-1), m_name.c_str());
+}
+
+/// Extend the index up to the requested number of offsets
+void Geant4TextEventFile::extend(std::size_t num_offsets)   {
+  std::string_view data(m_data, m_size);
+  while( !m_complete && m_offsets.size() < num_offsets )   {
+    std::size_t pos = m_scanner(data, m_offsets.empty() ? std::string_view::npos : m_offsets.back());
+    // Stop at the end of the file or if the scanner does not advance (malformed input)
+    if ( pos >= m_size || (!m_offsets.empty() && pos <= m_offsets.back()) )  {
+      m_offsets.emplace_back(m_size);
+      m_complete = true;
+      save_index();
+      break;
+    }
+    m_offsets.emplace_back(pos);
+  }
+}
+
+/// Access the data of the event with the given sequence number
+bool Geant4TextEventFile::event(std::size_t event_number, std::string_view& data)   {
+  std::lock_guard<std::mutex> lock(m_lock);
+  extend(event_number+2);
+  if ( event_number+1 >= m_offsets.size() )
+    return false;
+  std::size_t start = m_offsets[event_number];
+  data = std::string_view(m_data+start, m_offsets[event_number+1]-start);
+  return true;
+}
+
+/// Data of the file before the first event (file header)
+std::string_view Geant4TextEventFile::prologue()   {
+  std::lock_guard<std::mutex> lock(m_lock);
+  extend(1);
+  return std::string_view(m_data, m_offsets.empty() ? 0 : m_offsets[0]);
+}
+
+/// Total number of events in the file. Requires to scan the entire file
+std::size_t Geant4TextEventFile::numEvents()   {
+  std::lock_guard<std::mutex> lock(m_lock);
+  extend(std::numeric_limits<std::size_t>::max());
+  return m_offsets.empty() ? 0 : m_offsets.size()-1;
+}
@@ -23,11 +23,13 @@
 #include <DDG4/Geant4Mapping.h>
 
 // Geant4 include files
+#include <G4Types.hh>
 #include <G4VTouchable.hh>
 #include <G4LogicalVolume.hh>
 #include <G4VPhysicalVolume.hh>
 
 // C/C++ include files
+#include <atomic>
 #include <sstream>
 
 //#define VOLMGR_HAVE_DEBUG_INFO  1
@@ -55,6 +57,9 @@ using VolIDDescriptor = std::pair<VolumeID,std::vector<std::pair<const BitFieldE
 
 namespace  {
 
+  /// Epoch of the per-thread touchable caches. Incremented whenever a volume manager is populated
+  std::atomic<unsigned int> s_touchableCacheEpoch { 1 };
+
   /// Helper class to populate the Geant4 volume manager
   /**
    *  \author  M.Frank
@@ -71,6 +76,8 @@ namespace  {
     const Detector&     m_detDesc;
     /// Set of already added entries
     Registries          m_entries;
+    /// Geant4 paths of parametrised/replicated entries to compute the level encoders
+    std::map<uint64_t, Geant4TouchableHandler::Geant4PlacementPath> m_flaggedPaths;
     /// Reference to Geant4 translation information
     Geant4GeometryInfo& m_geo;
 
@@ -136,7 +143,28 @@ namespace  {
         if( pv.second->IsReplicated() )
           m_geo.g4Replicated[pv.second] = pv.first;
       }
+      /// Precompute the field encoders of all parametrised/replicated levels
+      for( const auto& p : m_flaggedPaths )  {
+        auto& entry = m_geo.g4Paths[p.first];
+        const auto& path = p.second;
+        entry.encoders.clear();
+        for( std::size_t j=0; j < path.size(); ++j )  {
+          const auto* phys = path[j];
+          const BitFieldElement* field = nullptr;
+          if( phys->IsParameterised() || phys->IsReplicated() )  {
+            const auto& m  = phys->IsParameterised() ? m_geo.g4Parameterised : m_geo.g4Replicated;
+            const auto  it = m.find(phys);
+            if( it != m.end() )  {
+              field = (*it).second.data()->params->field;
+            }
+            /// Missing fields are reported when the volume ID is requested
+            entry.encoders.emplace_back(int(j), field);
+          }
+        }
+      }
+      m_flaggedPaths.clear();
       m_entries.clear();
+      ++s_touchableCacheEpoch;
     }
 
     /// Scan a single physical volume and look for sensitive elements below
@@ -252,6 +280,9 @@ namespace  {
             opt.flags.replicated   = path.front()->IsReplicated()    ? 1 : 0;
             m_geo.g4Paths[hash]    = { code, opt.value };
             m_entries.emplace(code);
+            if( opt.value != 0 )  {
+              m_flaggedPaths.emplace(hash, path);
+            }
             return;
           }
           /// This is a normal case for parametrized volumes and no error
@@ -321,6 +352,32 @@ bool Geant4VolumeManager::checkValidity() const  {
 }
 
 namespace  {
+
+  /// Maximal touchable depth resolved without heap allocation
+  constexpr int MAX_STACK_PATH_DEPTH = 128;
+  /// Number of slots in the per-thread touchable cache (power of 2)
+  constexpr std::size_t TOUCHABLE_CACHE_SIZE = 256;
+
+  /// Slot of the per-thread cache mapping Geant4 placement paths to volume manager entries
+  /**
+   *  The key is the (depth, path hash) pair also used by Geant4GeometryInfo::g4Paths.
+   *  Copy numbers of parametrised/replicated levels are applied after the lookup using
+   *  the precomputed level encoders, hence they need not be part of the key.
+   *
+   *  \author  M.Frank
+   *  \version 1.0
+   *  \ingroup DD4HEP_SIMULATION
+   */
+  struct TouchableCacheSlot  {
+    unsigned int                         epoch;
+    const Geant4GeometryInfo*            info;
+    uint64_t                             hash;
+    int                                  depth;
+    const Geant4GeometryInfo::Placement* placement;
+  };
+  /// Per-thread touchable cache. POD array: fine for G4ThreadLocal in all configurations
+  G4ThreadLocal TouchableCacheSlot s_touchableCache[TOUCHABLE_CACHE_SIZE];
+
   std::string debug_status(const Geant4VolumeManager* mgr)  {
     char text[256];
     auto* p = mgr->ptr();
@@ -335,80 +392,75 @@ namespace  {
 
 /// Access CELLID by Geant4 touchable object
 VolumeID Geant4VolumeManager::volumeID(const G4VTouchable* touchable) const  {
-  Geant4TouchableHandler handler(touchable);
-  std::vector<const G4VPhysicalVolume*> path = handler.placementPath();
   if( !isValid() )  {
     printout(INFO, "Geant4VolumeManager", "+++   INVALID Geant4VolumeManager handle.");
     return NonExisting;
   }
-  else if( !ptr()->valid )  {
+  const Geant4GeometryInfo* info = ptr();
+  if( !info->valid )  {
     printout(INFO, "Geant4VolumeManager", "+++   INVALID Geant4VolumeManager [Not initialized]");
     return NonExisting;
   }
-  else if( path.empty() )  {
+  int depth = touchable ? touchable->GetHistoryDepth() : 0;
+  if( depth <= 0 )  {
     printout(INFO, "Geant4VolumeManager", "+++   EMPTY volume Geant4 Path: %s",
-	     Geant4TouchableHandler::placementPath(path).c_str());
+	     Geant4TouchableHandler::placementPath(placementPath(touchable, false)).c_str());
     return NonExisting;
   }
+  /// Collect the placement path on the stack: no heap allocation for all sane geometries
+  const G4VPhysicalVolume*               stack_path[MAX_STACK_PATH_DEPTH];
+  std::vector<const G4VPhysicalVolume*>  heap_path;
+  const G4VPhysicalVolume**              path = stack_path;
+  if( depth > MAX_STACK_PATH_DEPTH )  {
+    heap_path.resize(depth);
+    path = &heap_path[0];
+  }
+  for( int j=0; j < depth; ++j )
+    path[j] = touchable->GetVolume(j);
+
+  uint64_t hash = detail::hash64(path, sizeof(path[0])*depth);
+  auto&    slot = s_touchableCache[(hash ^ uint64_t(depth)) & (TOUCHABLE_CACHE_SIZE-1)];
+  const Geant4GeometryInfo::Placement* placement = nullptr;
+  unsigned int epoch = s_touchableCacheEpoch.load(std::memory_order_relaxed);
+  if( slot.epoch == epoch && slot.info == info && slot.hash == hash && slot.depth == depth )  {
+    placement = slot.placement;
+  }
   else  {
-    uint64_t hash = detail::hash64(&path[0], sizeof(path[0])*path.size());
-    auto i = ptr()->g4Paths.find(hash);
-    if( i != ptr()->g4Paths.end() )  {
-      const auto& e = (*i).second;
-      VolumeID volid = e.volumeID;
-      /// No parametrization or replication.
-      if( e.flags == 0 )  {
-        return volid;
-      }
-      const auto& paramterised = ptr()->g4Parameterised;
-      const auto& replicated   = ptr()->g4Replicated;
-      /// This is incredibly slow .... but what can I do ? Need a better idea.
-      for( std::size_t j=0; j < path.size(); ++j )  {
-        const auto* phys = path[j];
-        if( phys->IsParameterised() )  {
-          int copy_no = touchable->GetCopyNumber(j);
-          const auto it = paramterised.find(phys);
-          if( it != paramterised.end() )  {
-            //printout(INFO,"Geant4VolumeManager",
-            //         "Copy number:   %ld  <--> %ld", copy_no, long(phys->GetCopyNo()));
-            const auto* field = (*it).second.data()->params->field;
-            volid |= IDDescriptor::encode(field, copy_no);
-            continue;
-          }
-          except("Geant4VolumeManager",
-                 "Error  Geant4VolumeManager::volumeID(const G4VTouchable* touchable)");
-        }
-        else if( phys->IsReplicated() )   {
-          int copy_no = touchable->GetCopyNumber(j);
-          const auto it = replicated.find(phys);
-          if( it != replicated.end() )  {
-            const auto* field = (*it).second.data()->params->field;
-            volid |= IDDescriptor::encode(field, copy_no);
-            continue;
-          }
-          except("Geant4VolumeManager",
-                 "Error  Geant4VolumeManager::volumeID(const G4VTouchable* touchable)");
-        }
-      }
-      return volid;
+    auto i = info->g4Paths.find(hash);
+    if( i != info->g4Paths.end() )  {
+      placement = &(*i).second;
+      slot = { epoch, info, hash, depth, placement };
     }
-    if( !path[0] )  {
-      printout(INFO, "Geant4VolumeManager", "+++   Bad Geant4 volume path: \'%s\' [invalid path] %s",
-	       Geant4TouchableHandler::placementPath(path).c_str(), debug_status(this).c_str());
-      return InvalidPath;
+  }
+  if( placement )  {
+    VolumeID volid = placement->volumeID;
+    /// No parametrization or replication.
+    if( placement->flags == 0 )  {
+      return volid;
     }
-    else if( !path[0]->GetLogicalVolume()->GetSensitiveDetector() )  {
-      printout(INFO, "Geant4VolumeManager", "+++   Bad Geant4 volume path: \'%s\' [insensitive] %s",
-	       Geant4TouchableHandler::placementPath(path).c_str(), debug_status(this).c_str());
-      return Insensitive;
+    /// Only the parametrised/replicated levels contribute: O(depth) without lookups
+    for( const auto& enc : placement->encoders )  {
+      if( nullptr == enc.second )  {
+        except("Geant4VolumeManager",
+               "Error  Geant4VolumeManager::volumeID(const G4VTouchable* touchable)");
+      }
+      volid |= IDDescriptor::encode(enc.second, touchable->GetCopyNumber(enc.first));
     }
-    printout(INFO, "Geant4VolumeManager",
-	     "+++   Bad Geant4 volume path: \'%s\' [missing entry] %s",
-	     Geant4TouchableHandler::placementPath(path).c_str(), debug_status(this).c_str());
-    return NonExisting;
+    return volid;
+  }
+  if( !path[0] )  {
+    printout(INFO, "Geant4VolumeManager", "+++   Bad Geant4 volume path: \'%s\' [invalid path] %s",
+             Geant4TouchableHandler::placementPath(Geant4TouchableHandler::Geant4PlacementPath(path, path+depth)).c_str(), debug_status(this).c_str());
+    return InvalidPath;
+  }
+  else if( !path[0]->GetLogicalVolume()->GetSensitiveDetector() )  {
+    printout(INFO, "Geant4VolumeManager", "+++   Bad Geant4 volume path: \'%s\' [insensitive] %s",
+             Geant4TouchableHandler::placementPath(Geant4TouchableHandler::Geant4PlacementPath(path, path+depth)).c_str(), debug_status(this).c_str());
+    return Insensitive;
   }
-  printout(INFO, "Geant4VolumeManager", "+++   Bad Geant4 volume path: \'%s\' %s",
-           Geant4TouchableHandler::placementPath(path).c_str(), yes_no(path.empty()));
+  printout(INFO, "Geant4VolumeManager",
+           "+++   Bad Geant4 volume path: \'%s\' [missing entry] %s",
+           Geant4TouchableHandler::placementPath(Geant4TouchableHandler::Geant4PlacementPath(path, path+depth)).c_str(), debug_status(this).c_str());
   return NonExisting;
 }
 
@@ -66,6 +66,19 @@ namespace dd4hep  {
         ERROR_CALCULATION_ERROR     /**< Error during calculation */
       };
 
+      /**
+       * Evaluation counters.
+       *
+       * @see statistics
+       */
+      struct Statistics {
+        long literals    = 0;       /**< Numeric literals converted without locking */
+        long cached      = 0;       /**< Expressions executed from the cache */
+        long compiled    = 0;       /**< Expressions compiled and added to the cache */
+        long interpreted = 0;       /**< Expressions evaluated by the interpreter only */
+        long invalidated = 0;       /**< Cached expressions dropped after a redefinition */
+      };
+
       /**
        * Constructor.
        */
@@ -261,6 +274,25 @@ namespace dd4hep  {
        */
       bool findFunction(const std::string& name, int npar)   const;
 
+      /**
+       * Enables or disables the evaluation shortcuts:
+       * numeric literals are converted without locking the dictionary,
+       * other expressions are compiled and cached. A cached expression is
+       * dropped if a variable or function it depends on is redefined.
+       * The results are identical to the ones of the interpreter.
+       *
+       * @param  value new setting.
+       * @return previous setting.
+       */
+      bool setCaching(bool value)  const;
+
+      /**
+       * Access the evaluation counters.
+       *
+       * @return copy of the counters.
+       */
+      Statistics statistics()  const;
+
       class Object;
 
     private:
@@ -269,6 +269,19 @@ namespace dd4hep  {
        */
       void clear();
 
+      /**
+       * Enables or disables the literal conversion and the expression cache.
+       *
+       * @param  value new setting.
+       * @return previous setting.
+       */
+      bool setCaching(bool value);
+
+      /**
+       * Access the evaluation counters.
+       */
+      Evaluator::Statistics statistics() const;
+
       struct Struct;
       
     private:
@@ -16,8 +16,17 @@
 #include <cstdlib>     // for strtod()
 #include <stack>
 #include <string>
+#include <vector>
+#include <atomic>
 #include <unordered_map>
 
+// Locale independent conversion of numeric literals
+#if defined(__has_include)
+#if __has_include(<charconv>) && __cplusplus >= 201703L
+#include <charconv>
+#endif
+#endif
+
 // Disable some diagnostics, which we know, but need to ignore
 #if defined(__GNUC__) && !defined(__APPLE__) && !defined(__llvm__)
 /*  This is OK:
@@ -75,6 +84,42 @@ namespace  {
     FCN(double (*f)(double,double,double,double)) { f4 = f; }
     FCN(double (*f)(double,double,double,double,double)) { f5 = f; }
   };
+
+  /// Compiled expression: the operations of a successful evaluation in reverse polish notation
+  /**
+   *  Numbers and variables are stored as constants. Expressions are valid
+   *  as long as none of the dictionary items they depend on is modified.
+   */
+  struct Program {
+    /// Single operation: push constant, arithmetic operation or function call
+    struct Code {
+      int    op;
+      int    npar;
+      double value;
+      void*  function;
+    };
+    std::vector<Code>        code;
+    /// Names of the dictionary items the expression depends on
+    std::vector<std::string> depends;
+    int depth = 0, max_depth = 0;
+
+    void push(double value)   {
+      code.emplace_back(Code{-1, 0, value, nullptr});
+      if ( ++depth > max_depth ) max_depth = depth;
+    }
+    void apply(int op)   {
+      code.emplace_back(Code{op, 0, 0e0, nullptr});
+      --depth;
+    }
+    void call(void* function, int npar)   {
+      code.emplace_back(Code{-2, npar, 0e0, function});
+      depth -= npar;
+      if ( ++depth > max_depth ) max_depth = depth;
+    }
+    void depend(std::string name)   {
+      depends.emplace_back(std::move(name));
+    }
+  };
 }
 
 //typedef char * pchar;
@@ -123,6 +168,39 @@ struct EVAL::Object::Struct {
   bool theWriterWaiting = false;
   std::condition_variable theCond;
   std::mutex  theLock;
+
+  /// Cache of compiled expressions
+  std::unordered_map<std::string,Program> theCache;
+  /// Cached expressions depending on a dictionary item
+  std::unordered_map<std::string,std::vector<std::string> > theDependents;
+  /// Flag to enable the literal conversion and the expression cache
+  std::atomic<bool> theCaching { true };
+  /// Evaluation counters
+  std::atomic<long> theLiterals { 0 }, theCached { 0 }, theCompiled { 0 };
+  std::atomic<long> theInterpreted { 0 }, theInvalidated { 0 };
+
+  /// Drop the compiled expressions depending on the dictionary item. Requires the write lock
+  void invalidate(const std::string& name)   {
+    auto i = theDependents.find(name);
+    if ( i != theDependents.end() )  {
+      for( const auto& expression : i->second )
+        theInvalidated += theCache.erase(expression);
+      theDependents.erase(i);
+    }
+  }
+  /// Add compiled expression to the cache. Requires the dictionary lock
+  void insert(const char* expression, Program&& program)   {
+    static constexpr std::size_t MAX_CACHE_SIZE = 1<<16;
+    if ( theCache.size() >= MAX_CACHE_SIZE )   {
+      theCache.clear();
+      theDependents.clear();
+    }
+    auto ret = theCache.emplace(expression, std::move(program));
+    if ( ret.second )   {
+      for( const auto& name : ret.first->second.depends )
+        theDependents[name].emplace_back(ret.first->first);
+    }
+  }
 };
 
 //---------------------------------------------------------------------------
@@ -144,10 +222,10 @@ static constexpr char sss[MAX_N_PAR+2] = "012345";
 enum { ENDL, LBRA, OR, AND, EQ, NE, GE, GT, LE, LT,
        PLUS, MINUS, MULT, DIV, POW, RBRA, VALUE };
 
-static int engine(char const*, char const*, double &, char const* &, const dic_type &);
+static int engine(char const*, char const*, double &, char const* &, const dic_type &, Program*);
 
 static int variable(const std::string & name, double & result,
-                    const dic_type & dictionary)
+                    const dic_type & dictionary, Program* program)
 /***********************************************************************
  *                                                                     *
  * Name: variable                                    Date:    03.10.00 *
@@ -160,22 +238,25 @@ static int variable(const std::string & name, double & result,
  *   name   - name of the variable.                                    *
  *   result - value of the variable.                                   *
  *   dictionary - dictionary of available variables and functions.     *
+ *   program - optional compiled expression to record the operations.  *
  *                                                                     *
  ***********************************************************************/
 {
   dic_type::const_iterator iter = dictionary.find(name);
   if (iter == dictionary.end())
     return EVAL::ERROR_UNKNOWN_VARIABLE;
+  if (program) program->depend(name);
   //NOTE: copying ::string not thread safe so must use ref
   Item const& item = iter->second;
   switch (item.what) {
   case Item::VARIABLE:
     result = item.variable;
+    if (program) program->push(result);
     return EVAL::OK;
   case Item::EXPRESSION: {
     char const* exp_begin = (item.expression.c_str());
     char const* exp_end   = exp_begin + strlen(exp_begin) - 1;
-    if (engine(exp_begin, exp_end, result, exp_end, dictionary) == EVAL::OK)
+    if (engine(exp_begin, exp_end, result, exp_end, dictionary, program) == EVAL::OK)
       return EVAL::OK;
     return EVAL::ERROR_CALCULATION_ERROR;
   }
@@ -184,8 +265,42 @@ static int variable(const std::string & name, double & result,
   }
 }
 
+static int call_function(void* function, int npar, const double* pp, double & result)
+/***********************************************************************
+ *                                                                     *
+ * Function: Calls the function with the parameters pp[npar-1]...pp[0] *
+ *           This function is used by execute_function() and execute()*
+ *                                                                     *
+ ***********************************************************************/
+{
+  errno = 0;
+  if (function == 0)       return EVAL::ERROR_CALCULATION_ERROR;
+  FCN fcn(function);
+  switch (npar) {
+  case 0:
+    result = (*fcn.f0)();
+    break;
+  case 1:
+    result = (*fcn.f1)(pp[0]);
+    break;
+  case 2:
+    result = (*fcn.f2)(pp[1], pp[0]);
+    break;
+  case 3:
+    result = (*fcn.f3)(pp[2],pp[1],pp[0]);
+    break;
+  case 4:
+    result = (*fcn.f4)(pp[3],pp[2],pp[1],pp[0]);
+    break;
+  case 5:
+    result = (*fcn.f5)(pp[4],pp[3],pp[2],pp[1],pp[0]);
+    break;
+  }
+  return (errno == 0) ? EVAL::OK : EVAL::ERROR_CALCULATION_ERROR;
+}
+
 static int execute_function(const std::string & name, std::stack<double> & par,
-                    double & result, const dic_type & dictionary)
+                    double & result, const dic_type & dictionary, Program* program)
 /***********************************************************************
  *                                                                     *
  * Name: execute_function                            Date:    03.10.00 *
@@ -199,6 +314,7 @@ static int execute_function(const std::string & name, std::stack<double> & par,
  *   par    - stack of parameters.                                     *
  *   result - value of the function.                                   *
  *   dictionary - dictionary of available variables and functions.     *
+ *   program - optional compiled expression to record the operations.  *
  *                                                                     *
  ***********************************************************************/
 {
@@ -212,34 +328,15 @@ static int execute_function(const std::string & name, std::stack<double> & par,
 
   double pp[MAX_N_PAR];
   for(int i=0; i<npar; i++) { pp[i] = par.top(); par.pop(); }
-  errno = 0;
-  if (item.function == 0)       return EVAL::ERROR_CALCULATION_ERROR;
-  FCN fcn(item.function);
-  switch (npar) {
-  case 0:
-    result = (*fcn.f0)();
-    break;
-  case 1:
-    result = (*fcn.f1)(pp[0]);
-    break;
-  case 2:
-    result = (*fcn.f2)(pp[1], pp[0]);
-    break;
-  case 3:
-    result = (*fcn.f3)(pp[2],pp[1],pp[0]);
-    break;
-  case 4:
-    result = (*fcn.f4)(pp[3],pp[2],pp[1],pp[0]);
-    break;
-  case 5:
-    result = (*fcn.f5)(pp[4],pp[3],pp[2],pp[1],pp[0]);
-    break;
+  if (program)   {
+    program->depend(iter->first);
+    program->call(item.function, npar);
   }
-  return (errno == 0) ? EVAL::OK : EVAL::ERROR_CALCULATION_ERROR;
+  return call_function(item.function, npar, pp, result);
 }
 
 static int operand(char const* begin, char const* end, double & result,
-                   char const* & endp, const dic_type & dictionary)
+                   char const* & endp, const dic_type & dictionary, Program* program)
 /***********************************************************************
  *                                                                     *
  * Name: operand                                     Date:    03.10.00 *
@@ -255,6 +352,7 @@ static int operand(char const* begin, char const* end, double & result,
  *   result - value of the operand.                                    *
  *   endp   - pointer to the character where the evaluation stoped.    *
  *   dictionary - dictionary of available variables and functions.     *
+ *   program - optional compiled expression to record the operations.  *
  *                                                                     *
  ***********************************************************************/
 {
@@ -273,6 +371,7 @@ static int operand(char const* begin, char const* end, double & result,
 #endif
       result = strtod(pointer, (char **)(&pointer));
     if (errno == 0) {
+      if (program) program->push(result);
       EVAL_EXIT( EVAL::OK, --pointer );
     }else{
       EVAL_EXIT( EVAL::ERROR_CALCULATION_ERROR, begin );
@@ -293,7 +392,7 @@ static int operand(char const* begin, char const* end, double & result,
   result = 0.0;
   SKIP_BLANKS;
   if (c != '(') {
-    EVAL_STATUS = variable(name, result, dictionary);
+    EVAL_STATUS = variable(name, result, dictionary, program);
     EVAL_EXIT( EVAL_STATUS, (EVAL_STATUS == EVAL::OK) ? --pointer : begin);
   }
 
@@ -315,7 +414,7 @@ static int operand(char const* begin, char const* end, double & result,
     case ',':
       if (pos.size() == 1) {
         par_end = pointer-1;
-        EVAL_STATUS = engine(par_begin, par_end, value, par_end, dictionary);
+        EVAL_STATUS = engine(par_begin, par_end, value, par_end, dictionary, program);
         if (EVAL_STATUS == EVAL::WARNING_BLANK_STRING)
 	  { EVAL_EXIT( EVAL::ERROR_EMPTY_PARAMETER, --par_end ); }
         if (EVAL_STATUS != EVAL::OK)
@@ -330,7 +429,7 @@ static int operand(char const* begin, char const* end, double & result,
         break;
       }else{
         par_end = pointer-1;
-        EVAL_STATUS = engine(par_begin, par_end, value, par_end, dictionary);
+        EVAL_STATUS = engine(par_begin, par_end, value, par_end, dictionary, program);
         switch (EVAL_STATUS) {
         case EVAL::OK:
           par.push(value);
@@ -342,7 +441,7 @@ static int operand(char const* begin, char const* end, double & result,
         default:
           EVAL_EXIT( EVAL_STATUS, par_end );
         }
-        EVAL_STATUS = execute_function(name, par, result, dictionary);
+        EVAL_STATUS = execute_function(name, par, result, dictionary, program);
         EVAL_EXIT( EVAL_STATUS, (EVAL_STATUS == EVAL::OK) ? pointer : begin);
       }
     }
@@ -363,52 +462,49 @@ static int operand(char const* begin, char const* end, double & result,
  *   val - stack of values.                                            *
  *                                                                     *
  ***********************************************************************/
-static int maker(int op, std::stack<double> & val)
+static int operation(int op, double val1, double val2, double & result)
 {
-  if (val.size() < 2) return EVAL::ERROR_SYNTAX_ERROR;
-  double val2 = val.top(); val.pop();
-  double val1 = val.top();
   switch (op) {
   case OR:                                // operator ||
-    val.top() = (val1 || val2) ? 1. : 0.;
+    result = (val1 || val2) ? 1. : 0.;
     return EVAL::OK;
   case AND:                               // operator &&
-    val.top() = (val1 && val2) ? 1. : 0.;
+    result = (val1 && val2) ? 1. : 0.;
     return EVAL::OK;
   case EQ:                                // operator ==
-    val.top() = (val1 == val2) ? 1. : 0.;
+    result = (val1 == val2) ? 1. : 0.;
     return EVAL::OK;
   case NE:                                // operator !=
-    val.top() = (val1 != val2) ? 1. : 0.;
+    result = (val1 != val2) ? 1. : 0.;
     return EVAL::OK;
   case GE:                                // operator >=
-    val.top() = (val1 >= val2) ? 1. : 0.;
+    result = (val1 >= val2) ? 1. : 0.;
     return EVAL::OK;
   case GT:                                // operator >
-    val.top() = (val1 >  val2) ? 1. : 0.;
+    result = (val1 >  val2) ? 1. : 0.;
     return EVAL::OK;
   case LE:                                // operator <=
-    val.top() = (val1 <= val2) ? 1. : 0.;
+    result = (val1 <= val2) ? 1. : 0.;
     return EVAL::OK;
   case LT:                                // operator <
-    val.top() = (val1 <  val2) ? 1. : 0.;
+    result = (val1 <  val2) ? 1. : 0.;
     return EVAL::OK;
   case PLUS:                              // operator '+'
-    val.top() = val1 + val2;
+    result = val1 + val2;
     return EVAL::OK;
   case MINUS:                             // operator '-'
-    val.top() = val1 - val2;
+    result = val1 - val2;
     return EVAL::OK;
   case MULT:                              // operator '*'
-    val.top() = val1 * val2;
+    result = val1 * val2;
     return EVAL::OK;
   case DIV:                               // operator '/'
     if (val2 == 0.0) return EVAL::ERROR_CALCULATION_ERROR;
-    val.top() = val1 / val2;
+    result = val1 / val2;
     return EVAL::OK;
   case POW:                               // operator '^' (or '**')
     errno = 0;
-    val.top() = pow(val1,val2);
+    result = pow(val1,val2);
     if (errno == 0) return EVAL::OK;
     ATTR_FALLTHROUGH;
   default:
@@ -416,6 +512,91 @@ static int maker(int op, std::stack<double> & val)
   }
 }
 
+static int maker(int op, std::stack<double> & val, Program* program)
+{
+  if (val.size() < 2) return EVAL::ERROR_SYNTAX_ERROR;
+  double val2 = val.top(); val.pop();
+  double val1 = val.top();
+  if (program) program->apply(op);
+  return operation(op, val1, val2, val.top());
+}
+
+/***********************************************************************
+ *                                                                     *
+ * Function: Executes a compiled expression.                           *
+ *           The operations are identical to the ones of engine():     *
+ *           the result is bit-identical.                              *
+ *                                                                     *
+ ***********************************************************************/
+static int execute(const Program & program, double & result)
+{
+  double  buffer[32];
+  std::vector<double> large;
+  double* stack = buffer;
+  int     top   = -1, status;
+  if (program.max_depth > 32) {
+    large.resize(program.max_depth);
+    stack = large.data();
+  }
+  for(const auto& c : program.code) {
+    switch (c.op) {
+    case -1:                              // constant
+      stack[++top] = c.value;
+      break;
+    case -2: {                            // function call
+      double pp[MAX_N_PAR];
+      for(int i=0; i<c.npar; i++) pp[i] = stack[top-i];
+      top -= c.npar;
+      status = call_function(c.function, c.npar, pp, stack[++top]);
+      if (status != EVAL::OK) return status;
+      break;
+    }
+    default:                              // arithmetic operation
+      status = operation(c.op, stack[top-1], stack[top], stack[top-1]);
+      --top;
+      if (status != EVAL::OK) return status;
+      break;
+    }
+  }
+  if (top != 0) return EVAL::ERROR_SYNTAX_ERROR;
+  result = stack[0];
+  return EVAL::OK;
+}
+
+/***********************************************************************
+ *                                                                     *
+ * Function: Converts an expression consisting of a single number      *
+ *           with optional sign and surrounding blanks.                *
+ *           Returns false if the expression is no such literal: the   *
+ *           expression must then be evaluated by engine().            *
+ *           The result is identical to the one of engine().           *
+ *                                                                     *
+ ***********************************************************************/
+static bool literal(char const* expression, double & result)
+{
+  char const* begin = expression;
+  while (isspace(*begin)) ++begin;
+  char sign = *begin;
+  if (sign == '+' || sign == '-') ++begin;
+  if (!(isdigit(*begin) || (*begin == '.' && isdigit(*(begin+1))))) return false;
+  char const* end = begin + strlen(begin);
+  while (end > begin && isspace(*(end-1))) --end;
+  double value;
+#if defined(__cpp_lib_to_chars)
+  // Hexadecimal numbers, overflows etc. are left to engine()
+  auto ret = std::from_chars(begin, end, value);
+  if (ret.ec != std::errc() || ret.ptr != end) return false;
+#else
+  char* endp = nullptr;
+  errno = 0;
+  value = strtod(begin, &endp);
+  if (errno != 0 || endp != end) return false;
+#endif
+  // Signs are handled by engine() as binary operations with 0
+  result = (sign == '-') ? 0.0 - value : (sign == '+') ? 0.0 + value : value;
+  return true;
+}
+
 /***********************************************************************
  *                                                                     *
  * Name: engine                                      Date:    28.09.00 *
@@ -430,10 +611,11 @@ static int maker(int op, std::stack<double> & val)
  *   result - result of the evaluation.                                *
  *   endp   - pointer to the character where the evaluation stoped.    *
  *   dictionary - dictionary of available variables and functions.     *
+ *   program - optional compiled expression to record the operations.  *
  *                                                                     *
  ***********************************************************************/
 static int engine(char const* begin, char const* end, double & result,
-                  char const*& endp, const dic_type & dictionary)
+                  char const*& endp, const dic_type & dictionary, Program* program)
 {
   static constexpr int SyntaxTable[17][17] = {
     //E  (  || && == != >= >  <= <  +  -  *  /  ^  )  V - current token
@@ -548,12 +730,13 @@ static int engine(char const* begin, char const* end, double & result,
     case 0:                             // syntax error
       EVAL_EXIT( EVAL::ERROR_SYNTAX_ERROR, pointer );
     case 1:                             // operand: number, variable, function
-      EVAL_STATUS = operand(pointer, end, value, pointer, dictionary);
+      EVAL_STATUS = operand(pointer, end, value, pointer, dictionary, program);
       if (EVAL_STATUS != EVAL::OK) { EVAL_EXIT( EVAL_STATUS, pointer ); }
       val.push(value);
       continue;
     case 2:                             // unary + or unary -
       val.push(0.0);
+      if (program) program->push(0.0);
     case 3: default:                    // next operator
       break;
     }
@@ -578,7 +761,7 @@ static int engine(char const* begin, char const* end, double & result,
         op.push(iCur); pos.push(pointer);
         break;
       case 2:                           // execute top operator
-        EVAL_STATUS = maker(iTop, val); // put current operator in stack
+        EVAL_STATUS = maker(iTop, val, program); // put current operator in stack
         if (EVAL_STATUS != EVAL::OK) {
           EVAL_EXIT( EVAL_STATUS, pos.top() );
         }
@@ -588,7 +771,7 @@ static int engine(char const* begin, char const* end, double & result,
         op.pop(); pos.pop();
         break;
       case 4: default:                  // execute top operator and
-        EVAL_STATUS = maker(iTop, val); // delete it from stack
+        EVAL_STATUS = maker(iTop, val, program); // delete it from stack
         if (EVAL_STATUS != EVAL::OK) {  // repete with the same iCur
           EVAL_EXIT( EVAL_STATUS, pos.top() );
         }
@@ -630,6 +813,7 @@ static int setItem(const char * prefix, const char * name,
   EVAL::Object::Struct::WriteLock guard(imp);
   dic_type::iterator iter = imp->theDictionary.find(item_name);
   if (iter != imp->theDictionary.end()) {
+    imp->invalidate(item_name);
     iter->second = item;
     if (item_name == name) {
       return EVAL::WARNING_EXISTING_VARIABLE;
@@ -704,16 +888,76 @@ Evaluator::Object::~Object() {
 Evaluator::Object::EvalStatus Evaluator::Object::evaluate(const char * expression) const {
   EvalStatus s;
   if (expression != 0) {
+    bool caching = imp->theCaching;
+    // Numeric literals do not need the dictionary: no locking
+    if (caching && literal(expression, s.theResult)) {
+      s.thePosition = expression+strlen(expression);
+      ++imp->theLiterals;
+      return s;
+    }
     Struct::ReadLock guard(imp);
+    // The read lock holds the dictionary mutex: the cache may be updated
+    if (caching) {
+      auto iter = imp->theCache.find(expression);
+      if (iter != imp->theCache.end()) {
+        if (execute(iter->second, s.theResult) == EVAL::OK) {
+          s.thePosition = expression+strlen(expression);
+          ++imp->theCached;
+          return s;
+        }
+      }
+      else {
+        Program program;
+        s.theStatus = engine(expression,
+                             expression+strlen(expression)-1,
+                             s.theResult,
+                             s.thePosition,
+                             imp->theDictionary,
+                             &program);
+        if (s.theStatus == EVAL::OK) {
+          imp->insert(expression, std::move(program));
+          ++imp->theCompiled;
+        }
+        else {
+          ++imp->theInterpreted;
+        }
+        return s;
+      }
+    }
+    // Errors are always reported by the interpreter
     s.theStatus = engine(expression,
                          expression+strlen(expression)-1,
                          s.theResult,
                          s.thePosition,
-                         imp->theDictionary);
+                         imp->theDictionary,
+                         nullptr);
+    ++imp->theInterpreted;
   }
   return s;
 }
 
+//---------------------------------------------------------------------------
+bool Evaluator::Object::setCaching(bool value) {
+  bool old = imp->theCaching.exchange(value);
+  if (!value) {
+    Struct::WriteLock guard(imp);
+    imp->theCache.clear();
+    imp->theDependents.clear();
+  }
+  return old;
+}
+
+//---------------------------------------------------------------------------
+Evaluator::Statistics Evaluator::Object::statistics() const {
+  Statistics stat;
+  stat.literals    = imp->theLiterals;
+  stat.cached      = imp->theCached;
+  stat.compiled    = imp->theCompiled;
+  stat.interpreted = imp->theInterpreted;
+  stat.invalidated = imp->theInvalidated;
+  return stat;
+}
+
 //---------------------------------------------------------------------------
 int Evaluator::Object::EvalStatus::status() const {
   return theStatus;
@@ -873,6 +1117,7 @@ void Evaluator::Object::removeVariable(const char * name) {
   const char * pointer; int n; REMOVE_BLANKS;
   if (n == 0) return;
   Struct::WriteLock guard(imp);
+  imp->invalidate(std::string(pointer,n));
   imp->theDictionary.erase(std::string(pointer,n));
 }
 
@@ -883,6 +1128,7 @@ void Evaluator::Object::removeFunction(const char * name, int npar) {
   const char * pointer; int n; REMOVE_BLANKS;
   if (n == 0) return;
   Struct::WriteLock guard(imp);
+  imp->invalidate(sss[npar]+std::string(pointer,n));
   imp->theDictionary.erase(sss[npar]+std::string(pointer,n));
 }
 
@@ -1026,3 +1272,13 @@ bool Evaluator::findFunction(const std::string& name, int npar) const    {
   ret = object->findFunction(name.c_str(), npar);
   return ret;
 }
+
+//---------------------------------------------------------------------------
+bool Evaluator::setCaching(bool value)  const    {
+  return object->setCaching(value);
+}
+
+//---------------------------------------------------------------------------
+Evaluator::Statistics Evaluator::statistics()  const    {
+  return object->statistics();
+}
@@ -19,6 +19,7 @@
 
 #include "DDSegmentation/Segmentation.h"
 
+#include <memory>
 #include <set>
 #include <string>
 
@@ -29,6 +30,8 @@ namespace dd4hep {
     typedef DDSegmentation::CellID CellID;
     typedef DDSegmentation::VolumeID VolumeID;
 
+    class CellIDPositionIndex;
+
     /** Utility for position to cellID and cellID to position conversions.
      *  (Correctly re-implements some of the functionality of the deprecated IDDecoder).
      *
@@ -70,10 +73,24 @@ namespace dd4hep {
 
       /** Return the global cellID for the given global position.
        *  Note: this call is rather slow - only use it when really needed !
-       *  
+       *  Once buildSpatialIndex() was called, the spatial index is used instead
+       *  of the TGeoManager navigator and the call may be used concurrently.
        */
       CellID cellID(const Position& global) const;
 
+      /** Return the global cellIDs for n global positions.
+       *  Uses the spatial index if it was built.
+       */
+      void cellIDs(std::size_t n, const Position* global, CellID* cells) const;
+
+      /** Build the spatial index over all sensitive placements used by
+       *  cellID(const Position&) and cellIDs(). The index is built only once.
+       */
+      void buildSpatialIndex();
+
+      /// Access to the spatial index. NULL unless buildSpatialIndex() was called.
+      const CellIDPositionIndex* spatialIndex() const { return _index.get() ; }
+
 
 
       /** Find the context with DetElement, placements etc for a given cellID of a sensitive volume.
@@ -119,6 +136,7 @@ namespace dd4hep {
     protected:
       VolumeManager _volumeManager{} ;
       const Detector* _description ;
+      std::shared_ptr<const CellIDPositionIndex> _index{} ; //! transient
 
     };
 
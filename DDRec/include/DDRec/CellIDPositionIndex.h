@@ -0,0 +1,134 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#ifndef DDREC_CELLIDPOSITIONINDEX_H
+#define DDREC_CELLIDPOSITIONINDEX_H
+
+#include "DD4hep/Detector.h"
+#include "DD4hep/Segmentations.h"
+
+#include <cstddef>
+#include <vector>
+
+class TGeoNode;
+class TGeoShape;
+
+namespace dd4hep {
+  namespace rec {
+
+    /** Spatial index over all sensitive placements of a detector.
+     *
+     *  The index is built once by scanning the placement tree. For every sensitive
+     *  placement it caches the world-to-local transformation, the axis aligned bounding
+     *  box in world coordinates, the solid, the segmentation and the pre-encoded
+     *  volume ID. The bounding boxes are organized in a bounding volume hierarchy.
+     *
+     *  Global position to cellID conversion then needs neither TGeoManager::FindNode
+     *  nor the construction of a TGeoPhysicalNode. The index is read-only after
+     *  construction and does not touch any navigator state: it may be used
+     *  concurrently from several threads.
+     *
+     *  If several sensitive placements contain a point, the deepest one wins. If the
+     *  point lies inside an insensitive daughter of the sensitive placement, no cellID
+     *  is returned - as with the navigator based lookup.
+     *
+     * @author M.Frank
+     * @version 1.0
+     */
+    class CellIDPositionIndex {
+    public:
+      /// Cached information of one sensitive placement
+      struct Entry {
+        /// Rotation part of the local-to-world transformation (row major)
+        double           rotation[9];
+        /// Translation part of the local-to-world transformation
+        double           translation[3];
+        /// Lower corner of the world bounding box
+        double           lower[3];
+        /// Upper corner of the world bounding box
+        double           upper[3];
+        /// The solid of the sensitive volume
+        const TGeoShape* solid     { nullptr };
+        /// The sensitive placement itself
+        const TGeoNode*  node      { nullptr };
+        /// The segmentation of the readout
+        Segmentation     segmentation { };
+        /// Encoded volume ID of all volIDs along the placement path
+        VolumeID         volumeID  { 0 };
+        /// Depth of the placement in the geometry tree
+        int              depth     { 0 };
+
+        /// Transform global point to the local coordinate system of the placement
+        void toLocal(const double g[3], double l[3])  const  {
+          const double d[3] = { g[0]-translation[0], g[1]-translation[1], g[2]-translation[2] };
+          l[0] = rotation[0]*d[0] + rotation[3]*d[1] + rotation[6]*d[2];
+          l[1] = rotation[1]*d[0] + rotation[4]*d[1] + rotation[7]*d[2];
+          l[2] = rotation[2]*d[0] + rotation[5]*d[1] + rotation[8]*d[2];
+        }
+      };
+
+      /// Node of the bounding volume hierarchy
+      struct Node {
+        double lower[3];
+        double upper[3];
+        /// Leaf nodes: first entry; inner nodes: index of the right child (left child is next)
+        int    first;
+        /// Number of entries for leaf nodes, 0 for inner nodes
+        int    count;
+      };
+
+    protected:
+      /// Sensitive placements in BVH leaf order
+      std::vector<Entry> _entries ;
+      /// BVH nodes in depth-first order
+      std::vector<Node>  _nodes ;
+
+      /// Recursively build the BVH over the entries [first, last)
+      int buildNode(int first, int last) ;
+
+    public:
+      /// Maximal number of entries in a BVH leaf
+      static constexpr int LEAF_SIZE = 4;
+      /// Maximal depth of the BVH handled by the traversal stack
+      static constexpr int MAX_DEPTH = 64;
+
+      /// Initializing constructor: scan the geometry of the given detector
+      CellIDPositionIndex(const Detector& description) ;
+      /// No copy constructor
+      CellIDPositionIndex(const CellIDPositionIndex&) = delete ;
+      /// No assignment
+      CellIDPositionIndex& operator=(const CellIDPositionIndex&) = delete ;
+      /// Default destructor
+      ~CellIDPositionIndex() = default ;
+
+      /// Access to the indexed sensitive placements
+      const std::vector<Entry>& entries() const { return _entries ; }
+      /// Access to the BVH nodes
+      const std::vector<Node>& nodes() const { return _nodes ; }
+
+      /** Find the sensitive placement containing the global point.
+       *  On success the local coordinates are filled. Returns NULL if no sensitive
+       *  placement contains the point.
+       */
+      const Entry* find(const double global[3], double local[3]) const ;
+
+      /// Return the cellID for the given global position (0 if none)
+      CellID cellID(const Position& global) const ;
+
+      /// Convert n global positions to cellIDs
+      void cellIDs(std::size_t n, const Position* global, CellID* cells) const ;
+    };
+
+  } /* namespace rec */
+} /* namespace dd4hep */
+
+#endif // DDREC_CELLIDPOSITIONINDEX_H
@@ -12,6 +12,7 @@
 //==========================================================================
 
 #include <DDRec/CellIDPositionConverter.h>
+#include <DDRec/CellIDPositionIndex.h>
 
 #include <DD4hep/Detector.h>
 #include <DD4hep/detail/VolumeManagerInterna.h>
@@ -84,8 +85,25 @@ namespace dd4hep {
 
 
 
+    void CellIDPositionConverter::buildSpatialIndex() {
+      if( !_index )
+        _index = std::make_shared<const CellIDPositionIndex>( *_description ) ;
+    }
+
+    void CellIDPositionConverter::cellIDs(std::size_t n, const Position* global, CellID* cells) const {
+      if( _index ){
+        _index->cellIDs( n, global, cells ) ;
+        return ;
+      }
+      for( std::size_t i=0 ; i<n ; ++i )
+        cells[i] = cellID( global[i] ) ;
+    }
+
     CellID CellIDPositionConverter::cellID(const Position& global) const {
 
+      if( _index )
+        return _index->cellID( global ) ;
+
       CellID result(0) ;
       
       TGeoManager *geoManager = _description->world().volume()->GetGeoManager() ;
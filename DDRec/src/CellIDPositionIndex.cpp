@@ -0,0 +1,262 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+
+#include <DDRec/CellIDPositionIndex.h>
+
+#include <DD4hep/Printout.h>
+#include <DD4hep/Volumes.h>
+
+#include <TGeoBBox.h>
+#include <TGeoMatrix.h>
+#include <TGeoNode.h>
+
+#include <algorithm>
+#include <limits>
+
+namespace dd4hep {
+  namespace rec {
+
+    namespace {
+
+      typedef CellIDPositionIndex::Entry Entry ;
+
+      /// Helper to collect all sensitive placements of the geometry tree
+      struct Scanner {
+        std::vector<Entry>& entries ;
+
+        /// Fill the cached transformation and the world bounding box of the entry
+        void setup(Entry& e, const TGeoHMatrix& world) const {
+          const Double_t* r = world.GetRotationMatrix() ;
+          const Double_t* t = world.GetTranslation() ;
+          std::copy(r, r+9, e.rotation) ;
+          std::copy(t, t+3, e.translation) ;
+
+          const TGeoBBox* box = static_cast<const TGeoBBox*>(e.solid) ;
+          const Double_t* org = box->GetOrigin() ;
+          const double    dim[3] = { box->GetDX(), box->GetDY(), box->GetDZ() } ;
+          for( int i=0 ; i<3 ; ++i ){
+            e.lower[i] =  std::numeric_limits<double>::max() ;
+            e.upper[i] = -std::numeric_limits<double>::max() ;
+          }
+          for( int c=0 ; c<8 ; ++c ){
+            double l[3] = { org[0] + ((c&1) ? dim[0] : -dim[0]) ,
+                            org[1] + ((c&2) ? dim[1] : -dim[1]) ,
+                            org[2] + ((c&4) ? dim[2] : -dim[2]) } ;
+            double g[3] ;
+            world.LocalToMaster( l, g ) ;
+            for( int i=0 ; i<3 ; ++i ){
+              e.lower[i] = std::min( e.lower[i], g[i] ) ;
+              e.upper[i] = std::max( e.upper[i], g[i] ) ;
+            }
+          }
+        }
+
+        /// Scan a single placement and all its daughters
+        void scan(const TGeoNode* node, const TGeoHMatrix& mother, PlacedVolume::VolIDs ids, int depth) {
+          PlacedVolume pv(node) ;
+          Volume       vol = pv.volume() ;
+          TGeoHMatrix  world(mother) ;
+          world.Multiply( node->GetMatrix() ) ;
+
+          ids.PlacedVolume::VolIDs::Base::insert( ids.end(), pv.volIDs().begin(), pv.volIDs().end() ) ;
+          if( vol.isSensitive() ){
+            SensitiveDetector sd = vol.sensitiveDetector() ;
+            Readout rdout = sd.isValid() ? sd.readout() : Readout() ;
+            if( rdout.isValid() ){
+              Entry e ;
+              e.solid        = vol->GetShape() ;
+              e.node         = node ;
+              e.segmentation = rdout.segmentation() ;
+              e.volumeID     = rdout.idSpec().encode( ids ) ;
+              e.depth        = depth ;
+              setup( e, world ) ;
+              entries.emplace_back( e ) ;
+            }
+          }
+          for( Int_t idau = 0, ndau = node->GetNdaughters() ; idau < ndau ; ++idau ){
+            const TGeoNode* daughter = node->GetDaughter( idau ) ;
+            if( PlacedVolume(daughter).data() )
+              scan( daughter, world, ids, depth+1 ) ;
+          }
+        }
+      };
+
+      /// Check if a point lies inside the bounds
+      inline bool inside(const double lower[3], const double upper[3], const double p[3]) {
+        return p[0] >= lower[0] && p[0] <= upper[0] &&
+          p[1] >= lower[1] && p[1] <= upper[1] &&
+          p[2] >= lower[2] && p[2] <= upper[2] ;
+      }
+    }
+
+    CellIDPositionIndex::CellIDPositionIndex(const Detector& description) {
+      PlacedVolume world = description.world().placement() ;
+      Scanner scanner { _entries } ;
+      TGeoHMatrix top ;
+      for( Int_t idau = 0, ndau = world->GetNdaughters() ; idau < ndau ; ++idau ){
+        const TGeoNode* daughter = world->GetDaughter( idau ) ;
+        // world has no volIDs
+        if( PlacedVolume(daughter).data() )
+          scanner.scan( daughter, top, PlacedVolume::VolIDs(), 1 ) ;
+      }
+      if( !_entries.empty() ){
+        _nodes.reserve( 2*_entries.size()/LEAF_SIZE + 1 ) ;
+        buildNode( 0, int(_entries.size()) ) ;
+      }
+      printout( DEBUG, "CellIDPositionIndex", "+++ Indexed %ld sensitive placements in %ld BVH nodes.",
+                long(_entries.size()), long(_nodes.size()) ) ;
+    }
+
+    int CellIDPositionIndex::buildNode(int first, int last) {
+      int  idx = int(_nodes.size()) ;
+      Node node ;
+      for( int i=0 ; i<3 ; ++i ){
+        node.lower[i] =  std::numeric_limits<double>::max() ;
+        node.upper[i] = -std::numeric_limits<double>::max() ;
+      }
+      for( int k=first ; k<last ; ++k ){
+        for( int i=0 ; i<3 ; ++i ){
+          node.lower[i] = std::min( node.lower[i], _entries[k].lower[i] ) ;
+          node.upper[i] = std::max( node.upper[i], _entries[k].upper[i] ) ;
+        }
+      }
+      _nodes.emplace_back( node ) ;
+      if( last-first <= LEAF_SIZE ){
+        _nodes[idx].first = first ;
+        _nodes[idx].count = last-first ;
+        return idx ;
+      }
+      // Median split of the entry centers along the largest extent
+      int axis = 0 ;
+      double ext = node.upper[0]-node.lower[0] ;
+      for( int i=1 ; i<3 ; ++i ){
+        if( node.upper[i]-node.lower[i] > ext ){
+          axis = i ;
+          ext  = node.upper[i]-node.lower[i] ;
+        }
+      }
+      int middle = (first+last)/2 ;
+      std::nth_element( _entries.begin()+first, _entries.begin()+middle, _entries.begin()+last,
+                        [axis](const Entry& a, const Entry& b) {
+                          return a.lower[axis]+a.upper[axis] < b.lower[axis]+b.upper[axis] ;
+                        } ) ;
+      buildNode( first, middle ) ;
+      int right = buildNode( middle, last ) ;
+      _nodes[idx].first = right ;
+      _nodes[idx].count = 0 ;
+      return idx ;
+    }
+
+    const CellIDPositionIndex::Entry*
+    CellIDPositionIndex::find(const double global[3], double local[3]) const {
+      const Entry* found = nullptr ;
+      int stack[MAX_DEPTH] ;
+      int top = 0 ;
+      if( !_nodes.empty() )
+        stack[top++] = 0 ;
+
+      while( top > 0 ){
+        const Node& node = _nodes[ stack[--top] ] ;
+        if( !inside( node.lower, node.upper, global ) )
+          continue ;
+        if( node.count > 0 ){
+          for( int k=node.first, kend=node.first+node.count ; k<kend ; ++k ){
+            const Entry& e = _entries[k] ;
+            if( found && found->depth >= e.depth )
+              continue ;
+            if( !inside( e.lower, e.upper, global ) )
+              continue ;
+            double l[3] ;
+            e.toLocal( global, l ) ;
+            if( e.solid->Contains( l ) ){
+              found = &e ;
+              local[0] = l[0] ; local[1] = l[1] ; local[2] = l[2] ;
+            }
+          }
+          continue ;
+        }
+        int left = int(&node - &_nodes[0]) + 1 ;
+        // The median split keeps the tree depth at ~log2(N): only degenerate input hits the limit
+        if( top+2 > MAX_DEPTH ){
+          except( "CellIDPositionIndex", "BVH exceeds the maximal traversal depth of %d", MAX_DEPTH ) ;
+        }
+        stack[top++] = node.first ;
+        stack[top++] = left ;
+      }
+      if( found ){
+        // A point inside an insensitive daughter does not belong to the sensitive volume
+        const TGeoNode* node = found->node ;
+        for( Int_t idau = 0, ndau = node->GetNdaughters() ; idau < ndau ; ++idau ){
+          const TGeoNode* daughter = node->GetDaughter( idau ) ;
+          double dl[3] ;
+          daughter->MasterToLocal( local, dl ) ;
+          if( daughter->GetVolume()->GetShape()->Contains( dl ) )
+            return nullptr ;
+        }
+      }
+      return found ;
+    }
+
+    CellID CellIDPositionIndex::cellID(const Position& global) const {
+      double g[3], l[3] ;
+      global.GetCoordinates( g ) ;
+      const Entry* e = find( g, l ) ;
+      if( e ){
+        return e->segmentation.cellID( Position( l[0], l[1], l[2] ), global, e->volumeID ) ;
+      }
+      return CellID(0) ;
+    }
+
+    void CellIDPositionIndex::cellIDs(std::size_t n, const Position* global, CellID* cells) const {
+      // Locate all points first, then convert them in batches per segmentation
+      std::vector<const Entry*> found( n ) ;
+      std::vector<Position>     local( n ) ;
+      std::vector<std::size_t>  order ;
+      order.reserve( n ) ;
+      for( std::size_t i=0 ; i<n ; ++i ){
+        double g[3], l[3] ;
+        global[i].GetCoordinates( g ) ;
+        found[i] = find( g, l ) ;
+        cells[i] = CellID(0) ;
+        if( found[i] ){
+          local[i].SetCoordinates( l ) ;
+          order.emplace_back( i ) ;
+        }
+      }
+      std::stable_sort( order.begin(), order.end(), [&found](std::size_t a, std::size_t b) {
+          return found[a]->segmentation.ptr() < found[b]->segmentation.ptr() ;
+        } ) ;
+
+      std::vector<Position> l, g ;
+      std::vector<VolumeID> v ;
+      std::vector<CellID>   c ;
+      for( std::size_t first=0 ; first < order.size() ; ){
+        Segmentation seg = found[ order[first] ]->segmentation ;
+        std::size_t last = first ;
+        l.clear() ; g.clear() ; v.clear() ;
+        for( ; last < order.size() && found[ order[last] ]->segmentation.ptr() == seg.ptr() ; ++last ){
+          std::size_t i = order[last] ;
+          l.emplace_back( local[i] ) ;
+          g.emplace_back( global[i] ) ;
+          v.emplace_back( found[i]->volumeID ) ;
+        }
+        c.resize( l.size() ) ;
+        seg.cellIDs( l.size(), &l[0], &g[0], &v[0], &c[0] ) ;
+        for( std::size_t k=first ; k<last ; ++k )
+          cells[ order[k] ] = c[k-first] ;
+        first = last ;
+      }
+    }
+
+  } /* namespace rec */
+} /* namespace dd4hep */
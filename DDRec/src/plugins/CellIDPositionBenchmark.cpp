@@ -0,0 +1,137 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+#include "DD4hep/Detector.h"
+#include "DD4hep/Factories.h"
+#include "DD4hep/Printout.h"
+
+#include "DDRec/CellIDPositionConverter.h"
+#include "DDRec/CellIDPositionIndex.h"
+
+#include <TGeoBBox.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+
+namespace dd4hep {
+  namespace rec {
+
+    namespace {
+      double elapsed(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count() ;
+      }
+    }
+
+    /** Benchmark the global position to cellID conversion of the CellIDPositionConverter.
+     *
+     *  Compares the TGeoManager navigator based lookup with the spatial index
+     *  (single and batch API) for random points inside sensitive volumes and
+     *  counts the differences.
+     *
+     *  Factory: DD4hep_CellIDPositionBenchmark
+     *
+     *  \author  M.Frank
+     *  \version 1.0
+     */
+    static long cellid_position_benchmark(Detector& description, int argc, char** argv) {
+      std::size_t num_points = 100000 ;
+      unsigned    seed = 12345 ;
+      for( int i = 0; i < argc && argv[i]; ++i )  {
+        if ( 0 == ::strncmp("-points",argv[i],4) )
+          num_points = ::atol(argv[++i]) ;
+        else if ( 0 == ::strncmp("-seed",argv[i],4) )
+          seed = ::atol(argv[++i]) ;
+        else  {
+          std::cout <<
+            "Usage: -plugin DD4hep_CellIDPositionBenchmark  -arg [-arg]                    \n\n"
+            "     Benchmark global position to cellID conversions.                         \n\n"
+            "     -points   <number> Number of random points. Default: 100000              \n"
+            "     -seed     <number> Random number seed.      Default: 12345               \n"
+            "     -help              Print this help output                                \n"
+            "     Arguments given: " << arguments(argc,argv) << std::endl << std::flush ;
+          ::exit(EINVAL) ;
+        }
+      }
+      CellIDPositionConverter navigator( description ) ;
+      CellIDPositionConverter indexed( description ) ;
+
+      auto start = std::chrono::steady_clock::now() ;
+      indexed.buildSpatialIndex() ;
+      double t_build = elapsed( start ) ;
+
+      const auto& entries = indexed.spatialIndex()->entries() ;
+      if( entries.empty() )  {
+        printout(ERROR,"CellIDPositionBenchmark","+++ No sensitive placements found.") ;
+        return 0 ;
+      }
+      // Generate random points inside random sensitive volumes
+      std::mt19937 engine( seed ) ;
+      std::uniform_int_distribution<std::size_t> pick( 0, entries.size()-1 ) ;
+      std::uniform_real_distribution<double>     flat( -1.0, 1.0 ) ;
+      std::vector<Position> points ;
+      points.reserve( num_points ) ;
+      while( points.size() < num_points )  {
+        const auto&     e   = entries[ pick(engine) ] ;
+        const TGeoBBox* box = static_cast<const TGeoBBox*>( e.solid ) ;
+        const Double_t* org = box->GetOrigin() ;
+        double l[3] = { org[0] + flat(engine)*box->GetDX(),
+                        org[1] + flat(engine)*box->GetDY(),
+                        org[2] + flat(engine)*box->GetDZ() } ;
+        if( !e.solid->Contains( l ) )
+          continue ;
+        const double* r = e.rotation ;
+        points.emplace_back( r[0]*l[0] + r[1]*l[1] + r[2]*l[2] + e.translation[0],
+                             r[3]*l[0] + r[4]*l[1] + r[5]*l[2] + e.translation[1],
+                             r[6]*l[0] + r[7]*l[1] + r[8]*l[2] + e.translation[2] ) ;
+      }
+
+      std::vector<CellID> ref( num_points ), single( num_points ), batch( num_points ) ;
+      start = std::chrono::steady_clock::now() ;
+      for( std::size_t i=0 ; i < num_points ; ++i )
+        ref[i] = navigator.cellID( points[i] ) ;
+      double t_nav = elapsed( start ) ;
+
+      start = std::chrono::steady_clock::now() ;
+      for( std::size_t i=0 ; i < num_points ; ++i )
+        single[i] = indexed.cellID( points[i] ) ;
+      double t_single = elapsed( start ) ;
+
+      start = std::chrono::steady_clock::now() ;
+      indexed.cellIDs( num_points, &points[0], &batch[0] ) ;
+      double t_batch = elapsed( start ) ;
+
+      std::size_t num_diff = 0 ;
+      for( std::size_t i=0 ; i < num_points ; ++i )  {
+        if( ref[i] != single[i] || ref[i] != batch[i] )  {
+          if( ++num_diff <= 10 )  {
+            printout(ERROR,"CellIDPositionBenchmark","+++ Point (%g,%g,%g): navigator %016llX index %016llX batch %016llX",
+                     points[i].X(), points[i].Y(), points[i].Z(), (unsigned long long)ref[i],
+                     (unsigned long long)single[i], (unsigned long long)batch[i]) ;
+          }
+        }
+      }
+      printout(ALWAYS,"CellIDPositionBenchmark","+++ Index: %ld sensitive placements, %ld BVH nodes built in %.3f sec.",
+               long(entries.size()), long(indexed.spatialIndex()->nodes().size()), t_build) ;
+      printout(ALWAYS,"CellIDPositionBenchmark","+++ %ld points:  navigator: %8.3f usec/point", long(num_points), 1e6*t_nav/num_points) ;
+      printout(ALWAYS,"CellIDPositionBenchmark","+++ %ld points:  index:     %8.3f usec/point", long(num_points), 1e6*t_single/num_points) ;
+      printout(ALWAYS,"CellIDPositionBenchmark","+++ %ld points:  batch:     %8.3f usec/point", long(num_points), 1e6*t_batch/num_points) ;
+      printout(num_diff ? ERROR : ALWAYS,"CellIDPositionBenchmark","+++ %ld of %ld cellIDs differ from the navigator result.",
+               long(num_diff), long(num_points)) ;
+      return 1 ;
+    }
+  }
+}
+
+DECLARE_APPLY( DD4hep_CellIDPositionBenchmark, dd4hep::rec::cellid_position_benchmark )
@@ -0,0 +1,134 @@
+#include "DD4hep/DDTest.h"
+#include "DDDigi/DigiArena.h"
+#include "DDDigi/DigiData.h"
+
+#include <cmath>
+#include <exception>
+#include <utility>
+#include <vector>
+
+using namespace dd4hep::digi;
+
+namespace {
+
+  /// Cell identifier and energy of a deposit
+  typedef std::vector<std::pair<CellID, double> > Entries ;
+
+  EnergyDeposit deposit(double energy) {
+    EnergyDeposit dep ;
+    dep.deposit      = energy ;
+    dep.depositError = 0.1*energy ;
+    dep.position     = Position( energy, 0e0, 0e0 ) ;
+    return dep ;
+  }
+
+  template <typename CONTAINER> void fill(CONTAINER& cont, const Entries& entries) {
+    for( const auto& e : entries ) cont.emplace( e.first, deposit(e.second) ) ;
+  }
+
+  template <typename CONTAINER> Entries entries(const CONTAINER& cont) {
+    Entries result ;
+    for( const auto& e : cont ) result.emplace_back( e.first, e.second.deposit ) ;
+    return result ;
+  }
+
+  const Entries existing = { {1, 1.0}, {3, 2.0}, {3, 5.0}, {5, 4.0} } ;
+  const Entries updates  = { {4, 1.0}, {3, 0.5}, {1, 2.0}, {3, 1.5}, {0, 7.0}, {4, 2.0} } ;
+}
+
+int main() {
+
+  dd4hep::DDTest test( "DigiDeposits" );
+
+  try{
+    // merge: updates of existing cells are folded into the first deposit of the cell
+    {
+      DepositSortedVector sorted( "sorted", 0, SegmentEntry::TRACKER_HITS ) ;
+      DepositVector       input ( "input",  0, SegmentEntry::TRACKER_HITS ) ;
+      fill( sorted, existing ) ;
+      fill( input,  updates ) ;
+      test( sorted.merge( std::move(input) ), updates.size(), "merge: number of updates" ) ;
+      Entries expected = { {0, 7.0}, {1, 3.0}, {3, 4.0}, {3, 5.0}, {4, 3.0}, {5, 4.0} } ;
+      test( entries( sorted ) == expected, true, "merge: sorted cells and combined deposits" ) ;
+      test( std::abs( sorted.get(3).depositError - 0.4 ) < 1e-12, true, "merge: errors of the first deposit summed" ) ;
+      test( std::abs( sorted.get(3).position.X() - 1.625 ) < 1e-12, true, "merge: position weighted by the deposits" ) ;
+
+      // Same result as the DepositMapping
+      DepositMapping mapping( "mapping", 0, SegmentEntry::TRACKER_HITS ) ;
+      DepositVector  again  ( "input",   0, SegmentEntry::TRACKER_HITS ) ;
+      fill( mapping, existing ) ;
+      fill( again,   updates ) ;
+      mapping.merge( std::move(again) ) ;
+      test( entries( sorted ) == entries( mapping ), true, "merge: identical to the deposit mapping" ) ;
+
+      // Sorted updates: input container is consumed
+      DepositSortedVector more( "more", 0, SegmentEntry::TRACKER_HITS ) ;
+      fill( more, { {5, 1.0}, {9, 2.0} } ) ;
+      test( sorted.merge( std::move(more) ), std::size_t(2), "merge sorted: number of updates" ) ;
+      test( more.empty(), true, "merge sorted: updates consumed" ) ;
+      test( sorted.size(), std::size_t(7), "merge sorted: one new cell" ) ;
+      test( sorted.get(5).deposit, 5.0, "merge sorted: existing cell combined" ) ;
+      test( sorted.find(2) == sorted.end(), true, "find: unknown cell" ) ;
+      auto range = sorted.equal_range(3) ;
+      test( std::size_t(range.second-range.first), std::size_t(2), "equal_range: deposits of one cell" ) ;
+
+      bool thrown = false ;
+      try  {  sorted.get(2) ;  }  catch( const std::exception& )  {  thrown = true ;  }
+      test( thrown, true, "get: unknown cell throws" ) ;
+    }
+
+    // insert: all deposits are kept. Equal cells: existing first, then the updates in their order
+    {
+      DepositSortedVector sorted( "sorted", 0, SegmentEntry::TRACKER_HITS ) ;
+      DepositVector       input ( "input",  0, SegmentEntry::TRACKER_HITS ) ;
+      fill( sorted, existing ) ;
+      fill( input,  { {3, 9.0}, {2, 8.0}, {3, 10.0}, {7, 1.0} } ) ;
+      test( sorted.insert( input ), std::size_t(4), "insert: number of updates" ) ;
+      test( input.size(), std::size_t(4), "insert: input kept" ) ;
+      Entries expected = { {1, 1.0}, {2, 8.0}, {3, 2.0}, {3, 5.0}, {3, 9.0}, {3, 10.0}, {5, 4.0}, {7, 1.0} } ;
+      test( entries( sorted ) == expected, true, "insert: sorted and stable" ) ;
+
+      DepositMapping mapping( "mapping", 0, SegmentEntry::TRACKER_HITS ) ;
+      fill( mapping, { {0, 1.0}, {3, 11.0} } ) ;
+      sorted.insert( mapping ) ;
+      test( sorted.size(), std::size_t(10), "insert mapping: all deposits kept" ) ;
+      test( sorted.begin()->first, CellID(0), "insert mapping: new first cell" ) ;
+      test( (sorted.equal_range(3).second-1)->second.deposit, 11.0, "insert mapping: appended to the equal cells" ) ;
+    }
+
+    // The deposits are allocated from the arena given at construction
+    {
+      DigiArena arena( true, 1024 ) ;
+      DepositSortedVector sorted( "sorted", 0, SegmentEntry::TRACKER_HITS, &arena ) ;
+      for( int i=0 ; i<1000 ; ++i ) sorted.emplace( CellID(999-i), deposit(1.0) ) ;
+      const auto& counters = arena.counters() ;
+      test( counters.bytes >= 1000*sizeof(DepositSortedVector::value_type), true, "arena: deposits allocated from the arena" ) ;
+
+      std::size_t allocations = counters.allocations ;
+      DepositVector input( "input", 0, SegmentEntry::TRACKER_HITS ) ;
+      fill( input, { {10, 1.0}, {2000, 1.0} } ) ;
+      sorted.merge( std::move(input) ) ;
+      test( counters.allocations > allocations, true, "arena: merged deposits allocated from the arena" ) ;
+      test( sorted.size(), std::size_t(1001), "arena: merged deposits" ) ;
+
+      // Data segments keep the resource of the moved container
+      DigiEvent event( 1, true ) ;
+      DepositSortedVector deposits( "deposits", 0, SegmentEntry::TRACKER_HITS, &event.arena() ) ;
+      fill( deposits, existing ) ;
+      const auto* payload = &*deposits.begin() ;
+      std::size_t bytes   = event.arena().counters().bytes ;
+      test( bytes >= existing.size()*sizeof(DepositSortedVector::value_type), true, "segment: payload in the event arena" ) ;
+      Key key( "deposits", 0 ) ;
+      auto& segment = event.get_segment( "inputs" ) ;
+      segment.put( key, std::move(deposits) ) ;
+      const auto& stored = segment.get<DepositSortedVector>( key ) ;
+      test( &*stored.begin() == payload, true, "segment: payload moved without copy" ) ;
+      test( entries( stored ) == existing, true, "segment: deposits stored" ) ;
+    }
+  } catch( std::exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+  return 0;
+}
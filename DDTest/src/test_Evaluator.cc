@@ -6,6 +6,8 @@
 #include <array>
 
 #include <atomic>
+#include <chrono>
+#include <sstream>
 #include <thread>
 
 #include "Evaluator/Evaluator.h"
@@ -81,6 +83,52 @@ int main(int /* argc */, char** /* argv */ ){
       test( r.first, Evaluator::OK, " status OK");
     }
     
+    {
+      // Literals, cached expressions and the interpreter must give identical results
+      Evaluator e_ref, e_fast;
+      e_ref.setCaching(false);
+      const char* expressions[] = { "5.2", " -5.2 ", "+3", "-0", ".5", "1e5", "0x1A", "1e400",
+                                    "2*layer_thickness", "nested", "nested/cm", "sin(30*deg)",
+                                    "2^3^2", "-2^2", "1/0", "7_", "unknown*2", "" };
+      bool same = true;
+      for( int pass=0; pass<3; ++pass ){
+        for( Evaluator* ev : { &e_ref, &e_fast } ){
+          ev->setVariable("layer_thickness", 1.5 + pass);
+          ev->setVariable("nested", pass < 2 ? "2*layer_thickness+cm" : "3*layer_thickness");
+        }
+        for( const char* expr : expressions ){
+          auto r = e_ref.evaluate(expr), f = e_fast.evaluate(expr);
+          same &= r.first == f.first && ( r.first != Evaluator::OK || r.second == f.second );
+        }
+      }
+      test( same, true, " cached evaluation identical to the interpreter");
+      Evaluator::Statistics stat = e_fast.statistics();
+      test( stat.literals > 0, true, " literal conversion used");
+      test( stat.cached > 0, true, " cached expressions used");
+      test( stat.invalidated > 0, true, " cached expressions invalidated by redefinition");
+      test( e_ref.statistics().cached + e_ref.statistics().literals, 0L, " caching disabled");
+
+      // Micro-benchmark: typical compact attribute values
+      const char* attributes[] = { "5.2", "0.3*mm", "2*layer_thickness", "-12.5",
+                                   "(layer_thickness+1*cm)/2", "360*deg/24", "1000" };
+      const int num_loops = 20000;
+      double t[2], sum[2];
+      for( int i=0; i<2; ++i ){
+        Evaluator& ev = i == 0 ? e_ref : e_fast;
+        auto start = std::chrono::steady_clock::now();
+        sum[i] = 0.0;
+        for( int loop=0; loop<num_loops; ++loop )
+          for( const char* attr : attributes )
+            sum[i] += ev.evaluate(attr).second;
+        t[i] = std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count();
+      }
+      test( sum[0], sum[1], " benchmark: identical results");
+      double norm = 1e9 / double(num_loops) / double(sizeof(attributes)/sizeof(attributes[0]));
+      std::stringstream str;
+      str << "nsec/evaluation: interpreter: " << t[0]*norm << "  literals and cache: " << t[1]*norm;
+      test.log( str.str() );
+    }
+
     {
       //use cm as length
       Evaluator e_cm(100.);
@@ -0,0 +1,194 @@
+#include "DD4hep/DDTest.h"
+#include "DD4hep/Detector.h"
+#include "DD4hep/Plugins.h"
+#include "DD4hep/Primitives.h"
+#include "DDG4/Geant4Context.h"
+#include "DDG4/Geant4InputAction.h"
+#include "DDG4/Geant4Kernel.h"
+#include "DDG4/Geant4Particle.h"
+#include "DDG4/Geant4Primary.h"
+#include "DDG4/Geant4TextEventFile.h"
+#include "DDG4/Geant4Vertex.h"
+
+#include "G4Event.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace dd4hep::sim;
+typedef Geant4EventReader Reader;
+
+namespace {
+
+  /// Number of scanner calls: zero if the sidecar index was used
+  int num_scans = 0;
+
+  /// Scanner of the test format: every event starts with a line 'E'
+  std::size_t scan(std::string_view data, std::size_t pos) {
+    ++num_scans ;
+    if( pos == std::string_view::npos && !data.empty() && data[0] == 'E' )
+      return 0 ;
+    std::size_t next = data.find( "\nE", pos == std::string_view::npos ? 0 : pos ) ;
+    return next == std::string_view::npos ? data.size() : next + 1 ;
+  }
+
+  /// Append events with the identifiers [first, last) to a file
+  void write_events(const std::string& name, int first, int last) {
+    std::ofstream out( name, std::ios::out|std::ios::app ) ;
+    for( int i=first ; i<last ; ++i )
+      out << "E " << i << "\n  particle " << i << " 1\n  particle " << i << " 2\n" ;
+  }
+
+  /// Open the file, access all events and return the number of events
+  std::size_t open_file(const std::string& name, const std::string& tag, const std::string& index, bool& correct) {
+    num_scans = 0 ;
+    auto file = Geant4TextEventFile::open( name, tag, scan, index ) ;
+    std::size_t num_events = file->numEvents() ;
+    correct = true ;
+    for( std::size_t i=0 ; i<num_events ; ++i ){
+      std::string_view data ;
+      correct &= file->event( i, data ) && data.substr( 0, data.find('\n') ) == "E "+std::to_string(i) ;
+    }
+    return num_events ;
+  }
+
+  /// Read an event with a reader
+  std::vector<Geant4Particle*> read_event(Reader* reader, int event_number, Reader::EventReaderStatus& sc) {
+    std::vector<Geant4Particle*> particles ;
+    std::vector<Geant4Vertex*> vertices ;
+    sc = reader->readParticles( event_number, vertices, particles ) ;
+    std::for_each( vertices.begin(), vertices.end(), dd4hep::detail::deleteObject<Geant4Vertex> ) ;
+    return particles ;
+  }
+
+  void release(std::vector<Geant4Particle*>& particles) {
+    for( Geant4Particle* p : particles ) p->release() ;
+    particles.clear() ;
+  }
+}
+
+int main(int argc, char** argv ){
+
+  dd4hep::DDTest test( "EventIndex" ) ;
+
+  if( argc < 2 ) {
+    std::cout << " usage:  test_EventIndex Path/To/InputFiles " << std::endl ;
+    exit(1) ;
+  }
+
+  try{
+    // Sidecar index: creation, reuse and invalidation
+    {
+      const std::string name  = "test_EventIndex.dat" ;
+      const std::string index = Geant4TextEventFile::indexFileName( "auto", name ) ;
+      std::remove( name.c_str() ) ;
+      std::remove( index.c_str() ) ;
+      write_events( name, 0, 20 ) ;
+      bool correct = false ;
+
+      test( open_file( name, "Test", index, correct ), std::size_t(20), "index: number of events" ) ;
+      test( correct && num_scans > 0, true, "index: built by scanning the file" ) ;
+      test( std::ifstream( index ).good(), true, "index: sidecar file written" ) ;
+
+      test( open_file( name, "Test", index, correct ), std::size_t(20), "reuse: number of events" ) ;
+      test( correct && num_scans == 0, true, "reuse: sidecar index used without scanning" ) ;
+
+      // A different format must not use the index of another reader
+      test( open_file( name, "Other", index, correct ), std::size_t(20), "tag changed: number of events" ) ;
+      test( correct && num_scans > 0, true, "tag changed: index rebuilt" ) ;
+
+      // A changed data file invalidates the index
+      write_events( name, 20, 25 ) ;
+      test( open_file( name, "Test", index, correct ), std::size_t(25), "file changed: number of events" ) ;
+      test( correct && num_scans > 0, true, "file changed: index rebuilt" ) ;
+      test( open_file( name, "Test", index, correct ), std::size_t(25), "file changed: number of events again" ) ;
+      test( correct && num_scans == 0, true, "file changed: rebuilt index reused" ) ;
+
+      // A corrupted index is ignored
+      std::ofstream( index, std::ios::out|std::ios::trunc ) << "garbage" ;
+      test( open_file( name, "Test", index, correct ), std::size_t(25), "corrupted: number of events" ) ;
+      test( correct && num_scans > 0, true, "corrupted: index rebuilt" ) ;
+
+      std::remove( name.c_str() ) ;
+      std::remove( index.c_str() ) ;
+    }
+
+    // GuineaPig pairs: without 'ParticlesPerEvent' the file holds exactly one event
+    {
+      const std::string name = "test_EventIndex.pairs" ;
+      std::remove( name.c_str() ) ;
+      {
+        std::ofstream out( name ) ;
+        for( int i=0 ; i<10 ; ++i )
+          out << ( i%2 ? -1.5 : 2.5 ) << " 0.1 0.2 0.97 " << i << " " << -i << " 1.0\n" ;
+      }
+      std::map<std::string, std::string> params ;
+      Reader* reader = dd4hep::PluginService::Create<Reader*>( "Geant4EventReaderGuineaPig", name ) ;
+      reader->setParameters( params ) ;
+      Reader::EventReaderStatus sc ;
+      std::vector<Geant4Particle*> particles = read_event( reader, 0, sc ) ;
+      test( sc == Reader::EVENT_READER_OK && particles.size() == 10, true, "GuineaPig: all particles in event 0" ) ;
+      release( particles ) ;
+      test( reader->moveToEvent( 1 ) == Reader::EVENT_READER_EOF, true, "GuineaPig: event 1 is EOF" ) ;
+      delete reader ;
+
+      params["ParticlesPerEvent"] = "4" ;
+      reader = dd4hep::PluginService::Create<Reader*>( "Geant4EventReaderGuineaPig", name ) ;
+      reader->setParameters( params ) ;
+      test( reader->moveToEvent( 2 ) == Reader::EVENT_READER_OK, true, "GuineaPig: move to event 2" ) ;
+      particles = read_event( reader, 2, sc ) ;
+      test( sc == Reader::EVENT_READER_OK && particles.size() == 2, true, "GuineaPig: last event partially filled" ) ;
+      release( particles ) ;
+      test( reader->moveToEvent( 3 ) == Reader::EVENT_READER_EOF, true, "GuineaPig: event 3 is EOF" ) ;
+      delete reader ;
+      std::remove( name.c_str() ) ;
+    }
+
+    // UseEventID: the input action reads the event given by the Geant4 event identifier
+    {
+      const std::string type = "Geant4EventReaderHepEvtShort" ;
+      const std::string name = argv[1] + std::string("/inputFiles/Muons10GeV.HEPEvt") ;
+      Geant4Kernel&      kernel  = Geant4Kernel::instance( dd4hep::Detector::getInstance() ) ;
+      Geant4Context*     context = kernel.workerContext() ;
+      Geant4InputAction* input   = new Geant4InputAction( context, "Input" ) ;
+      input->property( "Input" ).set( type+"|"+name ) ;
+      input->property( "UseEventID" ).set( true ) ;
+      Reader* reader = dd4hep::PluginService::Create<Reader*>( type, name ) ;
+
+      for( int evt_id : { 7, 2, 11, 2 } ){
+        G4Event     g4_event( evt_id ) ;
+        Geant4Event event( &g4_event, nullptr ) ;
+        event.addExtension( new Geant4PrimaryEvent() ) ;
+        context->setEvent( &event ) ;
+        (*input)( &g4_event ) ;
+        const Geant4PrimaryInteraction* inter = event.extension<Geant4PrimaryEvent>()->get( 0 ) ;
+
+        Reader::EventReaderStatus sc ;
+        std::vector<Geant4Particle*> particles = read_event( reader, evt_id, sc ) ;
+        bool same = sc == Reader::EVENT_READER_OK && inter && !particles.empty()
+          && inter->particles.size() == particles.size() ;
+        if( same ){
+          const Geant4Particle* p = inter->particles.begin()->second ;
+          same = p->psx == particles[0]->psx && p->psy == particles[0]->psy && p->psz == particles[0]->psz ;
+        }
+        test( same, true, "UseEventID: event "+std::to_string(evt_id)+" read by identifier" ) ;
+        test( g4_event.GetEventID(), evt_id, "UseEventID: event identifier unchanged" ) ;
+        release( particles ) ;
+        context->setEvent( nullptr ) ;
+      }
+      delete reader ;
+      input->release() ;
+    }
+  } catch( std::exception &e ){
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+  return 0;
+}
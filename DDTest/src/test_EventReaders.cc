@@ -42,6 +42,7 @@ int main(int argc, char** argv ){
   tests.push_back( TestTuple( "LCIOFileReader",   "muons.slcio" , /*skipEOF= */ true ) );
   #endif
   tests.push_back( TestTuple( "Geant4EventReaderHepEvtShort", "Muons10GeV.HEPEvt" ) );
+  tests.push_back( TestTuple( "Geant4EventReaderHepMC", "g4pythia.hepmc" ) );
   #ifdef DD4HEP_USE_HEPMC3
   tests.push_back( TestTuple( "HEPMC3FileReader", "g4pythia.hepmc", /*skipEOF= */ true) );
   tests.push_back( TestTuple( "HEPMC3FileReader", "Pythia_output.hepmc", /*skipEOF= */ true) );
@@ -71,10 +72,27 @@ int main(int argc, char** argv ){
       std::vector<Particle*> particles;
       std::vector<Vertex*> vertices ;
       dd4hep::sim::Geant4EventReader::EventReaderStatus sc = thisReader->readParticles(2,vertices,particles);
+      std::size_t numParticles = particles.size();
       std::for_each(particles.begin(),particles.end(),dd4hep::detail::deleteObject<Particle>);
       test( thisReader->currentEventNumber() == 2 && sc == dd4hep::sim::Geant4EventReader::EVENT_READER_OK,
             readerType + std::string("Event Number Read") );
 
+      //Direct access: read an earlier event and the same event again
+      if (thisReader->hasDirectAccess()) {
+        for(int evt : {0, 2}) {
+          particles.clear();
+          std::for_each(vertices.begin(),vertices.end(),dd4hep::detail::deleteObject<Vertex>);
+          vertices.clear();
+          sc = thisReader->readParticles(evt,vertices,particles);
+          test( thisReader->currentEventNumber() == evt && sc == dd4hep::sim::Geant4EventReader::EVENT_READER_OK,
+                readerType + std::string("Direct Access Read") );
+          if ( evt == 2 ) {
+            test( particles.size() == numParticles, readerType + std::string("Direct Access Same Event") );
+          }
+          std::for_each(particles.begin(),particles.end(),dd4hep::detail::deleteObject<Particle>);
+        }
+      }
+
       //Reset Reader to check what happens if moving too far in the file
       if (not skipEOF) {
         thisReader = dd4hep::PluginService::Create<dd4hep::sim::Geant4EventReader*>(readerType, std::move(inputFile));
@@ -0,0 +1,236 @@
+#include "DD4hep/FieldTypes.h"
+#include "DD4hep/DDTest.h"
+
+#include "TClass.h"
+#include "TFile.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <exception>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace dd4hep;
+
+namespace {
+
+  typedef void (*analytic_t)(const double* u, double* b);
+
+  /// Multilinear cartesian field: reproduced exactly by trilinear interpolation
+  void linear_field(const double* u, double* b) {
+    b[0] = 1.0 + 1e-3*u[0] - 1e-6*u[1]*u[2] ;
+    b[1] = 2.0 - 2e-3*u[1] + 1e-9*u[0]*u[1]*u[2] ;
+    b[2] = 0.5 + 3e-4*u[2] ;
+  }
+
+  /// Smooth solenoid like field in cylindrical components (F_r, F_phi, F_z)
+  void solenoid_field(const double* u, double* b) {
+    double r = u[0], z = u[2] ;
+    b[0] = 0.4 * r * z * std::exp(-z*z/1e6) / 1e6 ;
+    b[1] = 0.0 ;
+    b[2] = 4.0 * std::exp(-z*z/1e6) * (1.0 - r*r/1e7) ;
+  }
+
+  /// Field with 4-fold rotational symmetry in cylindrical components
+  void clover_field(const double* u, double* b) {
+    double r = u[0], phi = u[1] ;
+    b[0] = 1e-4 * r * std::cos(4.0*phi) ;
+    b[1] = 1e-4 * r * std::sin(4.0*phi) ;
+    b[2] = 1.0 ;
+  }
+
+  /// Fill the grid of a field map with the analytic field and write it to file
+  void write_map(const std::string& file, int grid, const int* num,
+                 const double* min, const double* step, analytic_t fun) {
+    FieldMap::header_t hdr {} ;
+    hdr.grid = grid ;
+    std::vector<float> values ;
+    for( int i=0 ; i<3 ; ++i ){
+      hdr.num[i]  = num[i] ;
+      hdr.min[i]  = min[i] ;
+      hdr.step[i] = step[i] ;
+    }
+    for( int i=0 ; i<num[0] ; ++i ){
+      for( int j=0 ; j<num[1] ; ++j ){
+        for( int k=0 ; k<num[2] ; ++k ){
+          double u[3] = { min[0]+i*step[0], min[1]+j*step[1], min[2]+k*step[2] }, b[3] ;
+          fun( u, b ) ;
+          values.insert( values.end(), { float(b[0]), float(b[1]), float(b[2]) } ) ;
+        }
+      }
+    }
+    FieldMap::save( file, hdr, &values[0] ) ;
+  }
+
+  /// Analytic reference in cartesian components
+  void reference(int grid, analytic_t fun, const double* p, double* b) {
+    if( grid == FieldMap::CARTESIAN ){
+      fun( p, b ) ;
+      return ;
+    }
+    double r = std::sqrt( p[0]*p[0] + p[1]*p[1] ), phi = std::atan2( p[1], p[0] ) ;
+    double u[3] = { r, phi, p[2] }, c[3] ;
+    fun( u, c ) ;
+    b[0] = c[0]*std::cos(phi) - c[1]*std::sin(phi) ;
+    b[1] = c[0]*std::sin(phi) + c[1]*std::cos(phi) ;
+    b[2] = c[2] ;
+  }
+
+  /// Maximal deviation from the analytic field at random points inside the cube [-half, half]
+  double max_deviation(FieldMap& map, analytic_t fun, double half, double zmax) {
+    std::mt19937 engine( 4711 ) ;
+    std::uniform_real_distribution<double> xy( -half, half ), z( -zmax, zmax ) ;
+    double dev = 0.0 ;
+    for( int n=0 ; n<20000 ; ++n ){
+      double p[3] = { xy(engine), xy(engine), z(engine) }, b[3] = { 0, 0, 0 }, ref[3] ;
+      if( map.grid != FieldMap::CARTESIAN && p[0]*p[0]+p[1]*p[1] > half*half ) continue ;
+      map.fieldComponents( p, b ) ;
+      reference( map.grid, fun, p, ref ) ;
+      for( int i=0 ; i<3 ; ++i ) dev = std::max( dev, std::abs( b[i]-ref[i] ) ) ;
+    }
+    return dev ;
+  }
+
+  /// Time field evaluations at random points and along straight track segments
+  void throughput(DDTest& test, FieldMap& map, const std::string& tag) {
+    const int num_points = 1000000 ;
+    std::mt19937 engine( 12345 ) ;
+    std::uniform_real_distribution<double> coord( -900.0, 900.0 ) ;
+    std::vector<double> random( 3*num_points ), track( 3*num_points ) ;
+    for( auto& c : random ) c = coord( engine ) ;
+    // Tracks from the origin with 1 mm steps
+    for( int n=0 ; n<num_points ; n += 1000 ){
+      double dir[3] = { coord(engine), coord(engine), coord(engine) } ;
+      double len = std::sqrt( dir[0]*dir[0] + dir[1]*dir[1] + dir[2]*dir[2] ) ;
+      for( int s=0 ; s<1000 && n+s<num_points ; ++s )
+        for( int i=0 ; i<3 ; ++i ) track[3*(n+s)+i] = dir[i]/len * 0.9 * s ;
+    }
+    double sum = 0.0 ;
+    for( const auto* points : { &random, &track } ){
+      double b[3] = { 0, 0, 0 } ;
+      auto start = std::chrono::steady_clock::now() ;
+      for( int n=0 ; n<num_points ; ++n ) map.fieldComponents( &(*points)[3*n], b ) ;
+      std::chrono::duration<double> sec = std::chrono::steady_clock::now() - start ;
+      sum += b[0] + b[1] + b[2] ;
+      std::stringstream str ;
+      str << tag << ( points == &random ? " random points: " : " track steps:   " )
+          << 1e9*sec.count()/num_points << " nsec/evaluation" ;
+      test.log( str.str() ) ;
+    }
+    test( std::isfinite(sum), true, tag + ": finite field values" ) ;
+  }
+}
+
+int main() {
+
+  DDTest test( "FieldMap" );
+
+  try{
+    // Cartesian map [-1000,1000]^3 mm with 20 mm spacing
+    {
+      int    num[3]  = { 101, 101, 101 } ;
+      double min[3]  = { -1000, -1000, -1000 } ;
+      double step[3] = { 20, 20, 20 } ;
+      write_map( "test_FieldMap_cartesian.bin", FieldMap::CARTESIAN, num, min, step, linear_field ) ;
+      FieldMap map ;
+      map.load( "test_FieldMap_cartesian.bin" ) ;
+      test( map.num[0], 101, "cartesian: grid points loaded" ) ;
+      test( max_deviation( map, linear_field, 999.0, 999.0 ) < 1e-5, true,
+            "cartesian: multilinear field reproduced" ) ;
+      double p[3] = { 1500, 0, 0 }, b[3] = { 0, 0, 0 } ;
+      map.fieldComponents( p, b ) ;
+      test( b[0] == 0.0 && b[1] == 0.0 && b[2] == 0.0, true, "cartesian: no field outside the map" ) ;
+
+      // A second map of the same file shares the mapping
+      FieldMap other ;
+      other.load( "test_FieldMap_cartesian.bin" ) ;
+      test( other.values() == map.values(), true, "cartesian: file mapping shared" ) ;
+
+      // ROOT I/O: the values are not persistent and mapped again at the first access
+      TClass* cl = TClass::GetClass( typeid(FieldMap) ) ;
+      TFile*  f  = TFile::Open( "test_FieldMap.root", "RECREATE" ) ;
+      f->WriteObjectAny( &map, cl, "map" ) ;
+      f->Close() ;
+      delete f ;
+      f = TFile::Open( "test_FieldMap.root" ) ;
+      FieldMap* stored = static_cast<FieldMap*>( f->GetObjectChecked( "map", cl ) ) ;
+      test( stored != nullptr && stored->file == map.file, true, "ROOT I/O: field map read" ) ;
+      if( stored ){
+        test( max_deviation( *stored, linear_field, 999.0, 999.0 ) < 1e-5, true,
+              "ROOT I/O: field map file mapped at the first access" ) ;
+        test( stored->values() == map.values(), true, "ROOT I/O: file mapping shared" ) ;
+        delete stored ;
+      }
+      f->Close() ;
+      delete f ;
+      std::remove( "test_FieldMap.root" ) ;
+
+      // A missing file is reported at the first access
+      bool thrown = false ;
+      FieldMap missing ;
+      missing.file = "test_FieldMap_missing.bin" ;
+      try  {
+        double q[3] = { 0, 0, 0 } ;
+        missing.fieldComponents( q, b ) ;
+      }
+      catch( const std::exception& e )  {
+        thrown = std::string( e.what() ).find( "test_FieldMap_missing.bin" ) != std::string::npos ;
+      }
+      test( thrown, true, "missing field map file reported" ) ;
+      throughput( test, map, "cartesian" ) ;
+    }
+    // (r,z) map of the half space z >= 0, mirrored at z = 0 with F_r changing sign
+    {
+      int    num[3]  = { 101, 1, 101 } ;
+      double min[3]  = { 0, 0, 0 } ;
+      double step[3] = { 10, 0, 10 } ;
+      write_map( "test_FieldMap_rz.bin", FieldMap::CYLINDRICAL_RZ, num, min, step, solenoid_field ) ;
+      FieldMap map ;
+      map.load( "test_FieldMap_rz.bin" ) ;
+      map.mirror  = 1<<2 ;
+      map.flip[2] = 1<<0 ;
+      test( max_deviation( map, solenoid_field, 999.0, 999.0 ) < 1e-3, true,
+            "(r,z): interpolation accuracy with z mirror symmetry" ) ;
+      throughput( test, map, "(r,z)" ) ;
+    }
+    // (r,phi,z) map of one quadrant with 4-fold rotational symmetry
+    {
+      int    num[3]  = { 51, 45, 21 } ;
+      double min[3]  = { 0, 0, -1000 } ;
+      double step[3] = { 20, M_PI/2/45, 100 } ;
+      write_map( "test_FieldMap_rphiz.bin", FieldMap::CYLINDRICAL_RPHIZ, num, min, step, clover_field ) ;
+      FieldMap map ;
+      map.load( "test_FieldMap_rphiz.bin" ) ;
+      map.periodic = true ;
+      test( max_deviation( map, clover_field, 999.0, 999.0 ) < 1e-3, true,
+            "(r,phi,z): interpolation accuracy with rotational symmetry" ) ;
+    }
+    // Invalid files must be rejected
+    {
+      bool thrown = false ;
+      std::FILE* f = std::fopen( "test_FieldMap_invalid.bin", "w" ) ;
+      std::fputs( "this is not a field map, but it is long enough to hold a header of a field map", f ) ;
+      std::fclose( f ) ;
+      try  {
+        FieldMap map ;
+        map.load( "test_FieldMap_invalid.bin" ) ;
+      }
+      catch( ... )  {
+        thrown = true ;
+      }
+      test( thrown, true, "invalid field map file rejected" ) ;
+    }
+    for( const char* f : { "test_FieldMap_cartesian.bin", "test_FieldMap_rz.bin",
+                           "test_FieldMap_rphiz.bin", "test_FieldMap_invalid.bin" } )
+      std::remove( f ) ;
+
+  } catch( std::exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+  return 0;
+}
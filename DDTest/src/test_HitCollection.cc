@@ -0,0 +1,196 @@
+#include "DD4hep/DDTest.h"
+#include "DDG4/Geant4Data.h"
+#include "DDG4/Geant4HitCollection.h"
+
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <map>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace dd4hep::sim;
+typedef Geant4Calorimeter::Hit CaloHit;
+
+namespace {
+
+  /// Recorded calorimeter step: cell identifier and Monte Carlo contribution
+  struct Step {
+    dd4hep::VolumeID cell ;
+    int    track ;
+    double deposit ;
+    double time ;
+  };
+
+  /// Record a shower like step stream: tracks deposit energy in neighbouring cells
+  /** The cell identifiers follow the usual layout: volume identifier in the
+   *  lower 32 bits, segmentation bins (x,y) in the upper 32 bits.
+   */
+  std::vector<Step> record_steps(int num_tracks, int steps_per_track) {
+    std::mt19937 engine( 4711 ) ;
+    std::normal_distribution<double> spread( 0.0, 6.0 ) ;
+    std::uniform_int_distribution<int> layer( 0, 39 ), move( -1, 1 ) ;
+    std::exponential_distribution<double> deposit( 10.0 ) ;
+    std::vector<Step> steps ;
+    steps.reserve( num_tracks*steps_per_track ) ;
+    for( int t=0 ; t<num_tracks ; ++t ){
+      long x = std::lround( spread(engine) ), y = std::lround( spread(engine) ), l = layer( engine ) ;
+      for( int s=0 ; s<steps_per_track ; ++s ){
+        if( s%4 == 3 ){ x += move(engine) ; y += move(engine) ; }
+        if( s%8 == 7 && l < 39 ) ++l ;
+        dd4hep::VolumeID vol  = 0x3 | (dd4hep::VolumeID(l) << 8) ;
+        dd4hep::VolumeID bins = (dd4hep::VolumeID(x & 0xFFFF) << 16) | dd4hep::VolumeID(y & 0xFFFF) ;
+        steps.push_back( Step{ vol | (bins << 32), t+1, deposit(engine), 0.1*s } ) ;
+      }
+    }
+    return steps ;
+  }
+
+  /// Contribution of a recorded step
+  Geant4HitData::Contribution contribution(const Step& s) {
+    double pos[3] = { 0, 0, 0 }, mom[3] = { 0, 0, 0 } ;
+    return Geant4HitData::Contribution( s.track, 22, s.deposit, s.time, 0.0, pos, mom ) ;
+  }
+
+  /// Replay the step stream through a hit collection as the calorimeter action does
+  double replay(Geant4HitCollection& coll, const std::vector<Step>& steps) {
+    double total = 0.0 ;
+    for( const Step& s : steps ){
+      CaloHit* hit = coll.findByKey<CaloHit>( s.cell ) ;
+      if( !hit ){
+        hit = new CaloHit( dd4hep::Position() ) ;
+        hit->cellID = s.cell ;
+        coll.add( s.cell, hit ) ;
+      }
+      hit->truth.emplace_back( contribution(s) ) ;
+      hit->energyDeposit += s.deposit ;
+      total += s.deposit ;
+    }
+    return total ;
+  }
+
+  /// Reference: the former std::map key index with individually allocated hits
+  struct Reference {
+    std::map<dd4hep::VolumeID, std::size_t> keys ;
+    std::vector<std::unique_ptr<Geant4HitData::Contributions> > truth ;
+    std::vector<double> deposits ;
+    void replay(const std::vector<Step>& steps) {
+      for( const Step& s : steps ){
+        auto ret = keys.emplace( s.cell, deposits.size() ) ;
+        if( ret.second ){
+          truth.emplace_back( new Geant4HitData::Contributions() ) ;
+          deposits.push_back( 0.0 ) ;
+        }
+        truth[ret.first->second]->emplace_back( contribution(s) ) ;
+        deposits[ret.first->second] += s.deposit ;
+      }
+    }
+  };
+
+  /// Derived hit class: not served by the hit memory pool
+  struct BigHit : public CaloHit {
+    double extra[16] ;
+    BigHit() : CaloHit() { extra[0] = extra[15] = 1.0 ; }
+  };
+
+  double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count() ;
+  }
+}
+
+int main() {
+
+  dd4hep::DDTest test( "HitCollection" );
+
+  try{
+    const int num_events = 10 ;
+    std::vector<Step> steps = record_steps( 2000, 64 ) ;
+
+    // Correctness against the reference index
+    Reference ref ;
+    ref.replay( steps ) ;
+    {
+      Geant4HitCollection coll( "Calo", "CaloHits", nullptr, (CaloHit*)nullptr ) ;
+      replay( coll, steps ) ;
+      test( coll.GetSize(), ref.deposits.size(), "replay: number of hits" ) ;
+      bool same = true ;
+      for( const auto& k : ref.keys ){
+        CaloHit* hit = coll.findByKey<CaloHit>( k.first ) ;
+        same &= hit && hit->cellID == k.first && hit->truth.size() == ref.truth[k.second]->size()
+          && std::abs( hit->energyDeposit - ref.deposits[k.second] ) < 1e-9 ;
+      }
+      test( same, true, "replay: hits identical to the std::map reference" ) ;
+      test( coll.findByKey<CaloHit>( 0x1234 ) == nullptr, true, "replay: unknown key not found" ) ;
+
+      bool thrown = false ;
+      CaloHit* duplicate = new CaloHit() ;
+      try  {
+        coll.add( steps[0].cell, duplicate ) ;
+      }
+      catch( const std::exception& )  {
+        thrown = true ;
+      }
+      delete duplicate ;
+      test( thrown, true, "replay: duplicate key rejected" ) ;
+
+      // Released hits are owned by the caller; the index must be empty afterwards
+      std::vector<CaloHit*> hits = coll.releaseHits<CaloHit>() ;
+      test( hits.size(), ref.deposits.size(), "release: all hits returned" ) ;
+      test( coll.findByKey<CaloHit>( steps[0].cell ) == nullptr, true, "release: index cleared" ) ;
+      for( CaloHit* h : hits ) delete h ;
+    }
+    // Hits of derived classes are allocated from the heap
+    {
+      Geant4HitCollection coll( "Calo", "BigHits", nullptr, (CaloHit*)nullptr ) ;
+      for( int i=0 ; i<1000 ; ++i ) coll.add( dd4hep::VolumeID(i), new BigHit() ) ;
+      BigHit* hit = static_cast<BigHit*>( coll.findByKey<CaloHit>( 999 ) ) ;
+      test( hit != nullptr && hit->extra[15] == 1.0, true, "derived hits: allocation and lookup" ) ;
+    }
+
+    // Micro-benchmark: replay the recorded stream for several events
+    double t_ref = 0.0, t_coll = 0.0, t_reserved = 0.0, sum = 0.0 ;
+    std::size_t previous = 0 ;
+    for( int evt=0 ; evt<num_events ; ++evt ){
+      auto start = std::chrono::steady_clock::now() ;
+      {
+        Reference r ;
+        r.replay( steps ) ;
+        sum += r.deposits.size() ;
+      }
+      t_ref += seconds_since( start ) ;
+
+      start = std::chrono::steady_clock::now() ;
+      {
+        Geant4HitCollection coll( "Calo", "CaloHits", nullptr, (CaloHit*)nullptr ) ;
+        sum += replay( coll, steps ) ;
+      }
+      t_coll += seconds_since( start ) ;
+
+      // As the sensitive detector sequence: reserve with the size of the previous event
+      start = std::chrono::steady_clock::now() ;
+      {
+        Geant4HitCollection coll( "Calo", "CaloHits", nullptr, (CaloHit*)nullptr ) ;
+        coll.reserve( previous ) ;
+        sum += replay( coll, steps ) ;
+        previous = coll.GetSize() ;
+      }
+      t_reserved += seconds_since( start ) ;
+    }
+    double norm = 1e9 / double(num_events) / double(steps.size()) ;
+    std::stringstream str ;
+    str << steps.size() << " steps, " << ref.deposits.size() << " hits per event. nsec/step: "
+        << "std::map index: " << t_ref*norm << "  flat index: " << t_coll*norm
+        << "  flat index reserved: " << t_reserved*norm ;
+    test.log( str.str() ) ;
+    test( std::isfinite(sum), true, "benchmark: replay finished" ) ;
+
+  } catch( std::exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+  return 0;
+}
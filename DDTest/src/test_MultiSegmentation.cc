@@ -0,0 +1,88 @@
+#include "DDSegmentation/CartesianGridXY.h"
+#include "DDSegmentation/MultiSegmentation.h"
+#include "DD4hep/DDTest.h"
+
+#include <exception>
+#include <random>
+#include <string>
+
+using namespace dd4hep;
+using namespace DDSegmentation;
+
+namespace {
+
+  /// Reference: linear search over the sub-segmentation ranges
+  int linearIndex(const MultiSegmentation& multi, long key) {
+    const MultiSegmentation::Segmentations& segs = multi.subSegmentations() ;
+    for( size_t i=0 ; i < segs.size() ; ++i ){
+      if( segs[i].key_min <= key && segs[i].key_max >= key )
+        return int(i) ;
+    }
+    return -1 ;
+  }
+
+  /// Fill the multi segmentation with random, partly overlapping key ranges
+  void compare(DDTest& test, long keySpan, int nRanges, const std::string& tag) {
+    BitFieldCoder bf( "system:8,layer:-24,x:32:-16,y:-16" ) ;
+    MultiSegmentation multi( &bf ) ;
+    multi.parameter( "key" )->setValue( "layer" ) ;
+
+    std::mt19937 engine( 4711 ) ;
+    std::uniform_int_distribution<long> start( -keySpan/2, keySpan/2 ) ;
+    std::uniform_int_distribution<long> width( 0, keySpan/nRanges ) ;
+    for( int i=0 ; i < nRanges ; ++i ){
+      long kmin = start( engine ) ;
+      multi.addSubsegmentation( kmin, kmin + width( engine ), new CartesianGridXY( &bf ) ) ;
+    }
+    multi.setDecoder( &bf ) ;
+
+    size_t nBad = 0, nFound = 0 ;
+    for( long key = -keySpan/2 - 10 ; key <= keySpan/2 + keySpan/nRanges + 10 ; ++key ){
+      int ref = linearIndex( multi, key ) ;
+      if( multi.subsegmentationIndexByKey( key ) != ref ) ++nBad ;
+      if( ref < 0 ) continue ;
+      CellID cell = 0 ;
+      bf.set( cell, "layer", key ) ;
+      if( multi.subsegmentationIndex( cell ) != size_t(ref) ) ++nBad ;
+      if( &multi.subsegmentation( cell ) != multi.subSegmentations()[ref].segmentation ) ++nBad ;
+      ++nFound ;
+    }
+    test( nBad, size_t(0), tag + ": dispatch identical to linear search" ) ;
+    test( nFound > 0, true, tag + ": keys with sub-segmentation found" ) ;
+  }
+}
+
+int main() {
+
+  DDTest test( "MultiSegmentation" );
+
+  try{
+    // Dense: few keys, dispatch through the jump table
+    compare( test, 200, 40, "dense" ) ;
+    // Sparse: wide key span, dispatch through the interval search
+    compare( test, 200000, 50, "sparse" ) ;
+
+    // Keys without sub-segmentation must throw as before
+    BitFieldCoder bf( "system:8,layer:8,x:32:-16,y:-16" ) ;
+    MultiSegmentation multi( &bf ) ;
+    multi.parameter( "key" )->setValue( "layer" ) ;
+    multi.addSubsegmentation( 1, 3, new CartesianGridXY( &bf ) ) ;
+    multi.setDecoder( &bf ) ;
+    CellID cell = 0 ;
+    bf.set( cell, "layer", 4 ) ;
+    bool thrown = false ;
+    try  {
+      multi.subsegmentation( cell ) ;
+    }
+    catch( ... )  {
+      thrown = true ;
+    }
+    test( thrown, true, "invalid sub-segmentation identifier" ) ;
+
+  } catch( std::exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+  return 0;
+}
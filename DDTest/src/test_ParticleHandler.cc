@@ -0,0 +1,184 @@
+#include "DD4hep/DDTest.h"
+#include "DD4hep/Detector.h"
+#include "DDG4/Geant4Context.h"
+#include "DDG4/Geant4Kernel.h"
+#include "DDG4/Geant4Particle.h"
+#include "DDG4/Geant4ParticleHandler.h"
+#include "DDG4/Geant4Primary.h"
+
+#include "G4Electron.hh"
+#include "G4Event.hh"
+#include "G4Gamma.hh"
+
+#include <exception>
+#include <map>
+#include <set>
+#include <vector>
+
+using namespace dd4hep::sim;
+
+namespace {
+
+  /// Particle handler exposing the track index for the test
+  class Handler : public Geant4ParticleHandler {
+  public:
+    using Geant4ParticleHandler::Geant4ParticleHandler;
+    using Geant4ParticleHandler::storeParticle;
+    using Geant4ParticleHandler::trackParticle;
+    using Geant4ParticleHandler::m_trackIndex;
+    using Geant4ParticleHandler::m_trackIndexSize;
+    using Geant4ParticleHandler::m_particleMap;
+    using Geant4ParticleHandler::m_equivalentTracks;
+  };
+
+  /// Derived particle class: not served by the particle memory pool
+  struct BigParticle : public Geant4Particle {
+    double extra[16] ;
+    BigParticle() : Geant4Particle() { extra[0] = extra[15] = 1.0 ; }
+  };
+
+  /// Simulated track: Geant4 parent and decision of the tracking action
+  struct Track {
+    int  parent ;
+    bool kept ;
+  };
+
+  const int num_primaries = 2 ;
+  const int num_tracks    = 200 ;
+
+  /// Tracks with Geant4 identifiers 1...num_tracks. The first ones are the primaries
+  std::map<int,Track> simulate() {
+    std::map<int,Track> tracks ;
+    for( int g4_id=1 ; g4_id<=num_tracks ; ++g4_id ){
+      if( g4_id <= num_primaries )
+        tracks[g4_id] = Track{ 0, true } ;
+      else
+        tracks[g4_id] = Track{ g4_id < 10 ? 1 + g4_id%num_primaries : g4_id/2, g4_id%3 != 0 } ;
+    }
+    return tracks ;
+  }
+}
+
+int main() {
+
+  dd4hep::DDTest test( "ParticleHandler" );
+
+  try{
+    // Particles are recycled by the memory pool of the thread
+    {
+      std::set<Geant4Particle*> first, second ;
+      for( int i=0 ; i<1000 ; ++i ) first.insert( new Geant4Particle(i) ) ;
+      for( Geant4Particle* p : first ) p->release() ;
+      for( int i=0 ; i<1000 ; ++i ) second.insert( new Geant4Particle(i) ) ;
+      test( first == second, true, "pool: released particles are re-used" ) ;
+      for( Geant4Particle* p : second ) p->release() ;
+
+      std::vector<BigParticle*> big ;
+      for( int i=0 ; i<1000 ; ++i ) big.push_back( new BigParticle() ) ;
+      bool same = true ;
+      for( BigParticle* p : big ) same &= p->extra[0] == 1.0 && p->extra[15] == 1.0 ;
+      test( same, true, "pool: derived particles allocated from the heap" ) ;
+      for( BigParticle* p : big ) p->release() ;
+    }
+
+    // The particle table must know the particles of the record
+    G4Electron::Definition() ;
+    G4Gamma::Definition() ;
+
+    Geant4Kernel&  kernel  = Geant4Kernel::instance( dd4hep::Detector::getInstance() ) ;
+    Geant4Context* context = kernel.workerContext() ;
+    Handler*       handler = new Handler( context, "ParticleHandler" ) ;
+    std::map<int,Track> tracks = simulate() ;
+
+    for( int evt=0 ; evt<2 ; ++evt ){
+      G4Event      g4_event( evt ) ;
+      Geant4Event* event = new Geant4Event( &g4_event, nullptr ) ;
+      context->setEvent( event ) ;
+      Geant4PrimaryInteraction* inter = new Geant4PrimaryInteraction() ;
+      event->addExtension( new Geant4PrimaryMap() ) ;
+      event->addExtension( new Geant4ParticleMap() ) ;
+      event->addExtension( inter ) ;
+      for( int i=0 ; i<num_primaries ; ++i ){
+        Geant4Particle* p = new Geant4Particle( i ) ;
+        p->pdgID  = 11 ;
+        p->reason = G4PARTICLE_PRIMARY ;
+        inter->particles[i] = p ;
+      }
+      handler->beginEvent( &g4_event ) ;
+      if( evt > 0 ){
+        test( handler->m_trackIndex.size(), handler->m_trackIndexSize, "begin event: index sized from the previous event" ) ;
+      }
+
+      // Store: as the tracking action does it at the end of each track
+      for( const auto& t : tracks ){
+        int g4_id = t.first ;
+        Geant4Particle* p = g4_id <= num_primaries
+          ? inter->particles[g4_id-1]->addRef()
+          : new Geant4Particle( g4_id ) ;
+        if( g4_id > num_primaries ){
+          p->pdgID    = 22 ;
+          p->g4Parent = t.second.parent ;
+          // Tracks without any property are dropped and their history assigned to the parent
+          p->reason   = t.second.kept ? G4PARTICLE_KEEP_ALWAYS : 0 ;
+        }
+        handler->storeParticle( g4_id, p ) ;
+        handler->m_equivalentTracks[g4_id] = g4_id ;
+      }
+      bool found = true ;
+      for( const auto& t : tracks ){
+        Geant4Particle* p = handler->trackParticle( t.first ) ;
+        found &= p != nullptr && p == handler->m_particleMap[t.first] ;
+      }
+      test( found, true, "store: all tracks found in the index" ) ;
+      test( handler->trackParticle( num_tracks+1 ) == nullptr, true, "store: unknown track not found" ) ;
+      test( handler->trackParticle( -1 ) == nullptr, true, "store: negative track not found" ) ;
+
+      // Recombine, rebase and export the record
+      handler->endEvent( &g4_event ) ;
+      test( handler->m_trackIndex.empty() && handler->m_particleMap.empty(), true, "clear: index and map empty" ) ;
+      test( handler->m_trackIndexSize > std::size_t(num_tracks), true, "clear: index size kept for the next event" ) ;
+
+      // Expected: kept secondaries numbered after the primaries in the order of the Geant4 identifiers
+      std::map<int,int> final_id ;
+      int next_id = num_primaries ;
+      for( const auto& t : tracks ){
+        if( t.first <= num_primaries ) final_id[t.first] = t.first-1 ;
+        else if( t.second.kept ) final_id[t.first] = next_id++ ;
+      }
+      auto equivalent = [&tracks, &final_id](int g4_id)  {
+        while( !final_id.count(g4_id) ) g4_id = tracks[g4_id].parent ;
+        return final_id[g4_id] ;
+      } ;
+      const Geant4ParticleMap* record = event->extension<Geant4ParticleMap>() ;
+      test( record->particles().size(), final_id.size(), "rebase: number of particles in the record" ) ;
+      bool numbered = true, parents = true, equivalents = true ;
+      for( const auto& t : tracks ){
+        int g4_id = t.first ;
+        equivalents &= record->particleID( g4_id, false ) == equivalent( g4_id ) ;
+        if( !final_id.count(g4_id) ) continue ;
+        auto ip = record->particles().find( final_id[g4_id] ) ;
+        if( ip == record->particles().end() || ip->second->id != final_id[g4_id] ){
+          numbered = false ;
+          continue ;
+        }
+        if( g4_id > num_primaries ){
+          const std::set<int>& par = ip->second->parents ;
+          parents &= par.size() == 1 && *par.begin() == equivalent( t.second.parent ) ;
+        }
+      }
+      test( numbered, true, "rebase: particles numbered after the primaries" ) ;
+      test( parents, true, "rebase: parents resolved through removed tracks" ) ;
+      test( equivalents, true, "rebase: Geant4 tracks mapped to the stored equivalent" ) ;
+
+      context->setEvent( nullptr ) ;
+      delete event ;
+    }
+    handler->release() ;
+
+  } catch( std::exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+  return 0;
+}
@@ -0,0 +1,145 @@
+#include "DD4hep/DDTest.h"
+#include "DD4hep/Detector.h"
+#include "DD4hep/Shapes.h"
+#include "DDG4/Geant4Converter.h"
+
+#include "G4TessellatedSolid.hh"
+#include "G4VFacet.hh"
+#include "G4VSolid.hh"
+
+#include <TGeoTessellated.h>
+
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace dd4hep::sim;
+
+namespace {
+
+  /// Closed prism with a polygonal cross section of n segments
+  dd4hep::TessellatedSolid prism(const std::string& name, int n, double r, double dz) {
+    typedef dd4hep::TessellatedSolid::Vertex Vertex ;
+    dd4hep::TessellatedSolid solid( name, 3*n ) ;
+    Vertex top( 0, 0, dz ), bottom( 0, 0, -dz ) ;
+    for( int i=0 ; i<n ; ++i ){
+      double p0 = 2.0*M_PI*i/n, p1 = 2.0*M_PI*(i+1)/n ;
+      Vertex b0( r*std::cos(p0), r*std::sin(p0), -dz ), b1( r*std::cos(p1), r*std::sin(p1), -dz ) ;
+      Vertex t0( b0.x(), b0.y(), dz ), t1( b1.x(), b1.y(), dz ) ;
+      solid.addFacet( b0, b1, t1, t0 ) ;
+      solid.addFacet( top, t0, t1 ) ;
+      solid.addFacet( bottom, b1, b0 ) ;
+    }
+    solid->CloseShape( true, true, false ) ;
+    return solid ;
+  }
+
+  /// Identical facets with identical vertices
+  bool same_facets(const G4TessellatedSolid* a, const G4TessellatedSolid* b) {
+    if( a->GetNumberOfFacets() != b->GetNumberOfFacets() ) return false ;
+    for( int i=0 ; i<a->GetNumberOfFacets() ; ++i ){
+      const G4VFacet* fa = a->GetFacet(i) ;
+      const G4VFacet* fb = b->GetFacet(i) ;
+      if( fa->GetNumberOfVertices() != fb->GetNumberOfVertices() ) return false ;
+      for( int j=0 ; j<fa->GetNumberOfVertices() ; ++j )
+        if( fa->GetVertex(j) != fb->GetVertex(j) ) return false ;
+    }
+    return true ;
+  }
+
+  /// Identical extent and identical answers of Inside() on a grid around the solid
+  bool same_geometry(const G4VSolid* a, const G4VSolid* b) {
+    G4ThreeVector amin, amax, bmin, bmax ;
+    a->BoundingLimits( amin, amax ) ;
+    b->BoundingLimits( bmin, bmax ) ;
+    if( amin != bmin || amax != bmax ) return false ;
+    const int n = 9 ;
+    G4ThreeVector size = 1.2*(amax-amin), start = 0.5*(amin+amax) - 0.5*size ;
+    for( int i=0 ; i<n ; ++i )
+      for( int j=0 ; j<n ; ++j )
+        for( int k=0 ; k<n ; ++k ){
+          G4ThreeVector p( start.x() + size.x()*i/(n-1), start.y() + size.y()*j/(n-1), start.z() + size.z()*k/(n-1) ) ;
+          if( a->Inside(p) != b->Inside(p) ) return false ;
+        }
+    return true ;
+  }
+
+  double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count() ;
+  }
+}
+
+int main() {
+
+  dd4hep::DDTest test( "TessellatedConversion" );
+
+  try{
+    dd4hep::Detector& description = dd4hep::Detector::getInstance() ;
+
+    // Meshes of different size, one inside a boolean and one inside a scaled solid
+    std::vector<TGeoShape*> meshes, shapes ;
+    for( int i=0 ; i<12 ; ++i ){
+      dd4hep::TessellatedSolid mesh = prism( "mesh_"+std::to_string(i), 16 << (i%5), 2.0+0.5*i, 3.0+0.25*i ) ;
+      meshes.emplace_back( mesh.ptr() ) ;
+      shapes.emplace_back( mesh.ptr() ) ;
+    }
+    dd4hep::TessellatedSolid hole = prism( "hole", 64, 1.5, 6.0 ) ;
+    dd4hep::TessellatedSolid bulb = prism( "bulb", 48, 1.0, 2.0 ) ;
+    dd4hep::SubtractionSolid boolean( dd4hep::Box( 4.0, 4.0, 4.0 ), hole, dd4hep::Position( 0.5, 0.0, 0.0 ) ) ;
+    dd4hep::Scale scaled( "scaled", bulb, 2.0, 1.0, 0.5 ) ;
+    meshes.emplace_back( hole.ptr() ) ;
+    meshes.emplace_back( bulb.ptr() ) ;
+    shapes.emplace_back( boolean.ptr() ) ;
+    shapes.emplace_back( scaled.ptr() ) ;
+
+    // Sequential conversion: every solid converted on demand
+    Geant4Converter sequential( description, dd4hep::WARNING ) ;
+    sequential.numThreads = 1 ;
+    auto start = std::chrono::steady_clock::now() ;
+    for( TGeoShape* shape : shapes ) sequential.handleSolid( shape->GetName(), shape ) ;
+    double seq_seconds = seconds_since( start ) ;
+
+    // Concurrent conversion of all meshes, then the remaining solids use them
+    Geant4Converter concurrent( description, dd4hep::WARNING ) ;
+    concurrent.numThreads = 4 ;
+    start = std::chrono::steady_clock::now() ;
+    concurrent.handleTessellatedSolids( shapes ) ;
+    double par_seconds = seconds_since( start ) ;
+    std::map<const TGeoShape*, G4VSolid*> converted( concurrent.data().g4Solids.begin(), concurrent.data().g4Solids.end() ) ;
+    for( TGeoShape* shape : shapes ) concurrent.handleSolid( shape->GetName(), shape ) ;
+
+    test( converted.size(), meshes.size(), "all meshes converted concurrently, also inside boolean and scaled solids" ) ;
+    for( TGeoShape* mesh : meshes ){
+      std::string name = mesh->GetName() ;
+      auto* seq = dynamic_cast<G4TessellatedSolid*>( sequential.data().g4Solids[mesh] ) ;
+      auto* par = dynamic_cast<G4TessellatedSolid*>( concurrent.data().g4Solids[mesh] ) ;
+      test( seq != nullptr && par != nullptr && seq != par, true, name+": converted by both converters" ) ;
+      if( !seq || !par ) continue ;
+      test( par == converted[mesh], true, name+": concurrent solid re-used" ) ;
+      test( par->GetNumberOfFacets(), int(((TGeoTessellated*)mesh)->GetNfacets()), name+": number of facets" ) ;
+      test( same_facets( seq, par ), true, name+": identical facets" ) ;
+      test( same_geometry( seq, par ), true, name+": identical extent and inside" ) ;
+    }
+    for( TGeoShape* shape : { (TGeoShape*)boolean.ptr(), (TGeoShape*)scaled.ptr() } ){
+      G4VSolid* seq = sequential.data().g4Solids[shape] ;
+      G4VSolid* par = concurrent.data().g4Solids[shape] ;
+      test( seq != nullptr && par != nullptr, true, std::string(shape->GetName())+": converted by both converters" ) ;
+      if( seq && par )
+        test( same_geometry( seq, par ), true, std::string(shape->GetName())+": identical extent and inside" ) ;
+    }
+
+    std::stringstream str ;
+    str << "Converted " << meshes.size() << " tessellated solids. Sequential: " << seq_seconds
+        << " seconds (all solids), " << concurrent.numThreads << " threads: " << par_seconds << " seconds (meshes)" ;
+    test.log( str.str() ) ;
+  } catch( std::exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+  return 0;
+}
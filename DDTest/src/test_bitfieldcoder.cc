@@ -5,11 +5,19 @@
 #include <cmath>
 
 #include "DDSegmentation/BitFieldCoder.h"
+#include "DDSegmentation/FixedBitFieldCoder.h"
 
 using namespace std;
 using namespace dd4hep;
 using namespace DDSegmentation;
 
+namespace {
+  struct TestEncoding {
+    static constexpr const char* encoding() { return "system:5,side:-2,layer:9,module:8,sensor:8,x:32:-16,y:-16"; }
+  };
+  typedef FixedEncodingCoder<TestEncoding> FixedCoder;
+}
+
 //=============================================================================
 int main(int /* argc */, char** /* argv */ ){
   // this should be the first line in your test
@@ -63,6 +71,57 @@ int main(int /* argc */, char** /* argv */ ){
     test( bf2.get( field, bf2.index( "y")),    -16710 , " acces field value: y" );
 
 
+    test.log( "test fixed bitfieldcoder" );
+
+    static_assert( FixedCoder::SIZE == 7, "Number of fixed fields" );
+    static_assert( FixedCoder::index( "sensor" ) == 4, "Index of fixed field" );
+    static_assert( FixedCoder::Field<5>::offset == 32 && FixedCoder::Field<5>::isSigned, "Fixed field layout" );
+
+    test( FixedCoder::matches( bf ), true , " fixed coder matches runtime coder" );
+    test( FixedCoder::matches( BitFieldCoder( "system:5,side:2,layer:9" ) ), false , " fixed coder differs from runtime coder" );
+    test( FixedCoder::mask(), bf.mask() , " fixed coder mask" );
+
+    FixedCoder::Values values = FixedCoder::decode( field );
+    for( unsigned i=0 ; i < bf.size() ; ++i )
+      test( values[i], bf.get( field, i ) , " fixed decode of field " + bf[i].name() );
+
+    test( FixedCoder::get<FixedCoder::index( "x" )>( field ), -310 , " fixed access field value: x" );
+    test( FixedCoder::encode( values ), field , " fixed encode of all fields" );
+
+    CellID fixedField = 0 ;
+    FixedCoder::set<FixedCoder::index( "layer" )>( fixedField, 373 );
+    FixedCoder::set<FixedCoder::index( "y" )>( fixedField, -16710 );
+    CellID runtimeField = 0 ;
+    bf.set( runtimeField, "layer",  373 );
+    bf.set( runtimeField, "y", -16710 );
+    test( fixedField, runtimeField , " fixed set identical to runtime set" );
+
+    // batch decoding and encoding
+    const size_t nCells = 1001 ;
+    vector<CellID> cells( nCells ), encoded( nCells ) ;
+    vector<vector<FieldID> > columns( FixedCoder::SIZE, vector<FieldID>( nCells ) ) ;
+    CellID seed = 0x9e3779b97f4a7c15UL ;
+    for( size_t i=0 ; i < nCells ; ++i ){
+      seed ^= seed << 13 ; seed ^= seed >> 7 ; seed ^= seed << 17 ;
+      cells[i] = seed ;
+    }
+    FixedCoder::Outputs out ;
+    FixedCoder::Inputs  in ;
+    for( size_t j=0 ; j < FixedCoder::SIZE ; ++j ){
+      out[j] = columns[j].data() ;
+      in[j]  = columns[j].data() ;
+    }
+    FixedCoder::decode( nCells, cells.data(), out );
+    FixedCoder::encode( nCells, in, encoded.data() );
+    size_t nBad = 0 ;
+    for( size_t i=0 ; i < nCells ; ++i ){
+      for( size_t j=0 ; j < FixedCoder::SIZE ; ++j )
+        if( columns[j][i] != bf.get( cells[i], j ) ) ++nBad ;
+      if( encoded[i] != cells[i] ) ++nBad ;
+    }
+    test( nBad, size_t(0) , " fixed batch decode and encode" );
+
+
     // --------------------------------------------------------------------
 
 
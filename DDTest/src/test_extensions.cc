@@ -0,0 +1,114 @@
+#include "DD4hep/DDTest.h"
+#include "DD4hep/DetElement.h"
+#include "DD4hep/ObjectExtensions.h"
+
+#include <chrono>
+#include <exception>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace dd4hep;
+
+namespace {
+
+  /// Simple detector element extensions
+  struct LayerData {
+    int layer = 0 ;
+    LayerData() = default ;
+    explicit LayerData(int l) : layer(l) {}
+    LayerData(const LayerData& c, DetElement) : layer(c.layer) {}
+  };
+  struct SurfaceData {
+    double thickness = 0.0 ;
+    SurfaceData() = default ;
+    explicit SurfaceData(double t) : thickness(t) {}
+    SurfaceData(const SurfaceData& c, DetElement) : thickness(c.thickness) {}
+  };
+  struct UnusedData {
+    UnusedData(const UnusedData&, DetElement) {}
+  };
+
+  double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>( std::chrono::steady_clock::now() - start ).count() ;
+  }
+}
+
+int main() {
+
+  DDTest test( "extensions" );
+
+  try{
+    const int num_elements = 200 ;
+    std::vector<DetElement> elements ;
+    for( int i=0 ; i<num_elements ; ++i ){
+      DetElement de( "element_" + std::to_string(i), i ) ;
+      de.addExtension<LayerData>( new LayerData( i ) ) ;
+      if( i%2 == 0 ) de.addExtension<SurfaceData>( new SurfaceData( 0.5*i ) ) ;
+      elements.push_back( de ) ;
+    }
+
+    // Typed (slot) access and key access must agree
+    bool same = true ;
+    for( const DetElement& de : elements ){
+      LayerData* l = de.extension<LayerData>() ;
+      same &= l == de.extension( detail::typeHash64<LayerData>(), true ) ;
+      same &= l->layer == de.id() ;
+    }
+    test( same, true, "slot access identical to key access" ) ;
+    test( detail::extensionSlot<LayerData>() != detail::extensionSlot<SurfaceData>(), true, "distinct slots per type" ) ;
+    test( detail::extensionSlot<LayerData>() < ObjectExtensions::MAX_SLOTS, true, "dense slot assigned" ) ;
+
+    // Missing extensions
+    test( elements[1].extension<SurfaceData>( false ) == nullptr, true, "missing extension without alert" ) ;
+    test( elements[0].extension<UnusedData>( false ) == nullptr, true, "unused type without alert" ) ;
+    bool thrown = false ;
+    try  {
+      elements[1].extension<SurfaceData>() ;
+    }
+    catch( const std::exception& )  {
+      thrown = true ;
+    }
+    test( thrown, true, "missing extension with alert throws" ) ;
+
+    // Removal and clone must keep the slots consistent with the map
+    DetElement first = elements[0] ;
+    first->removeExtension( detail::typeHash64<SurfaceData>(), true ) ;
+    test( first.extension<SurfaceData>( false ) == nullptr, true, "removed extension not found" ) ;
+    DetElement copy = elements[2].clone( "element_copy", 4711 ) ;
+    test( copy.extension<SurfaceData>()->thickness, 1.0, "cloned extension by slot" ) ;
+    test( copy.extension<SurfaceData>() != elements[2].extension<SurfaceData>(), true, "cloned extension is a copy" ) ;
+
+    // Lookup statistics and micro-benchmark: slot access versus key access
+    const int num_loops = 2000 ;
+    ObjectExtensions::enableStatistics( true ) ;
+    double sum = 0.0 ;
+    auto start = std::chrono::steady_clock::now() ;
+    for( int loop=0 ; loop<num_loops ; ++loop )
+      for( const DetElement& de : elements )
+        sum += de.extension<LayerData>()->layer ;
+    double t_slot = seconds_since( start ) ;
+    ObjectExtensions::enableStatistics( false ) ;
+    start = std::chrono::steady_clock::now() ;
+    for( int loop=0 ; loop<num_loops ; ++loop )
+      for( const DetElement& de : elements )
+        sum -= ((LayerData*)de.extension( detail::typeHash64<LayerData>(), true ))->layer ;
+    double t_key = seconds_since( start ) ;
+    ObjectExtensions::printStatistics() ;
+    test( sum, 0.0, "benchmark: identical results" ) ;
+
+    double norm = 1e9 / double(num_loops) / double(num_elements) ;
+    std::stringstream str ;
+    str << "nsec/lookup: slot access: " << t_slot*norm << "  key access: " << t_key*norm ;
+    test.log( str.str() ) ;
+
+    for( DetElement& de : elements ) de.destroy() ;
+    copy.destroy() ;
+
+  } catch( std::exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+  return 0;
+}
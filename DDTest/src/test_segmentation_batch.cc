@@ -0,0 +1,100 @@
+#include "DDSegmentation/CartesianGridXY.h"
+#include "DDSegmentation/CartesianGridXYZ.h"
+#include "DDSegmentation/MultiSegmentation.h"
+#include "DD4hep/DDTest.h"
+
+#include <exception>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace dd4hep;
+using namespace DDSegmentation;
+
+namespace {
+
+  /// Compare the batch interface with the single cell interface of a segmentation
+  void compare(DDTest& test, const Segmentation& seg, const std::string& tag) {
+    const size_t nCells = 2000 ;
+    const BitFieldCoder& bf = *seg.decoder() ;
+    std::mt19937 engine( 12345 ) ;
+    std::uniform_real_distribution<double> flat( -250., 250. ) ;
+    std::uniform_int_distribution<int>     layer( 0, 5 ) ;
+
+    std::vector<Vector3D> local( nCells ), global( nCells ), pos( nCells ) ;
+    std::vector<VolumeID> volIDs( nCells ) ;
+    std::vector<CellID>   cells( nCells ) ;
+    for( size_t i=0 ; i < nCells ; ++i ){
+      local[i] = global[i] = Vector3D( flat(engine), flat(engine), flat(engine) ) ;
+      VolumeID vID = 0 ;
+      bf.set( vID, "system", 7 ) ;
+      bf.set( vID, "layer", layer(engine) ) ;
+      volIDs[i] = vID ;
+    }
+    seg.cellIDs( nCells, &local[0], &global[0], &volIDs[0], &cells[0] ) ;
+    seg.positions( nCells, &cells[0], &pos[0] ) ;
+
+    size_t nBadCell = 0, nBadPos = 0 ;
+    for( size_t i=0 ; i < nCells ; ++i ){
+      if( cells[i] != seg.cellID( local[i], global[i], volIDs[i] ) ) ++nBadCell ;
+      Vector3D p = seg.position( cells[i] ) ;
+      if( p.X != pos[i].X || p.Y != pos[i].Y || p.Z != pos[i].Z ) ++nBadPos ;
+    }
+    test( nBadCell, size_t(0), tag + ": batch cellIDs identical to cellID" ) ;
+    test( nBadPos,  size_t(0), tag + ": batch positions identical to position" ) ;
+  }
+}
+
+int main() {
+
+  DDTest test( "segmentation_batch" );
+
+  try{
+    const std::string encoding = "system:8,layer:8,x:24:-20,y:-20" ;
+    const std::string encodingZ = "system:8,layer:8,x:16:-16,y:-16,z:-16" ;
+
+    CartesianGridXY xy( encoding ) ;
+    xy.setGridSizeX( 3.5 ) ;
+    xy.setGridSizeY( 5.1 ) ;
+    xy.setOffsetY( 0.7 ) ;
+    compare( test, xy, "CartesianGridXY" ) ;
+
+    CartesianGridXYZ xyz( encodingZ ) ;
+    xyz.setGridSizeX( 10. ) ;
+    xyz.setGridSizeY( 12. ) ;
+    xyz.setGridSizeZ( 0.5 ) ;
+    compare( test, xyz, "CartesianGridXYZ" ) ;
+
+    // Multi segmentation with layer dependent sub-segmentations
+    BitFieldCoder bf( encoding ) ;
+    MultiSegmentation multi( &bf ) ;
+    multi.parameter( "key" )->setValue( "layer" ) ;
+    for( int l=0 ; l < 6 ; l += 2 ){
+      CartesianGridXY* sub = new CartesianGridXY( &bf ) ;
+      sub->setGridSizeX( 1.0 + l ) ;
+      sub->setGridSizeY( 2.0 + l ) ;
+      multi.addSubsegmentation( l, l+1, sub ) ;
+    }
+    multi.setDecoder( &bf ) ;
+    compare( test, multi, "MultiSegmentation" ) ;
+
+    // Out of range values must raise the same exception as the single cell interface
+    Vector3D  far( 1e9, 0., 0. ) ;
+    VolumeID  vID = 0 ;
+    CellID    cell = 0 ;
+    bool      thrown = false ;
+    try  {
+      xy.cellIDs( 1, &far, &far, &vID, &cell ) ;
+    }
+    catch( const std::exception& )  {
+      thrown = true ;
+    }
+    test( thrown, true, "CartesianGridXY: batch cellIDs range check" ) ;
+
+  } catch( std::exception &e ){
+
+    test.log( e.what() );
+    test.error( "exception occurred" );
+  }
+  return 0;
+}
@@ -0,0 +1,227 @@
+//==========================================================================
+//  AIDA Detector description implementation
+//--------------------------------------------------------------------------
+// Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+// All rights reserved.
+//
+// For the licensing terms see $DD4hepINSTALL/LICENSE.
+// For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+//
+// Author     : M.Frank
+//
+//==========================================================================
+/*
+   Plugin invocation:
+   ==================
+   This plugin behaves like a main program.
+   Invoke the plugin with something like this:
+
+   geoPluginRun -volmgr -destroy -plugin DD4hep_AlignmentExample_compiled \
+   -input file:${DD4hep_DIR}/examples/AlignDet/compact/Telescope.xml
+
+   Regression test of the alignment computation using a compiled detector
+   element hierarchy against the path ordered computation:
+
+   1) Deltas for all detector elements
+   2) Deltas for the subdetectors only: the alignments are propagated to the subtrees
+   3) Incremental update after changing a few deltas
+
+   The results must be identical. Optionally the computations are repeated
+   to measure the timing.
+*/
+// Framework include files
+#include "AlignmentExampleObjects.h"
+#include "DD4hep/Factories.h"
+#include "TTimeStamp.h"
+#include "TRandom3.h"
+
+// C/C++ include files
+#include <cstring>
+
+using namespace std;
+using namespace dd4hep;
+using namespace dd4hep::AlignmentExamples;
+
+namespace {
+
+  /// Compare the bits and the components of two transformation matrices bit by bit
+  /** Compared with memcmp: with double == 0 equals -0 and a NaN never matches. */
+  bool same_matrix(const TGeoHMatrix& a, const TGeoHMatrix& b)  {
+    unsigned int bits = TGeoMatrix::kGeoGenTrans|TGeoMatrix::kGeoReflection;
+    return a.TestBits(bits) == b.TestBits(bits) &&
+      0 == ::memcmp(a.GetRotationMatrix(), b.GetRotationMatrix(), 9*sizeof(double)) &&
+      0 == ::memcmp(a.GetTranslation(),    b.GetTranslation(),    3*sizeof(double)) &&
+      0 == ::memcmp(a.GetScale(),          b.GetScale(),          3*sizeof(double));
+  }
+
+  /// Compare the alignments of the computed map with the reference map. Returns number of differences
+  size_t compare(const char* tag, const ConditionsTreeMap& reference, const ConditionsTreeMap& computed)  {
+    size_t num_diff = 0;
+    for( const auto& r : reference.data )  {
+      auto c = computed.data.find(r.first);
+      if ( c == computed.data.end() )   {
+        printout(ERROR,"Compare","%-12s: Alignment %016llX is missing.",tag,r.first);
+        ++num_diff;
+        continue;
+      }
+      const AlignmentData& ra = AlignmentCondition(r.second).data();
+      const AlignmentData& ca = AlignmentCondition(c->second).data();
+      if ( !same_matrix(ra.worldTrafo, ca.worldTrafo) ||
+           !same_matrix(ra.detectorTrafo, ca.detectorTrafo) ||
+           !(ra.trToWorld == ca.trToWorld) )   {
+        printout(ERROR,"Compare","%-12s: Alignment %016llX of %s differs.",tag,r.first,
+                 ra.detector.isValid() ? ra.detector.path().c_str() : "---");
+        ++num_diff;
+      }
+    }
+    if ( reference.data.size() != computed.data.size() )   {
+      printout(ERROR,"Compare","%-12s: Number of alignments differs: %ld <> %ld.",
+               tag, reference.data.size(), computed.data.size());
+      ++num_diff;
+    }
+    printout(ALWAYS,"Compare","%-12s: %ld alignments compared, %ld differences.",
+             tag, reference.data.size(), num_diff);
+    return num_diff;
+  }
+
+  /// Random delta
+  Delta random_delta(TRandom3& rndm)  {
+    Position    pos(rndm.Gaus(0e0,1e-2), rndm.Gaus(0e0,1e-2), rndm.Gaus(0e0,1e-2));
+    RotationZYX rot(rndm.Gaus(0e0,1e-3), rndm.Gaus(0e0,1e-3), rndm.Gaus(0e0,1e-3));
+    return Delta(pos, rot);
+  }
+}
+
+/// Plugin function: Alignment program example
+/**
+ *  Factory: DD4hep_AlignmentExample_compiled
+ *
+ *  \author  M.Frank
+ *  \version 1.0
+ *  \date    16/10/2026
+ */
+static int alignment_example (Detector& description, int argc, char** argv)  {
+  string input;
+  int    num_repeat = 0, num_threads = 0, num_change = 3;
+  bool   arg_error = false;
+  for(int i=0; i<argc && argv[i]; ++i)  {
+    if ( 0 == ::strncmp("-input",argv[i],4) )
+      input = argv[++i];
+    else if ( 0 == ::strncmp("-repeat",argv[i],4) )
+      num_repeat = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-threads",argv[i],4) )
+      num_threads = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-changes",argv[i],4) )
+      num_change = ::atol(argv[++i]);
+    else
+      arg_error = true;
+  }
+  if ( arg_error || input.empty() )   {
+    /// Help printout describing the basic command line interface
+    cout <<
+      "Usage: -plugin <name> -arg [-arg]                                             \n"
+      "     name:   factory name     DD4hep_AlignmentExample_compiled                \n"
+      "     -input   <string>        Geometry file                                   \n"
+      "     -repeat  <number>        Number of computations for the timing.          \n"
+      "     -threads <number>        Number of threads for the compiled computation. \n"
+      "     -changes <number>        Number of changed deltas for the incremental    \n"
+      "                              computation.                                    \n"
+      "\tArguments given: " << arguments(argc,argv) << endl << flush;
+    ::exit(EINVAL);
+  }
+
+  // First we load the geometry
+  description.fromXML(input);
+
+  DetElement world = description.world();
+  vector<DetElement> elements;
+  Scanner().scan([&elements](DetElement de, int)  { elements.emplace_back(de); return 1; }, world);
+
+  TRandom3 rndm(4711);
+  map<DetElement, Delta> all_deltas, top_deltas;
+  for( DetElement de : elements )   {
+    if ( de == world ) continue;
+    Delta delta = random_delta(rndm);
+    all_deltas.emplace(de, delta);
+    if ( de.parent() == world ) top_deltas.emplace(de, delta);
+  }
+  auto ordered = [](const map<DetElement, Delta>& deltas)  {
+    AlignmentsCalculator::OrderedDeltas result;
+    for( const auto& d : deltas ) result.emplace(d.first, &d.second);
+    return result;
+  };
+
+  AlignmentsCalculator            calculator;
+  AlignmentsCalculator::Hierarchy hierarchy(world);
+  hierarchy.threads = num_threads;
+  printout(ALWAYS,"Hierarchy","Compiled %ld detector elements in %ld levels.",
+           hierarchy.size(), hierarchy.numLevels());
+
+  size_t num_diff = 0, num_compared = 0;
+  // 1) Deltas for all detector elements
+  {
+    ConditionsTreeMap reference, computed;
+    AlignmentsCalculator::Result rres = calculator.compute(ordered(all_deltas), reference);
+    AlignmentsCalculator::Result cres = calculator.compute(hierarchy, ordered(all_deltas), computed);
+    printout(ALWAYS,"Compute","All deltas:  reference (C:%ld,M:%ld)  compiled (C:%ld,M:%ld)",
+             rres.computed, rres.missing, cres.computed, cres.missing);
+    num_diff += compare("All deltas", reference, computed);
+    num_compared += reference.data.size();
+  }
+  // 2) Deltas for the subdetectors only
+  {
+    ConditionsTreeMap reference, computed;
+    AlignmentsCalculator::Result rres = calculator.compute(ordered(top_deltas), reference);
+    AlignmentsCalculator::Result cres = calculator.compute(hierarchy, ordered(top_deltas), computed);
+    printout(ALWAYS,"Compute","Subdetectors: reference (C:%ld,M:%ld)  compiled (C:%ld,M:%ld)",
+             rres.computed, rres.missing, cres.computed, cres.missing);
+    num_diff += compare("Subdetectors", reference, computed);
+    num_compared += reference.data.size();
+  }
+  // 3) Incremental update after changing a few deltas
+  {
+    ConditionsTreeMap reference, computed;
+    map<DetElement, Delta> deltas = all_deltas;
+    calculator.compute(hierarchy, ordered(deltas), computed);
+    for( int i = 0; i < num_change && !deltas.empty(); ++i )   {
+      auto it = deltas.begin();
+      advance(it, long(rndm.Uniform(0, double(deltas.size()))) % long(deltas.size()));
+      it->second = random_delta(rndm);
+    }
+    AlignmentsCalculator::Result rres = calculator.compute(ordered(deltas), reference);
+    AlignmentsCalculator::Result cres = calculator.compute(hierarchy, ordered(deltas), computed, true);
+    printout(ALWAYS,"Compute","Incremental: reference (C:%ld,M:%ld)  compiled (C:%ld,M:%ld,R:%ld)",
+             rres.computed, rres.missing, cres.computed, cres.missing, cres.reused);
+    num_diff += compare("Incremental", reference, computed);
+    num_compared += reference.data.size();
+  }
+
+  // Timing of the repeated computations
+  if ( num_repeat > 0 )   {
+    AlignmentsCalculator::OrderedDeltas deltas = ordered(all_deltas);
+    ConditionsTreeMap reference, computed;
+    TTimeStamp start;
+    for( int i = 0; i < num_repeat; ++i )
+      calculator.compute(deltas, reference);
+    TTimeStamp stop_reference;
+    for( int i = 0; i < num_repeat; ++i )
+      calculator.compute(hierarchy, deltas, computed);
+    TTimeStamp stop_compiled;
+    for( int i = 0; i < num_repeat; ++i )
+      calculator.compute(hierarchy, deltas, computed, true);
+    TTimeStamp stop_incremental;
+    printout(ALWAYS,"Timing","%d computations of %ld alignments: reference %8.3f sec "
+             "compiled %8.3f sec incremental %8.3f sec [%d threads]",
+             num_repeat, reference.data.size(),
+             stop_reference.AsDouble()-start.AsDouble(),
+             stop_compiled.AsDouble()-stop_reference.AsDouble(),
+             stop_incremental.AsDouble()-stop_compiled.AsDouble(), num_threads);
+  }
+  printout(ALWAYS,"Summary","%ld alignments compared in 3 cases: %ld differences.",
+           num_compared, num_diff);
+  // All done.
+  return 1;
+}
+
+// first argument is the type from the xml file
+DECLARE_APPLY(DD4hep_AlignmentExample_compiled,alignment_example)
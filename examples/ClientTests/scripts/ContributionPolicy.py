@@ -0,0 +1,178 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+#
+#
+from __future__ import absolute_import, unicode_literals
+import math
+import os
+import sys
+import DDG4
+from DDG4 import OutputLevel as Output
+from g4units import GeV
+#
+#
+"""
+
+   dd4hep example: contribution policies of the calorimeter action
+
+   Simulate the same events with one contribution per step and with
+   merged contributions:
+   $> python ContributionPolicy.py -events 5 -policy AllSteps -output Policy_AllSteps.root
+   $> python ContributionPolicy.py -events 5 -policy PerTrack -output Policy_PerTrack.root
+
+   and check the merged contributions against the steps of the reference:
+   $> python ContributionPolicy.py -check -policy PerTrack -reference Policy_AllSteps.root -input Policy_PerTrack.root
+
+   The Monte Carlo truth is not handled: contributions keep the Geant4 track identifiers.
+
+   @author  M.Frank
+   @version 1.0
+
+"""
+
+time_bin = 1.0
+num_primaries = 2
+
+
+def merge_key(policy, contrib, index):
+  """
+  Merge key of a contribution of the reference file as expected from the policy
+
+  \author  M.Frank
+  """
+  if policy == 'PerTrack':
+    return contrib.trackID
+  elif policy == 'TimeBinned':
+    return int(math.floor(contrib.time / time_bin))
+  return index
+
+
+def close(a, b):
+  return abs(a - b) <= 1e-9 * max(1.0, abs(b))
+
+
+def check(policy, reference, input):  # noqa: A002
+  """
+  Check the merged contributions of all calorimeter hits against the steps of the reference
+
+  \author  M.Frank
+  """
+  import ROOT
+  DDG4.loadDDG4()
+  files = [ROOT.TFile.Open(reference), ROOT.TFile.Open(input)]
+  trees = [f.Get('EVENT') for f in files]
+  branches = [b.GetName() for b in trees[0].GetListOfBranches()
+              if 'Geant4Calorimeter::Hit' in b.GetClassName()]
+  num_hits = 0
+  num_steps = 0
+  num_contribs = 0
+  num_errors = 0
+  num_events = trees[0].GetEntries()
+  if num_events != trees[1].GetEntries():
+    print('+++ ContributionPolicy: Event numbers differ: %d <> %d' % (num_events, trees[1].GetEntries()))
+    num_errors = num_errors + 1
+    num_events = min(num_events, trees[1].GetEntries())
+
+  for evt in range(num_events):
+    for t in trees:
+      t.GetEntry(evt)
+    for name in branches:
+      hits = [getattr(t, name) for t in trees]
+      if hits[0].size() != hits[1].size():
+        print('+++ ContributionPolicy: Event %d %s: number of hits differ: %d <> %d' %
+              (evt, name, hits[0].size(), hits[1].size()))
+        num_errors = num_errors + 1
+        continue
+      for i in range(hits[0].size()):
+        h0 = hits[0][i]
+        h1 = hits[1][i]
+        num_hits = num_hits + 1
+        num_steps = num_steps + h0.truth.size()
+        num_contribs = num_contribs + h1.truth.size()
+        # Expected merged contributions: summed deposits and lengths, earliest time
+        expected = {}
+        for j in range(h0.truth.size()):
+          c = h0.truth[j]
+          e = expected.setdefault(merge_key(policy, c, j), [0.0, 0.0, c.time])
+          e[0] = e[0] + c.deposit
+          e[1] = e[1] + c.length
+          e[2] = min(e[2], c.time)
+        deposit = sum([h1.truth[j].deposit for j in range(h1.truth.size())])
+        same = h0.cellID == h1.cellID and h0.energyDeposit == h1.energyDeposit and close(deposit, h1.energyDeposit)
+        if policy == 'PerPrimary':
+          same = same and 0 < h1.truth.size() <= min(num_primaries, len(set([c.trackID for c in h0.truth])))
+          for c in h1.truth:
+            same = same and 0 < c.trackID <= num_primaries
+        else:
+          same = same and h1.truth.size() == len(expected)
+          for j in range(h1.truth.size() if same else 0):
+            c = h1.truth[j]
+            e = expected.get(merge_key(policy, c, j))
+            same = same and e is not None and close(c.deposit, e[0]) and close(c.length, e[1]) and c.time == e[2]
+        if not same:
+          print('+++ ContributionPolicy: Event %d %s: hit %d cell %016X: %d steps -> %d contributions, deposit %g <> %g' %
+                (evt, name, i, h1.cellID, h0.truth.size(), h1.truth.size(), h0.energyDeposit, deposit))
+          num_errors = num_errors + 1
+
+  print('+++ ContributionPolicy: %s: %d events with %d hits: %d steps -> %d contributions (%.1f %%): %d differences' %
+        (policy, num_events, num_hits, num_steps, num_contribs,
+         100.0 * num_contribs / num_steps if num_steps else 100.0, num_errors))
+  for f in files:
+    f.Close()
+  return num_errors
+
+
+def run():
+  args = DDG4.CommandLine()
+  policy = args.policy if args.policy else 'AllSteps'
+  if args.check:
+    sys.exit(1 if check(policy, args.reference, args.input) else 0)
+
+  kernel = DDG4.Kernel()
+  install_dir = os.environ['DD4hepExamplesINSTALL']
+  geometry = "file:" + install_dir + "/examples/ClientTests/compact/MultiSegmentations.xml"
+  if args.compact:
+    geometry = args.compact
+  kernel.loadGeometry(str(geometry))
+  geant4 = DDG4.Geant4(kernel)
+  geant4.printDetectors()
+  ui = geant4.setupCshUI()
+  ui.Commands = ['/run/beamOn ' + str(args.events if args.events else 5), '/ddg4/UI/terminate']
+
+  # Identical events for all policies
+  rndm = DDG4.Action(kernel, 'Geant4Random/Random')
+  rndm.Seed = 987654321
+  rndm.initialize()
+
+  # Configure field
+  geant4.setupTrackingField(prt=True)
+  # Configure I/O: keep the Geant4 track identifiers of the contributions
+  geant4.setupROOTOutput('RootOutput', args.output if args.output else 'Policy_' + policy, mc_truth=False)
+  # Setup particle gun
+  gun = geant4.setupGun("Gun", particle='e-', energy=10 * GeV, multiplicity=num_primaries, isotrop=False)
+  gun.direction = (0.2, 0.1, 1.0)
+  gun.OutputLevel = Output.WARNING
+
+  # The calorimeter with the contribution policy
+  seq, act = geant4.setupCalorimeter('TestCal')
+  act.ContributionPolicy = policy
+  act.ContributionTimeBin = time_bin
+
+  # Now build the physics list:
+  phys = kernel.physicsList()
+  phys.extends = 'QGSP_BERT'
+  phys.enableUI()
+  # and run
+  geant4.execute()
+
+
+if __name__ == "__main__":
+  run()
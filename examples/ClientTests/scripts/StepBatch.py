@@ -0,0 +1,166 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+#
+#
+from __future__ import absolute_import, unicode_literals
+import os
+import sys
+import DDG4
+from DDG4 import OutputLevel as Output
+from g4units import GeV, MeV
+#
+#
+"""
+
+   dd4hep example: step-batched processing of the calorimeter action
+
+   Simulate the same events with StepBatchSize off and on:
+   $> python StepBatch.py -events 10 -batch_size 0  -output StepBatch_off.root
+   $> python StepBatch.py -events 10 -batch_size 16 -output StepBatch_on.root
+
+   and compare the calorimeter hit collections of the two files:
+   $> python StepBatch.py -compare -reference StepBatch_off.root -input StepBatch_on.root
+
+   With -optical the water calorimeter StepBatchOptical.xml is simulated with
+   Cerenkov photons and BoundaryInvokeSD: the cell identifiers of optical
+   photons are taken from the post-step volume, the hit positions from the
+   pre-step volume.
+
+   @author  M.Frank
+   @version 1.0
+
+"""
+
+
+def compare(reference, input):  # noqa: A002
+  """
+  Compare all calorimeter hit collections of two DDG4 ROOT files hit by hit
+
+  \author  M.Frank
+  """
+  import ROOT
+  DDG4.loadDDG4()
+  files = [ROOT.TFile.Open(reference), ROOT.TFile.Open(input)]
+  trees = [f.Get('EVENT') for f in files]
+  branches = [b.GetName() for b in trees[0].GetListOfBranches()
+              if 'Geant4Calorimeter::Hit' in b.GetClassName()]
+  num_hits = 0
+  num_contribs = 0
+  num_errors = 0
+  num_events = trees[0].GetEntries()
+  if num_events != trees[1].GetEntries():
+    print('+++ StepBatch: Event numbers differ: %d <> %d' % (num_events, trees[1].GetEntries()))
+    num_errors = num_errors + 1
+    num_events = min(num_events, trees[1].GetEntries())
+
+  for evt in range(num_events):
+    for t in trees:
+      t.GetEntry(evt)
+    for name in branches:
+      hits = [getattr(t, name) for t in trees]
+      if hits[0].size() != hits[1].size():
+        print('+++ StepBatch: Event %d %s: number of hits differ: %d <> %d' %
+              (evt, name, hits[0].size(), hits[1].size()))
+        num_errors = num_errors + 1
+        continue
+      for i in range(hits[0].size()):
+        h0 = hits[0][i]
+        h1 = hits[1][i]
+        num_hits = num_hits + 1
+        same = h0.cellID == h1.cellID and h0.energyDeposit == h1.energyDeposit and \
+            h0.position.X() == h1.position.X() and h0.position.Y() == h1.position.Y() and \
+            h0.position.Z() == h1.position.Z() and h0.truth.size() == h1.truth.size()
+        for j in range(h0.truth.size() if same else 0):
+          c0 = h0.truth[j]
+          c1 = h1.truth[j]
+          num_contribs = num_contribs + 1
+          same = same and c0.trackID == c1.trackID and c0.pdgID == c1.pdgID and \
+              c0.deposit == c1.deposit and c0.time == c1.time and c0.length == c1.length and \
+              c0.x == c1.x and c0.y == c1.y and c0.z == c1.z
+        if not same:
+          print('+++ StepBatch: Event %d %s: hit %d differs: cell %016X <> %016X deposit %g <> %g' %
+                (evt, name, i, h0.cellID, h1.cellID, h0.energyDeposit, h1.energyDeposit))
+          num_errors = num_errors + 1
+
+  print('+++ StepBatch: Compared %d events with %d hits and %d contributions in %d collection(s): %d differences' %
+        (num_events, num_hits, num_contribs, len(branches), num_errors))
+  for f in files:
+    f.Close()
+  return num_errors
+
+
+def run():
+  args = DDG4.CommandLine()
+  if args.compare:
+    sys.exit(1 if compare(args.reference, args.input) else 0)
+
+  kernel = DDG4.Kernel()
+  install_dir = os.environ['DD4hepExamplesINSTALL']
+  geometry = "file:" + install_dir + "/examples/ClientTests/compact/MultiSegmentations.xml"
+  if args.optical:
+    geometry = "file:" + install_dir + "/examples/ClientTests/compact/StepBatchOptical.xml"
+  if args.compact:
+    geometry = args.compact
+  kernel.loadGeometry(str(geometry))
+  geant4 = DDG4.Geant4(kernel)
+  geant4.printDetectors()
+  ui = geant4.setupCshUI()
+  ui.Commands = ['/run/beamOn ' + str(args.events if args.events else 10), '/ddg4/UI/terminate']
+
+  # Identical events in both simulations
+  rndm = DDG4.Action(kernel, 'Geant4Random/Random')
+  rndm.Seed = 987654321
+  rndm.initialize()
+
+  # Configure field
+  geant4.setupTrackingField(prt=True)
+  # Configure I/O
+  geant4.setupROOTOutput('RootOutput', args.output if args.output else 'StepBatch', mc_truth=True)
+  # Setup particle gun
+  if args.optical:
+    gun = geant4.setupGun("Gun", particle='mu-', energy=1 * GeV, multiplicity=1, isotrop=False)
+  else:
+    gun = geant4.setupGun("Gun", particle='e-', energy=10 * GeV, multiplicity=2, isotrop=False)
+  gun.direction = (0.2, 0.1, 1.0)
+  gun.OutputLevel = Output.WARNING
+
+  # The calorimeter with or without batched step processing
+  seq, act = geant4.setupCalorimeter('TestCal')
+  act.StepBatchSize = int(args.batch_size) if args.batch_size else 0
+
+  # And handle the simulation particles.
+  part = DDG4.GeneratorAction(kernel, "Geant4ParticleHandler/ParticleHandler")
+  kernel.generatorAction().adopt(part)
+  part.MinimalKineticEnergy = 1 * MeV
+  part.enableUI()
+
+  # Now build the physics list:
+  phys = kernel.physicsList()
+  phys.extends = 'QGSP_BERT'
+  if args.optical:
+    ph = DDG4.PhysicsList(kernel, 'Geant4CerenkovPhysics/CerenkovPhys')
+    ph.MaxNumPhotonsPerStep = 10
+    ph.MaxBetaChangePerStep = 10.0
+    ph.TrackSecondariesFirst = True
+    ph.enableUI()
+    phys.adopt(ph)
+    ph = DDG4.PhysicsList(kernel, 'Geant4OpticalPhotonPhysics/OpticalGammaPhys')
+    ph.addParticleConstructor('G4OpticalPhoton')
+    ph.BoundaryInvokeSD = True
+    ph.enableUI()
+    phys.adopt(ph)
+  phys.enableUI()
+  # and run
+  geant4.execute()
+
+
+if __name__ == "__main__":
+  run()
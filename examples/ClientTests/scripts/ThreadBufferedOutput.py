@@ -0,0 +1,157 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+#
+#
+from __future__ import absolute_import, unicode_literals
+import os
+import sys
+import DDG4
+from DDG4 import OutputLevel as Output
+from g4units import GeV, MeV
+#
+#
+"""
+
+   dd4hep example: multi-threaded simulation with thread-buffered ROOT output
+
+   Every worker thread has its own Geant4Output2ROOT instance writing into an
+   in-memory buffer. The buffers are merged into one output file:
+   $> python ThreadBufferedOutput.py -threads 3 -events 20 -output ThreadBuffered.root
+
+   Read the merged file back and check the event tree:
+   $> python ThreadBufferedOutput.py -check ThreadBuffered.root -events 20
+
+   @author  M.Frank
+   @version 1.0
+
+"""
+
+
+def check(input, num_events):  # noqa: A002
+  """
+  Check the merged output: all events present, all branches with all entries
+
+  \author  M.Frank
+  """
+  import ROOT
+  DDG4.loadDDG4()
+  num_errors = 0
+  num_hits = 0
+  num_particles = 0
+  f = ROOT.TFile.Open(input)
+  tree = f.Get('EVENT') if f and not f.IsZombie() else None
+  if not tree:
+    print('+++ ThreadBuffered: No event tree in file %s' % (input,))
+    return 1
+  entries = tree.GetEntries()
+  branches = sorted([b.GetName() for b in tree.GetListOfBranches()])
+  if entries != num_events:
+    print('+++ ThreadBuffered: Number of events %d <> %d' % (entries, num_events))
+    num_errors = num_errors + 1
+  if branches != ['MCParticles', 'TestCalHits']:
+    print('+++ ThreadBuffered: Unexpected branches: %s' % (str(branches),))
+    num_errors = num_errors + 1
+  for b in tree.GetListOfBranches():
+    if b.GetEntries() != entries:
+      print('+++ ThreadBuffered: Branch %s has %d entries instead of %d' % (b.GetName(), b.GetEntries(), entries))
+      num_errors = num_errors + 1
+  for evt in range(entries):
+    tree.GetEntry(evt)
+    particles = getattr(tree, 'MCParticles', None)
+    hits = getattr(tree, 'TestCalHits', None)
+    if not particles or particles.size() == 0:
+      print('+++ ThreadBuffered: Event %d has no MC particles' % (evt,))
+      num_errors = num_errors + 1
+    else:
+      num_particles = num_particles + particles.size()
+    if not hits or hits.size() == 0:
+      print('+++ ThreadBuffered: Event %d has no calorimeter hits' % (evt,))
+      num_errors = num_errors + 1
+    else:
+      num_hits = num_hits + hits.size()
+  print('+++ ThreadBuffered: Read %d events with %d particles and %d hits in %d branch(es): %s' %
+        (entries, num_particles, num_hits, len(branches), 'FAILED' if num_errors else 'PASSED'))
+  f.Close()
+  return num_errors
+
+
+def setupWorker(geant4, output):
+  kernel = geant4.kernel()
+  # Setup particle gun
+  gun = geant4.setupGun("Gun", particle='e-', energy=10 * GeV, multiplicity=1, isotrop=False)
+  gun.direction = (0.2, 0.1, 1.0)
+  gun.OutputLevel = Output.WARNING
+
+  # And handle the simulation particles.
+  part = DDG4.GeneratorAction(kernel, "Geant4ParticleHandler/ParticleHandler")
+  kernel.generatorAction().adopt(part)
+  part.MinimalKineticEnergy = 1 * MeV
+  part.enableUI()
+
+  # One output instance per worker: the buffers of all workers are merged
+  evt_root = DDG4.EventAction(kernel, 'Geant4Output2ROOT/RootOutput')
+  evt_root.Output = output
+  evt_root.ThreadBuffered = True
+  evt_root.Compression = 505
+  evt_root.AutoFlush = 2
+  evt_root.BasketSize = 16000
+  evt_root.HandleMCTruth = True
+  evt_root.Control = True
+  evt_root.enableUI()
+  kernel.eventAction().add(evt_root)
+  return 1
+
+
+def setupMaster(geant4):
+  return 1
+
+
+def setupSensitives(geant4):
+  geant4.setupCalorimeter('TestCal')
+  return 1
+
+
+def run():
+  args = DDG4.CommandLine()
+  num_events = int(args.events) if args.events else 20
+  output = args.output if args.output else 'ThreadBuffered.root'
+  if args.check:
+    sys.exit(1 if check(args.check, num_events) else 0)
+
+  kernel = DDG4.Kernel()
+  install_dir = os.environ['DD4hepExamplesINSTALL']
+  kernel.loadGeometry(str("file:" + install_dir + "/examples/ClientTests/compact/MultiSegmentations.xml"))
+  kernel.NumberOfThreads = int(args.threads) if args.threads else 3
+  kernel.RunManagerType = 'G4MTRunManager'
+  kernel.NumEvents = num_events
+  geant4 = DDG4.Geant4(kernel)
+  geant4.printDetectors()
+  geant4.addUserInitialization(worker=setupWorker, worker_args=(geant4, output),
+                               master=setupMaster, master_args=(geant4,))
+  geant4.addDetectorConstruction("Geant4DetectorGeometryConstruction/ConstructGeo")
+  geant4.addDetectorConstruction("Geant4PythonDetectorConstruction/SetupSD",
+                                 sensitives=setupSensitives, sensitives_args=(geant4,))
+  geant4.addDetectorConstruction("Geant4DetectorSensitivesConstruction/ConstructSD")
+
+  rndm = DDG4.Action(kernel, 'Geant4Random/Random')
+  rndm.Seed = 987654321
+  rndm.initialize()
+
+  # Now build the physics list:
+  phys = kernel.physicsList()
+  phys.extends = 'QGSP_BERT'
+  phys.enableUI()
+  # and run
+  geant4.run()
+
+
+if __name__ == "__main__":
+  run()
@@ -26,6 +26,7 @@
 // Framework include files
 #include "ConditionExampleObjects.h"
 #include "DDCond/ConditionsManagerObject.h"
+#include "DDCond/ConditionsIOVPool.h"
 #include "DD4hep/Factories.h"
 #include "TStatistic.h"
 #include "TTimeStamp.h"
@@ -92,6 +93,10 @@ namespace {
                access.GetRMS(), access.GetN());
       printout(INFO,"Statistics","+  Accessed a total of %ld conditions (S:%6ld,L:%6ld,C:%6ld,M:%ld) during the test. Created:%ld",
                total_accesses, totals.selected, totals.loaded, totals.computed, totals.missing, total_created);
+      if ( totals.reused > 0 )  {
+        printout(INFO,"Statistics","+  Re-used %ld derived conditions with unchanged inputs on IOV transitions.",
+                 totals.reused);
+      }
       printout(INFO,"Statistics","+=========================================================================");
     }
   };
@@ -172,8 +177,8 @@ namespace {
  */
 static int condition_example (Detector& description, int argc, char** argv)  {
   string input;
-  int    num_iov = 10, num_threads = 1, num_run = 30;
-  bool   arg_error = false;
+  int    num_iov = 10, num_threads = 1, num_run = 30, num_compute = 0;
+  bool   arg_error = false, timing = false, incremental = false;
   for(int i=0; i<argc && argv[i]; ++i)  {
     if ( 0 == ::strncmp("-input",argv[i],4) )
       input = argv[++i];
@@ -183,6 +188,12 @@ static int condition_example (Detector& description, int argc, char** argv)  {
       num_run = ::atol(argv[++i]);
     else if ( 0 == ::strncmp("-threads",argv[i],4) )
       num_threads = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-compute",argv[i],4) )
+      num_compute = ::atol(argv[++i]);
+    else if ( 0 == ::strncmp("-timing",argv[i],4) )
+      timing = true;
+    else if ( 0 == ::strncmp("-incremental",argv[i],4) )
+      incremental = true;
     else
       arg_error = true;
   }
@@ -195,6 +206,9 @@ static int condition_example (Detector& description, int argc, char** argv)  {
       "     -iovs    <number>        Number of parallel IOV slots for processing.    \n"
       "     -runs    <number>        Number of collision loads to be performed.      \n"
       "     -threads <number>        Number of execution threads.                    \n"
+      "     -compute <number>        Number of threads to compute derived conditions.\n"
+      "     -timing                  Print timing report of the derived conditions.  \n"
+      "     -incremental             Re-use derived conditions with unchanged inputs.\n"
       "\tArguments given: " << arguments(argc,argv) << endl << flush;
     ::exit(EINVAL);
   }
@@ -204,6 +218,9 @@ static int condition_example (Detector& description, int argc, char** argv)  {
 
   /******************** Initialize the conditions manager *****************/
   ConditionsManager manager = installManager(description);
+  manager["ComputeThreads"] = num_compute;
+  manager["CallbackTiming"] = timing;
+  manager["IncrementalUpdates"] = incremental;
   const IOVType*    iov_typ = manager.registerIOVType(0,"run").second;
   if ( 0 == iov_typ )
     except("ConditionsPrepare","++ Unknown IOV type supplied.");
@@ -213,6 +230,9 @@ static int condition_example (Detector& description, int argc, char** argv)  {
   shared_ptr<ConditionsSlice>   slice(new ConditionsSlice(manager,content));
   Scanner(ConditionsKeys(*content,INFO),description.world());
   Scanner(ConditionsDependencyCreator(*content,DEBUG),description.world());
+  // The example callbacks only access declared dependencies: they may run concurrently
+  for( auto& d : content->derived() )
+    d.second->threadSafe = num_compute > 0;
 
   Statistics stats;
   EventQueue events;
@@ -251,6 +271,10 @@ static int condition_example (Detector& description, int argc, char** argv)  {
            "+======= Summary: # of IOV: %3d  # of Threads: %3d ========================",
            num_iov, num_threads);
   stats.print();
+  // Contention of the conditions store: time spent waiting for the IOV pool locks
+  if ( ConditionsIOVPool* iov_pool = manager.iovPool(*iov_typ) )  {
+    iov_pool->printStatistics();
+  }
   // All done.
   return 1;
 }
@@ -0,0 +1,87 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+from __future__ import absolute_import
+import sys
+import dd4hep
+"""
+
+   Compare the deposits of two files written by Digi2ROOTWriter
+
+   $> python CompareDigi.py -reference <file> -input <file>
+
+   Events are processed in parallel: the order of the events in the files is
+   arbitrary. The per-event summaries of all collections (identifiers of the
+   cells hit and energy sum) are sorted and compared. Several deposits of the
+   same cell count as one cell: the merging of containers may differ. The energy sums are compared
+   with the relative precision -tolerance (default: 1e-9).
+
+   @author  M.Frank
+   @version 1.0
+
+"""
+
+
+def summaries(fname):
+  """
+  Per-event summary of all deposit collections of a Digi2ROOTWriter file
+
+  \author  M.Frank
+  """
+  import ROOT
+  f = ROOT.TFile.Open(fname)
+  tree = f.Get('EVENT')
+  names = sorted([b.GetName() for b in tree.GetListOfBranches()
+                  if 'EnergyDeposit' in b.GetClassName()])
+  result = []
+  for evt in range(tree.GetEntries()):
+    tree.GetEntry(evt)
+    cells = []
+    energies = []
+    for name in names:
+      deposits = getattr(tree, name)
+      cells.append((name, tuple(sorted(set([d.first for d in deposits])))))
+      energies.append(sum([d.second.deposit for d in deposits]))
+    result.append((tuple(cells), tuple(energies)))
+  f.Close()
+  return names, sorted(result)
+
+
+def run():
+  args = dd4hep.CommandLine()
+  import dddigi
+  dddigi.loadDDDigi()
+  tolerance = float(args.tolerance) if args.tolerance else 1e-9
+  names, reference = summaries(args.reference)
+  _, data = summaries(args.input)
+  num_errors = 0
+  if len(reference) != len(data):
+    print('+++ CompareDigi: Event numbers differ: %d <> %d' % (len(reference), len(data)))
+    num_errors = num_errors + 1
+  total_cells = 0
+  for ref, evt in zip(reference, data):
+    same = True
+    for i, name in enumerate(names):
+      num_cells = [len(ref[0][i][1]), len(evt[0][i][1])]
+      energy = [ref[1][i], evt[1][i]]
+      total_cells = total_cells + num_cells[0]
+      if ref[0][i] != evt[0][i] or abs(energy[0] - energy[1]) > tolerance * max(abs(energy[0]), 1.0):
+        print('+++ CompareDigi: %s differs: %d <> %d cells energy sum %g <> %g' %
+              (name, num_cells[0], num_cells[1], energy[0], energy[1]))
+        same = False
+    if not same:
+      num_errors = num_errors + 1
+  print('+++ CompareDigi: Compared %d events with %d cells in %d collection(s): %d differences' %
+        (len(reference), total_cells, len(names), num_errors))
+  sys.exit(1 if num_errors else 0)
+
+
+if __name__ == '__main__':
+  run()
@@ -0,0 +1,44 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+from __future__ import absolute_import
+
+
+# ---------------------------------------------------------------------------
+def run():
+  """
+     Read DDG4 input with or without prefetching reader and write the deposits:
+     $> python TestInputPrefetch.py -prefetch 0  -output dddigi_prefetch_0.root
+     $> python TestInputPrefetch.py -prefetch 10 -output dddigi_prefetch_10.root
+     $> python CompareDigi.py -reference dddigi_prefetch_0_00000000.root -input dddigi_prefetch_10_00000000.root
+
+     With a read-ahead depth larger than the number of events, the prefetched
+     events, which are not processed, are dropped at terminate.
+  """
+  import DigiTest
+  digi = DigiTest.Test(geometry=None)
+  prefetch = int(digi.prefetch) if digi.prefetch else 0
+  output = digi.output if digi.output else 'dddigi_prefetch_%d.root' % (prefetch, )
+  read = digi.input_action('DigiDDG4ROOT/SignalReader', mask=0x0, input=[digi.next_input()], prefetch=prefetch)
+  writ = digi.output_action('Digi2ROOTWriter/EventWriter',
+                            parallel=True,
+                            input_mask=0x0,
+                            input_segment='input',
+                            output=output)
+  proc = digi.create_action('Digi2ROOTProcessor/Writer')
+  cont = [c + '/TrackerHits' for c in digi.containers()]
+  writ.adopt_container_processor(proc, cont)
+  digi.check_creation([read, writ, proc])
+  digi.run_checked(num_events=5, num_threads=10, parallel=5)
+
+
+# ---------------------------------------------------------------------------
+if __name__ == '__main__':
+  run()
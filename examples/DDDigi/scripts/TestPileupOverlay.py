@@ -0,0 +1,104 @@
+# ==========================================================================
+#  AIDA Detector description implementation
+# --------------------------------------------------------------------------
+# Copyright (C) Organisation europeenne pour la Recherche nucleaire (CERN)
+# All rights reserved.
+#
+# For the licensing terms see $DD4hepINSTALL/LICENSE.
+# For the list of contributors see $DD4hepINSTALL/doc/CREDITS.
+#
+# ==========================================================================
+from __future__ import absolute_import
+import argparse
+
+
+def run():
+  import DigiTest
+  parser = argparse.ArgumentParser(description='Pile-up overlay from an in-memory event pool')
+  parser.add_argument('-overlays', dest='overlays', default=50, type=int,
+                      help='Number of pile-up events overlayed to each signal event')
+  parser.add_argument('-pool', dest='pool', default=30, type=int,
+                      help='Number of background events kept in memory')
+  parser.add_argument('-events', dest='events', default=5, type=int,
+                      help='Number of signal events to be processed')
+  parser.add_argument('-baseline', dest='baseline', default=False, action='store_true',
+                      help='Baseline: read every pile-up event from file with its own reader')
+  parser.add_argument('-sequential', dest='sequential', default=False, action='store_true',
+                      help='Pool mode: overlay the same pile-up events as the baseline')
+  parser.add_argument('-output', dest='output', default=None,
+                      help='Write the merged deposits to this file')
+  args, _ = parser.parse_known_args()
+
+  digi = DigiTest.Test(geometry=None)
+  input_action = digi.input_action('DigiParallelActionSequence/READER')
+  # ========================================================================================================
+  digi.info('Created SIGNAL input')
+  signal = input_action.adopt_action('DigiDDG4ROOT/SignalReader', mask=0x0, input=[digi.next_input()])
+  digi.check_creation([signal])
+  event = digi.event_action('DigiSequentialActionSequence/EventAction')
+  # ========================================================================================================
+  if args.baseline:
+    # Reference: one reader per pile-up event as in TestMultiInteractions.py
+    masks = []
+    for i in range(args.overlays):
+      mask = 0x100 + i
+      overlay = input_action.adopt_action('DigiSequentialActionSequence/Overlay-%d' % (i, ))
+      evtreader = overlay.adopt_action('DigiDDG4ROOT/Reader-%d' % (i, ), mask=mask, input=[digi.next_input()])
+      hist_drop = overlay.adopt_action('DigiHitHistoryDrop/Drop-%d' % (i, ), masks=[mask])
+      digi.check_creation([overlay, evtreader, hist_drop])
+      masks.append(mask)
+    digi.info('Created baseline with %d pile-up readers' % (args.overlays, ))
+  elif args.sequential:
+    # The pool holds the first events of the baseline input files and
+    # overlay i of the k-th event is the k-th event of the i-th file: as the baseline
+    inputs = [digi.next_input() for i in range(args.overlays)]
+    overlay = event.adopt_action('DigiPileupOverlay/Pileup',
+                                 reader_type='DigiDDG4ROOT',
+                                 input=inputs,
+                                 pool_size=args.overlays * args.events,
+                                 events_per_file=args.events,
+                                 sequential=True,
+                                 overlays=args.overlays,
+                                 output_mask=0xFEED,
+                                 output_segment='inputs')
+    digi.check_creation([overlay])
+    masks = [0xFEED]
+    digi.info('Created sequential pile-up overlay with %d overlays per event from %d files'
+              % (args.overlays, len(inputs), ))
+  else:
+    overlay = event.adopt_action('DigiPileupOverlay/Pileup',
+                                 reader_type='DigiDDG4ROOT',
+                                 input=[digi.next_input()],
+                                 pool_size=args.pool,
+                                 overlays=args.overlays,
+                                 output_mask=0xFEED,
+                                 output_segment='inputs')
+    digi.check_creation([overlay])
+    masks = [0xFEED]
+    digi.info('Created pile-up overlay with %d overlays per event from a pool of %d events'
+              % (args.overlays, args.pool, ))
+  # ========================================================================================================
+  # Pile-up and signal are merged by the standard container combination
+  combine = event.adopt_action('DigiContainerCombine/Combine',
+                               parallel=False,
+                               input_masks=[0x0] + masks,
+                               output_mask=0xBEEF,
+                               input_segment='inputs',
+                               output_segment='deposits',
+                               erase_combined=True)
+  dump = event.adopt_action('DigiStoreDump/StoreDump')
+  digi.check_creation([combine, dump])
+  if args.output:
+    writ = digi.output_action('Digi2ROOTWriter/EventWriter',
+                              parallel=True,
+                              input_mask=0xBEEF,
+                              input_segment='deposits',
+                              output=args.output)
+    proc = digi.create_action('Digi2ROOTProcessor/Writer')
+    writ.adopt_container_processor(proc, [c + '/TrackerHits' for c in digi.containers()])
+    digi.check_creation([writ, proc])
+  # ========================================================================================================
+  digi.run_checked(num_events=args.events, num_threads=10, parallel=3)
+
+if __name__ == '__main__':
+  run()